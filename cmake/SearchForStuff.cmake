@@ -10,6 +10,10 @@ message(STATUS "Building for arch: ${ARCH}")
 list(INSERT CMAKE_MODULE_PATH 0 "${CMAKE_CURRENT_SOURCE_DIR}/cmake/Modules")
 find_package(TinyXML2 REQUIRED)
 
+#################################################
+# Find threads, used to load included files concurrently.
+find_package(Threads REQUIRED)
+
 ################################################
 # Find urdfdom parser. Logic:
 #
@@ -18,10 +18,12 @@
 #define SDF_ELEMENT_HH_
 
 #include <any>
+#include <atomic>
 #include <map>
 #include <memory>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -46,6 +48,7 @@ namespace sdf
   //
 
   class ElementPrivate;
+  class ElementRange;
   class SDFORMAT_VISIBLE Element;
 
   /// \def ElementPtr
@@ -75,6 +78,8 @@ namespace sdf
     public: virtual ~Element();
 
     /// \brief Create a copy of this Element.
+    /// \remarks Element descriptions are shared between this Element and
+    /// its copy, since they are treated as immutable once built.
     /// \return A copy of this Element.
     public: ElementPtr Clone() const;
 
@@ -222,6 +227,9 @@ namespace sdf
     public: ElementPtr GetElementDescription(unsigned int _index) const;
 
     /// \brief Get an element description using a key
+    /// \remarks Element descriptions built from the SDFormat specification
+    /// are shared by every element of the same type, and must not be
+    /// modified.
     /// \param[in] _key the key to use to find the element.
     /// \return An Element pointer to the found element.
     public: ElementPtr GetElementDescription(const std::string &_key) const;
@@ -310,6 +318,14 @@ namespace sdf
     /// child = child->GetNextElement() to iterate through the children.
     public: ElementPtr GetNextElement(const std::string &_name = "") const;
 
+    /// \brief Get a range over the child elements of this element.
+    /// \param[in] _name If given then filter children by their xml tag.
+    /// \return A range that can be used in a range-based for loop, e.g.
+    /// `for (const auto &link : model->Children("link"))`. Iterating the
+    /// range is equivalent to calling GetElement(_name) followed by
+    /// GetNextElement(_name), without adding missing elements.
+    public: ElementRange Children(const std::string &_name = "") const;
+
     /// \brief Get set of child element type names.
     /// \return A set of the names of the child elements.
     public: std::set<std::string> GetElementTypeNames() const;
@@ -371,8 +387,8 @@ namespace sdf
     ///        the embedded Param.
     public: void Update();
 
-    /// \brief Call reset on each element and element description
-    ///        before deleting all of them.  Also clear out the
+    /// \brief Call reset on each element before deleting all of them,
+    ///        and release the element descriptions.  Also clear out the
     ///        embedded Param.
     public: void Reset();
 
@@ -467,18 +483,9 @@ namespace sdf
     /// \brief Element's parent
     public: ElementWeakPtr parent;
 
-    // Attributes of this element
-    public: Param_V attributes;
-
     // Value of this element
     public: ParamPtr value;
 
-    // The existing child elements
-    public: ElementPtr_V elements;
-
-    // The possible child elements
-    public: ElementPtr_V elementDescriptions;
-
     /// name of the include file that was used to create this element
     public: std::string includeFilename;
 
@@ -490,6 +497,124 @@ namespace sdf
 
     /// \brief Spec version that this was originally parsed from.
     public: std::string originalVersion;
+
+    /// \brief Append an attribute and index it by key.
+    /// \param[in] _param Attribute to add.
+    private: void PushAttribute(ParamPtr _param);
+
+    /// \brief Append a child element and index it by name.
+    /// \param[in] _elem Child element to add.
+    private: void PushElement(ElementPtr _elem);
+
+    /// \brief Remove a child element and update the index entry of its
+    /// name.
+    /// \param[in] _iter Position of the child element in elements.
+    private: void EraseElement(ElementPtr_V::iterator _iter);
+
+    /// \brief Update the index entries of a child element that was renamed.
+    /// \param[in] _elem The child element, which already has its new name.
+    /// \param[in] _oldName The previous name of the child element.
+    private: void RenameElement(const Element *_elem,
+                                const std::string &_oldName);
+
+    /// \brief Clear the child elements and their index.
+    private: void ClearElements();
+
+    /// \brief Append an element description and index it by name.
+    /// \param[in] _elem Element description to add.
+    private: void PushElementDescription(ElementPtr _elem);
+
+    /// \brief Share the element descriptions and their index of another
+    /// element.
+    /// \param[in] _other Private data of the other element.
+    private: void CopyElementDescriptions(const ElementPrivate &_other);
+
+    /// \brief Clear the element descriptions and their index.
+    private: void ClearElementDescriptions();
+
+    /// \brief Attributes of this element. Only modified through
+    /// PushAttribute, which keeps attributesIndex up to date.
+    private: Param_V attributes;
+
+    /// \brief The existing child elements. Only modified through
+    /// PushElement, EraseElement, RenameElement and ClearElements, which
+    /// keep elementsIndex up to date.
+    private: ElementPtr_V elements;
+
+    /// \brief The possible child elements. Only modified through
+    /// PushElementDescription, CopyElementDescriptions and
+    /// ClearElementDescriptions, which keep elementDescriptionsIndex up to
+    /// date.
+    private: ElementPtr_V elementDescriptions;
+
+    /// \brief Index of the first attribute with a given key.
+    private: std::unordered_map<std::string, std::size_t> attributesIndex;
+
+    /// \brief First child element with a given name.
+    private: std::unordered_map<std::string, ElementPtr> elementsIndex;
+
+    /// \brief Index of the first element description with a given name.
+    private: std::unordered_map<std::string, std::size_t>
+             elementDescriptionsIndex;
+
+    /// \brief Cached position of this element in its parent's elements
+    /// vector. Used by GetNextElement, which validates it before use.
+    private: std::atomic<std::size_t> indexInParent{0};
+
+    /// \brief Element maintains the indexes.
+    private: friend class Element;
+  };
+
+  /// \brief A forward range over the child elements of an Element,
+  /// optionally filtered by name. See Element::Children.
+  class SDFORMAT_VISIBLE ElementRange
+  {
+    /// \brief Iterator over the elements of an ElementRange.
+    public: class SDFORMAT_VISIBLE Iterator
+    {
+      /// \brief Constructor.
+      /// \param[in] _elem Current element, or nullptr for the end iterator.
+      /// \param[in] _name Name used to filter siblings.
+      public: Iterator(ElementPtr _elem, const std::string &_name);
+
+      /// \brief Get the current element.
+      /// \return The current element.
+      public: const ElementPtr &operator*() const;
+
+      /// \brief Advance to the next sibling that matches the filter.
+      /// \return A reference to this iterator.
+      public: Iterator &operator++();
+
+      /// \brief Inequality operator.
+      /// \param[in] _other Iterator to compare against.
+      /// \return True if the iterators point to different elements.
+      public: bool operator!=(const Iterator &_other) const;
+
+      /// \brief Current element.
+      private: ElementPtr elem;
+
+      /// \brief Name used to filter siblings.
+      private: std::string name;
+    };
+
+    /// \brief Constructor.
+    /// \param[in] _first First element of the range, or nullptr if empty.
+    /// \param[in] _name Name used to filter siblings.
+    public: ElementRange(ElementPtr _first, const std::string &_name);
+
+    /// \brief Get an iterator to the first element of the range.
+    /// \return Iterator to the first element.
+    public: Iterator begin() const;
+
+    /// \brief Get an iterator past the last element of the range.
+    /// \return End iterator.
+    public: Iterator end() const;
+
+    /// \brief First element of the range.
+    private: ElementPtr first;
+
+    /// \brief Name used to filter siblings.
+    private: std::string name;
   };
 
   ///////////////////////////////////////////////
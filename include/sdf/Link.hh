@@ -79,7 +79,7 @@ namespace sdf
     /// \brief Get the name of the link.
     /// The name of a link must be unique within the scope of a Model.
     /// \return Name of the link.
-    public: std::string Name() const;
+    public: const std::string &Name() const;
 
     /// \brief Set the name of the link.
     /// The name of a link must be unique within the scope of a Model.
@@ -19,9 +19,11 @@
 
 #include <memory>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <ignition/math/Pose3.hh>
 #include "sdf/Element.hh"
+#include "sdf/ResolvedPoses.hh"
 #include "sdf/SemanticPose.hh"
 #include "sdf/Types.hh"
 #include "sdf/sdf_config.h"
@@ -79,7 +81,7 @@ namespace sdf
     /// \brief Get the name of the model.
     /// The name of the model should be unique within the scope of a World.
     /// \return Name of the model.
-    public: std::string Name() const;
+    public: const std::string &Name() const;
 
     /// \brief Set the name of the model.
     /// The name of the model should be unique within the scope of a World.
@@ -305,6 +307,22 @@ namespace sdf
     /// \return SemanticPose object for this link.
     public: sdf::SemanticPose SemanticPose() const;
 
+    /// \brief Resolve the poses of all the links, joints, frames and nested
+    /// models of this model, and of the collisions, visuals, sensors and
+    /// lights of its links, in one call. This is faster than resolving the
+    /// SemanticPose of each object, since the poses are computed from a
+    /// single pass over the PoseRelativeToGraph.
+    /// \param[out] _poses The resolved poses. Objects whose pose can't be
+    /// resolved are left out.
+    /// \param[in] _resolveTo Name of the frame in the scope of this model
+    /// relative to which the poses are resolved. If empty, the poses are
+    /// resolved relative to the model frame.
+    /// \return Errors, which is a vector of Error objects. Each Error
+    /// includes an error code and message. An empty vector indicates no
+    /// error.
+    public: Errors ResolvePoses(ResolvedPoses &_poses,
+                                const std::string &_resolveTo = "") const;
+
     /// \brief Get the name of the placement frame of the model.
     /// \return Name of the placement frame attribute of the model.
     public: const std::string &PlacementFrameName() const;
@@ -337,6 +355,21 @@ namespace sdf
     private: void SetFrameAttachedToGraph(
         sdf::ScopedGraph<FrameAttachedToGraph> _graph);
 
+    /// \brief Find a nested model by a name that can be a sequence of nested
+    /// model names separated by "::", without copying the name segments.
+    /// \param[in] _name Nested model name.
+    /// \return The nested model, or nullptr if it was not found.
+    private: const Model *NestedModelByName(std::string_view _name) const;
+
+    /// \brief Find the model that contains the object referred to by a
+    /// nested name. If the part of the name before the last "::" is the name
+    /// of a nested model, that model is returned and _name is set to the part
+    /// after the last "::". Otherwise this model is returned and _name is left
+    /// unchanged.
+    /// \param[in,out] _name Nested name of an object.
+    /// \return The model that contains the object.
+    private: const Model *ScopeOfName(std::string_view &_name) const;
+
     /// \brief Allow Root::Load, World::SetPoseRelativeToGraph, or
     /// World::SetFrameAttachedToGraph to call SetPoseRelativeToGraph and
     /// SetFrameAttachedToGraph
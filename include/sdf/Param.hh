@@ -281,6 +281,31 @@ namespace sdf
     //// \brief Name of the type.
     public: std::string typeName;
 
+    /// \brief Types that a parameter value can be parsed as.
+    public: enum class ValueType
+    {
+      /// \brief The type name was not recognized.
+      UNKNOWN = 0,
+      BOOL,
+      CHAR,
+      STRING,
+      INT,
+      UINT64,
+      UNSIGNED_INT,
+      DOUBLE,
+      FLOAT,
+      TIME,
+      COLOR,
+      VECTOR2I,
+      VECTOR2D,
+      VECTOR3,
+      QUATERNION,
+      POSE
+    };
+
+    /// \brief Type of the value, resolved from typeName on construction.
+    public: ValueType valueType = ValueType::UNKNOWN;
+
     /// \brief Description of the parameter.
     public: std::string description;
 
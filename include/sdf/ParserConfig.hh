@@ -0,0 +1,223 @@
+/*
+ * Copyright 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef SDF_PARSER_CONFIG_HH_
+#define SDF_PARSER_CONFIG_HH_
+
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "sdf/sdf_config.h"
+#include "sdf/system_util.hh"
+
+namespace sdf
+{
+  // Inline bracket to help doxygen filtering.
+  inline namespace SDF_VERSION_NAMESPACE {
+  // Forward declare private data class.
+  class ParserConfigPrivate;
+
+  /// \brief This class contains configuration options for the libsdformat
+  /// parser, such as the URI path map and the callback used to find files.
+  ///
+  /// Every parsing function that does not take a ParserConfig uses the
+  /// global configuration, which is modified by sdf::addURIPath and
+  /// sdf::setFindCallback. Parsing is re-entrant: independent files can be
+  /// parsed concurrently from several threads as long as the configuration
+  /// used by each parse is not modified while it is in progress. To change
+  /// the configuration while other threads are parsing, give each parse its
+  /// own copy of a ParserConfig instead of modifying the global one.
+  class SDFORMAT_VISIBLE ParserConfig
+  {
+    /// \brief Map from a URI scheme, such as "model://", to a list of search
+    /// paths.
+    public: using SchemeToPathMap =
+                std::map<std::string, std::vector<std::string>>;
+
+    /// \brief Callback used to find a file that could not be found in the
+    /// search paths.
+    public: using FindFileCallbackType =
+                std::function<std::string(const std::string &)>;
+
+    /// \brief Default constructor
+    public: ParserConfig();
+
+    /// \brief Copy constructor
+    /// \param[in] _config ParserConfig to copy.
+    public: ParserConfig(const ParserConfig &_config);
+
+    /// \brief Move constructor
+    /// \param[in] _config ParserConfig to move.
+    public: ParserConfig(ParserConfig &&_config) noexcept;
+
+    /// \brief Destructor
+    public: ~ParserConfig();
+
+    /// \brief Assignment operator.
+    /// \param[in] _config The ParserConfig to set values from.
+    /// \return *this
+    public: ParserConfig &operator=(const ParserConfig &_config);
+
+    /// \brief Move assignment operator.
+    /// \param[in] _config The ParserConfig to set values from.
+    /// \return *this
+    public: ParserConfig &operator=(ParserConfig &&_config) noexcept;
+
+    /// \brief Get the global parser configuration. This is the configuration
+    /// used by the parsing functions that do not take a ParserConfig.
+    /// \return Reference to the global ParserConfig object.
+    public: static ParserConfig &GlobalConfig();
+
+    /// \brief Get the callback used to find files.
+    /// \return The callback, which is empty if it has not been set.
+    public: FindFileCallbackType FindFileCallback() const;
+
+    /// \brief Set the callback to use when libsdformat can't find a file.
+    /// The callback should return a complete path to the requested file, or
+    /// an empty string if the file was not found in the callback.
+    /// Setting the callback clears the findFile and include caches.
+    /// \param[in] _cb The callback function.
+    public: void SetFindCallback(FindFileCallbackType _cb);
+
+    /// \brief Get the URI scheme to search path map.
+    /// \return A reference to the map.
+    public: const SchemeToPathMap &URIPathMap() const;
+
+    /// \brief Associate paths to a URI.
+    /// Example parameters: "model://", "/usr/share/models:~/.gazebo/models"
+    /// Adding paths clears the findFile and include caches.
+    /// \param[in] _uri URI that will be mapped to _path
+    /// \param[in] _path Colon separated set of paths. Paths that are not
+    /// existing directories are ignored.
+    public: void AddURIPath(const std::string &_uri, const std::string &_path);
+
+    /// \brief Get the number of threads used to load the files referenced
+    /// by the <include> elements of a single parent element.
+    /// \return The number of threads. The default value of 1 loads the
+    /// included files one at a time.
+    /// \sa SetIncludeThreadCount
+    public: std::size_t IncludeThreadCount() const;
+
+    /// \brief Set the number of threads used to load the files referenced by
+    /// the <include> elements of a single parent element, such as a world.
+    /// When greater than 1, the included files are found, read and converted
+    /// concurrently, then inserted in document order, so the result is the
+    /// same as when they are loaded one at a time. Includes nested inside
+    /// included files are loaded on the thread that loads their parent.
+    /// The find-file callback may be called from several threads at once
+    /// when this is enabled.
+    /// \param[in] _count Number of threads. Values of 0 and 1 load included
+    /// files one at a time.
+    public: void SetIncludeThreadCount(std::size_t _count);
+
+    /// \brief Get whether files loaded through <include> elements are
+    /// cached.
+    /// \return True if included files are cached.
+    /// \sa SetIncludeCacheEnabled
+    public: bool IncludeCacheEnabled() const;
+
+    /// \brief Enable or disable caching of files loaded through <include>
+    /// elements. When enabled, each included file is read and converted
+    /// once, and every <include> of the same file gets a copy of the cached
+    /// elements. Entries are keyed by the canonical path of the included
+    /// file and are discarded when its modification time or size changes.
+    /// Changes to files that the included file includes in turn are not
+    /// detected; call ClearIncludeCache after modifying them. The cache is
+    /// disabled by default, and copies of a ParserConfig start with an empty
+    /// cache. Disabling the cache clears it.
+    /// \param[in] _enabled True to cache included files.
+    public: void SetIncludeCacheEnabled(bool _enabled);
+
+    /// \brief Get the number of included files that were found in the cache
+    /// since it was enabled or last cleared.
+    /// \return Number of cache hits.
+    public: std::size_t IncludeCacheHits() const;
+
+    /// \brief Get the number of included files that were not found in the
+    /// cache since it was enabled or last cleared.
+    /// \return Number of cache misses.
+    public: std::size_t IncludeCacheMisses() const;
+
+    /// \brief Remove every cached included file and reset the hit and miss
+    /// counters.
+    public: void ClearIncludeCache();
+
+    /// \brief Get whether the results of sdf::findFile are cached.
+    /// \return True if findFile results are cached.
+    /// \sa SetFindFileCacheEnabled
+    public: bool FindFileCacheEnabled() const;
+
+    /// \brief Enable or disable caching of sdf::findFile results for this
+    /// configuration. When enabled, each lookup searches the file system
+    /// once, and both found paths and failed lookups are remembered until
+    /// the cache is cleared. Call ClearFindFileCache after adding or
+    /// removing files that have already been looked up. The cache is
+    /// disabled by default, and copies of a ParserConfig start with an empty
+    /// cache. Disabling the cache clears it.
+    /// \param[in] _enabled True to cache findFile results.
+    public: void SetFindFileCacheEnabled(bool _enabled);
+
+    /// \brief Remove every cached findFile result.
+    public: void ClearFindFileCache();
+
+    /// \brief Get whether conversion recipes apply their descendant rules in
+    /// a single pass.
+    /// \return True if single pass conversion is enabled.
+    /// \sa SetSinglePassConversionEnabled
+    public: bool SinglePassConversionEnabled() const;
+
+    /// \brief Enable or disable single pass conversion of documents from
+    /// older SDFormat versions. By default, each <convert descendant_name>
+    /// rule of a recipe walks the whole document on its own. When enabled,
+    /// the descendant rules of a <convert> element are gathered up front and
+    /// every element is visited once, applying the rules that match its name
+    /// in recipe order. This gives the same result as long as the descendant
+    /// rules of a recipe don't change the elements matched by each other,
+    /// which holds for the recipes shipped with SDFormat. Disabled by
+    /// default.
+    /// \param[in] _enabled True to convert in a single pass.
+    public: void SetSinglePassConversionEnabled(bool _enabled);
+
+    /// \brief Get the number of threads used to load sibling models into
+    /// DOM objects.
+    /// \return The number of threads. The default value of 1 loads the
+    /// models one at a time.
+    /// \sa SetModelLoadThreadCount
+    public: std::size_t ModelLoadThreadCount() const;
+
+    /// \brief Set the number of threads used by sdf::Root::Load and
+    /// sdf::World::Load to load the models that are direct children of
+    /// <sdf> or <world> into sdf::Model objects. When greater than 1, the
+    /// models and their frame graphs are built concurrently, then added in
+    /// document order with their errors, so the result is the same as when
+    /// they are loaded one at a time. Nested models are loaded on the thread
+    /// that loads their parent.
+    /// \param[in] _count Number of threads. Values of 0 and 1 load models
+    /// one at a time.
+    public: void SetModelLoadThreadCount(std::size_t _count);
+
+    /// \brief The private data gives the parser access to the caches.
+    private: friend class ParserConfigPrivate;
+
+    /// \brief Private data pointer.
+    private: ParserConfigPrivate *dataPtr = nullptr;
+  };
+  }
+}
+#endif
@@ -0,0 +1,162 @@
+/*
+ * Copyright 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef SDF_RESOLVED_POSES_HH_
+#define SDF_RESOLVED_POSES_HH_
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <ignition/math/Pose3.hh>
+#include <ignition/math/Quaternion.hh>
+#include <ignition/math/Vector3.hh>
+
+#include "sdf/sdf_config.h"
+#include "sdf/system_util.hh"
+
+namespace sdf
+{
+  // Inline bracket to help doxygen filtering.
+  inline namespace SDF_VERSION_NAMESPACE {
+  // Forward declare private data class.
+  class ResolvedPosesPrivate;
+
+  /// \brief The resolved poses of the frames and objects of a model or
+  /// world, all relative to the same frame. It is filled by
+  /// Model::ResolvePoses and World::ResolvePoses.
+  ///
+  /// The poses are stored as a structure of arrays: entry i has the name
+  /// Names()[i], the type Types()[i], the position Positions()[i] and the
+  /// orientation Orientations()[i]. Names are relative to the scope of the
+  /// model or world, and are scoped with "::", such as "link",
+  /// "link::visual" or "nested_model::link::collision".
+  class SDFORMAT_VISIBLE ResolvedPoses
+  {
+    /// \brief Type of object whose pose is resolved.
+    public: enum class PoseType
+    {
+      /// \brief A model nested in the model, or a model in the world.
+      MODEL,
+
+      /// \brief A link.
+      LINK,
+
+      /// \brief A joint.
+      JOINT,
+
+      /// \brief An explicit frame.
+      FRAME,
+
+      /// \brief A collision of a link.
+      COLLISION,
+
+      /// \brief A visual of a link.
+      VISUAL,
+
+      /// \brief A sensor of a link.
+      SENSOR,
+
+      /// \brief A light of a link or world.
+      LIGHT,
+    };
+
+    /// \brief Default constructor
+    public: ResolvedPoses();
+
+    /// \brief Copy constructor
+    /// \param[in] _poses ResolvedPoses to copy.
+    public: ResolvedPoses(const ResolvedPoses &_poses);
+
+    /// \brief Move constructor
+    /// \param[in] _poses ResolvedPoses to move.
+    public: ResolvedPoses(ResolvedPoses &&_poses) noexcept;
+
+    /// \brief Destructor
+    public: ~ResolvedPoses();
+
+    /// \brief Assignment operator.
+    /// \param[in] _poses The ResolvedPoses to set values from.
+    /// \return *this
+    public: ResolvedPoses &operator=(const ResolvedPoses &_poses);
+
+    /// \brief Move assignment operator.
+    /// \param[in] _poses The ResolvedPoses to set values from.
+    /// \return *this
+    public: ResolvedPoses &operator=(ResolvedPoses &&_poses) noexcept;
+
+    /// \brief Get the number of poses.
+    /// \return Number of poses.
+    public: std::size_t Count() const;
+
+    /// \brief Get the name of the frame relative to which the poses are
+    /// resolved.
+    /// \return Name of the frame.
+    public: const std::string &ResolveTo() const;
+
+    /// \brief Set the name of the frame relative to which the poses are
+    /// resolved.
+    /// \param[in] _resolveTo Name of the frame.
+    public: void SetResolveTo(const std::string &_resolveTo);
+
+    /// \brief Get the scoped names of the objects.
+    /// \return Names of the objects.
+    public: const std::vector<std::string> &Names() const;
+
+    /// \brief Get the types of the objects.
+    /// \return Types of the objects.
+    public: const std::vector<PoseType> &Types() const;
+
+    /// \brief Get the positions of the objects.
+    /// \return Positions of the objects.
+    public: const std::vector<ignition::math::Vector3d> &Positions() const;
+
+    /// \brief Get the orientations of the objects.
+    /// \return Orientations of the objects.
+    public: const std::vector<ignition::math::Quaterniond> &Orientations()
+                const;
+
+    /// \brief Get a pose by index.
+    /// \param[in] _index Index of the pose, which must be less than Count().
+    /// \return The pose.
+    public: ignition::math::Pose3d PoseByIndex(std::size_t _index) const;
+
+    /// \brief Get the index of an object by name.
+    /// \param[in] _name Scoped name of the object.
+    /// \return Index of the object, or Count() if there is no object with
+    /// that name.
+    public: std::size_t IndexByName(const std::string &_name) const;
+
+    /// \brief Add a pose.
+    /// \param[in] _name Scoped name of the object.
+    /// \param[in] _type Type of the object.
+    /// \param[in] _pose Resolved pose of the object.
+    public: void Add(const std::string &_name, PoseType _type,
+                     const ignition::math::Pose3d &_pose);
+
+    /// \brief Reserve space for a number of poses.
+    /// \param[in] _count Number of poses.
+    public: void Reserve(std::size_t _count);
+
+    /// \brief Remove all the poses.
+    public: void Clear();
+
+    /// \brief Private data pointer.
+    private: ResolvedPosesPrivate *dataPtr = nullptr;
+  };
+  }
+}
+#endif
@@ -18,7 +18,9 @@
 #define SDF_ROOT_HH_
 
 #include <string>
+#include <string_view>
 
+#include "sdf/ParserConfig.hh"
 #include "sdf/SDFImpl.hh"
 #include "sdf/Types.hh"
 #include "sdf/sdf_config.h"
@@ -83,12 +85,30 @@ namespace sdf
     /// an error code and message. An empty vector indicates no error.
     public: Errors Load(const std::string &_filename);
 
+    /// \brief Parse the given SDF file, and generate objects based on types
+    /// specified in the SDF file.
+    /// \param[in] _filename Name of the SDF file to parse.
+    /// \param[in] _config Parser configuration
+    /// \return Errors, which is a vector of Error objects. Each Error includes
+    /// an error code and message. An empty vector indicates no error.
+    public: Errors Load(const std::string &_filename,
+                        const ParserConfig &_config);
+
+    /// \brief Parse the given SDF string, and generate objects based on types
+    /// specified in the SDF file.
+    /// \param[in] _sdf SDF string to parse.
+    /// \return Errors, which is a vector of Error objects. Each Error includes
+    /// an error code and message. An empty vector indicates no error.
+    public: Errors LoadSdfString(std::string_view _sdf);
+
     /// \brief Parse the given SDF string, and generate objects based on types
     /// specified in the SDF file.
     /// \param[in] _sdf SDF string to parse.
+    /// \param[in] _config Parser configuration
     /// \return Errors, which is a vector of Error objects. Each Error includes
     /// an error code and message. An empty vector indicates no error.
-    public: Errors LoadSdfString(const std::string &_sdf);
+    public: Errors LoadSdfString(std::string_view _sdf,
+                                 const ParserConfig &_config);
 
     /// \brief Parse the given SDF pointer, and generate objects based on types
     /// specified in the SDF file.
@@ -97,6 +117,14 @@ namespace sdf
     /// an error code and message. An empty vector indicates no error.
     public: Errors Load(const SDFPtr _sdf);
 
+    /// \brief Parse the given SDF pointer, and generate objects based on types
+    /// specified in the SDF file.
+    /// \param[in] _sdf SDF pointer to parse.
+    /// \param[in] _config Parser configuration
+    /// \return Errors, which is a vector of Error objects. Each Error includes
+    /// an error code and message. An empty vector indicates no error.
+    public: Errors Load(const SDFPtr _sdf, const ParserConfig &_config);
+
     /// \brief Get the SDF version specified in the parsed file or SDF
     /// pointer.
     /// \return SDF version string.
@@ -119,6 +147,13 @@ namespace sdf
     /// \sa uint64_t WorldCount() const
     public: const World *WorldByIndex(const uint64_t _index) const;
 
+    /// \brief Get a mutable world based on an index.
+    /// \param[in] _index Index of the world. The index should be in the
+    /// range [0..WorldCount()).
+    /// \return Pointer to the world. Nullptr if the index does not exist.
+    /// \sa uint64_t WorldCount() const
+    public: World *WorldByIndex(const uint64_t _index);
+
     /// \brief Get whether a world name exists.
     /// \param[in] _name Name of the world to check.
     /// \return True if there exists a world with the given name.
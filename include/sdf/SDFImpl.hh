@@ -23,6 +23,7 @@
 
 #include "sdf/Param.hh"
 #include "sdf/Element.hh"
+#include "sdf/ParserConfig.hh"
 #include "sdf/sdf_config.h"
 #include "sdf/system_util.hh"
 #include "sdf/Types.hh"
@@ -64,14 +65,30 @@ namespace sdf
                        bool _searchLocalPath = true,
                        bool _useCallback = false);
 
-  /// \brief Associate paths to a URI.
+  /// \brief Find the absolute path of a file, using the URI path map and
+  /// find file callback of the given parser configuration.
+  /// \param[in] _filename Name of the file to find.
+  /// \param[in] _searchLocalPath True to search for the file in the current
+  /// working directory.
+  /// \param[in] _useCallback True to find a file based on a registered
+  /// callback if the file is not found via the normal mechanism.
+  /// \param[in] _config Parser configuration.
+  /// \return File's full path.
+  SDFORMAT_VISIBLE
+  std::string findFile(const std::string &_filename,
+                       bool _searchLocalPath,
+                       bool _useCallback,
+                       const ParserConfig &_config);
+
+  /// \brief Associate paths to a URI in the global parser configuration.
   /// Example paramters: "model://", "/usr/share/models:~/.gazebo/models"
   /// \param[in] _uri URI that will be mapped to _path
   /// \param[in] _path Colon separated set of paths.
   SDFORMAT_VISIBLE
   void addURIPath(const std::string &_uri, const std::string &_path);
 
-  /// \brief Set the callback to use when SDF can't find a file.
+  /// \brief Set the callback to use when SDF can't find a file. This sets
+  /// the callback of the global parser configuration.
   /// The callback should return a complete path to the requested file, or
   /// and empty string if the file was not found in the callback.
   /// \param[in] _cb The callback function.
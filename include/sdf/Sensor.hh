@@ -143,7 +143,7 @@ namespace sdf
     /// \brief Get the name of the sensor.
     /// The name of the sensor should be unique within the scope of a World.
     /// \return Name of the sensor.
-    public: std::string Name() const;
+    public: const std::string &Name() const;
 
     /// \brief Set the name of the sensor.
     /// The name of the sensor should be unique within the scope of a World.
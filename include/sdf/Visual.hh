@@ -80,7 +80,7 @@ namespace sdf
     /// \brief Get the name of the visual.
     /// The name of the visual must be unique within the scope of a Link.
     /// \return Name of the visual.
-    public: std::string Name() const;
+    public: const std::string &Name() const;
 
     /// \brief Set the name of the visual.
     /// The name of the visual must be unique within the scope of a Link.
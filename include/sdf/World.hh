@@ -23,6 +23,8 @@
 #include "sdf/Atmosphere.hh"
 #include "sdf/Element.hh"
 #include "sdf/Gui.hh"
+#include "sdf/ParserConfig.hh"
+#include "sdf/ResolvedPoses.hh"
 #include "sdf/Scene.hh"
 #include "sdf/Types.hh"
 #include "sdf/sdf_config.h"
@@ -79,6 +81,15 @@ namespace sdf
     /// an error code and message. An empty vector indicates no error.
     public: Errors Load(ElementPtr _sdf);
 
+    /// \brief Load the world based on a element pointer. This is *not* the
+    /// usual entry point. Typical usage of the SDF DOM is through the Root
+    /// object.
+    /// \param[in] _sdf The SDF Element pointer
+    /// \param[in] _config Parser configuration
+    /// \return Errors, which is a vector of Error objects. Each Error includes
+    /// an error code and message. An empty vector indicates no error.
+    public: Errors Load(ElementPtr _sdf, const ParserConfig &_config);
+
     /// \brief Get the name of the world.
     /// \return Name of the world.
     public: std::string Name() const;
@@ -275,6 +286,40 @@ namespace sdf
     /// \return True if there exists a physics profile with the given name.
     public: bool PhysicsNameExists(const std::string &_name) const;
 
+    /// \brief Resolve the poses of all the models, frames and lights of this
+    /// world, and of the links, joints, frames, nested models, collisions,
+    /// visuals, sensors and lights of its models, in one call. This is
+    /// faster than resolving the SemanticPose of each object, since the
+    /// poses are computed from a single pass over the PoseRelativeToGraph.
+    /// \param[out] _poses The resolved poses. Objects whose pose can't be
+    /// resolved are left out.
+    /// \param[in] _resolveTo Name of the frame in the scope of this world
+    /// relative to which the poses are resolved. If empty, the poses are
+    /// resolved relative to the world frame.
+    /// \return Errors, which is a vector of Error objects. Each Error
+    /// includes an error code and message. An empty vector indicates no
+    /// error.
+    public: Errors ResolvePoses(ResolvedPoses &_poses,
+                                const std::string &_resolveTo = "") const;
+
+    /// \brief Replace a model of this world with a changed version of it,
+    /// for example loaded from an edited copy of the model's element, and
+    /// update the frame graphs of the world without rebuilding them. Only
+    /// the parts of the graphs that belong to the model are rebuilt and
+    /// validated, so the cost depends on the size of the model but not on
+    /// the size of the world. The frames of the model can be moved and new
+    /// links, joints, frames and nested models can be added, but removing
+    /// one or changing its type, for example by making the model static,
+    /// requires loading the world again. Only the DOM object of the model is
+    /// replaced: the element of the world, returned by Element(), is not
+    /// modified and still holds the previous version of the model.
+    /// \param[in] _model The changed model. It replaces the model of this
+    /// world with the same name.
+    /// \return Errors, which is a vector of Error objects. Each Error
+    /// includes an error code and message. An empty vector indicates no
+    /// error. The world is not modified if there are errors.
+    public: Errors UpdateModel(const Model &_model);
+
     /// \brief Give the Scoped PoseRelativeToGraph to be passed on to child
     /// entities for resolving poses. This is private and is intended to be
     /// called by Root::Load.
@@ -17,8 +17,11 @@
 #ifndef SDF_PARSER_HH_
 #define SDF_PARSER_HH_
 
+#include <ostream>
 #include <string>
+#include <string_view>
 
+#include "sdf/ParserConfig.hh"
 #include "sdf/SDFImpl.hh"
 #include "sdf/sdf_config.h"
 #include "sdf/system_util.hh"
@@ -54,7 +57,7 @@ namespace sdf
 
   /// \brief Initialize the SDF interface using a string
   SDFORMAT_VISIBLE
-  bool initString(const std::string &_xmlString, SDFPtr _sdf);
+  bool initString(std::string_view _xmlString, SDFPtr _sdf);
 
   /// \brief Populate the SDF values from a file
   ///
@@ -77,6 +80,19 @@ namespace sdf
   SDFORMAT_VISIBLE
   sdf::SDFPtr readFile(const std::string &_filename, Errors &_errors);
 
+  /// \brief Populate the SDF values from a file
+  ///
+  /// This populates the given sdf pointer from a file. If the file is a URDF
+  /// file it is converted to SDF first. All files are converted to the latest
+  /// SDF version
+  /// \param[in] _filename Name of the SDF file
+  /// \param[in] _config Parser configuration
+  /// \param[out] _errors Parsing errors will be appended to this variable.
+  /// \return Populated SDF pointer.
+  SDFORMAT_VISIBLE
+  sdf::SDFPtr readFile(const std::string &_filename,
+      const ParserConfig &_config, Errors &_errors);
+
   /// \brief Populate the SDF values from a file
   ///
   /// This populates the given sdf pointer from a file. If the file is a URDF
@@ -89,6 +105,20 @@ namespace sdf
   SDFORMAT_VISIBLE
   bool readFile(const std::string &_filename, SDFPtr _sdf, Errors &_errors);
 
+  /// \brief Populate the SDF values from a file
+  ///
+  /// This populates the given sdf pointer from a file. If the file is a URDF
+  /// file it is converted to SDF first. All files are converted to the latest
+  /// SDF version
+  /// \param[in] _filename Name of the SDF file
+  /// \param[in] _config Parser configuration
+  /// \param[in] _sdf Pointer to an SDF object.
+  /// \param[out] _errors Parsing errors will be appended to this variable.
+  /// \return True if successful.
+  SDFORMAT_VISIBLE
+  bool readFile(const std::string &_filename, const ParserConfig &_config,
+      SDFPtr _sdf, Errors &_errors);
+
   /// \brief Populate the SDF values from a file without converting to the
   /// latest SDF version
   ///
@@ -104,6 +134,22 @@ namespace sdf
   bool readFileWithoutConversion(
       const std::string &_filename, SDFPtr _sdf, Errors &_errors);
 
+  /// \brief Populate the SDF values from a file without converting to the
+  /// latest SDF version
+  ///
+  /// This populates the given sdf pointer from a file. If the file is a URDF
+  /// file it is converted to SDF first. This function does not convert the
+  /// loaded SDF to the latest version. Use this function with care, as it may
+  /// prevent loading of DOM objects from this SDF object.
+  /// \param[in] _filename Name of the SDF file
+  /// \param[in] _config Parser configuration
+  /// \param[in] _sdf Pointer to an SDF object.
+  /// \param[out] _errors Parsing errors will be appended to this variable.
+  /// \return True if successful.
+  SDFORMAT_VISIBLE
+  bool readFileWithoutConversion(const std::string &_filename,
+      const ParserConfig &_config, SDFPtr _sdf, Errors &_errors);
+
   /// \brief Populate the SDF values from a file
   ///
   /// This populates the given sdf pointer from a file. If the file is a URDF
@@ -125,7 +171,7 @@ namespace sdf
   /// \param[out] _errors Parsing errors will be appended to this variable.
   /// \return True if successful.
   SDFORMAT_VISIBLE
-  bool readString(const std::string &_xmlString, SDFPtr _sdf, Errors &_errors);
+  bool readString(std::string_view _xmlString, SDFPtr _sdf, Errors &_errors);
 
   /// \brief Populate the SDF values from a string
   ///
@@ -133,10 +179,24 @@ namespace sdf
   /// string it is converted to SDF first. All string are converted to the
   /// latest SDF version
   /// \param[in] _xmlString XML string to be parsed.
+  /// \param[in] _config Parser configuration
   /// \param[in] _sdf Pointer to an SDF object.
+  /// \param[out] _errors Parsing errors will be appended to this variable.
   /// \return True if successful.
   SDFORMAT_VISIBLE
-  bool readString(const std::string &_xmlString, SDFPtr _sdf);
+  bool readString(std::string_view _xmlString, const ParserConfig &_config,
+      SDFPtr _sdf, Errors &_errors);
+
+  /// \brief Populate the SDF values from a string
+  ///
+  /// This populates the sdf pointer from a string. If the string is a URDF
+  /// string it is converted to SDF first. All string are converted to the
+  /// latest SDF version
+  /// \param[in] _xmlString XML string to be parsed.
+  /// \param[in] _sdf Pointer to an SDF object.
+  /// \return True if successful.
+  SDFORMAT_VISIBLE
+  bool readString(std::string_view _xmlString, SDFPtr _sdf);
 
   /// \brief Populate the SDF values from a string
   ///
@@ -148,9 +208,23 @@ namespace sdf
   /// \param[out] _errors Parsing errors will be appended to this variable.
   /// \return True if successful.
   SDFORMAT_VISIBLE
-  bool readString(const std::string &_xmlString, ElementPtr _sdf,
+  bool readString(std::string_view _xmlString, ElementPtr _sdf,
       Errors &_errors);
 
+  /// \brief Populate the SDF values from a string
+  ///
+  /// This populates the sdf pointer from a string. If the string is a URDF
+  /// string it is converted to SDF first. All strings are converted to the
+  /// latest SDF version
+  /// \param[in] _xmlString XML string to be parsed.
+  /// \param[in] _config Parser configuration
+  /// \param[in] _sdf Pointer to an SDF object.
+  /// \param[out] _errors Parsing errors will be appended to this variable.
+  /// \return True if successful.
+  SDFORMAT_VISIBLE
+  bool readString(std::string_view _xmlString, const ParserConfig &_config,
+      ElementPtr _sdf, Errors &_errors);
+
   /// \brief Populate the SDF values from a string without converting to the
   /// latest SDF version
   ///
@@ -164,7 +238,23 @@ namespace sdf
   /// \return True if successful.
   SDFORMAT_VISIBLE
   bool readStringWithoutConversion(
-      const std::string &_xmlString, SDFPtr _sdf, Errors &_errors);
+      std::string_view _xmlString, SDFPtr _sdf, Errors &_errors);
+
+  /// \brief Populate the SDF values from a string without converting to the
+  /// latest SDF version
+  ///
+  /// This populates the sdf pointer from a string. If the string is a URDF
+  /// file it is converted to SDF first. This function does not convert the
+  /// loaded SDF to the latest version. Use this function with care, as it may
+  /// prevent loading of DOM objects from this SDF object.
+  /// \param[in] _xmlString XML string to be parsed.
+  /// \param[in] _config Parser configuration
+  /// \param[in] _sdf Pointer to an SDF object.
+  /// \param[out] _errors Parsing errors will be appended to this variable.
+  /// \return True if successful.
+  SDFORMAT_VISIBLE
+  bool readStringWithoutConversion(std::string_view _xmlString,
+      const ParserConfig &_config, SDFPtr _sdf, Errors &_errors);
 
   /// \brief Populate the SDF values from a string
   ///
@@ -175,7 +265,7 @@ namespace sdf
   /// \param[in] _sdf Pointer to an sdf Element object.
   /// \return True if successful.
   SDFORMAT_VISIBLE
-  bool readString(const std::string &_xmlString, ElementPtr _sdf);
+  bool readString(std::string_view _xmlString, ElementPtr _sdf);
 
   /// \brief Get the file path to the model file
   /// \param[in] _modelDirPath directory system path of the model
@@ -256,6 +346,26 @@ namespace sdf
   SDFORMAT_VISIBLE
   bool checkPoseRelativeToGraph(const sdf::Root *_root);
 
+  /// \brief Run the checks of `ign sdf --check` on a Root that was loaded
+  /// without errors. The canonical link and joint parent/child checks are run
+  /// in a single pass over the worlds and models, followed by the sibling
+  /// unique name check. The attached_to and relative_to graphs are not
+  /// rebuilt, since Root::Load has already built and validated them.
+  /// \param[in] _root sdf Root object to check.
+  /// \return True if all checks pass.
+  SDFORMAT_VISIBLE
+  bool checkLoadedRoot(const sdf::Root *_root);
+
+  /// \brief Run the checks of `ign sdf --check` on a Root that was loaded
+  /// without errors, writing errors to the given stream instead of
+  /// std::cerr. This allows several files to be checked concurrently with
+  /// the errors of each file kept together.
+  /// \param[in] _root sdf Root object to check.
+  /// \param[out] _out Stream that errors are written to.
+  /// \return True if all checks pass.
+  SDFORMAT_VISIBLE
+  bool checkLoadedRoot(const sdf::Root *_root, std::ostream &_out);
+
   /// \brief Check that all sibling elements of the same type have unique names.
   /// This checks recursively and should check the files exhaustively
   /// rather than terminating early when the first duplicate name is found.
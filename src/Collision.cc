@@ -23,6 +23,7 @@
 #include "sdf/Surface.hh"
 #include "sdf/Types.hh"
 #include "FrameSemantics.hh"
+#include "NameIndex.hh"
 #include "ScopedGraph.hh"
 #include "Utils.hh"
 
@@ -142,7 +143,7 @@ Errors Collision::Load(ElementPtr _sdf)
 }
 
 /////////////////////////////////////////////////
-std::string Collision::Name() const
+const std::string &Collision::Name() const
 {
   return this->dataPtr->name;
 }
@@ -151,6 +152,8 @@ std::string Collision::Name() const
 void Collision::SetName(const std::string &_name) const
 {
   this->dataPtr->name = _name;
+  // The owner's index of names can't see this change.
+  NameIndex::NameChanged();
 }
 
 /////////////////////////////////////////////////
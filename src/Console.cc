@@ -151,9 +151,11 @@ void Console::ConsoleStream::Prefix(const std::string &_lbl,
 #endif
   }
 
-  if (Console::Instance()->dataPtr->logFileStream.is_open())
+  ConsolePtr console = Console::Instance();
+  if (console->dataPtr->logFileStream.is_open())
   {
-    Console::Instance()->dataPtr->logFileStream << _lbl << " [" <<
+    std::lock_guard<std::mutex> lock(console->dataPtr->logFileMutex);
+    console->dataPtr->logFileStream << _lbl << " [" <<
       _file.substr(index , _file.size() - index)<< ":" << _line << "] ";
   }
 }
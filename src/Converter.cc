@@ -17,9 +17,11 @@
 
 #include <algorithm>
 #include <map>
+#include <memory>
 #include <set>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
@@ -40,12 +42,166 @@ bool EndsWith(const std::string& _a, const std::string& _b)
   return (_a.size() >= _b.size()) &&
       (_a.compare(_a.size() - _b.size(), _b.size(), _b) == 0);
 }
+
+/// \brief A conversion recipe from one SDFormat version to the next.
+struct ConvertRecipe
+{
+  /// \brief Version produced by the recipe.
+  std::string toVersion;
+
+  /// \brief Parsed recipe, referred to by rule.
+  std::unique_ptr<tinyxml2::XMLDocument> doc;
+
+  /// \brief Compiled root <convert> element.
+  ConvertRule rule;
+
+  /// \brief Parse error of the recipe, empty on success.
+  std::string error;
+};
+
+/// \brief Resolve the lazily decoded strings of all nodes of a document,
+/// so that later reads don't modify it and can run concurrently.
+/// \param[in] _node Root of the tree to resolve.
+void ResolveStrings(const tinyxml2::XMLNode *_node)
+{
+  _node->Value();
+  if (const auto *elem = _node->ToElement())
+  {
+    for (const auto *attr = elem->FirstAttribute(); attr; attr = attr->Next())
+    {
+      attr->Name();
+      attr->Value();
+    }
+  }
+  for (const auto *child = _node->FirstChild(); child;
+       child = child->NextSibling())
+  {
+    ResolveStrings(child);
+  }
+}
+
+/// \brief Get the kind of an operation of a <convert> element.
+/// \param[in] _name Name of the operation element.
+/// \return The operation kind.
+ConvertRule::OperationType OperationTypeFromName(const std::string &_name)
+{
+  if (_name == "rename")
+    return ConvertRule::OperationType::RENAME;
+  if (_name == "copy")
+    return ConvertRule::OperationType::COPY;
+  if (_name == "map")
+    return ConvertRule::OperationType::MAP;
+  if (_name == "move")
+    return ConvertRule::OperationType::MOVE;
+  if (_name == "add")
+    return ConvertRule::OperationType::ADD;
+  if (_name == "remove")
+    return ConvertRule::OperationType::REMOVE;
+  return ConvertRule::OperationType::UNKNOWN;
+}
+
+/// \brief The conversion recipes of the embedded files database, indexed by
+/// the version they upgrade from. The recipes are named, e.g.,
+/// "1.8/1_7.convert" to upgrade from 1.7 to 1.8. They are parsed and
+/// compiled once, on first use, and are read-only afterwards.
+/// \return The recipes.
+const std::map<std::string, ConvertRecipe> &EmbeddedRecipes()
+{
+  static const std::map<std::string, ConvertRecipe> recipes = []()
+  {
+    const std::string extension = ".convert";
+    std::map<std::string, ConvertRecipe> result;
+    for (const auto &[pathname, data] : GetEmbeddedSdf())
+    {
+      const std::size_t slash = pathname.rfind('/');
+      if (!EndsWith(pathname, extension) || slash == std::string::npos)
+      {
+        continue;
+      }
+
+      std::string fromVersion = pathname.substr(
+          slash + 1, pathname.size() - extension.size() - slash - 1);
+      std::replace(fromVersion.begin(), fromVersion.end(), '_', '.');
+
+      // Keep the first recipe found for a version.
+      if (result.find(fromVersion) != result.end())
+      {
+        continue;
+      }
+
+      ConvertRecipe &recipe = result[fromVersion];
+      recipe.toVersion = pathname.substr(0, slash);
+      recipe.doc = std::make_unique<tinyxml2::XMLDocument>();
+      recipe.doc->Parse(data.c_str());
+      if (recipe.doc->Error())
+      {
+        recipe.error = recipe.doc->ErrorStr();
+        continue;
+      }
+
+      ResolveStrings(recipe.doc.get());
+      tinyxml2::XMLElement *convert = recipe.doc->FirstChildElement("convert");
+      if (convert)
+      {
+        recipe.rule = ConvertRule::Compile(convert);
+      }
+    }
+    return result;
+  }();
+  return recipes;
+}
+}
+
+/////////////////////////////////////////////////
+ConvertRule ConvertRule::Compile(tinyxml2::XMLElement *_convert)
+{
+  ConvertRule rule;
+  rule.convert = _convert;
+  rule.name = _convert->Attribute("name");
+  rule.descendantName = _convert->Attribute("descendant_name");
+
+  for (tinyxml2::XMLElement *childElem = _convert->FirstChildElement();
+       childElem; childElem = childElem->NextSiblingElement())
+  {
+    const std::string name = childElem->Name();
+    if (name == "convert")
+    {
+      rule.rules.push_back(Compile(childElem));
+      const ConvertRule &nested = rule.rules.back();
+      if (nested.name)
+      {
+        rule.rulesByName[nested.name].push_back(rule.rules.size() - 1);
+      }
+      if (nested.descendantName)
+      {
+        rule.hasDescendantRules = true;
+        rule.descendantRulesByName[nested.descendantName].push_back(
+            rule.rules.size() - 1);
+      }
+    }
+    else
+    {
+      rule.hasDeprecated = rule.hasDeprecated || name == "deprecated";
+      rule.operations.emplace_back(OperationTypeFromName(name), childElem);
+    }
+  }
+
+  return rule;
 }
 
 /////////////////////////////////////////////////
 bool Converter::Convert(tinyxml2::XMLDocument *_doc,
                         const std::string &_toVersion,
                         bool _quiet)
+{
+  return Convert(_doc, _toVersion, ParserConfig::GlobalConfig(), _quiet);
+}
+
+/////////////////////////////////////////////////
+bool Converter::Convert(tinyxml2::XMLDocument *_doc,
+                        const std::string &_toVersion,
+                        const ParserConfig &_config,
+                        bool _quiet)
 {
   SDF_ASSERT(_doc != nullptr, "SDF XML doc is NULL");
 
@@ -81,43 +237,32 @@ bool Converter::Convert(tinyxml2::XMLDocument *_doc,
 
   elem->SetAttribute("version", _toVersion.c_str());
 
-  // The conversion recipes within the embedded files database are named, e.g.,
-  // "1.8/1_7.convert" to upgrade from 1.7 to 1.8.
-  const std::map<std::string, std::string> &embedded = GetEmbeddedSdf();
+  const std::map<std::string, ConvertRecipe> &recipes = EmbeddedRecipes();
 
   // Apply the conversions one at a time until we reach the desired _toVersion.
+  // Each recipe walks the result of the previous one, since later recipes
+  // match elements that earlier ones add, e.g. use_parent_model_frame.
   std::string curVersion = origVersion;
   while (curVersion != _toVersion)
   {
-    // Find the (at most one) file named, e.g., ".../1_7.convert".
-    std::string snakeVersion = curVersion;
-    std::replace(snakeVersion.begin(), snakeVersion.end(), '.', '_');
-    const std::string suffix = "/" + snakeVersion + ".convert";
-    const char* convertXml = nullptr;
-    for (const auto& [pathname, data] : embedded)
-    {
-      if (EndsWith(pathname, suffix))
-      {
-        curVersion = pathname.substr(0, pathname.size() - suffix.size());
-        convertXml = data.c_str();
-        break;
-      }
-    }
-    if (convertXml == nullptr)
+    auto recipe = recipes.find(curVersion);
+    if (recipe == recipes.end())
     {
       break;
     }
+    curVersion = recipe->second.toVersion;
 
-    // Parse and apply the conversion XML.
-    tinyxml2::XMLDocument xmlDoc;
-    xmlDoc.Parse(convertXml);
-    if (xmlDoc.Error())
+    if (!recipe->second.error.empty())
     {
       sdferr << "Error parsing XML from string: "
-             << xmlDoc.ErrorStr() << '\n';
+             << recipe->second.error << '\n';
       return false;
     }
-    ConvertImpl(elem, xmlDoc.FirstChildElement("convert"));
+    if (recipe->second.rule.convert)
+    {
+      ConvertImpl(elem, recipe->second.rule,
+                  _config.SinglePassConversionEnabled());
+    }
   }
 
   // Check that we actually converted to the desired final version.
@@ -133,19 +278,24 @@ bool Converter::Convert(tinyxml2::XMLDocument *_doc,
 
 /////////////////////////////////////////////////
 void Converter::Convert(tinyxml2::XMLDocument *_doc,
-                        tinyxml2::XMLDocument *_convertDoc)
+                        tinyxml2::XMLDocument *_convertDoc,
+                        bool _singlePass)
 {
   SDF_ASSERT(_doc != NULL, "SDF XML doc is NULL");
   SDF_ASSERT(_convertDoc != NULL, "Convert XML doc is NULL");
+  SDF_ASSERT(_convertDoc->FirstChildElement() != NULL,
+             "Convert element is NULL");
 
-  ConvertImpl(_doc->FirstChildElement(), _convertDoc->FirstChildElement());
+  ConvertImpl(_doc->FirstChildElement(),
+              ConvertRule::Compile(_convertDoc->FirstChildElement()),
+              _singlePass);
 }
 
 /////////////////////////////////////////////////
 void Converter::ConvertDescendantsImpl(tinyxml2::XMLElement *_e,
-                                       tinyxml2::XMLElement *_c)
+                                       const ConvertRule &_rule)
 {
-  if (!_c->Attribute("descendant_name"))
+  if (!_rule.descendantName)
   {
     return;
   }
@@ -163,75 +313,130 @@ void Converter::ConvertDescendantsImpl(tinyxml2::XMLElement *_e,
   tinyxml2::XMLElement *e = _e->FirstChildElement();
   while (e)
   {
-    if (strcmp(e->Name(), _c->Attribute("descendant_name")) == 0)
+    if (strcmp(e->Name(), _rule.descendantName) == 0)
     {
-      ConvertImpl(e, _c);
+      ConvertImpl(e, _rule, false);
     }
-    ConvertDescendantsImpl(e, _c);
+    ConvertDescendantsImpl(e, _rule);
     e = e->NextSiblingElement();
   }
 }
 
 /////////////////////////////////////////////////
-void Converter::ConvertImpl(tinyxml2::XMLElement *_elem,
-                            tinyxml2::XMLElement *_convert)
+void Converter::ConvertDescendantsSinglePass(tinyxml2::XMLElement *_e,
+                                             const ConvertRule &_rule)
 {
-  SDF_ASSERT(_elem != NULL, "SDF element is NULL");
-  SDF_ASSERT(_convert != NULL, "Convert element is NULL");
+  if (strcmp(_e->Name(), "plugin") == 0)
+  {
+    return;
+  }
 
-  CheckDeprecation(_elem, _convert);
+  if (strchr(_e->Name(), ':') != nullptr)
+  {
+    return;
+  }
 
-  for (auto *convertElem = _convert->FirstChildElement("convert");
-       convertElem; convertElem = convertElem->NextSiblingElement("convert"))
+  for (tinyxml2::XMLElement *e = _e->FirstChildElement(); e;
+       e = e->NextSiblingElement())
   {
-    if (convertElem->Attribute("name"))
+    auto rules = _rule.descendantRulesByName.find(std::string_view(e->Name()));
+    if (rules != _rule.descendantRulesByName.end())
     {
-      tinyxml2::XMLElement *elem = _elem->FirstChildElement(
-          convertElem->Attribute("name"));
-      while (elem)
+      for (std::size_t index : rules->second)
       {
-        ConvertImpl(elem, convertElem);
-        elem = elem->NextSiblingElement(convertElem->Attribute("name"));
+        ConvertImpl(e, _rule.rules[index], true);
       }
     }
-    if (convertElem->Attribute("descendant_name"))
-    {
-      ConvertDescendantsImpl(_elem, convertElem);
-    }
+    ConvertDescendantsSinglePass(e, _rule);
   }
+}
 
-  for (tinyxml2::XMLElement *childElem = _convert->FirstChildElement();
-       childElem; childElem = childElem->NextSiblingElement())
+/////////////////////////////////////////////////
+void Converter::ConvertImpl(tinyxml2::XMLElement *_elem,
+                            const ConvertRule &_rule,
+                            bool _singlePass)
+{
+  SDF_ASSERT(_elem != NULL, "SDF element is NULL");
+  SDF_ASSERT(_rule.convert != NULL, "Convert element is NULL");
+
+  if (_rule.hasDeprecated)
   {
-    const auto name = std::string(childElem->Name());
+    CheckDeprecation(_elem, _rule.convert);
+  }
 
-    if (name == "rename")
-    {
-      Rename(_elem, childElem);
-    }
-    else if (name == "copy")
-    {
-      Move(_elem, childElem, true);
-    }
-    else if (name == "map")
-    {
-      Map(_elem, childElem);
-    }
-    else if (name == "move")
-    {
-      Move(_elem, childElem, false);
-    }
-    else if (name == "add")
+  if (_rule.hasDescendantRules && !_singlePass)
+  {
+    // A descendant rule can match elements changed by an earlier rule, so
+    // the rules are applied one after the other.
+    for (const ConvertRule &rule : _rule.rules)
     {
-      Add(_elem, childElem);
+      if (rule.name)
+      {
+        tinyxml2::XMLElement *elem = _elem->FirstChildElement(rule.name);
+        while (elem)
+        {
+          ConvertImpl(elem, rule, _singlePass);
+          elem = elem->NextSiblingElement(rule.name);
+        }
+      }
+      if (rule.descendantName)
+      {
+        ConvertDescendantsImpl(_elem, rule);
+      }
     }
-    else if (name == "remove")
+  }
+  else if (!_rule.rulesByName.empty())
+  {
+    // A named rule only changes the subtree of the child it matches, so the
+    // children are visited once and dispatched to the rules by name.
+    for (tinyxml2::XMLElement *elem = _elem->FirstChildElement(); elem;
+         elem = elem->NextSiblingElement())
     {
-      Remove(_elem, childElem);
+      auto rules = _rule.rulesByName.find(std::string_view(elem->Name()));
+      if (rules != _rule.rulesByName.end())
+      {
+        for (std::size_t index : rules->second)
+        {
+          ConvertImpl(elem, _rule.rules[index], _singlePass);
+        }
+      }
     }
-    else if (name != "convert")
+  }
+
+  // In single pass mode, the named rules are followed by one walk that
+  // applies all the descendant rules.
+  if (_rule.hasDescendantRules && _singlePass)
+  {
+    ConvertDescendantsSinglePass(_elem, _rule);
+  }
+
+  for (const auto &[type, operationElem] : _rule.operations)
+  {
+    switch (type)
     {
-      sdferr << "Unknown convert element[" << name << "]\n";
+      case ConvertRule::OperationType::RENAME:
+        Rename(_elem, operationElem);
+        break;
+      case ConvertRule::OperationType::COPY:
+        Move(_elem, operationElem, true);
+        break;
+      case ConvertRule::OperationType::MAP:
+        Map(_elem, operationElem);
+        break;
+      case ConvertRule::OperationType::MOVE:
+        Move(_elem, operationElem, false);
+        break;
+      case ConvertRule::OperationType::ADD:
+        Add(_elem, operationElem);
+        break;
+      case ConvertRule::OperationType::REMOVE:
+        Remove(_elem, operationElem);
+        break;
+      case ConvertRule::OperationType::UNKNOWN:
+      default:
+        sdferr << "Unknown convert element[" << operationElem->Name()
+               << "]\n";
+        break;
     }
   }
 }
@@ -19,9 +19,14 @@
 
 #include <tinyxml2.h>
 
+#include <functional>
+#include <map>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include <sdf/sdf_config.h>
+#include "sdf/ParserConfig.hh"
 #include "sdf/system_util.hh"
 
 namespace sdf
@@ -30,6 +35,60 @@ namespace sdf
   inline namespace SDF_VERSION_NAMESPACE {
   //
 
+  /// \brief A <convert> element of a conversion recipe, compiled so that it
+  /// can be applied repeatedly without inspecting the recipe XML again.
+  /// The rule refers to elements of the recipe document, which must outlive
+  /// it.
+  struct ConvertRule
+  {
+    /// \brief Kind of an operation of a rule.
+    enum class OperationType
+    {
+      RENAME,
+      COPY,
+      MAP,
+      MOVE,
+      ADD,
+      REMOVE,
+      UNKNOWN
+    };
+
+    /// \brief The <convert> element the rule was compiled from.
+    tinyxml2::XMLElement *convert = nullptr;
+
+    /// \brief Value of the name attribute, or nullptr.
+    const char *name = nullptr;
+
+    /// \brief Value of the descendant_name attribute, or nullptr.
+    const char *descendantName = nullptr;
+
+    /// \brief Nested rules, in document order.
+    std::vector<ConvertRule> rules;
+
+    /// \brief Indices in rules of the nested rules with a name attribute,
+    /// indexed by that name.
+    std::map<std::string, std::vector<std::size_t>, std::less<>> rulesByName;
+
+    /// \brief True if a nested rule has a descendant_name attribute.
+    bool hasDescendantRules = false;
+
+    /// \brief Indices in rules of the nested rules with a descendant_name
+    /// attribute, indexed by that name.
+    std::map<std::string, std::vector<std::size_t>, std::less<>>
+        descendantRulesByName;
+
+    /// \brief True if the <convert> element has <deprecated> children.
+    bool hasDeprecated = false;
+
+    /// \brief Operations applied to the matched element, in document order.
+    std::vector<std::pair<OperationType, tinyxml2::XMLElement *>> operations;
+
+    /// \brief Compile a <convert> element and its nested rules.
+    /// \param[in] _convert The <convert> element.
+    /// \return The compiled rule.
+    static ConvertRule Compile(tinyxml2::XMLElement *_convert);
+  };
+
   /// \brief Convert from one version of SDF to another
   class Converter
   {
@@ -41,28 +100,54 @@ namespace sdf
                                 const std::string &_toVersion,
                                 bool _quiet = false);
 
+    /// \brief Convert SDF to the specified version.
+    /// \param[in] _doc SDF xml doc
+    /// \param[in] _toVersion Version number in string format
+    /// \param[in] _config Parser configuration, which selects the
+    /// conversion mode.
+    /// \param[in] _quiet False to be more verbose
+    public: static bool Convert(tinyxml2::XMLDocument *_doc,
+                                const std::string &_toVersion,
+                                const ParserConfig &_config,
+                                bool _quiet = false);
+
     /// \cond
     /// This is an internal function.
     /// \brief Generic convert function that converts the SDF based on the
     /// given Convert file.
     /// \param[in] _doc SDF xml doc
     /// \param[in] _convertDoc Convert xml doc
+    /// \param[in] _singlePass True to apply the descendant rules in a single
+    /// pass, see ParserConfig::SetSinglePassConversionEnabled.
     public: static void Convert(tinyxml2::XMLDocument *_doc,
-                                tinyxml2::XMLDocument *_convertDoc);
+                                tinyxml2::XMLDocument *_convertDoc,
+                                bool _singlePass = false);
     /// \endcond
 
     /// \brief Implementation of Convert functionality.
     /// \param[in] _elem SDF xml element tree to convert.
-    /// \param[in] _convert Convert xml element tree.
+    /// \param[in] _rule Compiled convert rule.
+    /// \param[in] _singlePass True to apply the descendant rules in a single
+    /// pass.
     private: static void ConvertImpl(tinyxml2::XMLElement *_elem,
-                                     tinyxml2::XMLElement *_convert);
+                                     const ConvertRule &_rule,
+                                     bool _singlePass);
 
     /// \brief Recursive helper function for ConvertImpl that converts
     /// elements named by the descendant_name attribute.
     /// \param[in] _e SDF xml element tree to convert.
-    /// \param[in] _c Convert xml element tree.
+    /// \param[in] _rule Compiled convert rule with a descendant_name.
     private: static void ConvertDescendantsImpl(tinyxml2::XMLElement *_e,
-                                                tinyxml2::XMLElement *_c);
+                                                const ConvertRule &_rule);
+
+    /// \brief Apply all the descendant rules nested in a rule with a single
+    /// walk of the descendants of an element. Each element is visited once
+    /// and its name selects the rules applied to it, in recipe order.
+    /// \param[in] _e SDF xml element tree to convert.
+    /// \param[in] _rule Compiled convert rule whose nested descendant rules
+    /// are applied.
+    private: static void ConvertDescendantsSinglePass(
+                 tinyxml2::XMLElement *_e, const ConvertRule &_rule);
 
     /// \brief Rename an element or attribute.
     /// \param[in] _elem The element to be renamed, or the element which
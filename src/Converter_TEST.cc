@@ -18,6 +18,9 @@
 #include <gtest/gtest.h>
 #include <array>
 #include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
 #include "sdf/Exception.hh"
 #include "sdf/Filesystem.hh"
 
@@ -2141,6 +2144,186 @@ TEST(Converter, Pose_16_to_17)
   EXPECT_STREQ("parent", jointLinkPoseElem->Attribute("relative_to"));
 }
 
+////////////////////////////////////////////////////
+/// Rules with the same name apply in order to each matching child, and rules
+/// with different names only touch the children they match.
+TEST(Converter, NamedRulesDispatch)
+{
+  tinyxml2::XMLDocument xmlDoc;
+  xmlDoc.Parse("<elemA>"
+               "  <elemB/><elemC/><elemB/>"
+               "</elemA>");
+
+  tinyxml2::XMLDocument convertXmlDoc;
+  convertXmlDoc.Parse("<convert name='elemA'>"
+                      "  <convert name='elemB'>"
+                      "    <add element='elemX' value='x'/>"
+                      "  </convert>"
+                      "  <convert name='elemC'>"
+                      "    <add attribute='attrC' value='c'/>"
+                      "  </convert>"
+                      "  <convert name='elemB'>"
+                      "    <rename>"
+                      "      <from element='elemX'/>"
+                      "      <to element='elemY'/>"
+                      "    </rename>"
+                      "  </convert>"
+                      "</convert>");
+  sdf::Converter::Convert(&xmlDoc, &convertXmlDoc);
+
+  tinyxml2::XMLElement *elemA = xmlDoc.FirstChildElement("elemA");
+  ASSERT_NE(nullptr, elemA);
+  int count = 0;
+  for (tinyxml2::XMLElement *elemB = elemA->FirstChildElement("elemB"); elemB;
+       elemB = elemB->NextSiblingElement("elemB"), ++count)
+  {
+    EXPECT_EQ(nullptr, elemB->FirstChildElement("elemX"));
+    ASSERT_NE(nullptr, elemB->FirstChildElement("elemY"));
+    EXPECT_STREQ("x", elemB->FirstChildElement("elemY")->GetText());
+    EXPECT_EQ(nullptr, elemB->Attribute("attrC"));
+  }
+  EXPECT_EQ(2, count);
+
+  tinyxml2::XMLElement *elemC = elemA->FirstChildElement("elemC");
+  ASSERT_NE(nullptr, elemC);
+  EXPECT_STREQ("c", elemC->Attribute("attrC"));
+  EXPECT_EQ(nullptr, elemC->FirstChildElement());
+}
+
+////////////////////////////////////////////////////
+/// The embedded recipes are shared by conversions running concurrently.
+TEST(Converter, ConcurrentConversions)
+{
+  const std::string xmlString =
+      "<sdf version='1.4'>"
+      "  <model name='m'>"
+      "    <link name='l'><pose frame='f'>0 0 0 0 0 0</pose></link>"
+      "    <joint name='j' type='revolute'>"
+      "      <parent>l</parent><child>l</child>"
+      "      <axis><xyz>0 0 1</xyz></axis>"
+      "    </joint>"
+      "  </model>"
+      "</sdf>";
+
+  auto convert = [&xmlString]()
+  {
+    tinyxml2::XMLDocument xmlDoc;
+    xmlDoc.Parse(xmlString.c_str());
+    EXPECT_TRUE(sdf::Converter::Convert(&xmlDoc, "1.8", true));
+    tinyxml2::XMLPrinter printer;
+    xmlDoc.Print(&printer);
+    return std::string(printer.CStr());
+  };
+
+  const std::string expected = convert();
+  EXPECT_NE(std::string::npos, expected.find("relative_to=\"f\""));
+  EXPECT_NE(std::string::npos, expected.find("expressed_in=\"__model__\""));
+
+  std::vector<std::thread> threads;
+  std::vector<std::string> results(4);
+  for (auto &result : results)
+  {
+    threads.emplace_back([&result, &convert]()
+    {
+      for (int i = 0; i < 10; ++i)
+        result = convert();
+    });
+  }
+  for (auto &thread : threads)
+    thread.join();
+
+  for (const auto &result : results)
+    EXPECT_EQ(expected, result);
+}
+
+////////////////////////////////////////////////////
+/// The single pass mode applies all descendant rules with one walk, in
+/// recipe order for each element, and skips plugins like the default mode.
+TEST(Converter, DescendantRulesSinglePass)
+{
+  const std::string xmlString =
+      "<elemA>"
+      "<elemB><elemC/><plugin><elemC/></plugin></elemB>"
+      "<elemC><elemB/></elemC>"
+      "</elemA>";
+
+  tinyxml2::XMLDocument convertXmlDoc;
+  convertXmlDoc.Parse("<convert name='elemA'>"
+                      "  <convert descendant_name='elemC'>"
+                      "    <add element='elemX' value='x'/>"
+                      "  </convert>"
+                      "  <convert descendant_name='elemB'>"
+                      "    <add attribute='attrB' value='b'/>"
+                      "  </convert>"
+                      "  <convert descendant_name='elemC'>"
+                      "    <rename>"
+                      "      <from element='elemX'/>"
+                      "      <to element='elemY'/>"
+                      "    </rename>"
+                      "  </convert>"
+                      "</convert>");
+
+  std::string results[2];
+  for (bool singlePass : {false, true})
+  {
+    tinyxml2::XMLDocument xmlDoc;
+    xmlDoc.Parse(xmlString.c_str());
+    sdf::Converter::Convert(&xmlDoc, &convertXmlDoc, singlePass);
+    tinyxml2::XMLPrinter printer(nullptr, true);
+    xmlDoc.Print(&printer);
+    results[singlePass] = printer.CStr();
+  }
+
+  EXPECT_EQ(results[0], results[1]);
+  EXPECT_EQ("<elemA>"
+            "<elemB attrB=\"b\"><elemC><elemY>x</elemY></elemC>"
+            "<plugin><elemC/></plugin></elemB>"
+            "<elemC><elemB attrB=\"b\"/><elemY>x</elemY></elemC>"
+            "</elemA>", results[1]);
+}
+
+////////////////////////////////////////////////////
+/// Both conversion modes give the same result for the embedded recipes.
+TEST(Converter, SinglePass_16_to_18)
+{
+  const std::string xmlString =
+      "<sdf version='1.6'>"
+      "  <world name='w'>"
+      "    <model name='m'>"
+      "      <pose frame='f'>1 0 0 0 0 0</pose>"
+      "      <link name='l'><pose frame='m'>0 0 0 0 0 0</pose></link>"
+      "      <joint name='j' type='revolute'>"
+      "        <pose frame='l'>0 0 0 0 0 0</pose>"
+      "        <parent>world</parent><child>l</child>"
+      "        <axis><xyz>0 0 1</xyz>"
+      "          <use_parent_model_frame>true</use_parent_model_frame>"
+      "        </axis>"
+      "      </joint>"
+      "      <plugin name='p' filename='p'><pose frame='x'/></plugin>"
+      "    </model>"
+      "  </world>"
+      "</sdf>";
+
+  std::string results[2];
+  for (bool singlePass : {false, true})
+  {
+    sdf::ParserConfig config;
+    config.SetSinglePassConversionEnabled(singlePass);
+    tinyxml2::XMLDocument xmlDoc;
+    xmlDoc.Parse(xmlString.c_str());
+    EXPECT_TRUE(sdf::Converter::Convert(&xmlDoc, "1.8", config, true));
+    tinyxml2::XMLPrinter printer;
+    xmlDoc.Print(&printer);
+    results[singlePass] = printer.CStr();
+  }
+
+  EXPECT_EQ(results[0], results[1]);
+  EXPECT_EQ(std::string::npos, results[1].find("frame=\"f\""));
+  EXPECT_NE(std::string::npos, results[1].find("relative_to=\"f\""));
+  EXPECT_NE(std::string::npos, results[1].find("frame=\"x\""));
+  EXPECT_NE(std::string::npos, results[1].find("expressed_in=\"__model__\""));
+}
+
 /////////////////////////////////////////////////
 /// Main
 int main(int argc, char **argv)
@@ -23,8 +23,118 @@
 #include "sdf/Element.hh"
 #include "sdf/Filesystem.hh"
 
+#include "Utils.hh"
+
 using namespace sdf;
 
+/////////////////////////////////////////////////
+void ElementPrivate::PushAttribute(ParamPtr _param)
+{
+  this->attributesIndex.emplace(_param->GetKey(), this->attributes.size());
+  this->attributes.push_back(std::move(_param));
+}
+
+/////////////////////////////////////////////////
+void ElementPrivate::PushElement(ElementPtr _elem)
+{
+  this->elementsIndex.emplace(_elem->GetName(), _elem);
+  this->elements.push_back(std::move(_elem));
+}
+
+/////////////////////////////////////////////////
+void ElementPrivate::EraseElement(ElementPtr_V::iterator _iter)
+{
+  const ElementPtr elem = *_iter;
+  auto next = this->elements.erase(_iter);
+
+  // Only the entry of the removed element's name can refer to it. It moves
+  // to the next element with that name, if any.
+  auto indexIter = this->elementsIndex.find(elem->GetName());
+  if (indexIter != this->elementsIndex.end() && indexIter->second == elem)
+  {
+    next = std::find_if(next, this->elements.end(),
+        [&](const ElementPtr &_e) {return _e->GetName() == elem->GetName();});
+    if (next != this->elements.end())
+    {
+      indexIter->second = *next;
+    }
+    else
+    {
+      this->elementsIndex.erase(indexIter);
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+void ElementPrivate::RenameElement(const Element *_elem,
+                                   const std::string &_oldName)
+{
+  auto pos = std::find_if(this->elements.begin(), this->elements.end(),
+      [&](const ElementPtr &_e) {return _e.get() == _elem;});
+  if (pos == this->elements.end())
+  {
+    return;
+  }
+
+  // The entry of the old name moves to the next element with that name.
+  auto oldIter = this->elementsIndex.find(_oldName);
+  if (oldIter != this->elementsIndex.end() && oldIter->second == *pos)
+  {
+    auto next = std::find_if(pos + 1, this->elements.end(),
+        [&](const ElementPtr &_e) {return _e->GetName() == _oldName;});
+    if (next != this->elements.end())
+    {
+      oldIter->second = *next;
+    }
+    else
+    {
+      this->elementsIndex.erase(oldIter);
+    }
+  }
+
+  // The entry of the new name refers to the element unless another element
+  // with that name comes before it.
+  auto newIter = this->elementsIndex.find(_elem->GetName());
+  if (newIter == this->elementsIndex.end())
+  {
+    this->elementsIndex.emplace(_elem->GetName(), *pos);
+  }
+  else if (std::find(pos + 1, this->elements.end(), newIter->second) !=
+           this->elements.end())
+  {
+    newIter->second = *pos;
+  }
+}
+
+/////////////////////////////////////////////////
+void ElementPrivate::ClearElements()
+{
+  this->elements.clear();
+  this->elementsIndex.clear();
+}
+
+/////////////////////////////////////////////////
+void ElementPrivate::PushElementDescription(ElementPtr _elem)
+{
+  this->elementDescriptionsIndex.emplace(
+      _elem->GetName(), this->elementDescriptions.size());
+  this->elementDescriptions.push_back(std::move(_elem));
+}
+
+/////////////////////////////////////////////////
+void ElementPrivate::CopyElementDescriptions(const ElementPrivate &_other)
+{
+  this->elementDescriptions = _other.elementDescriptions;
+  this->elementDescriptionsIndex = _other.elementDescriptionsIndex;
+}
+
+/////////////////////////////////////////////////
+void ElementPrivate::ClearElementDescriptions()
+{
+  this->elementDescriptions.clear();
+  this->elementDescriptionsIndex.clear();
+}
+
 /////////////////////////////////////////////////
 Element::Element()
   : dataPtr(new ElementPrivate)
@@ -66,7 +176,20 @@ void Element::SetParent(const ElementPtr _parent)
 /////////////////////////////////////////////////
 void Element::SetName(const std::string &_name)
 {
+  if (this->dataPtr->name == _name)
+  {
+    return;
+  }
+
+  const std::string oldName = std::move(this->dataPtr->name);
   this->dataPtr->name = _name;
+
+  // The parent indexes its children by name.
+  auto parent = this->dataPtr->parent.lock();
+  if (parent)
+  {
+    parent->dataPtr->RenameElement(this, oldName);
+  }
 }
 
 /////////////////////////////////////////////////
@@ -152,7 +275,7 @@ void Element::AddAttribute(const std::string &_key,
                            bool _required,
                            const std::string &_description)
 {
-  this->dataPtr->attributes.push_back(
+  this->dataPtr->PushAttribute(
       this->CreateParam(_key, _type, _defaultValue, _required, _description));
 }
 
@@ -173,21 +296,20 @@ ElementPtr Element::Clone() const
   for (aiter = this->dataPtr->attributes.begin();
        aiter != this->dataPtr->attributes.end(); ++aiter)
   {
-    clone->dataPtr->attributes.push_back((*aiter)->Clone());
+    clone->dataPtr->PushAttribute((*aiter)->Clone());
   }
 
-  ElementPtr_V::const_iterator eiter;
-  for (eiter = this->dataPtr->elementDescriptions.begin();
-      eiter != this->dataPtr->elementDescriptions.end(); ++eiter)
-  {
-    clone->dataPtr->elementDescriptions.push_back((*eiter)->Clone());
-  }
+  // Element descriptions are immutable once the schema has been built, so
+  // the clone shares them instead of deep-copying the description subtree.
+  clone->dataPtr->CopyElementDescriptions(*this->dataPtr);
 
+  ElementPtr_V::const_iterator eiter;
   for (eiter = this->dataPtr->elements.begin();
        eiter != this->dataPtr->elements.end(); ++eiter)
   {
-    clone->dataPtr->elements.push_back((*eiter)->Clone());
-    clone->dataPtr->elements.back()->SetParent(clone);
+    ElementPtr elem = (*eiter)->Clone();
+    elem->SetParent(clone);
+    clone->dataPtr->PushElement(elem);
   }
 
   if (this->dataPtr->value)
@@ -201,7 +323,7 @@ ElementPtr Element::Clone() const
 /////////////////////////////////////////////////
 void Element::Copy(const ElementPtr _elem)
 {
-  this->dataPtr->name = _elem->GetName();
+  this->SetName(_elem->GetName());
   this->dataPtr->description = _elem->GetDescription();
   this->dataPtr->required = _elem->GetRequired();
   this->dataPtr->copyChildren = _elem->GetCopyChildren();
@@ -215,7 +337,7 @@ void Element::Copy(const ElementPtr _elem)
   {
     if (!this->HasAttribute((*iter)->GetKey()))
     {
-      this->dataPtr->attributes.push_back((*iter)->Clone());
+      this->dataPtr->PushAttribute((*iter)->Clone());
     }
     ParamPtr param = this->GetAttribute((*iter)->GetKey());
     (*param) = (**iter);
@@ -233,22 +355,16 @@ void Element::Copy(const ElementPtr _elem)
     }
   }
 
-  this->dataPtr->elementDescriptions.clear();
-  for (ElementPtr_V::const_iterator iter =
-       _elem->dataPtr->elementDescriptions.begin();
-       iter != _elem->dataPtr->elementDescriptions.end(); ++iter)
-  {
-    this->dataPtr->elementDescriptions.push_back((*iter)->Clone());
-  }
+  this->dataPtr->CopyElementDescriptions(*_elem->dataPtr);
 
-  this->dataPtr->elements.clear();
+  this->dataPtr->ClearElements();
   for (ElementPtr_V::iterator iter = _elem->dataPtr->elements.begin();
        iter != _elem->dataPtr->elements.end(); ++iter)
   {
     ElementPtr elem = (*iter)->Clone();
     elem->Copy(*iter);
     elem->SetParent(shared_from_this());
-    this->dataPtr->elements.push_back(elem);
+    this->dataPtr->PushElement(elem);
   }
 }
 
@@ -540,14 +656,10 @@ bool Element::GetAttributeSet(const std::string &_key) const
 /////////////////////////////////////////////////
 ParamPtr Element::GetAttribute(const std::string &_key) const
 {
-  Param_V::const_iterator iter;
-  for (iter = this->dataPtr->attributes.begin();
-      iter != this->dataPtr->attributes.end(); ++iter)
+  auto iter = this->dataPtr->attributesIndex.find(_key);
+  if (iter != this->dataPtr->attributesIndex.end())
   {
-    if ((*iter)->GetKey() == _key)
-    {
-      return (*iter);
-    }
+    return this->dataPtr->attributes[iter->second];
   }
   return ParamPtr();
 }
@@ -590,14 +702,10 @@ ElementPtr Element::GetElementDescription(unsigned int _index) const
 /////////////////////////////////////////////////
 ElementPtr Element::GetElementDescription(const std::string &_key) const
 {
-  ElementPtr_V::const_iterator iter;
-  for (iter = this->dataPtr->elementDescriptions.begin();
-       iter != this->dataPtr->elementDescriptions.end(); ++iter)
+  auto iter = this->dataPtr->elementDescriptionsIndex.find(_key);
+  if (iter != this->dataPtr->elementDescriptionsIndex.end())
   {
-    if ((*iter)->GetName() == _key)
-    {
-      return (*iter);
-    }
+    return this->dataPtr->elementDescriptions[iter->second];
   }
 
   return ElementPtr();
@@ -618,14 +726,10 @@ bool Element::HasElement(const std::string &_name) const
 /////////////////////////////////////////////////
 ElementPtr Element::GetElementImpl(const std::string &_name) const
 {
-  ElementPtr_V::const_iterator iter;
-  for (iter = this->dataPtr->elements.begin();
-       iter != this->dataPtr->elements.end(); ++iter)
+  auto iter = this->dataPtr->elementsIndex.find(_name);
+  if (iter != this->dataPtr->elementsIndex.end())
   {
-    if ((*iter)->GetName() == _name)
-    {
-      return (*iter);
-    }
+    return iter->second;
   }
 
   return ElementPtr();
@@ -650,13 +754,37 @@ ElementPtr Element::GetNextElement(const std::string &_name) const
   auto parent = this->dataPtr->parent.lock();
   if (parent)
   {
+    const ElementPtr_V &siblings = parent->dataPtr->elements;
     ElementPtr_V::const_iterator iter;
-    iter = std::find(parent->dataPtr->elements.begin(),
-        parent->dataPtr->elements.end(), shared_from_this());
 
-    if (iter == parent->dataPtr->elements.end())
+    // Use the cached position in the parent if it is still valid, which
+    // keeps sibling iteration linear.
+    std::size_t index =
+        this->dataPtr->indexInParent.load(std::memory_order_relaxed);
+    if (index < siblings.size() && siblings[index].get() == this)
     {
-      return ElementPtr();
+      iter = siblings.begin() + index;
+    }
+    else
+    {
+      // Refresh the cached positions of all siblings at once, so the
+      // following calls on them don't have to search again.
+      // Walk backwards so that the first occurrence wins.
+      iter = siblings.end();
+      for (std::size_t i = siblings.size(); i-- > 0;)
+      {
+        siblings[i]->dataPtr->indexInParent.store(
+            i, std::memory_order_relaxed);
+        if (siblings[i].get() == this)
+        {
+          iter = siblings.begin() + i;
+        }
+      }
+
+      if (iter == siblings.end())
+      {
+        return ElementPtr();
+      }
     }
 
     ++iter;
@@ -683,6 +811,64 @@ ElementPtr Element::GetNextElement(const std::string &_name) const
   return ElementPtr();
 }
 
+/////////////////////////////////////////////////
+ElementRange Element::Children(const std::string &_name) const
+{
+  ElementPtr first;
+  if (_name.empty())
+  {
+    first = this->GetFirstElement();
+  }
+  else
+  {
+    first = this->GetElementImpl(_name);
+  }
+  return ElementRange(first, _name);
+}
+
+/////////////////////////////////////////////////
+ElementRange::ElementRange(ElementPtr _first, const std::string &_name)
+  : first(std::move(_first)), name(_name)
+{
+}
+
+/////////////////////////////////////////////////
+ElementRange::Iterator ElementRange::begin() const
+{
+  return Iterator(this->first, this->name);
+}
+
+/////////////////////////////////////////////////
+ElementRange::Iterator ElementRange::end() const
+{
+  return Iterator(ElementPtr(), this->name);
+}
+
+/////////////////////////////////////////////////
+ElementRange::Iterator::Iterator(ElementPtr _elem, const std::string &_name)
+  : elem(std::move(_elem)), name(_name)
+{
+}
+
+/////////////////////////////////////////////////
+const ElementPtr &ElementRange::Iterator::operator*() const
+{
+  return this->elem;
+}
+
+/////////////////////////////////////////////////
+ElementRange::Iterator &ElementRange::Iterator::operator++()
+{
+  this->elem = this->elem->GetNextElement(this->name);
+  return *this;
+}
+
+/////////////////////////////////////////////////
+bool ElementRange::Iterator::operator!=(const Iterator &_other) const
+{
+  return this->elem != _other.elem;
+}
+
 /////////////////////////////////////////////////
 std::set<std::string> Element::GetElementTypeNames() const
 {
@@ -700,15 +886,7 @@ std::set<std::string> Element::GetElementTypeNames() const
 /////////////////////////////////////////////////
 bool Element::HasUniqueChildNames(const std::string &_type) const
 {
-  auto namedElementsCount = this->CountNamedElements(_type);
-  for (auto &iter : namedElementsCount)
-  {
-    if (iter.second > 1)
-    {
-      return false;
-    }
-  }
-  return true;
+  return uniqueChildNames(*this, _type);
 }
 
 /////////////////////////////////////////////////
@@ -729,20 +907,12 @@ Element::CountNamedElements(const std::string &_type) const
 
   while (elem)
   {
-    if (elem->HasAttribute("name"))
+    ParamPtr nameParam = elem->GetAttribute("name");
+    if (nameParam)
     {
-      // Get("name") returns attribute value if it exists before checking
-      // for the value of a child element <name>, so it's safe to use
-      // here since we've checked HasAttribute("name").
-      std::string childNameAttributeValue = elem->Get<std::string>("name");
-      if (result.find(childNameAttributeValue) == result.end())
-      {
-        result[childNameAttributeValue] = 1;
-      }
-      else
-      {
-        ++result[childNameAttributeValue];
-      }
+      std::string childNameAttributeValue;
+      nameParam->Get<std::string>(childNameAttributeValue);
+      ++result[childNameAttributeValue];
     }
 
     elem = elem->GetNextElement(_type);
@@ -766,7 +936,7 @@ ElementPtr Element::GetElement(const std::string &_name)
 /////////////////////////////////////////////////
 void Element::InsertElement(ElementPtr _elem)
 {
-  this->dataPtr->elements.push_back(_elem);
+  this->dataPtr->PushElement(_elem);
 }
 
 /////////////////////////////////////////////////
@@ -785,36 +955,29 @@ ElementPtr Element::AddElement(const std::string &_name)
       this->dataPtr->elementDescriptions.empty() && parent &&
       parent->GetName() == this->dataPtr->name)
   {
-    for (unsigned int i = 0; i < parent->GetElementDescriptionCount(); ++i)
-    {
-      this->dataPtr->elementDescriptions.push_back(
-          parent->GetElementDescription(i)->Clone());
-    }
+    this->dataPtr->CopyElementDescriptions(*parent->dataPtr);
   }
 
-  ElementPtr_V::const_iterator iter, iter2;
-  for (iter = this->dataPtr->elementDescriptions.begin();
-      iter != this->dataPtr->elementDescriptions.end(); ++iter)
+  ElementPtr desc = this->GetElementDescription(_name);
+  if (desc)
   {
-    if ((*iter)->dataPtr->name == _name)
-    {
-      ElementPtr elem = (*iter)->Clone();
-      elem->SetParent(shared_from_this());
-      this->dataPtr->elements.push_back(elem);
+    ElementPtr elem = desc->Clone();
+    elem->SetParent(shared_from_this());
+    this->dataPtr->PushElement(elem);
 
-      // Add all child elements.
-      for (iter2 = elem->dataPtr->elementDescriptions.begin();
-           iter2 != elem->dataPtr->elementDescriptions.end(); ++iter2)
+    // Add all child elements.
+    ElementPtr_V::const_iterator iter;
+    for (iter = elem->dataPtr->elementDescriptions.begin();
+         iter != elem->dataPtr->elementDescriptions.end(); ++iter)
+    {
+      // Add only required child element
+      if ((*iter)->GetRequired() == "1")
       {
-        // Add only required child element
-        if ((*iter2)->GetRequired() == "1")
-        {
-          elem->AddElement((*iter2)->dataPtr->name);
-        }
+        elem->AddElement((*iter)->dataPtr->name);
       }
-
-      return this->dataPtr->elements.back();
     }
+
+    return elem;
   }
 
   sdferr << "Missing element description for [" << _name << "]\n";
@@ -838,7 +1001,7 @@ void Element::ClearElements()
     (*iter)->ClearElements();
   }
 
-  this->dataPtr->elements.clear();
+  this->dataPtr->ClearElements();
 }
 
 /////////////////////////////////////////////////
@@ -875,17 +1038,10 @@ void Element::Reset()
     (*iter).reset();
   }
 
-  for (ElementPtr_V::iterator iter = this->dataPtr->elementDescriptions.begin();
-      iter != this->dataPtr->elementDescriptions.end(); ++iter)
-  {
-    if (*iter)
-    {
-      (*iter)->Reset();
-    }
-    (*iter).reset();
-  }
-  this->dataPtr->elements.clear();
-  this->dataPtr->elementDescriptions.clear();
+  // Element descriptions may be shared with other elements through the
+  // schema cache, so only the references held by this element are dropped.
+  this->dataPtr->ClearElements();
+  this->dataPtr->ClearElementDescriptions();
 
   this->dataPtr->value.reset();
 
@@ -895,7 +1051,7 @@ void Element::Reset()
 /////////////////////////////////////////////////
 void Element::AddElementDescription(ElementPtr _elem)
 {
-  this->dataPtr->elementDescriptions.push_back(_elem);
+  this->dataPtr->PushElementDescription(_elem);
 }
 
 /////////////////////////////////////////////////
@@ -958,7 +1114,7 @@ void Element::RemoveFromParent()
 
     if (iter != parent->dataPtr->elements.end())
     {
-      parent->dataPtr->elements.erase(iter);
+      parent->dataPtr->EraseElement(iter);
       parent.reset();
     }
   }
@@ -976,7 +1132,7 @@ void Element::RemoveChild(ElementPtr _child)
   if (iter != this->dataPtr->elements.end())
   {
     _child->SetParent(ElementPtr());
-    this->dataPtr->elements.erase(iter);
+    this->dataPtr->EraseElement(iter);
   }
 }
 
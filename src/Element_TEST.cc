@@ -15,6 +15,9 @@
  *
  */
 
+#include <string>
+#include <vector>
+
 #include <gtest/gtest.h>
 
 #include "sdf/Element.hh"
@@ -283,6 +286,10 @@ TEST(Element, Clone)
   ASSERT_NE(newelem->GetFirstElement(), nullptr);
   ASSERT_EQ(newelem->GetElementDescriptionCount(), 1UL);
   ASSERT_EQ(newelem->GetAttributeCount(), 1UL);
+
+  // Element descriptions are shared, attributes are copied.
+  EXPECT_EQ(desc, newelem->GetElementDescription(0));
+  EXPECT_NE(parent->GetAttribute("test"), newelem->GetAttribute("test"));
 }
 
 /////////////////////////////////////////////////
@@ -718,6 +725,153 @@ TEST(Element, CountNamedElements)
   EXPECT_EQ(allMap.at("child3"), 1u);
 }
 
+/////////////////////////////////////////////////
+TEST(Element, IndexedLookup)
+{
+  sdf::ElementPtr parent = std::make_shared<sdf::Element>();
+  parent->SetName("parent");
+
+  sdf::ElementPtr first = std::make_shared<sdf::Element>();
+  first->SetName("child");
+  first->SetParent(parent);
+  parent->InsertElement(first);
+
+  sdf::ElementPtr second = std::make_shared<sdf::Element>();
+  second->SetName("child");
+  second->SetParent(parent);
+  parent->InsertElement(second);
+
+  sdf::ElementPtr other = std::make_shared<sdf::Element>();
+  other->SetName("other");
+  other->SetParent(parent);
+  parent->InsertElement(other);
+
+  // Lookup returns the first child with a given name.
+  EXPECT_EQ(first, parent->GetElement("child"));
+  EXPECT_EQ(other, parent->GetElement("other"));
+
+  // Removing the first child exposes the second one.
+  parent->RemoveChild(first);
+  EXPECT_EQ(second, parent->GetElement("child"));
+  EXPECT_EQ(other, parent->GetElement("other"));
+
+  // Renaming a child updates the parent's index.
+  other->SetName("renamed");
+  EXPECT_FALSE(parent->HasElement("other"));
+  EXPECT_EQ(other, parent->GetElement("renamed"));
+
+  second->RemoveFromParent();
+  EXPECT_FALSE(parent->HasElement("child"));
+  EXPECT_EQ(other, parent->GetElement("renamed"));
+
+  parent->ClearElements();
+  EXPECT_FALSE(parent->HasElement("renamed"));
+
+  // The first attribute with a given key wins.
+  parent->AddAttribute("key", "string", "first", false, "");
+  parent->AddAttribute("key", "string", "second", false, "");
+  EXPECT_EQ(parent->GetAttribute(0), parent->GetAttribute("key"));
+  EXPECT_EQ("first", parent->GetAttribute("key")->GetAsString());
+  EXPECT_EQ(nullptr, parent->GetAttribute("missing"));
+}
+
+/////////////////////////////////////////////////
+TEST(Element, IndexedRename)
+{
+  sdf::ElementPtr parent = std::make_shared<sdf::Element>();
+  parent->SetName("parent");
+
+  std::vector<sdf::ElementPtr> children;
+  for (const char *name : {"a", "b", "a", "b"})
+  {
+    sdf::ElementPtr child = std::make_shared<sdf::Element>();
+    child->SetName(name);
+    child->SetParent(parent);
+    parent->InsertElement(child);
+    children.push_back(child);
+  }
+
+  // Renaming the first child with a name exposes the next one.
+  children[0]->SetName("c");
+  EXPECT_EQ(children[2], parent->GetElement("a"));
+  EXPECT_EQ(children[0], parent->GetElement("c"));
+
+  // A child renamed after an earlier child with the same name is not found
+  // first.
+  children[3]->SetName("a");
+  EXPECT_EQ(children[2], parent->GetElement("a"));
+
+  // A child renamed before the first child with the same name is.
+  children[1]->SetName("a");
+  EXPECT_EQ(children[1], parent->GetElement("a"));
+  EXPECT_FALSE(parent->HasElement("b"));
+
+  // Removing the last child with a name removes it from the index.
+  parent->RemoveChild(children[0]);
+  EXPECT_FALSE(parent->HasElement("c"));
+  EXPECT_EQ(children[1], parent->GetElement("a"));
+
+  // Removing a child that is not first keeps the index entry.
+  parent->RemoveChild(children[2]);
+  EXPECT_EQ(children[1], parent->GetElement("a"));
+  parent->RemoveChild(children[1]);
+  EXPECT_EQ(children[3], parent->GetElement("a"));
+}
+
+/////////////////////////////////////////////////
+TEST(Element, Children)
+{
+  sdf::ElementPtr parent = std::make_shared<sdf::Element>();
+  parent->SetName("parent");
+
+  // The range over an element without children is empty.
+  EXPECT_FALSE(parent->Children().begin() != parent->Children().end());
+
+  std::vector<sdf::ElementPtr> children;
+  for (const char *name : {"link", "joint", "link", "frame", "link"})
+  {
+    sdf::ElementPtr child = std::make_shared<sdf::Element>();
+    child->SetName(name);
+    child->SetParent(parent);
+    parent->InsertElement(child);
+    children.push_back(child);
+  }
+
+  std::vector<sdf::ElementPtr> all;
+  for (const auto &child : parent->Children())
+  {
+    all.push_back(child);
+  }
+  EXPECT_EQ(children, all);
+
+  std::vector<sdf::ElementPtr> links;
+  for (const auto &link : parent->Children("link"))
+  {
+    links.push_back(link);
+  }
+  ASSERT_EQ(3u, links.size());
+  EXPECT_EQ(children[0], links[0]);
+  EXPECT_EQ(children[2], links[1]);
+  EXPECT_EQ(children[4], links[2]);
+
+  std::size_t count = 0;
+  for (const auto &missing : parent->Children("model"))
+  {
+    EXPECT_NE(nullptr, missing);
+    ++count;
+  }
+  EXPECT_EQ(0u, count);
+
+  // The range does not add missing elements.
+  EXPECT_FALSE(parent->HasElement("model"));
+
+  // Sibling iteration stays correct after the parent's vector changes.
+  parent->RemoveChild(children[1]);
+  EXPECT_EQ(children[3], children[2]->GetNextElement());
+  EXPECT_EQ(children[4], children[2]->GetNextElement("link"));
+  EXPECT_EQ(nullptr, children[1]->GetNextElement());
+}
+
 /////////////////////////////////////////////////
 /// Main
 int main(int argc, char **argv)
@@ -0,0 +1,48 @@
+/*
+ * Copyright 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <string>
+
+#include "FindFileCache.hh"
+
+using namespace sdf;
+
+/////////////////////////////////////////////////
+bool FindFileCache::Find(const std::string &_key, std::string &_path) const
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  auto iter = this->paths.find(_key);
+  if (iter == this->paths.end())
+    return false;
+
+  _path = iter->second;
+  return true;
+}
+
+/////////////////////////////////////////////////
+void FindFileCache::Insert(const std::string &_key, const std::string &_path)
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  this->paths[_key] = _path;
+}
+
+/////////////////////////////////////////////////
+void FindFileCache::Clear()
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  this->paths.clear();
+}
@@ -0,0 +1,67 @@
+/*
+ * Copyright 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef SDF_FIND_FILE_CACHE_HH_
+#define SDF_FIND_FILE_CACHE_HH_
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "sdf/ParserConfig.hh"
+#include "sdf/system_util.hh"
+
+namespace sdf
+{
+  // Inline bracket to help doxygen filtering.
+  inline namespace SDF_VERSION_NAMESPACE {
+  //
+
+  /// \brief Thread-safe cache of sdf::findFile results. Both found paths
+  /// and failed lookups, stored as empty paths, are cached.
+  class FindFileCache
+  {
+    /// \brief Look up a cached result.
+    /// \param[in] _key Lookup key, which must capture every input of the
+    /// lookup.
+    /// \param[out] _path The cached path, set on a hit. Empty if the
+    /// cached lookup failed.
+    /// \return True if the key was found.
+    public: bool Find(const std::string &_key, std::string &_path) const;
+
+    /// \brief Cache the result of a lookup.
+    /// \param[in] _key Lookup key.
+    /// \param[in] _path The path that was found, or an empty string if the
+    /// lookup failed.
+    public: void Insert(const std::string &_key, const std::string &_path);
+
+    /// \brief Remove every cached result.
+    public: void Clear();
+
+    /// \brief Mutex that protects the cached results.
+    private: mutable std::mutex mutex;
+
+    /// \brief Cached results indexed by lookup key.
+    private: std::unordered_map<std::string, std::string> paths;
+  };
+
+  /// \brief Get the findFile cache of a parser configuration.
+  /// \param[in] _config Parser configuration.
+  /// \return The cache, or nullptr if findFile caching is disabled.
+  FindFileCache *findFileCache(const ParserConfig &_config);
+  }
+}
+#endif
@@ -0,0 +1,522 @@
+/*
+ * Copyright 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef SDF_FLAT_DIRECTED_GRAPH_HH_
+#define SDF_FLAT_DIRECTED_GRAPH_HH_
+
+#include <cstddef>
+#include <iterator>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <ignition/math/graph/Graph.hh>
+
+#include "sdf/sdf_config.h"
+
+namespace sdf
+{
+// Inline bracket to help doxygen filtering.
+inline namespace SDF_VERSION_NAMESPACE {
+
+/// \brief A directed graph that stores its vertices and edges in contiguous
+/// arrays indexed by their IDs, used for the frame graphs instead of
+/// ignition::math::graph::DirectedGraph, which keeps them in maps.
+///
+/// The incoming and outgoing edges of each vertex are linked lists threaded
+/// through an array parallel to the edges, so adding an edge doesn't
+/// allocate anything but array growth, and the incident edges of a vertex
+/// are iterated without building a container. Vertex IDs are assigned in
+/// order starting at 0, and so are edge IDs. Vertices and edges can't be
+/// removed, but an edge can be updated in place or moved to other vertices.
+///
+/// The vertex and edge types are the ones of ignition::math::graph, so the
+/// graph can be printed in the same DOT format.
+/// \tparam V Type of the data stored in the vertices.
+/// \tparam E Type of the data stored in the edges.
+template <typename V, typename E>
+class FlatDirectedGraph
+{
+  // Type aliases
+  public: using VertexType = V;
+  public: using EdgeType = E;
+  public: using VertexId = ignition::math::graph::VertexId;
+  public: using EdgeId = ignition::math::graph::EdgeId;
+  public: using Vertex = ignition::math::graph::Vertex<V>;
+  public: using Edge = ignition::math::graph::DirectedEdge<E>;
+
+  /// \brief Links of an edge to the next edges into its head and out of its
+  /// tail.
+  private: struct EdgeLinks
+  {
+    /// \brief Next edge with the same head, or kNullId.
+    EdgeId nextIn = ignition::math::graph::kNullId;
+
+    /// \brief Next edge with the same tail, or kNullId.
+    EdgeId nextOut = ignition::math::graph::kNullId;
+  };
+
+  /// \brief Incident edges of a vertex.
+  private: struct VertexLinks
+  {
+    /// \brief First and last incoming edges, or kNullId.
+    EdgeId firstIn = ignition::math::graph::kNullId;
+    EdgeId lastIn = ignition::math::graph::kNullId;
+
+    /// \brief First and last outgoing edges, or kNullId.
+    EdgeId firstOut = ignition::math::graph::kNullId;
+    EdgeId lastOut = ignition::math::graph::kNullId;
+
+    /// \brief Number of incoming edges.
+    std::size_t inDegree = 0;
+
+    /// \brief Number of outgoing edges.
+    std::size_t outDegree = 0;
+  };
+
+  /// \brief Range of the incoming or outgoing edges of a vertex. It refers
+  /// to the graph, so it must not outlive it, and it stays valid when edges
+  /// are added.
+  public: class EdgeRange
+  {
+    /// \brief Forward iterator over the edges of the range.
+    public: class const_iterator
+    {
+      public: using iterator_category = std::forward_iterator_tag;
+      public: using value_type = Edge;
+      public: using difference_type = std::ptrdiff_t;
+      public: using pointer = const Edge *;
+      public: using reference = const Edge &;
+
+      /// \brief Default constructor, for an end iterator.
+      public: const_iterator() = default;
+
+      /// \brief Constructor.
+      /// \param[in] _graph Graph of the edges.
+      /// \param[in] _id ID of the current edge, or kNullId at the end.
+      /// \param[in] _incoming True to follow the incoming edges of the
+      /// vertex, false to follow its outgoing edges.
+      public: const_iterator(const FlatDirectedGraph *_graph, EdgeId _id,
+                  bool _incoming)
+          : graph(_graph), id(_id), incoming(_incoming)
+      {
+      }
+
+      /// \brief Get the current edge.
+      /// \return The current edge.
+      public: reference operator*() const
+      {
+        return this->graph->edges[this->id];
+      }
+
+      /// \brief Get the current edge.
+      /// \return Pointer to the current edge.
+      public: pointer operator->() const
+      {
+        return &this->graph->edges[this->id];
+      }
+
+      /// \brief Move to the next edge.
+      /// \return *this
+      public: const_iterator &operator++()
+      {
+        const EdgeLinks &links = this->graph->edgeLinks[this->id];
+        this->id = this->incoming ? links.nextIn : links.nextOut;
+        return *this;
+      }
+
+      /// \brief Move to the next edge.
+      /// \return Iterator to the current edge.
+      public: const_iterator operator++(int)
+      {
+        const_iterator result = *this;
+        ++(*this);
+        return result;
+      }
+
+      /// \brief Compare iterators of the same range.
+      /// \param[in] _other Iterator to compare with.
+      /// \return True if both iterators refer to the same edge.
+      public: bool operator==(const const_iterator &_other) const
+      {
+        return this->id == _other.id;
+      }
+
+      /// \brief Compare iterators of the same range.
+      /// \param[in] _other Iterator to compare with.
+      /// \return True if the iterators refer to different edges.
+      public: bool operator!=(const const_iterator &_other) const
+      {
+        return this->id != _other.id;
+      }
+
+      /// \brief Graph of the edges.
+      private: const FlatDirectedGraph *graph = nullptr;
+
+      /// \brief ID of the current edge, or kNullId at the end.
+      private: EdgeId id = ignition::math::graph::kNullId;
+
+      /// \brief True to follow the incoming edges of the vertex.
+      private: bool incoming = false;
+    };
+
+    /// \brief Constructor.
+    /// \param[in] _graph Graph of the edges.
+    /// \param[in] _first ID of the first edge, or kNullId.
+    /// \param[in] _size Number of edges.
+    /// \param[in] _incoming True for the incoming edges of a vertex.
+    public: EdgeRange(const FlatDirectedGraph *_graph, EdgeId _first,
+                std::size_t _size, bool _incoming)
+        : graph(_graph), first(_first), count(_size), incoming(_incoming)
+    {
+    }
+
+    /// \brief Get an iterator to the first edge.
+    /// \return Iterator to the first edge.
+    public: const_iterator begin() const
+    {
+      return const_iterator(this->graph, this->first, this->incoming);
+    }
+
+    /// \brief Get an iterator past the last edge.
+    /// \return End iterator.
+    public: const_iterator end() const
+    {
+      return const_iterator(this->graph, ignition::math::graph::kNullId,
+          this->incoming);
+    }
+
+    /// \brief Get the first edge. The range must not be empty.
+    /// \return The first edge.
+    public: const Edge &front() const
+    {
+      return this->graph->edges[this->first];
+    }
+
+    /// \brief Get the number of edges.
+    /// \return Number of edges.
+    public: std::size_t size() const
+    {
+      return this->count;
+    }
+
+    /// \brief Check whether the range has no edges.
+    /// \return True if the range has no edges.
+    public: bool empty() const
+    {
+      return this->count == 0;
+    }
+
+    /// \brief Graph of the edges.
+    private: const FlatDirectedGraph *graph;
+
+    /// \brief ID of the first edge, or kNullId.
+    private: EdgeId first;
+
+    /// \brief Number of edges.
+    private: std::size_t count;
+
+    /// \brief True for the incoming edges of a vertex.
+    private: bool incoming;
+  };
+
+  /// \brief Reserve memory for a number of vertices and edges.
+  /// \param[in] _vertices Number of vertices.
+  /// \param[in] _edges Number of edges.
+  public: void Reserve(std::size_t _vertices, std::size_t _edges)
+  {
+    this->vertices.reserve(_vertices);
+    this->vertexLinks.reserve(_vertices);
+    this->edges.reserve(_edges);
+    this->edgeLinks.reserve(_edges);
+  }
+
+  /// \brief Add a vertex to the graph. Its ID is the number of vertices
+  /// that were added before it.
+  /// \param[in] _name Name of the vertex. It doesn't need to be unique.
+  /// \param[in] _data Data stored in the vertex.
+  /// \return Reference to the new vertex. It is invalidated by adding
+  /// another vertex.
+  public: Vertex &AddVertex(const std::string &_name, const V &_data)
+  {
+    const VertexId id = this->vertices.size();
+    this->vertices.emplace_back(_name, _data, id);
+    this->vertexLinks.emplace_back();
+    return this->vertices.back();
+  }
+
+  /// \brief Add an edge to the graph. Its ID is the number of edges that
+  /// were added before it.
+  /// \param[in] _vertices IDs of the tail and head vertices of the edge.
+  /// \param[in] _data Data stored in the edge.
+  /// \param[in] _weight Weight of the edge.
+  /// \return Reference to the new edge, or NullEdge if one of the vertices
+  /// doesn't exist. It is invalidated by adding another edge.
+  public: Edge &AddEdge(const ignition::math::graph::VertexId_P &_vertices,
+              const E &_data, double _weight = 1.0)
+  {
+    const VertexId tail = _vertices.first;
+    const VertexId head = _vertices.second;
+    if (tail >= this->vertices.size() || head >= this->vertices.size())
+      return Edge::NullEdge;
+
+    const EdgeId id = this->edges.size();
+    this->edges.emplace_back(_vertices, _data, _weight, id);
+    this->edgeLinks.emplace_back();
+    this->Link(id, _vertices);
+    return this->edges.back();
+  }
+
+  /// \brief Replace the data of an edge. The edge keeps its ID.
+  /// \param[in] _id ID of the edge.
+  /// \param[in] _data New data.
+  /// \return False if the edge doesn't exist.
+  public: bool SetEdgeData(EdgeId _id, const E &_data)
+  {
+    if (_id >= this->edges.size())
+      return false;
+
+    const Edge &edge = this->edges[_id];
+    this->edges[_id] = Edge(edge.Vertices(), _data, edge.Weight(), _id);
+    return true;
+  }
+
+  /// \brief Move an edge to other vertices. The edge keeps its ID, and is
+  /// appended to the lists of incident edges of its new vertices.
+  /// \param[in] _id ID of the edge.
+  /// \param[in] _vertices IDs of the new tail and head vertices.
+  /// \return False if the edge or one of the vertices doesn't exist.
+  public: bool SetEdgeVertices(EdgeId _id,
+              const ignition::math::graph::VertexId_P &_vertices)
+  {
+    if (_id >= this->edges.size() ||
+        _vertices.first >= this->vertices.size() ||
+        _vertices.second >= this->vertices.size())
+    {
+      return false;
+    }
+
+    const Edge &edge = this->edges[_id];
+    const auto oldVertices = edge.Vertices();
+    if (oldVertices == _vertices)
+      return true;
+
+    this->Unlink(_id, oldVertices);
+    this->edges[_id] = Edge(_vertices, edge.Data(), edge.Weight(), _id);
+    this->Link(_id, _vertices);
+    return true;
+  }
+
+  /// \brief Get all the vertices, indexed by ID.
+  /// \return The vertices.
+  public: const std::vector<Vertex> &Vertices() const
+  {
+    return this->vertices;
+  }
+
+  /// \brief Get all the edges, indexed by ID.
+  /// \return The edges.
+  public: const std::vector<Edge> &Edges() const
+  {
+    return this->edges;
+  }
+
+  /// \brief Get a vertex from its ID.
+  /// \param[in] _id ID of the vertex.
+  /// \return The vertex, or NullVertex if it doesn't exist.
+  public: const Vertex &VertexFromId(VertexId _id) const
+  {
+    if (_id >= this->vertices.size())
+      return Vertex::NullVertex;
+    return this->vertices[_id];
+  }
+
+  /// \brief Get a vertex from its ID.
+  /// \param[in] _id ID of the vertex.
+  /// \return The vertex, or NullVertex if it doesn't exist.
+  public: Vertex &VertexFromId(VertexId _id)
+  {
+    if (_id >= this->vertices.size())
+      return Vertex::NullVertex;
+    return this->vertices[_id];
+  }
+
+  /// \brief Get an edge from its ID.
+  /// \param[in] _id ID of the edge.
+  /// \return The edge, or NullEdge if it doesn't exist.
+  public: const Edge &EdgeFromId(EdgeId _id) const
+  {
+    if (_id >= this->edges.size())
+      return Edge::NullEdge;
+    return this->edges[_id];
+  }
+
+  /// \brief Get the edges whose head is a vertex.
+  /// \param[in] _id ID of the vertex.
+  /// \return The incoming edges in the order in which they were added. The
+  /// range is empty if the vertex doesn't exist.
+  public: EdgeRange IncidentsTo(VertexId _id) const
+  {
+    if (_id >= this->vertexLinks.size())
+      return EdgeRange(this, ignition::math::graph::kNullId, 0, true);
+    const VertexLinks &links = this->vertexLinks[_id];
+    return EdgeRange(this, links.firstIn, links.inDegree, true);
+  }
+
+  /// \brief Get the edges whose head is a vertex.
+  /// \param[in] _vertex The vertex.
+  /// \return The incoming edges in the order in which they were added.
+  public: EdgeRange IncidentsTo(const Vertex &_vertex) const
+  {
+    return this->IncidentsTo(_vertex.Id());
+  }
+
+  /// \brief Get the edges whose tail is a vertex.
+  /// \param[in] _id ID of the vertex.
+  /// \return The outgoing edges in the order in which they were added. The
+  /// range is empty if the vertex doesn't exist.
+  public: EdgeRange IncidentsFrom(VertexId _id) const
+  {
+    if (_id >= this->vertexLinks.size())
+      return EdgeRange(this, ignition::math::graph::kNullId, 0, false);
+    const VertexLinks &links = this->vertexLinks[_id];
+    return EdgeRange(this, links.firstOut, links.outDegree, false);
+  }
+
+  /// \brief Get the edges whose tail is a vertex.
+  /// \param[in] _vertex The vertex.
+  /// \return The outgoing edges in the order in which they were added.
+  public: EdgeRange IncidentsFrom(const Vertex &_vertex) const
+  {
+    return this->IncidentsFrom(_vertex.Id());
+  }
+
+  /// \brief Get the number of incoming edges of a vertex.
+  /// \param[in] _id ID of the vertex.
+  /// \return Number of incoming edges, or 0 if the vertex doesn't exist.
+  public: std::size_t InDegree(VertexId _id) const
+  {
+    return this->IncidentsTo(_id).size();
+  }
+
+  /// \brief Get the number of outgoing edges of a vertex.
+  /// \param[in] _id ID of the vertex.
+  /// \return Number of outgoing edges, or 0 if the vertex doesn't exist.
+  public: std::size_t OutDegree(VertexId _id) const
+  {
+    return this->IncidentsFrom(_id).size();
+  }
+
+  /// \brief Stream insertion operator. The output uses the DOT format, like
+  /// the one of ignition::math::graph::DirectedGraph.
+  /// \param[out] _out The output stream.
+  /// \param[in] _g Graph to write to the stream.
+  /// \return The output stream.
+  public: friend std::ostream &operator<<(std::ostream &_out,
+              const FlatDirectedGraph &_g)
+  {
+    _out << "digraph G {" << std::endl;
+    for (const auto &vertex : _g.vertices)
+      _out << vertex;
+    for (const auto &edge : _g.edges)
+      _out << edge;
+    _out << "}" << std::endl;
+    return _out;
+  }
+
+  /// \brief Append an edge to the lists of incident edges of its vertices.
+  /// \param[in] _id ID of the edge.
+  /// \param[in] _vertices IDs of the tail and head vertices of the edge.
+  private: void Link(EdgeId _id,
+               const ignition::math::graph::VertexId_P &_vertices)
+  {
+    this->edgeLinks[_id] = EdgeLinks();
+
+    VertexLinks &tailLinks = this->vertexLinks[_vertices.first];
+    if (tailLinks.lastOut == ignition::math::graph::kNullId)
+      tailLinks.firstOut = _id;
+    else
+      this->edgeLinks[tailLinks.lastOut].nextOut = _id;
+    tailLinks.lastOut = _id;
+    ++tailLinks.outDegree;
+
+    VertexLinks &headLinks = this->vertexLinks[_vertices.second];
+    if (headLinks.lastIn == ignition::math::graph::kNullId)
+      headLinks.firstIn = _id;
+    else
+      this->edgeLinks[headLinks.lastIn].nextIn = _id;
+    headLinks.lastIn = _id;
+    ++headLinks.inDegree;
+  }
+
+  /// \brief Remove an edge from the lists of incident edges of its
+  /// vertices. This is linear in the degrees of the vertices.
+  /// \param[in] _id ID of the edge.
+  /// \param[in] _vertices IDs of the tail and head vertices of the edge.
+  private: void Unlink(EdgeId _id,
+               const ignition::math::graph::VertexId_P &_vertices)
+  {
+    const EdgeId kNullId = ignition::math::graph::kNullId;
+
+    VertexLinks &tailLinks = this->vertexLinks[_vertices.first];
+    EdgeId prev = kNullId;
+    for (EdgeId e = tailLinks.firstOut; e != _id;
+         e = this->edgeLinks[e].nextOut)
+    {
+      prev = e;
+    }
+    const EdgeId nextOut = this->edgeLinks[_id].nextOut;
+    if (prev == kNullId)
+      tailLinks.firstOut = nextOut;
+    else
+      this->edgeLinks[prev].nextOut = nextOut;
+    if (tailLinks.lastOut == _id)
+      tailLinks.lastOut = prev;
+    --tailLinks.outDegree;
+
+    VertexLinks &headLinks = this->vertexLinks[_vertices.second];
+    prev = kNullId;
+    for (EdgeId e = headLinks.firstIn; e != _id;
+         e = this->edgeLinks[e].nextIn)
+    {
+      prev = e;
+    }
+    const EdgeId nextIn = this->edgeLinks[_id].nextIn;
+    if (prev == kNullId)
+      headLinks.firstIn = nextIn;
+    else
+      this->edgeLinks[prev].nextIn = nextIn;
+    if (headLinks.lastIn == _id)
+      headLinks.lastIn = prev;
+    --headLinks.inDegree;
+  }
+
+  /// \brief Vertices, indexed by ID.
+  private: std::vector<Vertex> vertices;
+
+  /// \brief Incident edges of the vertices, indexed by vertex ID.
+  private: std::vector<VertexLinks> vertexLinks;
+
+  /// \brief Edges, indexed by ID.
+  private: std::vector<Edge> edges;
+
+  /// \brief Links between the edges, indexed by edge ID.
+  private: std::vector<EdgeLinks> edgeLinks;
+};
+}
+}
+
+#endif
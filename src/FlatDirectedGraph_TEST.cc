@@ -0,0 +1,160 @@
+/*
+ * Copyright 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "FlatDirectedGraph.hh"
+
+using Graph = sdf::FlatDirectedGraph<int, double>;
+
+/////////////////////////////////////////////////
+TEST(FlatDirectedGraph, Construction)
+{
+  Graph graph;
+  EXPECT_TRUE(graph.Vertices().empty());
+  EXPECT_TRUE(graph.Edges().empty());
+  EXPECT_FALSE(graph.VertexFromId(0).Valid());
+  EXPECT_EQ(ignition::math::graph::kNullId, graph.EdgeFromId(0).Id());
+  EXPECT_TRUE(graph.IncidentsTo(0).empty());
+  EXPECT_TRUE(graph.IncidentsFrom(0).empty());
+
+  graph.Reserve(3, 3);
+  EXPECT_EQ(0u, graph.AddVertex("a", 1).Id());
+  EXPECT_EQ(1u, graph.AddVertex("b", 2).Id());
+  EXPECT_EQ(2u, graph.AddVertex("b", 3).Id());
+  ASSERT_EQ(3u, graph.Vertices().size());
+  EXPECT_EQ("b", graph.VertexFromId(2).Name());
+  EXPECT_EQ(3, graph.VertexFromId(2).Data());
+
+  EXPECT_EQ(0u, graph.AddEdge({0, 1}, 0.5).Id());
+  EXPECT_EQ(1u, graph.AddEdge({0, 2}, 1.5).Id());
+  EXPECT_EQ(2u, graph.AddEdge({2, 1}, 2.5, 0.0).Id());
+  EXPECT_EQ(0u, graph.EdgeFromId(1).Tail());
+  EXPECT_EQ(2u, graph.EdgeFromId(1).Head());
+  EXPECT_DOUBLE_EQ(0.0, graph.EdgeFromId(2).Weight());
+
+  // Edges to missing vertices aren't added.
+  EXPECT_EQ(ignition::math::graph::kNullId,
+      graph.AddEdge({0, 3}, 0.0).Id());
+  EXPECT_EQ(3u, graph.Edges().size());
+
+  EXPECT_EQ(2u, graph.OutDegree(0));
+  EXPECT_EQ(0u, graph.InDegree(0));
+  EXPECT_EQ(2u, graph.InDegree(1));
+  EXPECT_EQ(1u, graph.OutDegree(2));
+}
+
+/////////////////////////////////////////////////
+TEST(FlatDirectedGraph, Incidents)
+{
+  Graph graph;
+  for (int i = 0; i < 4; ++i)
+    graph.AddVertex("v" + std::to_string(i), i);
+
+  graph.AddEdge({0, 1}, 0.0);
+  graph.AddEdge({2, 3}, 1.0);
+  graph.AddEdge({0, 3}, 2.0);
+  graph.AddEdge({1, 3}, 3.0);
+
+  // Edges are iterated in the order in which they were added.
+  std::vector<double> data;
+  for (const auto &edge : graph.IncidentsTo(3))
+    data.push_back(edge.Data());
+  EXPECT_EQ(std::vector<double>({1.0, 2.0, 3.0}), data);
+  EXPECT_DOUBLE_EQ(1.0, graph.IncidentsTo(3).front().Data());
+
+  data.clear();
+  for (const auto &edge : graph.IncidentsFrom(graph.VertexFromId(0)))
+    data.push_back(edge.Data());
+  EXPECT_EQ(std::vector<double>({0.0, 2.0}), data);
+
+  // Updating an edge keeps its ID and position in the lists.
+  EXPECT_TRUE(graph.SetEdgeData(2, 5.0));
+  EXPECT_FALSE(graph.SetEdgeData(4, 5.0));
+  EXPECT_EQ(2u, graph.EdgeFromId(2).Id());
+  data.clear();
+  for (const auto &edge : graph.IncidentsTo(3))
+    data.push_back(edge.Data());
+  EXPECT_EQ(std::vector<double>({1.0, 5.0, 3.0}), data);
+
+  // A range stays valid when edges are added.
+  const auto incidents = graph.IncidentsFrom(1);
+  graph.AddEdge({1, 0}, 6.0);
+  std::size_t count = 0;
+  for (auto it = incidents.begin(); it != incidents.end(); ++it)
+    ++count;
+  EXPECT_EQ(2u, count);
+  EXPECT_EQ(2u, graph.OutDegree(1));
+}
+
+/////////////////////////////////////////////////
+TEST(FlatDirectedGraph, MoveEdge)
+{
+  Graph graph;
+  for (int i = 0; i < 4; ++i)
+    graph.AddVertex("v" + std::to_string(i), i);
+
+  graph.AddEdge({0, 1}, 0.0);
+  graph.AddEdge({0, 2}, 1.0);
+  graph.AddEdge({0, 3}, 2.0);
+
+  // Move the edge in the middle of the list of 0 to another tail.
+  EXPECT_TRUE(graph.SetEdgeVertices(1, {3, 2}));
+  EXPECT_EQ(1u, graph.EdgeFromId(1).Id());
+  EXPECT_EQ(3u, graph.EdgeFromId(1).Tail());
+  EXPECT_DOUBLE_EQ(1.0, graph.EdgeFromId(1).Data());
+  EXPECT_EQ(2u, graph.OutDegree(0));
+  EXPECT_EQ(1u, graph.OutDegree(3));
+  EXPECT_EQ(1u, graph.InDegree(2));
+
+  std::vector<double> data;
+  for (const auto &edge : graph.IncidentsFrom(0))
+    data.push_back(edge.Data());
+  EXPECT_EQ(std::vector<double>({0.0, 2.0}), data);
+
+  // Move the last edge of 0, then add one, which goes after the others.
+  EXPECT_TRUE(graph.SetEdgeVertices(2, {1, 3}));
+  graph.AddEdge({0, 2}, 3.0);
+  data.clear();
+  for (const auto &edge : graph.IncidentsFrom(0))
+    data.push_back(edge.Data());
+  EXPECT_EQ(std::vector<double>({0.0, 3.0}), data);
+  EXPECT_EQ(2u, graph.InDegree(2));
+  EXPECT_DOUBLE_EQ(1.0, graph.IncidentsTo(2).front().Data());
+
+  EXPECT_FALSE(graph.SetEdgeVertices(4, {0, 1}));
+  EXPECT_FALSE(graph.SetEdgeVertices(0, {0, 4}));
+}
+
+/////////////////////////////////////////////////
+TEST(FlatDirectedGraph, Print)
+{
+  Graph graph;
+  graph.AddVertex("a", 0);
+  graph.AddVertex("b", 1);
+  graph.AddEdge({0, 1}, 0.0);
+
+  std::ostringstream stream;
+  stream << graph;
+  const std::string output = stream.str();
+  EXPECT_EQ(0u, output.find("digraph G {"));
+  EXPECT_NE(std::string::npos, output.find("a (0)"));
+  EXPECT_NE(std::string::npos, output.find("0 -> 1"));
+}
@@ -20,6 +20,7 @@
 #include "sdf/Error.hh"
 #include "sdf/Types.hh"
 #include "FrameSemantics.hh"
+#include "NameIndex.hh"
 #include "ScopedGraph.hh"
 #include "Utils.hh"
 
@@ -157,6 +158,8 @@ const std::string &Frame::Name() const
 void Frame::SetName(const std::string &_name) const
 {
   this->dataPtr->name = _name;
+  // The owner's index of names can't see this change.
+  NameIndex::NameChanged();
 }
 
 /////////////////////////////////////////////////
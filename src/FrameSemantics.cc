@@ -15,17 +15,24 @@
  *
 */
 #include <algorithm>
+#include <mutex>
 #include <string>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
+#include "sdf/Collision.hh"
 #include "sdf/Element.hh"
 #include "sdf/Error.hh"
 #include "sdf/Frame.hh"
 #include "sdf/Joint.hh"
+#include "sdf/Light.hh"
 #include "sdf/Link.hh"
 #include "sdf/Model.hh"
+#include "sdf/ResolvedPoses.hh"
+#include "sdf/Sensor.hh"
 #include "sdf/Types.hh"
+#include "sdf/Visual.hh"
 #include "sdf/World.hh"
 
 #include "FrameSemantics.hh"
@@ -102,8 +109,8 @@ FindSourceVertex(const ScopedGraph<T> &_graph,
           "current vertex [" + vertex.get().Name() + "]."});
       return PairType(Vertex::NullVertex, EdgesType());
     }
-    auto const &edge = incidentsTo.begin()->second;
-    vertex = _graph.Graph().VertexFromId(edge.get().Vertices().first);
+    auto const &edge = incidentsTo.front();
+    vertex = _graph.Graph().VertexFromId(edge.Tail());
     edges.push_back(edge);
     if (visited.count(vertex.get().Id()))
     {
@@ -176,8 +183,8 @@ FindSinkVertex(
           "current vertex [" + vertex.get().Name() + "]."});
       return PairType(Vertex::NullVertex, EdgesType());
     }
-    auto const &edge = incidentsFrom.begin()->second;
-    vertex = _graph.Graph().VertexFromId(edge.get().Vertices().second);
+    auto const &edge = incidentsFrom.front();
+    vertex = _graph.Graph().VertexFromId(edge.Head());
     edges.push_back(edge);
     if (visited.count(vertex.get().Id()))
     {
@@ -1107,10 +1114,9 @@ Errors validateFrameAttachedToGraph(
   }
 
   // Check number of outgoing edges for each vertex
-  auto vertices = _in.Graph().Vertices();
-  for (auto vertexPair : vertices)
+  for (const auto &vertex : _in.Graph().Vertices())
   {
-    const std::string vertexName = _in.VertexLocalName(vertexPair.second.get());
+    const std::string vertexName = _in.VertexLocalName(vertex);
     // Vertex names should not be empty
     if (vertexName.empty())
     {
@@ -1118,7 +1124,7 @@ Errors validateFrameAttachedToGraph(
           "FrameAttachedToGraph error, "
           "vertex with empty name detected."});
     }
-    auto outDegree = _in.Graph().OutDegree(vertexPair.first);
+    auto outDegree = _in.Graph().OutDegree(vertex.Id());
 
     if (outDegree > 1)
     {
@@ -1149,7 +1155,7 @@ Errors validateFrameAttachedToGraph(
     else if (sdf::FrameType::MODEL == scopeFrameType ||
         sdf::FrameType::STATIC_MODEL == scopeFrameType)
     {
-      switch (vertexPair.second.get().Data())
+      switch (vertex.Data())
       {
         case sdf::FrameType::WORLD:
           errors.push_back({ErrorCode::FRAME_ATTACHED_TO_GRAPH_ERROR,
@@ -1171,12 +1177,12 @@ Errors validateFrameAttachedToGraph(
         case sdf::FrameType::STATIC_MODEL:
           if (outDegree != 0)
           {
-            auto edges = _in.Graph().IncidentsFrom(vertexPair.first);
+            auto edges = _in.Graph().IncidentsFrom(vertex.Id());
             // Filter out alias edges (edge with a weight of 0)
             auto outDegreeNoAliases = std::count_if(
                 edges.begin(), edges.end(), [](const auto &_edge)
                 {
-                  return _edge.second.get().Weight() >= 1.0;
+                  return _edge.Weight() >= 1.0;
                 });
             if (outDegreeNoAliases)
             {
@@ -1215,7 +1221,7 @@ Errors validateFrameAttachedToGraph(
     else
     {
       // scopeFrameType must be sdf::FrameType::WORLD
-      switch (vertexPair.second.get().Data())
+      switch (vertex.Data())
       {
         case sdf::FrameType::WORLD:
           if (outDegree != 0)
@@ -1240,12 +1246,12 @@ Errors validateFrameAttachedToGraph(
         case sdf::FrameType::STATIC_MODEL:
           if (outDegree != 0)
           {
-            auto edges = _in.Graph().IncidentsFrom(vertexPair.first);
+            auto edges = _in.Graph().IncidentsFrom(vertex.Id());
             // Filter out alias edges (edge with a weight of 0)
             auto outDegreeNoAliases = std::count_if(
                 edges.begin(), edges.end(), [](const auto &_edge)
                 {
-                  return _edge.second.get().Weight() >= 1.0;
+                  return _edge.Weight() >= 1.0;
                 });
             if (outDegreeNoAliases)
             {
@@ -1331,10 +1337,9 @@ Errors validatePoseRelativeToGraph(
   }
 
   // Check number of incoming edges for each vertex
-  auto vertices = _in.Graph().Vertices();
-  for (auto vertexPair : vertices)
+  for (const auto &vertex : _in.Graph().Vertices())
   {
-    const std::string vertexName = _in.VertexLocalName(vertexPair.second.get());
+    const std::string vertexName = _in.VertexLocalName(vertex);
     // Vertex names should not be empty
     if (vertexName.empty())
     {
@@ -1343,7 +1348,7 @@ Errors validatePoseRelativeToGraph(
           "vertex with empty name detected."});
     }
 
-    std::size_t inDegree = _in.Graph().InDegree(vertexPair.first);
+    std::size_t inDegree = _in.Graph().InDegree(vertex.Id());
 
     if (inDegree > 1)
     {
@@ -1374,7 +1379,7 @@ Errors validatePoseRelativeToGraph(
     }
     else if (sdf::FrameType::MODEL == sourceFrameType)
     {
-      switch (vertexPair.second.get().Data())
+      switch (vertex.Data())
       {
         case sdf::FrameType::WORLD:
           errors.push_back({ErrorCode::POSE_RELATIVE_TO_GRAPH_ERROR,
@@ -1383,7 +1388,7 @@ Errors validatePoseRelativeToGraph(
               "should not have type WORLD in MODEL relative_to graph."});
           break;
         case sdf::FrameType::MODEL:
-          if (_in.ScopeVertexId() == vertexPair.first)
+          if (_in.ScopeVertexId() == vertex.Id())
           {
             if (inDegree != 0)
             {
@@ -1423,7 +1428,7 @@ Errors validatePoseRelativeToGraph(
     else
     {
       // sourceFrameType must be sdf::FrameType::WORLD
-      switch (vertexPair.second.get().Data())
+      switch (vertex.Data())
       {
         case sdf::FrameType::WORLD:
           if (inDegree != 1)
@@ -1472,6 +1477,384 @@ Errors validatePoseRelativeToGraph(
   return errors;
 }
 
+/////////////////////////////////////////////////
+/// \brief Get the names of the vertices that are added to the scope of a
+/// model when building its graphs.
+/// \param[in] _model The model.
+/// \param[in] _prefix Prefix of the names, for nested models.
+/// \param[out] _names Names to which the vertex names are appended.
+static void modelVertexNames(const Model *_model, const std::string &_prefix,
+    std::vector<std::string> &_names)
+{
+  _names.push_back(_prefix + "__model__");
+  for (uint64_t l = 0; l < _model->LinkCount(); ++l)
+    _names.push_back(_prefix + _model->LinkByIndex(l)->Name());
+  for (uint64_t j = 0; j < _model->JointCount(); ++j)
+    _names.push_back(_prefix + _model->JointByIndex(j)->Name());
+  for (uint64_t f = 0; f < _model->FrameCount(); ++f)
+    _names.push_back(_prefix + _model->FrameByIndex(f)->Name());
+  for (uint64_t m = 0; m < _model->ModelCount(); ++m)
+  {
+    const Model *nestedModel = _model->ModelByIndex(m);
+    _names.push_back(_prefix + nestedModel->Name());
+    modelVertexNames(nestedModel, _prefix + nestedModel->Name() + "::",
+        _names);
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Check that the part of a graph that was built for a model can be
+/// updated to match a graph built for the changed model alone: no vertex
+/// of the model is removed and none changes type.
+/// \param[in] _out Graph scoped to the parent of the model.
+/// \param[in] _new Graph built for the changed model alone.
+/// \param[in] _oldModel The model from which _out was built.
+/// \return Errors.
+template <typename T>
+static Errors checkModelSubgraph(const ScopedGraph<T> &_out,
+    const ScopedGraph<T> &_new, const Model *_oldModel)
+{
+  Errors errors;
+
+  constexpr bool kPoseGraph = std::is_same_v<T, PoseRelativeToGraph>;
+  const std::string graphName =
+      kPoseGraph ? "PoseRelativeToGraph" : "FrameAttachedToGraph";
+  const ErrorCode errorCode = kPoseGraph ?
+      ErrorCode::POSE_RELATIVE_TO_GRAPH_ERROR :
+      ErrorCode::FRAME_ATTACHED_TO_GRAPH_ERROR;
+
+  const std::string &modelName = _oldModel->Name();
+  const auto outModel = _out.ChildModelScope(modelName);
+  const auto newModel = _new.ChildModelScope(modelName);
+
+  for (const auto &vertex : _new.Graph().Vertices())
+  {
+    const auto [name, inScope] = newModel.FindAndRemovePrefix(vertex.Name());
+    if (!inScope)
+      continue;
+
+    const auto id = outModel.VertexIdByName(name);
+    if (id != ignition::math::graph::kNullId &&
+        outModel.Graph().VertexFromId(id).Data() != vertex.Data())
+    {
+      errors.push_back({errorCode, graphName + " error: the type of vertex "
+          "with name [" + name + "] changed in model with name [" +
+          modelName + "], which requires rebuilding the graph."});
+    }
+  }
+
+  std::vector<std::string> oldNames;
+  modelVertexNames(_oldModel, "", oldNames);
+  for (const auto &name : oldNames)
+  {
+    if (newModel.Count(name) != 1)
+    {
+      errors.push_back({errorCode, graphName + " error: vertex with name [" +
+          name + "] was removed from model with name [" + modelName +
+          "], which requires rebuilding the graph."});
+    }
+  }
+
+  return errors;
+}
+
+/////////////////////////////////////////////////
+/// \brief Merge a graph built for a model alone into the part of a graph
+/// that was built for the model. Vertices are matched by name, and missing
+/// ones are added. Each vertex of a PoseRelativeToGraph has one incoming
+/// edge and each vertex of a FrameAttachedToGraph has at most one outgoing
+/// edge, so edges are matched by that vertex and are updated or moved in
+/// place. Edges whose data doesn't change are left alone, so that the
+/// caches of the graph stay valid.
+/// \param[in,out] _out Graph scoped to the parent of the model.
+/// \param[in] _new Graph built for the changed model alone.
+/// \param[in] _modelName Name of the model.
+/// \param[out] _updates The edges that only need new data, and their new
+/// data. They are left to the caller, which applies them together with
+/// ScopedGraph::UpdateEdges so that the cached poses are updated once.
+template <typename T>
+static void mergeModelSubgraph(ScopedGraph<T> &_out,
+    const ScopedGraph<T> &_new, const std::string &_modelName,
+    std::vector<std::pair<ignition::math::graph::EdgeId,
+                          typename ScopedGraph<T>::EdgeType>> &_updates)
+{
+  using ignition::math::graph::VertexId;
+  using ignition::math::graph::kNullId;
+
+  constexpr bool kPoseGraph = std::is_same_v<T, PoseRelativeToGraph>;
+  auto outModel = _out.ChildModelScope(_modelName);
+  const auto newModel = _new.ChildModelScope(_modelName);
+  const auto &newGraph = _new.Graph();
+
+  // IDs in _out of the vertices of the model in _new, indexed by their IDs
+  // in _new. Vertices outside the model are kNullId.
+  std::vector<VertexId> ids(newGraph.Vertices().size(), kNullId);
+  for (const auto &vertex : newGraph.Vertices())
+  {
+    const auto [name, inScope] = newModel.FindAndRemovePrefix(vertex.Name());
+    if (!inScope)
+      continue;
+
+    VertexId id = outModel.VertexIdByName(name);
+    if (id == kNullId)
+      id = outModel.AddVertex(name, vertex.Data()).Id();
+    ids[vertex.Id()] = id;
+  }
+
+  for (const auto &newEdge : newGraph.Edges())
+  {
+    const VertexId tail = ids[newEdge.Tail()];
+    const VertexId head = ids[newEdge.Head()];
+    if (tail == kNullId || head == kNullId)
+      continue;
+
+    const auto incidents = kPoseGraph ?
+        outModel.Graph().IncidentsTo(head) :
+        outModel.Graph().IncidentsFrom(tail);
+    if (incidents.empty())
+    {
+      auto &edge = outModel.AddEdge({tail, head}, newEdge.Data());
+      edge.SetWeight(newEdge.Weight());
+      continue;
+    }
+
+    auto edge = incidents.front();
+    if (edge.Tail() != tail || edge.Head() != head)
+      outModel.UpdateEdge(edge, {tail, head}, newEdge.Data());
+    else if (!(edge.Data() == newEdge.Data()))
+      _updates.emplace_back(edge.Id(), newEdge.Data());
+  }
+}
+
+/////////////////////////////////////////////////
+Errors updateModelGraphs(
+    ScopedGraph<FrameAttachedToGraph> &_frameGraph,
+    ScopedGraph<PoseRelativeToGraph> &_poseGraph,
+    const Model *_oldModel,
+    const Model *_model)
+{
+  using ignition::math::graph::VertexId;
+
+  Errors errors;
+
+  if (!_oldModel || !_model)
+  {
+    errors.push_back({ErrorCode::ELEMENT_INVALID,
+        "Invalid sdf::Model pointer."});
+    return errors;
+  }
+
+  const std::string &modelName = _model->Name();
+  if (_oldModel->Name() != modelName)
+  {
+    errors.push_back({ErrorCode::ELEMENT_INVALID,
+        "Model with name [" + modelName + "] can't replace model with name [" +
+        _oldModel->Name() + "]."});
+    return errors;
+  }
+  if (_frameGraph.Count(modelName) != 1)
+  {
+    errors.push_back({ErrorCode::FRAME_ATTACHED_TO_GRAPH_ERROR,
+        "FrameAttachedToGraph error: model with name [" + modelName +
+        "] not found in graph."});
+  }
+  if (_poseGraph.Count(modelName) != 1)
+  {
+    errors.push_back({ErrorCode::POSE_RELATIVE_TO_GRAPH_ERROR,
+        "PoseRelativeToGraph error: model with name [" + modelName +
+        "] not found in graph."});
+  }
+  if (!errors.empty())
+    return errors;
+
+  // Build and validate the graphs of the changed model alone, which checks
+  // everything inside the model.
+  ScopedGraph<FrameAttachedToGraph> newFrameGraph(
+      std::make_shared<FrameAttachedToGraph>());
+  Errors newErrors = buildFrameAttachedToGraph(newFrameGraph, _model);
+  errors.insert(errors.end(), newErrors.begin(), newErrors.end());
+  newErrors = validateFrameAttachedToGraph(newFrameGraph);
+  errors.insert(errors.end(), newErrors.begin(), newErrors.end());
+
+  ScopedGraph<PoseRelativeToGraph> newPoseGraph(
+      std::make_shared<PoseRelativeToGraph>());
+  newErrors = buildPoseRelativeToGraph(newPoseGraph, _model);
+  errors.insert(errors.end(), newErrors.begin(), newErrors.end());
+  newErrors = validatePoseRelativeToGraph(newPoseGraph);
+  errors.insert(errors.end(), newErrors.begin(), newErrors.end());
+  if (!errors.empty())
+    return errors;
+
+  errors = checkModelSubgraph(_frameGraph, newFrameGraph, _oldModel);
+  newErrors = checkModelSubgraph(_poseGraph, newPoseGraph, _oldModel);
+  errors.insert(errors.end(), newErrors.begin(), newErrors.end());
+
+  // The pose of the model is relative to a frame of the parent scope, which
+  // must not itself be relative to the model.
+  const VertexId modelId = _poseGraph.VertexIdByName(modelName);
+  if (_poseGraph.Graph().InDegree(modelId) != 1)
+  {
+    errors.push_back({ErrorCode::POSE_RELATIVE_TO_GRAPH_ERROR,
+        "PoseRelativeToGraph error: model with name [" + modelName +
+        "] should have 1 incoming edge."});
+    return errors;
+  }
+
+  const std::string &relativeTo = _model->PoseRelativeTo();
+  VertexId relativeToId = _poseGraph.ScopeVertexId();
+  if (!relativeTo.empty())
+  {
+    if (_poseGraph.Count(relativeTo) != 1)
+    {
+      errors.push_back({ErrorCode::POSE_RELATIVE_TO_INVALID,
+          "relative_to name[" + relativeTo +
+          "] specified by model with name[" + modelName +
+          "] does not match a model or frame name in the scope of the "
+          "model."});
+      return errors;
+    }
+    relativeToId = _poseGraph.VertexIdByName(relativeTo);
+  }
+
+  const auto source = FindSourceVertex(_poseGraph, relativeToId, errors);
+  const bool cycle = relativeToId == modelId || std::any_of(
+      source.second.begin(), source.second.end(), [&](const auto &_edge)
+      {
+        return _edge.Tail() == modelId;
+      });
+  if (cycle)
+  {
+    errors.push_back({ErrorCode::POSE_RELATIVE_TO_CYCLE,
+        "relative_to name[" + relativeTo +
+        "] specified by model with name[" + modelName +
+        "] is relative to the model, causing a graph cycle."});
+  }
+  else if (errors.empty() && !source.first.Valid())
+  {
+    errors.push_back({ErrorCode::POSE_RELATIVE_TO_GRAPH_ERROR,
+        "PoseRelativeToGraph error: unable to resolve pose of relative_to "
+        "frame [" + relativeTo + "] of model with name [" + modelName +
+        "]."});
+  }
+  if (!errors.empty())
+    return errors;
+
+  std::vector<std::pair<ignition::math::graph::EdgeId, bool>> frameUpdates;
+  mergeModelSubgraph(_frameGraph, newFrameGraph, modelName, frameUpdates);
+  _frameGraph.UpdateEdges(frameUpdates);
+
+  std::vector<std::pair<ignition::math::graph::EdgeId, ignition::math::Pose3d>>
+      poseUpdates;
+  mergeModelSubgraph(_poseGraph, newPoseGraph, modelName, poseUpdates);
+
+  // The graph built for the model alone holds the pose of the model,
+  // including its placement frame, relative to its __root__ vertex.
+  const auto &newModelEdge = newPoseGraph.Graph().IncidentsTo(
+      newPoseGraph.VertexIdByName(modelName)).front();
+  auto edge = _poseGraph.Graph().IncidentsTo(modelId).front();
+  if (edge.Tail() != relativeToId)
+  {
+    _poseGraph.UpdateEdge(edge, {relativeToId, modelId}, newModelEdge.Data());
+  }
+  else if (!(edge.Data() == newModelEdge.Data()))
+  {
+    poseUpdates.emplace_back(edge.Id(), newModelEdge.Data());
+  }
+
+  // The poses cached below all the changed edges, which may be the whole
+  // model, are updated once.
+  _poseGraph.UpdateEdges(poseUpdates);
+  return errors;
+}
+
+/////////////////////////////////////////////////
+/// \brief Find the sink vertex of every vertex of a FrameAttachedToGraph in
+/// one pass. The edges are followed from each vertex until a vertex whose
+/// sink is already known, and the sink is then recorded for every vertex on
+/// the path, so that each vertex is visited once.
+/// \param[in] _graph Graph to read from.
+/// \param[out] _cache Cache to fill.
+static void updateAttachedToSinkCache(
+    const FrameAttachedToGraph::GraphType &_graph,
+    AttachedToSinkCache &_cache)
+{
+  using ignition::math::graph::VertexId;
+  using ignition::math::graph::kNullId;
+
+  const std::size_t size = _graph.Vertices().size();
+
+  enum class State : char { UNVISITED, ON_PATH, DONE };
+  std::vector<State> states(size, State::UNVISITED);
+  _cache.sinks.assign(size, kNullId);
+
+  std::vector<VertexId> path;
+  for (VertexId start = 0; start < size; ++start)
+  {
+    VertexId id = start;
+    VertexId sink = kNullId;
+    path.clear();
+    while (true)
+    {
+      if (states[id] == State::DONE)
+      {
+        sink = _cache.sinks[id];
+        break;
+      }
+      if (states[id] == State::ON_PATH)
+      {
+        // Cycle.
+        break;
+      }
+
+      states[id] = State::ON_PATH;
+      path.push_back(id);
+
+      const auto incidentsFrom = _graph.IncidentsFrom(id);
+      if (incidentsFrom.empty())
+      {
+        sink = id;
+        break;
+      }
+      if (incidentsFrom.size() != 1)
+      {
+        // Multiple outgoing edges.
+        break;
+      }
+      id = incidentsFrom.front().Head();
+    }
+
+    for (const VertexId pathId : path)
+    {
+      _cache.sinks[pathId] = sink;
+      states[pathId] = State::DONE;
+    }
+  }
+
+  _cache.valid = true;
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the sink vertex of a vertex of a FrameAttachedToGraph from
+/// the graph's cache of sinks, which is updated first if the graph has
+/// changed.
+/// \param[in] _graph Graph to read from.
+/// \param[in] _id Vertex whose sink is returned.
+/// \return ID of the sink vertex, or kNullId if the sink can't be found
+/// without errors.
+static ignition::math::graph::VertexId cachedSinkVertex(
+    const ScopedGraph<FrameAttachedToGraph> &_graph,
+    ignition::math::graph::VertexId _id)
+{
+  AttachedToSinkCache &cache = _graph.GraphData().sinks;
+  std::lock_guard<std::mutex> lock(cache.mutex);
+  if (!cache.valid)
+    updateAttachedToSinkCache(_graph.Graph(), cache);
+
+  if (_id >= cache.sinks.size())
+    return ignition::math::graph::kNullId;
+  return cache.sinks[_id];
+}
+
 /////////////////////////////////////////////////
 Errors resolveFrameAttachedToBody(
     std::string &_attachedToBody,
@@ -1498,8 +1881,12 @@ Errors resolveFrameAttachedToBody(
   }
   auto vertexId = _in.VertexIdByName(_vertexName);
 
-  auto sinkVertexEdges = FindSinkVertex(_in, vertexId, errors);
-  auto sinkVertex = sinkVertexEdges.first;
+  // The sinks of all the vertices are found at once and cached. The graph
+  // is only traversed from this vertex to report errors.
+  const auto sinkId = cachedSinkVertex(_in, vertexId);
+  auto sinkVertex = sinkId != ignition::math::graph::kNullId ?
+      _in.Graph().VertexFromId(sinkId) :
+      FindSinkVertex(_in, vertexId, errors).first;
 
   if (!errors.empty())
   {
@@ -1554,6 +1941,184 @@ Errors resolveFrameAttachedToBody(
   return errors;
 }
 
+/////////////////////////////////////////////////
+/// \brief Compute the poses of all the vertices of a PoseRelativeToGraph
+/// relative to the source vertex of their tree in one depth-first pass.
+/// \param[in] _graph Graph to read from.
+/// \param[out] _cache Cache to fill.
+static void updateRootPoseCache(const PoseRelativeToGraph::GraphType &_graph,
+    RootPoseCache &_cache)
+{
+  using ignition::math::graph::VertexId;
+
+  const std::size_t size = _graph.Vertices().size();
+
+  _cache.poses.assign(size, ignition::math::Pose3d::Zero);
+  _cache.first.assign(size, RootPoseCache::kUnresolved);
+  _cache.last.assign(size, RootPoseCache::kUnresolved);
+
+  // Vertices on the path from the source to the current vertex, paired with
+  // their next outgoing edge to visit.
+  using EdgeIterator =
+      PoseRelativeToGraph::GraphType::EdgeRange::const_iterator;
+  std::vector<std::pair<VertexId, EdgeIterator>> stack;
+  std::size_t count = 0;
+
+  for (VertexId source = 0; source < size; ++source)
+  {
+    if (_graph.InDegree(source) != 0)
+      continue;
+
+    _cache.first[source] = count++;
+    stack.emplace_back(source, _graph.IncidentsFrom(source).begin());
+    while (!stack.empty())
+    {
+      auto &top = stack.back();
+      if (top.second == EdgeIterator())
+      {
+        _cache.last[top.first] = count - 1;
+        stack.pop_back();
+        continue;
+      }
+
+      const auto &edge = *top.second;
+      ++top.second;
+
+      // Vertices with several incoming edges can't be resolved.
+      const VertexId child = edge.Head();
+      if (_graph.InDegree(child) != 1)
+        continue;
+
+      _cache.poses[child] = _cache.poses[edge.Tail()] * edge.Data();
+      _cache.first[child] = count++;
+      stack.emplace_back(child, _graph.IncidentsFrom(child).begin());
+    }
+  }
+
+  _cache.valid = true;
+}
+
+/////////////////////////////////////////////////
+void RootPoseCache::UpdatePoses(
+    const FlatDirectedGraph<FrameType, ignition::math::Pose3d> &_graph,
+    const std::vector<ignition::math::graph::VertexId> &_ids)
+{
+  using ignition::math::graph::VertexId;
+
+  std::lock_guard<std::mutex> lock(this->mutex);
+  if (!this->valid)
+    return;
+
+  // Vertices that weren't resolved still can't be. The others are updated
+  // in depth-first order, so that a vertex below one that was already
+  // updated can be skipped.
+  std::vector<VertexId> ids;
+  for (const VertexId id : _ids)
+  {
+    if (id < this->first.size() && this->first[id] != kUnresolved)
+      ids.push_back(id);
+  }
+  std::sort(ids.begin(), ids.end(), [this](VertexId _a, VertexId _b)
+      {
+        return this->first[_a] < this->first[_b];
+      });
+
+  std::vector<VertexId> stack;
+  std::size_t updatedLast = 0;
+  bool updated = false;
+  for (const VertexId id : ids)
+  {
+    if (updated && this->first[id] <= updatedLast)
+      continue;
+
+    const auto incidentsTo = _graph.IncidentsTo(id);
+    if (incidentsTo.size() != 1)
+    {
+      this->valid = false;
+      return;
+    }
+    const auto &edge = incidentsTo.front();
+    this->poses[id] = this->poses[edge.Tail()] * edge.Data();
+
+    // Visit the descendants the same way as updateRootPoseCache.
+    stack.push_back(id);
+    while (!stack.empty())
+    {
+      const VertexId parent = stack.back();
+      stack.pop_back();
+      for (const auto &childEdge : _graph.IncidentsFrom(parent))
+      {
+        const VertexId child = childEdge.Head();
+        if (_graph.InDegree(child) != 1)
+          continue;
+        this->poses[child] = this->poses[parent] * childEdge.Data();
+        stack.push_back(child);
+      }
+    }
+
+    updatedLast = this->last[id];
+    updated = true;
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Check whether a vertex was resolved in a cache of root poses and
+/// is a descendant of a scope vertex.
+/// \param[in] _cache Up to date cache.
+/// \param[in] _scopeId Scope vertex.
+/// \param[in] _id Vertex to check.
+/// \return True if the pose of the vertex relative to the scope vertex can
+/// be computed from the cache.
+static bool inCachedScope(const RootPoseCache &_cache,
+    ignition::math::graph::VertexId _scopeId,
+    ignition::math::graph::VertexId _id)
+{
+  return _scopeId < _cache.first.size() && _id < _cache.first.size() &&
+      _cache.first[_scopeId] != RootPoseCache::kUnresolved &&
+      _cache.first[_id] != RootPoseCache::kUnresolved &&
+      _cache.first[_scopeId] <= _cache.first[_id] &&
+      _cache.first[_id] <= _cache.last[_scopeId];
+}
+
+/////////////////////////////////////////////////
+/// \brief Resolve the pose of a vertex relative to another vertex in the
+/// scope of a PoseRelativeToGraph using the graph's cache of root poses,
+/// which is updated first if the graph has changed.
+/// \param[out] _pose Resolved pose.
+/// \param[in] _graph Graph to read from.
+/// \param[in] _vertexId Vertex whose pose is resolved.
+/// \param[in] _resolveToId Vertex relative to which the pose is resolved,
+/// or kNullId to resolve it relative to the scope vertex.
+/// \return False if the pose can't be resolved from the cache, in which
+/// case the graph has to be traversed to resolve it or to report errors.
+static bool resolveCachedPose(ignition::math::Pose3d &_pose,
+    const ScopedGraph<PoseRelativeToGraph> &_graph,
+    ignition::math::graph::VertexId _vertexId,
+    ignition::math::graph::VertexId _resolveToId)
+{
+  const ignition::math::graph::VertexId scopeId = _graph.ScopeVertexId();
+  if (_resolveToId == ignition::math::graph::kNullId)
+    _resolveToId = scopeId;
+
+  RootPoseCache &cache = _graph.GraphData().rootPoses;
+  std::lock_guard<std::mutex> lock(cache.mutex);
+  if (!cache.valid)
+    updateRootPoseCache(_graph.Graph(), cache);
+
+  // Both vertices have to be descendants of the scope vertex.
+  if (!inCachedScope(cache, scopeId, _vertexId) ||
+      !inCachedScope(cache, scopeId, _resolveToId))
+  {
+    return false;
+  }
+
+  if (_vertexId == _resolveToId)
+    _pose = ignition::math::Pose3d::Zero;
+  else
+    _pose = cache.poses[_resolveToId].Inverse() * cache.poses[_vertexId];
+  return true;
+}
+
 /////////////////////////////////////////////////
 Errors resolvePoseRelativeToRoot(
       ignition::math::Pose3d &_pose,
@@ -1581,6 +2146,12 @@ Errors resolvePoseRelativeToRoot(
 {
   Errors errors;
 
+  if (resolveCachedPose(_pose, _graph, _vertexId,
+                        ignition::math::graph::kNullId))
+  {
+    return errors;
+  }
+
   auto incomingVertexEdges = FindSourceVertex(_graph, _vertexId, errors);
 
   if (!errors.empty())
@@ -1625,6 +2196,9 @@ Errors resolvePose(ignition::math::Pose3d &_pose,
     const ignition::math::graph::VertexId &_frameVertexId,
     const ignition::math::graph::VertexId &_resolveToVertexId)
 {
+  if (resolveCachedPose(_pose, _graph, _frameVertexId, _resolveToVertexId))
+    return Errors();
+
   Errors errors = resolvePoseRelativeToRoot(_pose, _graph, _frameVertexId);
 
   // If the resolveTo is empty, we're resolving to the Root, so we're done
@@ -1670,5 +2244,259 @@ Errors resolvePose(
   return resolvePose(_pose, _graph, _graph.VertexIdByName(_frameName),
       _graph.VertexIdByName(_resolveTo));
 }
+/////////////////////////////////////////////////
+/// \brief An object whose pose is resolved by resolvePoses.
+struct PoseQuery
+{
+  /// \brief Scoped name of the object.
+  std::string name;
+
+  /// \brief Type of the object.
+  ResolvedPoses::PoseType type;
+
+  /// \brief Name of the vertex of the object, or of the frame relative to
+  /// which its raw pose is defined if it has no vertex.
+  std::string frame;
+
+  /// \brief True if the object has no vertex in the graph, in which case
+  /// its raw pose is composed with the pose of the frame.
+  bool hasRawPose;
+
+  /// \brief Raw pose of the object, if it has no vertex.
+  ignition::math::Pose3d rawPose;
+};
+
+/////////////////////////////////////////////////
+/// \brief Add a query for an object whose pose is defined relative to a
+/// frame of a link, such as a collision or a visual.
+/// \param[out] _queries Queries to add to.
+/// \param[in] _prefix Scope prefix of the link's model.
+/// \param[in] _linkName Name of the link.
+/// \param[in] _type Type of the object.
+/// \param[in] _object The object.
+template <typename T>
+static void addLinkChildQuery(std::vector<PoseQuery> &_queries,
+    const std::string &_prefix, const std::string &_linkName,
+    ResolvedPoses::PoseType _type, const T *_object)
+{
+  const std::string &relativeTo = _object->PoseRelativeTo();
+  _queries.push_back({_prefix + _linkName + "::" + _object->Name(), _type,
+      _prefix + (relativeTo.empty() ? _linkName : relativeTo), true,
+      _object->RawPose()});
+}
+
+/////////////////////////////////////////////////
+/// \brief Add queries for the contents of a model and its nested models.
+/// \param[out] _queries Queries to add to.
+/// \param[in] _prefix Scope prefix of the model, relative to the scope in
+/// which the poses are resolved, including the trailing "::".
+/// \param[in] _model The model.
+static void addModelQueries(std::vector<PoseQuery> &_queries,
+    const std::string &_prefix, const Model *_model)
+{
+  using PoseType = ResolvedPoses::PoseType;
+
+  for (uint64_t l = 0; l < _model->LinkCount(); ++l)
+  {
+    const Link *link = _model->LinkByIndex(l);
+    _queries.push_back({_prefix + link->Name(), PoseType::LINK,
+        _prefix + link->Name(), false, {}});
+
+    for (uint64_t i = 0; i < link->CollisionCount(); ++i)
+    {
+      addLinkChildQuery(_queries, _prefix, link->Name(), PoseType::COLLISION,
+          link->CollisionByIndex(i));
+    }
+    for (uint64_t i = 0; i < link->VisualCount(); ++i)
+    {
+      addLinkChildQuery(_queries, _prefix, link->Name(), PoseType::VISUAL,
+          link->VisualByIndex(i));
+    }
+    for (uint64_t i = 0; i < link->SensorCount(); ++i)
+    {
+      addLinkChildQuery(_queries, _prefix, link->Name(), PoseType::SENSOR,
+          link->SensorByIndex(i));
+    }
+    for (uint64_t i = 0; i < link->LightCount(); ++i)
+    {
+      addLinkChildQuery(_queries, _prefix, link->Name(), PoseType::LIGHT,
+          link->LightByIndex(i));
+    }
+  }
+
+  for (uint64_t j = 0; j < _model->JointCount(); ++j)
+  {
+    const Joint *joint = _model->JointByIndex(j);
+    _queries.push_back({_prefix + joint->Name(), PoseType::JOINT,
+        _prefix + joint->Name(), false, {}});
+  }
+
+  for (uint64_t f = 0; f < _model->FrameCount(); ++f)
+  {
+    const Frame *frame = _model->FrameByIndex(f);
+    _queries.push_back({_prefix + frame->Name(), PoseType::FRAME,
+        _prefix + frame->Name(), false, {}});
+  }
+
+  for (uint64_t m = 0; m < _model->ModelCount(); ++m)
+  {
+    const Model *nestedModel = _model->ModelByIndex(m);
+    _queries.push_back({_prefix + nestedModel->Name(), PoseType::MODEL,
+        _prefix + nestedModel->Name(), false, {}});
+    addModelQueries(_queries, _prefix + nestedModel->Name() + "::",
+        nestedModel);
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Resolve the poses of a list of objects relative to a frame. The
+/// poses of all the vertices are read from the graph's cache of root poses,
+/// which is computed in a single pass over the graph; only vertices that
+/// can't be resolved from the cache are resolved one by one, to report
+/// errors.
+/// \param[out] _poses Resolved poses.
+/// \param[in] _graph Graph to read from.
+/// \param[in] _queries Objects whose poses are resolved.
+/// \param[in] _resolveTo Name of the frame relative to which the poses are
+/// resolved.
+/// \return Errors.
+static Errors resolvePoseQueries(ResolvedPoses &_poses,
+    const ScopedGraph<PoseRelativeToGraph> &_graph,
+    const std::vector<PoseQuery> &_queries,
+    const std::string &_resolveTo)
+{
+  using ignition::math::graph::VertexId;
+
+  Errors errors;
+  _poses.Clear();
+  _poses.SetResolveTo(_resolveTo);
+
+  if (!_graph)
+  {
+    errors.push_back({ErrorCode::POSE_RELATIVE_TO_GRAPH_ERROR,
+        "Invalid pointer to PoseRelativeToGraph."});
+    return errors;
+  }
+
+  if (_graph.Count(_resolveTo) != 1)
+  {
+    errors.push_back({ErrorCode::POSE_RELATIVE_TO_INVALID,
+        "PoseRelativeToGraph unable to find unique frame with name [" +
+        _resolveTo + "] in graph."});
+    return errors;
+  }
+  const VertexId resolveToId = _graph.VertexIdByName(_resolveTo);
+
+  std::vector<VertexId> ids(_queries.size(), ignition::math::graph::kNullId);
+  for (std::size_t i = 0; i < _queries.size(); ++i)
+  {
+    if (_graph.Count(_queries[i].frame) != 1)
+    {
+      errors.push_back({ErrorCode::POSE_RELATIVE_TO_INVALID,
+          "PoseRelativeToGraph unable to find unique frame with name [" +
+          _queries[i].frame + "] in graph."});
+      continue;
+    }
+    ids[i] = _graph.VertexIdByName(_queries[i].frame);
+  }
+
+  std::vector<ignition::math::Pose3d> poses(_queries.size());
+  std::vector<bool> cached(_queries.size(), false);
+  {
+    const VertexId scopeId = _graph.ScopeVertexId();
+    RootPoseCache &cache = _graph.GraphData().rootPoses;
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    if (!cache.valid)
+      updateRootPoseCache(_graph.Graph(), cache);
+
+    if (inCachedScope(cache, scopeId, resolveToId))
+    {
+      const ignition::math::Pose3d inverse =
+          cache.poses[resolveToId].Inverse();
+      for (std::size_t i = 0; i < _queries.size(); ++i)
+      {
+        if (ids[i] == resolveToId)
+        {
+          cached[i] = true;
+        }
+        else if (inCachedScope(cache, scopeId, ids[i]))
+        {
+          poses[i] = inverse * cache.poses[ids[i]];
+          cached[i] = true;
+        }
+      }
+    }
+  }
+
+  _poses.Reserve(_queries.size());
+  for (std::size_t i = 0; i < _queries.size(); ++i)
+  {
+    if (ids[i] == ignition::math::graph::kNullId)
+      continue;
+
+    if (!cached[i])
+    {
+      Errors poseErrors = resolvePose(poses[i], _graph, ids[i], resolveToId);
+      if (!poseErrors.empty())
+      {
+        errors.insert(errors.end(), poseErrors.begin(), poseErrors.end());
+        continue;
+      }
+    }
+
+    if (_queries[i].hasRawPose)
+      poses[i] *= _queries[i].rawPose;
+    _poses.Add(_queries[i].name, _queries[i].type, poses[i]);
+  }
+
+  return errors;
+}
+
+/////////////////////////////////////////////////
+Errors resolvePoses(ResolvedPoses &_poses,
+    const ScopedGraph<PoseRelativeToGraph> &_graph,
+    const Model *_model, const std::string &_resolveTo)
+{
+  std::vector<PoseQuery> queries;
+  if (_model)
+    addModelQueries(queries, "", _model);
+  return resolvePoseQueries(_poses, _graph, queries, _resolveTo);
+}
+
+/////////////////////////////////////////////////
+Errors resolvePoses(ResolvedPoses &_poses,
+    const ScopedGraph<PoseRelativeToGraph> &_graph,
+    const World *_world, const std::string &_resolveTo)
+{
+  using PoseType = ResolvedPoses::PoseType;
+
+  std::vector<PoseQuery> queries;
+  if (_world)
+  {
+    for (uint64_t m = 0; m < _world->ModelCount(); ++m)
+    {
+      const Model *model = _world->ModelByIndex(m);
+      queries.push_back({model->Name(), PoseType::MODEL, model->Name(),
+          false, {}});
+      addModelQueries(queries, model->Name() + "::", model);
+    }
+
+    for (uint64_t f = 0; f < _world->FrameCount(); ++f)
+    {
+      const Frame *frame = _world->FrameByIndex(f);
+      queries.push_back({frame->Name(), PoseType::FRAME, frame->Name(),
+          false, {}});
+    }
+
+    for (uint64_t l = 0; l < _world->LightCount(); ++l)
+    {
+      const Light *light = _world->LightByIndex(l);
+      const std::string &relativeTo = light->PoseRelativeTo();
+      queries.push_back({light->Name(), PoseType::LIGHT,
+          relativeTo.empty() ? "world" : relativeTo, true, light->RawPose()});
+    }
+  }
+  return resolvePoseQueries(_poses, _graph, queries, _resolveTo);
+}
 }
 }
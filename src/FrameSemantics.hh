@@ -17,16 +17,22 @@
 #ifndef SDF_FRAMESEMANTICS_HH_
 #define SDF_FRAMESEMANTICS_HH_
 
-#include <map>
+#include <cstddef>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 #include <ignition/math/Pose3.hh>
 #include <ignition/math/graph/Graph.hh>
 
 #include "sdf/Error.hh"
+#include "sdf/ResolvedPoses.hh"
 #include "sdf/Types.hh"
 
+#include "FlatDirectedGraph.hh"
+
 /// \ingroup sdf_frame_semantics
 /// \brief namespace for Simulation Description Format Frame Semantics Utilities
 ///
@@ -72,41 +78,147 @@ namespace sdf
     STATIC_MODEL = 5,
   };
 
+  /// \brief Data derived from a graph and cached with it. The cache is
+  /// updated by const functions, so it is protected by a mutex. It is not
+  /// copied along with the graph; a copy starts out empty and invalid.
+  /// \tparam Data The cached data.
+  template <typename Data>
+  struct GraphCache : public Data
+  {
+    /// \brief Default constructor.
+    GraphCache() = default;
+
+    /// \brief Copy constructor. The copy starts out empty.
+    GraphCache(const GraphCache &)
+      : Data()
+    {
+    }
+
+    /// \brief Assignment operator. Discards the cached data.
+    /// \return *this
+    GraphCache &operator=(const GraphCache &)
+    {
+      this->Invalidate();
+      return *this;
+    }
+
+    /// \brief Discard the cached data, for example after the graph has
+    /// been modified.
+    void Invalidate()
+    {
+      std::lock_guard<std::mutex> lock(this->mutex);
+      this->valid = false;
+    }
+
+    /// \brief Protects the cache, which is updated by const functions.
+    std::mutex mutex;
+
+    /// \brief True if the cached data is up to date.
+    bool valid = false;
+  };
+
+  /// \brief The sink vertex of each vertex of a FrameAttachedToGraph, found
+  /// by following its outgoing edges. The sinks of all the vertices are
+  /// found in a single pass over the graph the first time an attached-to
+  /// body is resolved after the graph changed; each vertex is visited once
+  /// and cycles are detected once for the whole graph.
+  struct AttachedToSinks
+  {
+    /// \brief Sink vertex of each vertex, indexed by vertex ID. It is
+    /// kNullId for vertices whose edges lead to a cycle or to a vertex with
+    /// several outgoing edges.
+    std::vector<ignition::math::graph::VertexId> sinks;
+  };
+
+  /// \brief Cache of the sink vertices of a FrameAttachedToGraph.
+  using AttachedToSinkCache = GraphCache<AttachedToSinks>;
+
   /// \brief Data structure for frame attached_to graphs for Model or World.
   struct FrameAttachedToGraph
   {
-    /// \brief A DirectedGraph with a vertex for each frame and edges pointing
-    /// to the frame to which another frame is attached. Each vertex stores
-    /// its FrameType and each edge can store a boolean value.
-    using GraphType = ignition::math::graph::DirectedGraph<FrameType, bool>;
+    /// \brief A directed graph with a vertex for each frame and edges
+    /// pointing to the frame to which another frame is attached. Each vertex
+    /// stores its FrameType and each edge can store a boolean value.
+    using GraphType = FlatDirectedGraph<FrameType, bool>;
     GraphType graph;
 
     /// \brief A Map from Vertex names to Vertex Ids.
-    using MapType = std::map<std::string, ignition::math::graph::VertexId>;
+    using MapType =
+        std::unordered_map<std::string, ignition::math::graph::VertexId>;
     MapType map;
 
     /// \brief Name of scope vertex, either __model__ or world.
     std::string scopeName;
+
+    /// \brief Sink vertices of the vertices. It is invalidated by
+    /// ScopedGraph whenever the graph is modified.
+    mutable AttachedToSinkCache sinks;
+  };
+
+  /// \brief Poses of the vertices of a PoseRelativeToGraph relative to the
+  /// source vertex of their tree, computed in a single depth-first pass over
+  /// the graph the first time a pose is resolved after the graph changed.
+  /// The arrays are indexed by vertex ID. Only vertices that can be reached
+  /// from a source vertex through vertices with exactly one incoming edge
+  /// are resolved; the others are left to resolvePoseRelativeToRoot, which
+  /// reports the errors in the graph.
+  struct RootPoses
+  {
+    /// \brief Pose of each vertex relative to the source of its tree.
+    std::vector<ignition::math::Pose3d> poses;
+
+    /// \brief Position of each vertex in the depth-first order, or
+    /// kUnresolved if the vertex was not resolved.
+    std::vector<std::size_t> first;
+
+    /// \brief Position of the last descendant of each vertex in the
+    /// depth-first order. A vertex B is a descendant of a vertex A if
+    /// first[A] <= first[B] <= last[A].
+    std::vector<std::size_t> last;
+
+    /// \brief Value of first for unresolved vertices.
+    static constexpr std::size_t kUnresolved = static_cast<std::size_t>(-1);
+  };
+
+  /// \brief Cache of the poses of the vertices of a PoseRelativeToGraph
+  /// relative to the source vertex of their tree.
+  struct RootPoseCache : public GraphCache<RootPoses>
+  {
+    /// \brief Update the poses of some vertices and of their descendants
+    /// after the data of the edges into the vertices changed, without
+    /// changing the shape of the graph. Each vertex is updated once, even if
+    /// it is below several of the vertices, so the cost is linear in the
+    /// number of updated vertices.
+    /// \param[in] _graph The graph, with the updated edges.
+    /// \param[in] _ids The head vertices of the updated edges.
+    void UpdatePoses(
+        const FlatDirectedGraph<FrameType, ignition::math::Pose3d> &_graph,
+        const std::vector<ignition::math::graph::VertexId> &_ids);
   };
 
   /// \brief Data structure for pose relative_to graphs for Model or World.
   struct PoseRelativeToGraph
   {
-    /// \brief A DirectedGraph with a vertex for each explicit or implicit
+    /// \brief A directed graph with a vertex for each explicit or implicit
     /// frame and edges pointing to a given frame from its relative-to frame.
     /// When well-formed, it should form a directed tree with a root vertex
     /// named __model__ or world. Each vertex stores its FrameType and each edge
     /// stores the Pose3 between those frames.
     using Pose3d = ignition::math::Pose3d;
-    using GraphType = ignition::math::graph::DirectedGraph<FrameType, Pose3d>;
+    using GraphType = FlatDirectedGraph<FrameType, Pose3d>;
     GraphType graph;
 
     /// \brief A Map from Vertex names to Vertex Ids.
-    using MapType = std::map<std::string, ignition::math::graph::VertexId>;
+    using MapType =
+        std::unordered_map<std::string, ignition::math::graph::VertexId>;
     MapType map;
 
     /// \brief Name of source vertex, either __model__ or world.
     std::string sourceName;
+
+    /// \brief Poses of the vertices relative to their source vertex. It is
+    /// invalidated by ScopedGraph whenever the graph is modified.
+    mutable RootPoseCache rootPoses;
   };
 
   /// \brief Build a FrameAttachedToGraph for a model.
@@ -152,6 +264,28 @@ namespace sdf
   Errors validatePoseRelativeToGraph(
       const ScopedGraph<PoseRelativeToGraph> &_in);
 
+  /// \brief Update the parts of the FrameAttachedToGraph and
+  /// PoseRelativeToGraph that were built for a model after the model changed,
+  /// without rebuilding the rest of the graphs. Graphs are built and
+  /// validated for the changed model alone and merged into the graphs under
+  /// the model's ChildModelScope, and the pose of the model relative to its
+  /// parent scope is updated, so the cost depends on the size of the model
+  /// but not on the size of the graphs. Frames can be moved and added, but
+  /// removing a frame or changing its type, for example by making the model
+  /// static, requires rebuilding the graphs.
+  /// \param[in,out] _frameGraph FrameAttachedToGraph scoped to the parent
+  /// of the model, which is a world or a model.
+  /// \param[in,out] _poseGraph PoseRelativeToGraph scoped to the parent of
+  /// the model.
+  /// \param[in] _oldModel The model from which the graphs were built.
+  /// \param[in] _model The changed model, with the same name.
+  /// \return Errors. The graphs are not modified if there are errors.
+  Errors updateModelGraphs(
+      ScopedGraph<FrameAttachedToGraph> &_frameGraph,
+      ScopedGraph<PoseRelativeToGraph> &_poseGraph,
+      const Model *_oldModel,
+      const Model *_model);
+
   /// \brief Resolve the attached-to body for a given frame. Following the
   /// edges of the frame attached-to graph from a given frame must lead
   /// to a link or world frame.
@@ -201,6 +335,40 @@ namespace sdf
       const ScopedGraph<PoseRelativeToGraph> &_graph,
       const ignition::math::graph::VertexId &_frameVertexId,
       const ignition::math::graph::VertexId &_resolveToVertexId);
+
+  /// \brief Resolve the poses of all the links, joints, frames and nested
+  /// models of a model, and of the collisions, visuals, sensors and lights
+  /// of its links, relative to a frame in the scope of the model. The poses
+  /// are computed from a single pass over the graph.
+  /// \param[out] _poses Resolved poses. Objects whose pose can't be resolved
+  /// are left out.
+  /// \param[in] _graph PoseRelativeToGraph scoped to the model.
+  /// \param[in] _model Model whose poses are resolved.
+  /// \param[in] _resolveTo Name of the frame relative to which the poses
+  /// are resolved.
+  /// \return Errors.
+  Errors resolvePoses(
+      ResolvedPoses &_poses,
+      const ScopedGraph<PoseRelativeToGraph> &_graph,
+      const Model *_model,
+      const std::string &_resolveTo);
+
+  /// \brief Resolve the poses of all the models, frames and lights of a
+  /// world, and of the contents of its models, relative to a frame in the
+  /// scope of the world. The poses are computed from a single pass over the
+  /// graph.
+  /// \param[out] _poses Resolved poses. Objects whose pose can't be resolved
+  /// are left out.
+  /// \param[in] _graph PoseRelativeToGraph scoped to the world.
+  /// \param[in] _world World whose poses are resolved.
+  /// \param[in] _resolveTo Name of the frame relative to which the poses
+  /// are resolved.
+  /// \return Errors.
+  Errors resolvePoses(
+      ResolvedPoses &_poses,
+      const ScopedGraph<PoseRelativeToGraph> &_graph,
+      const World *_world,
+      const std::string &_resolveTo);
   }
 }
 #endif
@@ -103,6 +103,54 @@ TEST(FrameSemantics, buildFrameAttachedToGraph_Model)
         "invalid] in graph."));
 }
 
+/////////////////////////////////////////////////
+TEST(FrameSemantics, FrameAttachedToGraphCache)
+{
+  const std::string testFile =
+    sdf::filesystem::append(PROJECT_SOURCE_PATH, "test", "sdf",
+        "model_frame_attached_to.sdf");
+
+  sdf::Root root;
+  EXPECT_TRUE(root.Load(testFile).empty());
+  const sdf::Model *model = root.ModelByIndex(0);
+
+  auto ownedGraph = std::make_shared<sdf::FrameAttachedToGraph>();
+  sdf::ScopedGraph<sdf::FrameAttachedToGraph> graph(ownedGraph);
+  EXPECT_TRUE(sdf::buildFrameAttachedToGraph(graph, model).empty());
+  graph = graph.ChildModelScope(model->Name());
+  EXPECT_FALSE(ownedGraph->sinks.valid);
+
+  std::string resolvedBody;
+  EXPECT_TRUE(
+    sdf::resolveFrameAttachedToBody(resolvedBody, graph, "F2").empty());
+  EXPECT_EQ("L", resolvedBody);
+  EXPECT_TRUE(ownedGraph->sinks.valid);
+
+  // Adding a vertex and an edge invalidates the cached sinks.
+  graph.AddVertex("L2", sdf::FrameType::LINK);
+  EXPECT_FALSE(ownedGraph->sinks.valid);
+  EXPECT_TRUE(
+    sdf::resolveFrameAttachedToBody(resolvedBody, graph, "L2").empty());
+  EXPECT_EQ("L2", resolvedBody);
+
+  // A frame attached to two frames has no sink. Neither do the frames
+  // attached to it, and the errors are the same as without the cache.
+  graph.AddEdge(
+      {graph.VertexIdByName("F1"), graph.VertexIdByName("L2")}, true);
+  EXPECT_FALSE(ownedGraph->sinks.valid);
+  sdf::Errors errors =
+      sdf::resolveFrameAttachedToBody(resolvedBody, graph, "F1");
+  ASSERT_EQ(1u, errors.size());
+  EXPECT_EQ(sdf::ErrorCode::FRAME_ATTACHED_TO_GRAPH_ERROR, errors[0].Code());
+  EXPECT_NE(std::string::npos,
+      errors[0].Message().find("multiple outgoing edges"));
+
+  // Frames that aren't attached to it still resolve.
+  EXPECT_TRUE(
+    sdf::resolveFrameAttachedToBody(resolvedBody, graph, "L").empty());
+  EXPECT_EQ("L", resolvedBody);
+}
+
 /////////////////////////////////////////////////
 TEST(FrameSemantics, buildFrameAttachedToGraph_World)
 {
@@ -300,6 +348,53 @@ TEST(FrameSemantics, buildPoseRelativeToGraph)
         "invalid] in graph."));
 }
 
+/////////////////////////////////////////////////
+TEST(FrameSemantics, PoseRelativeToGraphCache)
+{
+  const std::string testFile =
+    sdf::filesystem::append(PROJECT_SOURCE_PATH, "test", "sdf",
+        "model_frame_relative_to_joint.sdf");
+
+  sdf::Root root;
+  EXPECT_TRUE(root.Load(testFile).empty());
+  const sdf::Model *model = root.ModelByIndex(0);
+
+  auto ownedGraph = std::make_shared<sdf::PoseRelativeToGraph>();
+  sdf::ScopedGraph<sdf::PoseRelativeToGraph> graph(ownedGraph);
+  EXPECT_TRUE(sdf::buildPoseRelativeToGraph(graph, model).empty());
+  graph = graph.ChildModelScope(model->Name());
+
+  ignition::math::Pose3d pose;
+  EXPECT_TRUE(sdf::resolvePoseRelativeToRoot(pose, graph, "F1").empty());
+  EXPECT_EQ(ignition::math::Pose3d(1, 0, 1, 0, 0, 0), pose);
+  EXPECT_TRUE(ownedGraph->rootPoses.valid);
+
+  // Updating the data of an edge updates the cached poses below it.
+  const auto pId = graph.VertexIdByName("P");
+  auto edge = graph.Graph().IncidentsTo(pId).front();
+  graph.UpdateEdge(edge, ignition::math::Pose3d(5, 0, 0, 0, 0, 0));
+  EXPECT_TRUE(ownedGraph->rootPoses.valid);
+
+  EXPECT_TRUE(sdf::resolvePoseRelativeToRoot(pose, graph, "P").empty());
+  EXPECT_EQ(ignition::math::Pose3d(5, 0, 0, 0, 0, 0), pose);
+  EXPECT_TRUE(sdf::resolvePoseRelativeToRoot(pose, graph, "F1").empty());
+  EXPECT_EQ(ignition::math::Pose3d(5, 0, 1, 0, 0, 0), pose);
+  EXPECT_TRUE(sdf::resolvePose(pose, graph, "F1", "C").empty());
+  EXPECT_EQ(ignition::math::Pose3d(-1, 0, 3, 0, -IGN_PI/2, 0), pose);
+
+  // Adding an edge invalidates them. A frame with two incoming edges can't
+  // be resolved, nor can the frames that are relative to it.
+  graph.AddEdge({graph.VertexIdByName("C"), pId}, {});
+  EXPECT_FALSE(ownedGraph->rootPoses.valid);
+  auto errors = sdf::resolvePoseRelativeToRoot(pose, graph, "F1");
+  ASSERT_EQ(1u, errors.size());
+  EXPECT_EQ(sdf::ErrorCode::POSE_RELATIVE_TO_GRAPH_ERROR, errors[0].Code());
+
+  // Frames that don't depend on that frame are still resolved.
+  EXPECT_TRUE(sdf::resolvePoseRelativeToRoot(pose, graph, "F4").empty());
+  EXPECT_EQ(ignition::math::Pose3d(6, 3, 3, 0, 0, 0), pose);
+}
+
 /////////////////////////////////////////////////
 TEST(NestedFrameSemantics, buildFrameAttachedToGraph_Model)
 {
@@ -0,0 +1,209 @@
+/*
+ * Copyright 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <chrono>
+#include <filesystem>
+#include <string>
+#include <system_error>
+
+#include "sdf/Filesystem.hh"
+#include "IncludeCache.hh"
+
+using namespace sdf;
+
+/////////////////////////////////////////////////
+bool IncludeCache::Key(const std::string &_filename, FileKey &_key)
+{
+  if (!sdf::filesystem::exists(_filename))
+  {
+    return false;
+  }
+
+  std::error_code error;
+  const std::filesystem::path canonical =
+    std::filesystem::canonical(_filename, error);
+  if (error)
+  {
+    return false;
+  }
+
+  const auto mtime = std::filesystem::last_write_time(canonical, error);
+  if (error)
+  {
+    return false;
+  }
+
+  const auto size = std::filesystem::file_size(canonical, error);
+  if (error)
+  {
+    return false;
+  }
+
+  // The modification time has the resolution of the file system, which is
+  // finer than seconds on most platforms, so a file rewritten within the
+  // same second is still detected.
+  _key.path = canonical.string();
+  _key.mtime = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      mtime.time_since_epoch()).count();
+  _key.size = static_cast<std::int64_t>(size);
+  return true;
+}
+
+/////////////////////////////////////////////////
+bool IncludeCache::Load(const std::string &_filename,
+                        const std::function<bool(Entry &)> &_load,
+                        Entry &_entry)
+{
+  FileKey key;
+  if (!Key(_filename, key))
+  {
+    {
+      std::lock_guard<std::mutex> lock(this->mutex);
+      ++this->misses;
+    }
+    Entry loaded;
+    _load(loaded);
+    return false;
+  }
+
+  while (true)
+  {
+    std::shared_future<Entry> pending;
+    std::promise<Entry> promise;
+    std::uint64_t load = 0;
+    bool uncached = false;
+    {
+      std::lock_guard<std::mutex> lock(this->mutex);
+      auto iter = this->slots.find(key.path);
+      if (iter != this->slots.end() &&
+          iter->second.key.mtime == key.mtime &&
+          iter->second.key.size == key.size)
+      {
+        // Slots only hold the entries of successful loads once they are
+        // ready.
+        if (iter->second.entry.wait_for(std::chrono::seconds(0)) ==
+            std::future_status::ready)
+        {
+          _entry = iter->second.entry.get();
+          ++this->hits;
+          return true;
+        }
+
+        // A file that includes itself is loaded again instead of waiting
+        // for its own result.
+        if (iter->second.loader == std::this_thread::get_id())
+        {
+          uncached = true;
+        }
+        else
+        {
+          pending = iter->second.entry;
+        }
+      }
+      else
+      {
+        load = ++this->loads;
+        Slot &slot = this->slots[key.path];
+        slot.key = key;
+        slot.entry = promise.get_future().share();
+        slot.loader = std::this_thread::get_id();
+        slot.load = load;
+      }
+
+      if (!pending.valid())
+      {
+        ++this->misses;
+      }
+    }
+
+    if (uncached)
+    {
+      Entry loaded;
+      _load(loaded);
+      return false;
+    }
+
+    // Wait for the thread that loads the file. If its load failed, the slot
+    // has been removed, so look the file up again.
+    if (pending.valid())
+    {
+      const Entry &entry = pending.get();
+      if (entry.root)
+      {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        _entry = entry;
+        ++this->hits;
+        return true;
+      }
+      continue;
+    }
+
+    // Publish the result to the waiting threads, and remove the slot if the
+    // load failed. The slot may have been cleared or replaced meanwhile.
+    Entry loaded;
+    auto finish = [&](bool _read)
+    {
+      std::lock_guard<std::mutex> lock(this->mutex);
+      auto iter = this->slots.find(key.path);
+      if (!_read)
+      {
+        loaded = Entry();
+        if (iter != this->slots.end() && iter->second.load == load)
+        {
+          this->slots.erase(iter);
+        }
+      }
+      promise.set_value(loaded);
+    };
+
+    bool read = false;
+    try
+    {
+      read = _load(loaded);
+    }
+    catch (...)
+    {
+      finish(false);
+      throw;
+    }
+    finish(read);
+    return false;
+  }
+}
+
+/////////////////////////////////////////////////
+void IncludeCache::Clear()
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  this->slots.clear();
+  this->hits = 0;
+  this->misses = 0;
+}
+
+/////////////////////////////////////////////////
+std::size_t IncludeCache::Hits() const
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  return this->hits;
+}
+
+/////////////////////////////////////////////////
+std::size_t IncludeCache::Misses() const
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  return this->misses;
+}
@@ -0,0 +1,143 @@
+/*
+ * Copyright 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef SDF_INCLUDE_CACHE_HH_
+#define SDF_INCLUDE_CACHE_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "sdf/Element.hh"
+#include "sdf/Error.hh"
+#include "sdf/ParserConfig.hh"
+#include "sdf/system_util.hh"
+
+namespace sdf
+{
+  // Inline bracket to help doxygen filtering.
+  inline namespace SDF_VERSION_NAMESPACE {
+  //
+
+  /// \brief Thread-safe cache of files loaded through <include> elements.
+  /// Entries are keyed by the canonical path of the file and are discarded
+  /// when the modification time or size of the file changes. The cache only
+  /// tracks the included file itself, not files that it includes in turn.
+  /// A file that is requested by several threads at once is loaded by the
+  /// first of them while the others wait for the result.
+  class IncludeCache
+  {
+    /// \brief A cached file.
+    public: struct Entry
+    {
+      /// \brief Root element of the loaded file. This must not be modified;
+      /// clone it before use.
+      ElementPtr root;
+
+      /// \brief Errors reported when the file was loaded.
+      Errors errors;
+    };
+
+    /// \brief Look up a file in the cache, and load it on a miss. A hit or a
+    /// miss is counted. If another thread is loading the same file, this
+    /// waits for it and counts a hit when it succeeds.
+    /// \param[in] _filename Path to the file.
+    /// \param[in] _load Called on a miss to load the file. It returns false
+    /// if the file could not be read, in which case nothing is cached. The
+    /// root element it sets must not be modified afterwards. Files whose
+    /// status can't be read are loaded but not cached.
+    /// \param[out] _entry The cached entry, set on a hit.
+    /// \return True if the file was found and has not changed since it was
+    /// cached, false if _load was called.
+    public: bool Load(const std::string &_filename,
+                      const std::function<bool(Entry &)> &_load,
+                      Entry &_entry);
+
+    /// \brief Remove every entry and reset the counters.
+    public: void Clear();
+
+    /// \brief Get the number of lookups that found a cached file.
+    /// \return Number of hits.
+    public: std::size_t Hits() const;
+
+    /// \brief Get the number of lookups that did not find a cached file.
+    /// \return Number of misses.
+    public: std::size_t Misses() const;
+
+    /// \brief Identity of a file on disk.
+    private: struct FileKey
+    {
+      /// \brief Canonical path.
+      std::string path;
+
+      /// \brief Last modification time in nanoseconds.
+      std::int64_t mtime = 0;
+
+      /// \brief File size in bytes.
+      std::int64_t size = 0;
+    };
+
+    /// \brief Get the identity of a file.
+    /// \param[in] _filename Path to the file.
+    /// \param[out] _key Identity of the file.
+    /// \return False if the status of the file could not be read.
+    private: static bool Key(const std::string &_filename, FileKey &_key);
+
+    /// \brief Cached entry and the identity of the file it was loaded from.
+    private: struct Slot
+    {
+      /// \brief Identity of the file when it was loaded.
+      FileKey key;
+
+      /// \brief The cached entry, which is ready once the file is loaded.
+      std::shared_future<Entry> entry;
+
+      /// \brief Thread that loads the file.
+      std::thread::id loader;
+
+      /// \brief Number of the load that created this slot, used by the
+      /// loader to find out whether the slot was replaced meanwhile.
+      std::uint64_t load = 0;
+    };
+
+    /// \brief Mutex that protects all members.
+    private: mutable std::mutex mutex;
+
+    /// \brief Cached files indexed by canonical path.
+    private: std::map<std::string, Slot> slots;
+
+    /// \brief Number of lookups that found a cached file.
+    private: std::size_t hits = 0;
+
+    /// \brief Number of lookups that did not find a cached file.
+    private: std::size_t misses = 0;
+
+    /// \brief Number of loads started so far.
+    private: std::uint64_t loads = 0;
+  };
+
+  /// \brief Get the include cache of a parser configuration.
+  /// \param[in] _config Parser configuration.
+  /// \return The cache, or nullptr if include caching is disabled.
+  IncludeCache *includeCache(const ParserConfig &_config);
+  }
+}
+#endif
@@ -30,6 +30,7 @@
 #include "sdf/Visual.hh"
 
 #include "FrameSemantics.hh"
+#include "NameIndex.hh"
 #include "ScopedGraph.hh"
 #include "Utils.hh"
 
@@ -58,6 +59,15 @@ class sdf::LinkPrivate
   /// \brief The sensors specified in this link.
   public: std::vector<Sensor> sensors;
 
+  /// \brief Index of the visuals by name.
+  public: NameIndex visualIndex;
+
+  /// \brief Index of the collisions by name.
+  public: NameIndex collisionIndex;
+
+  /// \brief Index of the sensors by name.
+  public: NameIndex sensorIndex;
+
   /// \brief The inertial information for this link.
   public: ignition::math::Inertiald inertial {{1.0,
             ignition::math::Vector3d::One, ignition::math::Vector3d::Zero},
@@ -166,6 +176,10 @@ Errors Link::Load(ElementPtr _sdf)
       this->dataPtr->sensors);
   errors.insert(errors.end(), sensorLoadErrors.begin(), sensorLoadErrors.end());
 
+  this->dataPtr->visualIndex.Build(this->dataPtr->visuals);
+  this->dataPtr->collisionIndex.Build(this->dataPtr->collisions);
+  this->dataPtr->sensorIndex.Build(this->dataPtr->sensors);
+
   ignition::math::Vector3d xxyyzz = ignition::math::Vector3d::One;
   ignition::math::Vector3d xyxzyz = ignition::math::Vector3d::Zero;
   ignition::math::Pose3d inertiaPose;
@@ -214,7 +228,7 @@ Errors Link::Load(ElementPtr _sdf)
 }
 
 /////////////////////////////////////////////////
-std::string Link::Name() const
+const std::string &Link::Name() const
 {
   return this->dataPtr->name;
 }
@@ -223,6 +237,8 @@ std::string Link::Name() const
 void Link::SetName(const std::string &_name) const
 {
   this->dataPtr->name = _name;
+  // The owner's index of names can't see this change.
+  NameIndex::NameChanged();
 }
 
 /////////////////////////////////////////////////
@@ -242,14 +258,7 @@ const Visual *Link::VisualByIndex(const uint64_t _index) const
 /////////////////////////////////////////////////
 bool Link::VisualNameExists(const std::string &_name) const
 {
-  for (auto const &v : this->dataPtr->visuals)
-  {
-    if (v.Name() == _name)
-    {
-      return true;
-    }
-  }
-  return false;
+  return nullptr != this->VisualByName(_name);
 }
 
 /////////////////////////////////////////////////
@@ -269,14 +278,7 @@ const Collision *Link::CollisionByIndex(const uint64_t _index) const
 /////////////////////////////////////////////////
 bool Link::CollisionNameExists(const std::string &_name) const
 {
-  for (auto const &c : this->dataPtr->collisions)
-  {
-    if (c.Name() == _name)
-    {
-      return true;
-    }
-  }
-  return false;
+  return nullptr != this->CollisionByName(_name);
 }
 
 /////////////////////////////////////////////////
@@ -316,27 +318,13 @@ const Sensor *Link::SensorByIndex(const uint64_t _index) const
 /////////////////////////////////////////////////
 bool Link::SensorNameExists(const std::string &_name) const
 {
-  for (auto const &s : this->dataPtr->sensors)
-  {
-    if (s.Name() == _name)
-    {
-      return true;
-    }
-  }
-  return false;
+  return nullptr != this->SensorByName(_name);
 }
 
 /////////////////////////////////////////////////
 const Sensor *Link::SensorByName(const std::string &_name) const
 {
-  for (auto const &s : this->dataPtr->sensors)
-  {
-    if (s.Name() == _name)
-    {
-      return &s;
-    }
-  }
-  return nullptr;
+  return this->dataPtr->sensorIndex.Find(this->dataPtr->sensors, _name);
 }
 
 /////////////////////////////////////////////////
@@ -418,27 +406,13 @@ sdf::SemanticPose Link::SemanticPose() const
 /////////////////////////////////////////////////
 const Visual *Link::VisualByName(const std::string &_name) const
 {
-  for (auto const &v : this->dataPtr->visuals)
-  {
-    if (v.Name() == _name)
-    {
-      return &v;
-    }
-  }
-  return nullptr;
+  return this->dataPtr->visualIndex.Find(this->dataPtr->visuals, _name);
 }
 
 /////////////////////////////////////////////////
 const Collision *Link::CollisionByName(const std::string &_name) const
 {
-  for (auto const &c : this->dataPtr->collisions)
-  {
-    if (c.Name() == _name)
-    {
-      return &c;
-    }
-  }
-  return nullptr;
+  return this->dataPtr->collisionIndex.Find(this->dataPtr->collisions, _name);
 }
 
 /////////////////////////////////////////////////
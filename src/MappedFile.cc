@@ -0,0 +1,126 @@
+/*
+ * Copyright 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <windows.h>
+#endif
+
+#include "MappedFile.hh"
+
+using namespace sdf;
+
+/////////////////////////////////////////////////
+MappedFile::MappedFile(const std::string &_filename)
+{
+#ifndef _WIN32
+  int fd = open(_filename.c_str(), O_RDONLY);
+  if (fd >= 0)
+  {
+    struct stat status;
+    if (fstat(fd, &status) == 0 && S_ISREG(status.st_mode) &&
+        status.st_size > 0)
+    {
+      const std::size_t size = static_cast<std::size_t>(status.st_size);
+      void *address = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (address != MAP_FAILED)
+      {
+        this->mapping = address;
+        this->mappingSize = size;
+      }
+    }
+    close(fd);
+  }
+#else
+  HANDLE file = CreateFileA(_filename.c_str(), GENERIC_READ, FILE_SHARE_READ,
+      nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file != INVALID_HANDLE_VALUE)
+  {
+    LARGE_INTEGER size;
+    if (GetFileSizeEx(file, &size) && size.QuadPart > 0)
+    {
+      HANDLE fileMapping =
+        CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+      if (fileMapping != nullptr)
+      {
+        void *address = MapViewOfFile(fileMapping, FILE_MAP_READ, 0, 0, 0);
+        if (address != nullptr)
+        {
+          this->mapping = address;
+          this->mappingSize = static_cast<std::size_t>(size.QuadPart);
+        }
+        // The view keeps the mapping alive.
+        CloseHandle(fileMapping);
+      }
+    }
+    CloseHandle(file);
+  }
+#endif
+
+  if (this->mapping)
+  {
+    this->data = std::string_view(static_cast<const char *>(this->mapping),
+                                  this->mappingSize);
+    this->valid = true;
+    return;
+  }
+
+  // Fall back to reading the file, for example for empty files or files on
+  // file systems that don't support mapping.
+  std::ifstream stream(_filename, std::ios::in | std::ios::binary);
+  if (stream)
+  {
+    std::ostringstream buffer;
+    buffer << stream.rdbuf();
+    this->contents = buffer.str();
+    this->data = this->contents;
+    this->valid = true;
+  }
+}
+
+/////////////////////////////////////////////////
+MappedFile::~MappedFile()
+{
+  if (!this->mapping)
+    return;
+
+#ifndef _WIN32
+  munmap(this->mapping, this->mappingSize);
+#else
+  UnmapViewOfFile(this->mapping);
+#endif
+}
+
+/////////////////////////////////////////////////
+bool MappedFile::Valid() const
+{
+  return this->valid;
+}
+
+/////////////////////////////////////////////////
+std::string_view MappedFile::Data() const
+{
+  return this->data;
+}
@@ -0,0 +1,79 @@
+/*
+ * Copyright 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef SDF_MAPPED_FILE_HH_
+#define SDF_MAPPED_FILE_HH_
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+#include "sdf/system_util.hh"
+
+namespace sdf
+{
+  // Inline bracket to help doxygen filtering.
+  inline namespace SDF_VERSION_NAMESPACE {
+  //
+
+  /// \brief Read-only view of the contents of a file. The file is memory
+  /// mapped when possible, so that reading it doesn't copy it to the heap
+  /// and its pages can be shared with other processes that read the same
+  /// file. If the file can't be mapped, it is read into memory instead.
+  class MappedFile
+  {
+    /// \brief Constructor. Opens and maps the file.
+    /// \param[in] _filename Path to the file.
+    public: explicit MappedFile(const std::string &_filename);
+
+    /// \brief Destructor. Unmaps the file.
+    public: ~MappedFile();
+
+    /// \brief Copy constructor, deleted since the mapping can't be shared.
+    public: MappedFile(const MappedFile &) = delete;
+
+    /// \brief Assignment operator, deleted since the mapping can't be
+    /// shared.
+    /// \return *this
+    public: MappedFile &operator=(const MappedFile &) = delete;
+
+    /// \brief Get whether the file could be read.
+    /// \return True if the file was opened.
+    public: bool Valid() const;
+
+    /// \brief Get the contents of the file.
+    /// \return View of the contents, which is valid for the lifetime of
+    /// this object.
+    public: std::string_view Data() const;
+
+    /// \brief Address of the mapping, or nullptr if the file isn't mapped.
+    private: void *mapping = nullptr;
+
+    /// \brief Size of the mapping in bytes.
+    private: std::size_t mappingSize = 0;
+
+    /// \brief Contents of the file, if it could not be mapped.
+    private: std::string contents;
+
+    /// \brief Contents of the file.
+    private: std::string_view data;
+
+    /// \brief True if the file could be read.
+    private: bool valid = false;
+  };
+  }
+}
+#endif
@@ -0,0 +1,63 @@
+/*
+ * Copyright 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <gtest/gtest.h>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "sdf/Filesystem.hh"
+#include "MappedFile.hh"
+#include "test_config.h"
+
+/////////////////////////////////////////////////
+TEST(MappedFile, Contents)
+{
+  const std::string filename = sdf::filesystem::append(PROJECT_SOURCE_PATH,
+      "test", "sdf", "empty.sdf");
+
+  std::ifstream stream(filename, std::ios::in | std::ios::binary);
+  std::ostringstream contents;
+  contents << stream.rdbuf();
+  ASSERT_FALSE(contents.str().empty());
+
+  sdf::MappedFile file(filename);
+  ASSERT_TRUE(file.Valid());
+  EXPECT_EQ(contents.str(), file.Data());
+}
+
+/////////////////////////////////////////////////
+TEST(MappedFile, EmptyFile)
+{
+  const std::string filename = sdf::filesystem::append(PROJECT_BINARY_DIR,
+      "mapped_file_empty.txt");
+  {
+    std::ofstream stream(filename);
+  }
+
+  sdf::MappedFile file(filename);
+  EXPECT_TRUE(file.Valid());
+  EXPECT_TRUE(file.Data().empty());
+}
+
+/////////////////////////////////////////////////
+TEST(MappedFile, MissingFile)
+{
+  sdf::MappedFile file("/this/file/does/not/exist.sdf");
+  EXPECT_FALSE(file.Valid());
+  EXPECT_TRUE(file.Data().empty());
+}
@@ -16,6 +16,7 @@
 */
 #include <memory>
 #include <string>
+#include <string_view>
 #include <unordered_set>
 #include <vector>
 #include <ignition/math/Pose3.hh>
@@ -27,6 +28,7 @@
 #include "sdf/Model.hh"
 #include "sdf/Types.hh"
 #include "FrameSemantics.hh"
+#include "NameIndex.hh"
 #include "ScopedGraph.hh"
 #include "Utils.hh"
 
@@ -74,6 +76,18 @@ class sdf::ModelPrivate
   /// \brief The nested models specified in this model.
   public: std::vector<Model> models;
 
+  /// \brief Index of the links by name.
+  public: NameIndex linkIndex;
+
+  /// \brief Index of the joints by name.
+  public: NameIndex jointIndex;
+
+  /// \brief Index of the frames by name.
+  public: NameIndex frameIndex;
+
+  /// \brief Index of the nested models by name.
+  public: NameIndex modelIndex;
+
   /// \brief The SDF element pointer used during load.
   public: sdf::ElementPtr sdf;
 
@@ -329,12 +343,17 @@ Errors Model::Load(ElementPtr _sdf)
     frameNames.insert(frameName);
   }
 
+  // Index the children by name once any name collisions have been resolved.
+  this->dataPtr->linkIndex.Build(this->dataPtr->links);
+  this->dataPtr->jointIndex.Build(this->dataPtr->joints);
+  this->dataPtr->frameIndex.Build(this->dataPtr->frames);
+  this->dataPtr->modelIndex.Build(this->dataPtr->models);
 
   return errors;
 }
 
 /////////////////////////////////////////////////
-std::string Model::Name() const
+const std::string &Model::Name() const
 {
   return this->dataPtr->name;
 }
@@ -436,30 +455,9 @@ bool Model::JointNameExists(const std::string &_name) const
 /////////////////////////////////////////////////
 const Joint *Model::JointByName(const std::string &_name) const
 {
-  auto index = _name.rfind("::");
-  if (index != std::string::npos)
-  {
-    const Model *model = this->ModelByName(_name.substr(0, index));
-    if (nullptr != model)
-    {
-      return model->JointByName(_name.substr(index + 2));
-    }
-
-    // The nested model name preceding the last "::" could not be found.
-    // For now, try to find a link that matches _name exactly.
-    // When "::" are reserved and not allowed in names, then uncomment
-    // the following line to return a nullptr.
-    // return nullptr;
-  }
-
-  for (auto const &j : this->dataPtr->joints)
-  {
-    if (j.Name() == _name)
-    {
-      return &j;
-    }
-  }
-  return nullptr;
+  std::string_view name = _name;
+  const Model *model = this->ScopeOfName(name);
+  return model->dataPtr->jointIndex.Find(model->dataPtr->joints, name);
 }
 
 /////////////////////////////////////////////////
@@ -485,30 +483,9 @@ bool Model::FrameNameExists(const std::string &_name) const
 /////////////////////////////////////////////////
 const Frame *Model::FrameByName(const std::string &_name) const
 {
-  auto index = _name.rfind("::");
-  if (index != std::string::npos)
-  {
-    const Model *model = this->ModelByName(_name.substr(0, index));
-    if (nullptr != model)
-    {
-      return model->FrameByName(_name.substr(index + 2));
-    }
-
-    // The nested model name preceding the last "::" could not be found.
-    // For now, try to find a link that matches _name exactly.
-    // When "::" are reserved and not allowed in names, then uncomment
-    // the following line to return a nullptr.
-    // return nullptr;
-  }
-
-  for (auto const &f : this->dataPtr->frames)
-  {
-    if (f.Name() == _name)
-    {
-      return &f;
-    }
-  }
-  return nullptr;
+  std::string_view name = _name;
+  const Model *model = this->ScopeOfName(name);
+  return model->dataPtr->frameIndex.Find(model->dataPtr->frames, name);
 }
 
 /////////////////////////////////////////////////
@@ -534,24 +511,48 @@ bool Model::ModelNameExists(const std::string &_name) const
 /////////////////////////////////////////////////
 const Model *Model::ModelByName(const std::string &_name) const
 {
-  auto index = _name.find("::");
-  const std::string nextModelName = _name.substr(0, index);
-  const Model *nextModel = nullptr;
+  return this->NestedModelByName(_name);
+}
 
-  for (auto const &m : this->dataPtr->models)
+/////////////////////////////////////////////////
+const Model *Model::NestedModelByName(std::string_view _name) const
+{
+  const Model *model = this;
+  while (true)
   {
-    if (m.Name() == nextModelName)
+    const auto index = _name.find("::");
+    const Model *nextModel = model->dataPtr->modelIndex.Find(
+        model->dataPtr->models, _name.substr(0, index));
+
+    if (nullptr == nextModel || index == std::string_view::npos)
     {
-      nextModel = &m;
-      break;
+      return nextModel;
     }
+
+    model = nextModel;
+    _name.remove_prefix(index + 2);
   }
+}
 
-  if (nullptr != nextModel && index != std::string::npos)
+/////////////////////////////////////////////////
+const Model *Model::ScopeOfName(std::string_view &_name) const
+{
+  const auto index = _name.rfind("::");
+  if (index != std::string_view::npos)
   {
-    return nextModel->ModelByName(_name.substr(index + 2));
+    const Model *model = this->NestedModelByName(_name.substr(0, index));
+    if (nullptr != model)
+    {
+      _name.remove_prefix(index + 2);
+      return model;
+    }
+
+    // The nested model name preceding the last "::" could not be found.
+    // For now, try to find an object that matches _name exactly.
+    // When "::" are reserved and not allowed in names, then return nullptr
+    // here instead.
   }
-  return nextModel;
+  return this;
 }
 
 /////////////////////////////////////////////////
@@ -705,32 +706,30 @@ sdf::SemanticPose Model::SemanticPose() const
 }
 
 /////////////////////////////////////////////////
-const Link *Model::LinkByName(const std::string &_name) const
+Errors Model::ResolvePoses(ResolvedPoses &_poses,
+                           const std::string &_resolveTo) const
 {
-  auto index = _name.rfind("::");
-  if (index != std::string::npos)
-  {
-    const Model *model = this->ModelByName(_name.substr(0, index));
-    if (nullptr != model)
-    {
-      return model->LinkByName(_name.substr(index + 2));
-    }
-
-    // The nested model name preceding the last "::" could not be found.
-    // For now, try to find a link that matches _name exactly.
-    // When "::" are reserved and not allowed in names, then uncomment
-    // the following line to return a nullptr.
-    // return nullptr;
-  }
+  Errors errors;
 
-  for (auto const &l : this->dataPtr->links)
+  auto graph = this->dataPtr->poseGraph;
+  if (!graph)
   {
-    if (l.Name() == _name)
-    {
-      return &l;
-    }
+    _poses.Clear();
+    errors.push_back({ErrorCode::POSE_RELATIVE_TO_GRAPH_ERROR,
+        "Model has invalid pointer to PoseRelativeToGraph."});
+    return errors;
   }
-  return nullptr;
+
+  return resolvePoses(_poses, graph.ChildModelScope(this->Name()), this,
+      _resolveTo.empty() ? "__model__" : _resolveTo);
+}
+
+/////////////////////////////////////////////////
+const Link *Model::LinkByName(const std::string &_name) const
+{
+  std::string_view name = _name;
+  const Model *model = this->ScopeOfName(name);
+  return model->dataPtr->linkIndex.Find(model->dataPtr->links, name);
 }
 
 /////////////////////////////////////////////////
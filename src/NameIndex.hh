@@ -0,0 +1,197 @@
+/*
+ * Copyright 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef SDF_NAME_INDEX_HH_
+#define SDF_NAME_INDEX_HH_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <shared_mutex>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "sdf/system_util.hh"
+
+namespace sdf
+{
+  // Inline bracket to help doxygen filtering.
+  inline namespace SDF_VERSION_NAMESPACE {
+  //
+
+  /// \brief Index from the names of the objects stored in a vector to their
+  /// positions, used by the DOM classes to look up children by name in
+  /// constant time. Only the hash of each name is stored, and a candidate
+  /// position is accepted only if the object there still has the requested
+  /// name. This keeps the index valid when the owning class is copied, and an
+  /// outdated entry can never return an object with a different name.
+  /// Lookups take a std::string_view and don't allocate.
+  ///
+  /// Some DOM classes can be renamed through const functions, which the
+  /// owner of the index doesn't see. Those functions call NameChanged, and
+  /// every index is rebuilt on its first lookup after a rename. The index is
+  /// thread-safe, so concurrent lookups through const functions may rebuild
+  /// it.
+  class NameIndex
+  {
+    /// \brief Default constructor.
+    public: NameIndex()
+      : generation(Renames().load())
+    {
+    }
+
+    /// \brief Copy constructor.
+    /// \param[in] _index Index to copy.
+    public: NameIndex(const NameIndex &_index)
+    {
+      std::shared_lock<std::shared_mutex> lock(_index.mutex);
+      this->positions = _index.positions;
+      this->generation = _index.generation;
+    }
+
+    /// \brief Assignment operator.
+    /// \param[in] _index Index to copy.
+    /// \return *this
+    public: NameIndex &operator=(const NameIndex &_index)
+    {
+      if (this != &_index)
+      {
+        std::unique_lock<std::shared_mutex> lock(this->mutex, std::defer_lock);
+        std::shared_lock<std::shared_mutex> otherLock(_index.mutex,
+            std::defer_lock);
+        std::lock(lock, otherLock);
+        this->positions = _index.positions;
+        this->generation = _index.generation;
+      }
+      return *this;
+    }
+
+    /// \brief Record that an indexed object was renamed without its owner
+    /// knowing, so that every index is rebuilt on its next lookup.
+    public: static void NameChanged()
+    {
+      ++Renames();
+    }
+
+    /// \brief Index every object of a vector, replacing the current entries.
+    /// \param[in] _objs Objects to index, which must have a Name() function.
+    public: template <typename T>
+            void Build(const std::vector<T> &_objs)
+    {
+      std::unique_lock<std::shared_mutex> lock(this->mutex);
+      this->Rebuild(_objs);
+    }
+
+    /// \brief Add the name of an object.
+    /// \param[in] _name Name of the object.
+    /// \param[in] _position Position of the object in its vector.
+    public: void Add(std::string_view _name, std::size_t _position)
+    {
+      std::unique_lock<std::shared_mutex> lock(this->mutex);
+      this->positions.emplace(std::hash<std::string_view>()(_name), _position);
+    }
+
+    /// \brief Find an object by name. If several objects have the name, the
+    /// first one in the index is returned, as a linear search would.
+    /// \param[in] _objs The indexed objects.
+    /// \param[in] _name Name of the object.
+    /// \return Pointer to the object, or nullptr if it was not found.
+    public: template <typename T>
+            const T *Find(const std::vector<T> &_objs,
+                          std::string_view _name) const
+    {
+      {
+        std::shared_lock<std::shared_mutex> lock(this->mutex);
+        if (this->generation == Renames().load())
+        {
+          return this->FindIndexed(_objs, _name);
+        }
+      }
+
+      // An object was renamed since the index was built.
+      std::unique_lock<std::shared_mutex> lock(this->mutex);
+      if (this->generation != Renames().load())
+      {
+        this->Rebuild(_objs);
+      }
+      return this->FindIndexed(_objs, _name);
+    }
+
+    /// \brief Find an object by name in the index. The mutex must be locked.
+    /// \param[in] _objs The indexed objects.
+    /// \param[in] _name Name of the object.
+    /// \return Pointer to the object, or nullptr if it was not found.
+    private: template <typename T>
+             const T *FindIndexed(const std::vector<T> &_objs,
+                                  std::string_view _name) const
+    {
+      const T *result = nullptr;
+      std::size_t resultPosition = _objs.size();
+      auto range =
+          this->positions.equal_range(std::hash<std::string_view>()(_name));
+      for (auto it = range.first; it != range.second; ++it)
+      {
+        if (it->second < resultPosition && _objs[it->second].Name() == _name)
+        {
+          resultPosition = it->second;
+          result = &_objs[resultPosition];
+        }
+      }
+      return result;
+    }
+
+    /// \brief Replace the entries with the names of a vector of objects.
+    /// The mutex must be locked exclusively.
+    /// \param[in] _objs Objects to index.
+    private: template <typename T>
+             void Rebuild(const std::vector<T> &_objs) const
+    {
+      // Read the count first, so that a rename during the rebuild triggers
+      // another one.
+      this->generation = Renames().load();
+      this->positions.clear();
+      this->positions.reserve(_objs.size());
+      for (std::size_t i = 0; i < _objs.size(); ++i)
+      {
+        this->positions.emplace(
+            std::hash<std::string_view>()(_objs[i].Name()), i);
+      }
+    }
+
+    /// \brief Number of calls to NameChanged.
+    /// \return Reference to the counter.
+    private: static std::atomic<std::uint64_t> &Renames()
+    {
+      static std::atomic<std::uint64_t> renames{0};
+      return renames;
+    }
+
+    /// \brief Protects the positions, which lookups may rebuild.
+    private: mutable std::shared_mutex mutex;
+
+    /// \brief Positions of the objects indexed by the hash of their name.
+    private: mutable std::unordered_multimap<std::size_t, std::size_t>
+             positions;
+
+    /// \brief Value of the rename counter when the index was built.
+    private: mutable std::uint64_t generation = 0;
+  };
+  }
+}
+#endif
@@ -0,0 +1,106 @@
+/*
+ * Copyright 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <gtest/gtest.h>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "NameIndex.hh"
+
+/// \brief Object with a name, like the DOM classes.
+struct Named
+{
+  const std::string &Name() const { return this->name; }
+  std::string name;
+};
+
+/////////////////////////////////////////////////
+TEST(NameIndex, Find)
+{
+  std::vector<Named> objs{{"a"}, {"b"}, {"c"}};
+  sdf::NameIndex index;
+
+  // Objects that aren't indexed are not found.
+  EXPECT_EQ(nullptr, index.Find(objs, "b"));
+  EXPECT_EQ(nullptr, index.Find(objs, "d"));
+
+  index.Build(objs);
+  EXPECT_EQ(&objs[0], index.Find(objs, "a"));
+  EXPECT_EQ(&objs[1], index.Find(objs, "b"));
+  EXPECT_EQ(&objs[2], index.Find(objs, "c"));
+  EXPECT_EQ(nullptr, index.Find(objs, "d"));
+  EXPECT_EQ(nullptr, index.Find(objs, ""));
+
+  // Lookups by part of a longer string
+  const std::string scoped = "b::c";
+  EXPECT_EQ(&objs[1], index.Find(objs, std::string_view(scoped).substr(0, 1)));
+
+  // Objects added after building the index, with or without adding them
+  // to the index
+  objs.push_back({"d"});
+  index.Add(objs.back().Name(), objs.size() - 1);
+  EXPECT_EQ(&objs[3], index.Find(objs, "d"));
+  objs.push_back({"e"});
+  EXPECT_EQ(nullptr, index.Find(objs, "e"));
+}
+
+/////////////////////////////////////////////////
+TEST(NameIndex, Duplicates)
+{
+  std::vector<Named> objs{{"a"}, {"b"}, {"a"}};
+  sdf::NameIndex index;
+  index.Build(objs);
+
+  // The first object with the name is found.
+  EXPECT_EQ(&objs[0], index.Find(objs, "a"));
+}
+
+/////////////////////////////////////////////////
+TEST(NameIndex, Outdated)
+{
+  std::vector<Named> objs{{"a"}, {"b"}};
+  sdf::NameIndex index;
+  index.Build(objs);
+
+  // An object that was renamed is not found by its old name.
+  objs[0].name = "x";
+  EXPECT_EQ(nullptr, index.Find(objs, "a"));
+
+  // After the rename is reported, it is found by its new name.
+  sdf::NameIndex::NameChanged();
+  EXPECT_EQ(&objs[0], index.Find(objs, "x"));
+  EXPECT_EQ(&objs[0], index.Find(objs, "x"));
+  EXPECT_EQ(nullptr, index.Find(objs, "a"));
+  EXPECT_EQ(&objs[1], index.Find(objs, "b"));
+
+  // An object renamed to the name of a later one is found first.
+  objs[0].name = "b";
+  sdf::NameIndex::NameChanged();
+  EXPECT_EQ(&objs[0], index.Find(objs, "b"));
+  objs[0].name = "x";
+  sdf::NameIndex::NameChanged();
+  EXPECT_EQ(&objs[1], index.Find(objs, "b"));
+
+  // Positions past the end of the vector are ignored.
+  objs.pop_back();
+  EXPECT_EQ(nullptr, index.Find(objs, "b"));
+
+  // A copy of the vector can be searched with the same index.
+  std::vector<Named> copy{{"a"}, {"b"}};
+  EXPECT_EQ(&copy[1], index.Find(copy, "b"));
+}
@@ -16,18 +16,23 @@
  */
 
 #include <algorithm>
+#include <array>
 #include <cctype>
+#include <charconv>
+#include <cmath>
 #include <cstdint>
+#include <limits>
 #include <locale>
 #include <sstream>
 #include <string>
-
-#include <locale.h>
-#include <math.h>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
 
 #include "sdf/Assert.hh"
 #include "sdf/Param.hh"
 #include "sdf/Types.hh"
+#include "Utils.hh"
 
 using namespace sdf;
 
@@ -56,6 +61,149 @@ namespace sdf
   }
 }
 
+//////////////////////////////////////////////////
+/// \brief Resolve the name of a parameter type.
+/// \param[in] _typeName Type name used in the SDFormat description.
+/// \return The matching value type, or UNKNOWN.
+static ParamPrivate::ValueType valueTypeFromName(const std::string &_typeName)
+{
+  using ValueType = ParamPrivate::ValueType;
+  static const std::unordered_map<std::string, ValueType> kTypes = {
+    {"bool", ValueType::BOOL},
+    {"char", ValueType::CHAR},
+    {"std::string", ValueType::STRING},
+    {"string", ValueType::STRING},
+    {"int", ValueType::INT},
+    {"uint64_t", ValueType::UINT64},
+    {"unsigned int", ValueType::UNSIGNED_INT},
+    {"double", ValueType::DOUBLE},
+    {"float", ValueType::FLOAT},
+    {"sdf::Time", ValueType::TIME},
+    {"time", ValueType::TIME},
+    {"ignition::math::Color", ValueType::COLOR},
+    {"color", ValueType::COLOR},
+    {"ignition::math::Vector2i", ValueType::VECTOR2I},
+    {"vector2i", ValueType::VECTOR2I},
+    {"ignition::math::Vector2d", ValueType::VECTOR2D},
+    {"vector2d", ValueType::VECTOR2D},
+    {"ignition::math::Vector3d", ValueType::VECTOR3},
+    {"vector3", ValueType::VECTOR3},
+    {"ignition::math::Quaterniond", ValueType::QUATERNION},
+    {"quaternion", ValueType::QUATERNION},
+    {"ignition::math::Pose3d", ValueType::POSE},
+    {"pose", ValueType::POSE},
+    {"Pose", ValueType::POSE}};
+
+  auto iter = kTypes.find(_typeName);
+  return iter != kTypes.end() ? iter->second : ValueType::UNKNOWN;
+}
+
+//////////////////////////////////////////////////
+/// \brief Remove leading and trailing whitespace, like sdf::trim, without
+/// copying the string.
+/// \param[in] _in Input string.
+/// \return View of the trimmed string.
+static std::string_view trimView(std::string_view _in)
+{
+  const size_t strBegin = _in.find_first_not_of(" \t\n");
+  if (strBegin == std::string_view::npos)
+  {
+    return std::string_view();
+  }
+
+  const size_t strEnd = _in.find_last_not_of(" \t\n");
+  return _in.substr(strBegin, strEnd - strBegin + 1);
+}
+
+//////////////////////////////////////////////////
+/// \brief Parse an integer with the same rules as std::strtol and
+/// std::strtoul: an optional sign, and an optional "0x" prefix in base 16.
+/// Like std::strtoul, a negative unsigned value wraps around.
+/// \param[in,out] _first Start of the input, advanced past the value.
+/// \param[in] _last End of the input.
+/// \param[out] _value Parsed value.
+/// \param[in] _base Numeric base.
+/// \return std::errc() on success, otherwise the error.
+template <typename T>
+static std::errc parseInteger(const char *&_first, const char *_last,
+                              T &_value, int _base = 10)
+{
+  using U = std::make_unsigned_t<T>;
+
+  const char *iter = _first;
+  skipSpace(iter, _last);
+
+  bool negative = false;
+  if (iter != _last && (*iter == '+' || *iter == '-'))
+  {
+    negative = *iter == '-';
+    ++iter;
+  }
+
+  if (_base == 16 && _last - iter > 2 && iter[0] == '0' &&
+      (iter[1] == 'x' || iter[1] == 'X') &&
+      std::isxdigit(static_cast<unsigned char>(iter[2])))
+  {
+    iter += 2;
+  }
+
+  U magnitude = 0;
+  auto result = std::from_chars(iter, _last, magnitude, _base);
+  if (result.ec != std::errc())
+  {
+    return result.ec;
+  }
+
+  if constexpr (std::is_signed_v<T>)
+  {
+    const U limit = static_cast<U>(std::numeric_limits<T>::max());
+    if (magnitude > limit + (negative ? 1u : 0u))
+    {
+      return std::errc::result_out_of_range;
+    }
+    _value = negative && magnitude > 0 ?
+        -static_cast<T>(magnitude - 1) - 1 : static_cast<T>(magnitude);
+  }
+  else
+  {
+    _value = negative ? static_cast<T>(0 - magnitude) : magnitude;
+  }
+
+  _first = result.ptr;
+  return std::errc();
+}
+
+//////////////////////////////////////////////////
+/// \brief Parse consecutive values separated by whitespace, as a stream
+/// would read them.
+/// \param[in,out] _first Start of the input, advanced past the values.
+/// \param[in] _last End of the input.
+/// \param[out] _values Parsed values.
+/// \return True if all values could be parsed.
+template <typename T, std::size_t N>
+static bool parseArray(const char *&_first, const char *_last,
+                       std::array<T, N> &_values)
+{
+  for (T &value : _values)
+  {
+    std::errc ec;
+    if constexpr (std::is_integral_v<T>)
+    {
+      ec = parseInteger(_first, _last, value);
+    }
+    else
+    {
+      ec = parseFloat(_first, _last, value, false);
+    }
+
+    if (ec != std::errc())
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
 //////////////////////////////////////////////////
 Param::Param(const std::string &_key, const std::string &_typeName,
              const std::string &_default, bool _required,
@@ -65,6 +213,7 @@ Param::Param(const std::string &_key, const std::string &_typeName,
   this->dataPtr->key = _key;
   this->dataPtr->required = _required;
   this->dataPtr->typeName = _typeName;
+  this->dataPtr->valueType = valueTypeFromName(_typeName);
   this->dataPtr->description = _description;
   this->dataPtr->set = false;
 
@@ -336,69 +485,44 @@ std::optional<std::string> Param::GetMaxValueAsString() const
   return std::nullopt;
 }
 
-//////////////////////////////////////////////////
-/// \brief Helper function for Param::ValueFromString
-/// \param[in] _input Input string.
-/// \param[in] _key Key of the parameter, used for error message.
-/// \param[out] _value This will be set with the parsed value.
-/// \return True if parsing succeeded.
-template <typename T>
-bool ParseUsingStringStream(const std::string &_input, const std::string &_key,
-                            ParamPrivate::ParamVariant &_value)
-{
-  StringStreamClassicLocale ss(_input);
-  T _val;
-  ss >> _val;
-  if (ss.fail())
-  {
-    sdferr << "Unknown error. Unable to set value [" << _input << " ] for key["
-           << _key << "]\n";
-    return false;
-  }
-  _value = _val;
-  return true;
-}
-
 //////////////////////////////////////////////////
 bool Param::ValueFromString(const std::string &_value)
 {
-  // Under some circumstances, latin locales (es_ES or pt_BR) will return a
-  // comma for decimal position instead of a dot, making the conversion
-  // to fail. See bug #60 for more information. Force to use always C
-  setlocale(LC_NUMERIC, "C");
-  std::string trimmed = sdf::trim(_value);
-  std::string tmp(trimmed);
-  std::string lowerTmp = lowercase(trimmed);
+  std::string_view trimmed = trimView(_value);
+  std::string_view tmp = trimmed;
 
   // "true" and "false" doesn't work properly
-  if (lowerTmp == "true")
+  if (equalsLowercase(trimmed, "true"))
   {
     tmp = "1";
   }
-  else if (lowerTmp == "false")
+  else if (equalsLowercase(trimmed, "false"))
   {
     tmp = "0";
   }
 
-  bool isHex = lowerTmp.compare(0, 2, "0x") == 0;
+  const char *first = tmp.data();
+  const char *last = first + tmp.size();
+  std::errc ec = std::errc();
 
-  try
+  // Report a value that could not be read by a stream operator.
+  auto streamError = [&]()
   {
-    // Try to use stoi and stoul for integers, and
-    // stof and stod for scalar floating point values.
-    int numericBase = 10;
-    if (isHex)
-    {
-      numericBase = 16;
-    }
+    sdferr << "Unknown error. Unable to set value [" << tmp << " ] for key["
+           << this->dataPtr->key << "]\n";
+    return false;
+  };
 
-    if (this->dataPtr->typeName == "bool")
+  using ValueType = ParamPrivate::ValueType;
+  switch (this->dataPtr->valueType)
+  {
+    case ValueType::BOOL:
     {
-      if (lowerTmp == "true" || lowerTmp == "1")
+      if (tmp == "1")
       {
         this->dataPtr->value = true;
       }
-      else if (lowerTmp == "false" || lowerTmp == "0")
+      else if (tmp == "0")
       {
         this->dataPtr->value = false;
       }
@@ -407,116 +531,183 @@ bool Param::ValueFromString(const std::string &_value)
         sdferr << "Invalid boolean value\n";
         return false;
       }
+      break;
     }
-    else if (this->dataPtr->typeName == "char")
+    case ValueType::CHAR:
     {
-      this->dataPtr->value = tmp[0];
+      this->dataPtr->value = tmp.empty() ? '\0' : tmp[0];
+      break;
     }
-    else if (this->dataPtr->typeName == "std::string" ||
-             this->dataPtr->typeName == "string")
+    case ValueType::STRING:
     {
-      this->dataPtr->value = tmp;
+      this->dataPtr->value = std::string(tmp);
+      break;
     }
-    else if (this->dataPtr->typeName == "int")
+    case ValueType::INT:
     {
-      this->dataPtr->value = std::stoi(tmp, nullptr, numericBase);
+      const int numericBase = equalsLowercase(tmp.substr(0, 2), "0x") ? 16 : 10;
+      int value = 0;
+      ec = parseInteger(first, last, value, numericBase);
+      if (ec == std::errc())
+      {
+        this->dataPtr->value = value;
+      }
+      break;
     }
-    else if (this->dataPtr->typeName == "uint64_t")
+    case ValueType::UINT64:
     {
-      return ParseUsingStringStream<std::uint64_t>(tmp, this->dataPtr->key,
-                                                   this->dataPtr->value);
+      std::uint64_t value = 0;
+      if (parseInteger(first, last, value) != std::errc())
+      {
+        return streamError();
+      }
+      this->dataPtr->value = value;
+      break;
     }
-    else if (this->dataPtr->typeName == "unsigned int")
+    case ValueType::UNSIGNED_INT:
     {
-      this->dataPtr->value = static_cast<unsigned int>(
-          std::stoul(tmp, nullptr, numericBase));
+      const int numericBase = equalsLowercase(tmp.substr(0, 2), "0x") ? 16 : 10;
+      // Parse as unsigned long and then narrow, like std::stoul did.
+      unsigned long value = 0;
+      ec = parseInteger(first, last, value, numericBase);
+      if (ec == std::errc())
+      {
+        this->dataPtr->value = static_cast<unsigned int>(value);
+      }
+      break;
     }
-    else if (this->dataPtr->typeName == "double")
+    case ValueType::DOUBLE:
     {
-      this->dataPtr->value = std::stod(tmp);
+      double value = 0;
+      ec = parseFloat(first, last, value, true);
+      if (ec == std::errc())
+      {
+        this->dataPtr->value = value;
+      }
+      break;
     }
-    else if (this->dataPtr->typeName == "float")
+    case ValueType::FLOAT:
     {
-      this->dataPtr->value = std::stof(tmp);
+      float value = 0;
+      ec = parseFloat(first, last, value, true);
+      if (ec == std::errc())
+      {
+        this->dataPtr->value = value;
+      }
+      break;
     }
-    else if (this->dataPtr->typeName == "sdf::Time" ||
-             this->dataPtr->typeName == "time")
+    case ValueType::TIME:
     {
-      return ParseUsingStringStream<sdf::Time>(tmp, this->dataPtr->key,
-                                               this->dataPtr->value);
+      std::array<std::int32_t, 2> values;
+      if (!parseArray(first, last, values))
+      {
+        return streamError();
+      }
+      this->dataPtr->value = sdf::Time(values[0], values[1]);
+      break;
     }
-    else if (this->dataPtr->typeName == "ignition::math::Color" ||
-             this->dataPtr->typeName == "color")
+    case ValueType::COLOR:
     {
-      // The insertion operator (>>) expects 4 values, but the last value (the
-      // alpha) is optional. We first try to parse assuming the alpha is
-      // specified. If that fails, we append the default value of alpha to the
-      // string and try to parse again.
-      bool result = ParseUsingStringStream<ignition::math::Color>(
-          tmp, this->dataPtr->key, this->dataPtr->value);
+      std::array<float, 3> values;
+      if (!parseArray(first, last, values))
+      {
+        return streamError();
+      }
 
-      if (!result)
+      ignition::math::Color color;
+      color.R(values[0]);
+      color.G(values[1]);
+      color.B(values[2]);
+
+      // The alpha value is optional.
+      skipSpace(first, last);
+      if (first != last)
       {
-        ignition::math::Color colortmp;
-        return ParseUsingStringStream<ignition::math::Color>(
-            tmp + " " + std::to_string(colortmp.A()), this->dataPtr->key,
-            this->dataPtr->value);
+        float alpha = 0;
+        if (parseFloat(first, last, alpha, false) != std::errc())
+        {
+          return streamError();
+        }
+        color.A(alpha);
       }
-      else
-        return true;
+      this->dataPtr->value = color;
+      break;
     }
-    else if (this->dataPtr->typeName == "ignition::math::Vector2i" ||
-             this->dataPtr->typeName == "vector2i")
+    case ValueType::VECTOR2I:
     {
-      return ParseUsingStringStream<ignition::math::Vector2i>(
-          tmp, this->dataPtr->key, this->dataPtr->value);
+      std::array<int, 2> values;
+      if (!parseArray(first, last, values))
+      {
+        return streamError();
+      }
+      this->dataPtr->value = ignition::math::Vector2i(values[0], values[1]);
+      break;
     }
-    else if (this->dataPtr->typeName == "ignition::math::Vector2d" ||
-             this->dataPtr->typeName == "vector2d")
+    case ValueType::VECTOR2D:
     {
-      return ParseUsingStringStream<ignition::math::Vector2d>(
-          tmp, this->dataPtr->key, this->dataPtr->value);
+      std::array<double, 2> values;
+      if (!parseArray(first, last, values))
+      {
+        return streamError();
+      }
+      this->dataPtr->value = ignition::math::Vector2d(values[0], values[1]);
+      break;
     }
-    else if (this->dataPtr->typeName == "ignition::math::Vector3d" ||
-             this->dataPtr->typeName == "vector3")
+    case ValueType::VECTOR3:
     {
-      return ParseUsingStringStream<ignition::math::Vector3d>(
-          tmp, this->dataPtr->key, this->dataPtr->value);
+      std::array<double, 3> values;
+      if (!parseArray(first, last, values))
+      {
+        return streamError();
+      }
+      this->dataPtr->value =
+          ignition::math::Vector3d(values[0], values[1], values[2]);
+      break;
     }
-    else if (this->dataPtr->typeName == "ignition::math::Pose3d" ||
-             this->dataPtr->typeName == "pose" ||
-             this->dataPtr->typeName == "Pose")
+    case ValueType::QUATERNION:
     {
-      if (!tmp.empty())
+      // Quaternions are written as roll, pitch and yaw angles.
+      std::array<double, 3> values;
+      if (!parseArray(first, last, values))
       {
-        return ParseUsingStringStream<ignition::math::Pose3d>(
-            tmp, this->dataPtr->key, this->dataPtr->value);
+        return streamError();
       }
+      this->dataPtr->value =
+          ignition::math::Quaterniond(values[0], values[1], values[2]);
+      break;
     }
-    else if (this->dataPtr->typeName == "ignition::math::Quaterniond" ||
-             this->dataPtr->typeName == "quaternion")
+    case ValueType::POSE:
     {
-      return ParseUsingStringStream<ignition::math::Quaterniond>(
-          tmp, this->dataPtr->key, this->dataPtr->value);
+      if (!tmp.empty())
+      {
+        std::array<double, 6> values;
+        if (!parseArray(first, last, values))
+        {
+          return streamError();
+        }
+        this->dataPtr->value = ignition::math::Pose3d(
+            values[0], values[1], values[2], values[3], values[4], values[5]);
+      }
+      break;
     }
-    else
+    case ValueType::UNKNOWN:
+    default:
     {
       sdferr << "Unknown parameter type[" << this->dataPtr->typeName << "]\n";
       return false;
     }
   }
-  // Catch invalid argument exception from std::stoi/stoul/stod/stof
-  catch(std::invalid_argument &)
+
+  if (ec == std::errc::result_out_of_range)
   {
-    sdferr << "Invalid argument. Unable to set value ["
+    sdferr << "Out of range. Unable to set value ["
            << _value << " ] for key["
            << this->dataPtr->key << "].\n";
     return false;
   }
-  // Catch out of range exception from std::stoi/stoul/stod/stof
-  catch(std::out_of_range &)
+  else if (ec != std::errc())
   {
-    sdferr << "Out of range. Unable to set value ["
+    sdferr << "Invalid argument. Unable to set value ["
            << _value << " ] for key["
            << this->dataPtr->key << "].\n";
     return false;
@@ -528,7 +719,7 @@ bool Param::ValueFromString(const std::string &_value)
 //////////////////////////////////////////////////
 bool Param::SetFromString(const std::string &_value)
 {
-  std::string str = sdf::trim(_value.c_str());
+  std::string_view str = trimView(_value);
 
   if (str.empty() && this->dataPtr->required)
   {
@@ -543,7 +734,7 @@ bool Param::SetFromString(const std::string &_value)
   }
 
   auto oldValue = this->dataPtr->value;
-  if (!this->ValueFromString(str))
+  if (!this->ValueFromString(_value))
   {
     return false;
   }
@@ -246,6 +246,12 @@ TEST(Param, HexDouble)
   EXPECT_FALSE(doubleParam.SetFromString("1.0e1000"));
   EXPECT_TRUE(doubleParam.Get<double>(value));
   EXPECT_DOUBLE_EQ(value, 0.123456789);
+
+  // Only one sign is accepted.
+  EXPECT_FALSE(doubleParam.SetFromString("--1"));
+  EXPECT_FALSE(doubleParam.SetFromString("+-1"));
+  EXPECT_TRUE(doubleParam.Get<double>(value));
+  EXPECT_DOUBLE_EQ(value, 0.123456789);
 }
 
 ////////////////////////////////////////////////////
@@ -450,6 +456,52 @@ TEST(Param, MinMaxViolation)
   }
 }
 
+////////////////////////////////////////////////////
+TEST(Param, MathTypesFromString)
+{
+  sdf::Param vector3Param("key", "vector3", "0 0 0", false, "description");
+  ignition::math::Vector3d vector3;
+  EXPECT_TRUE(vector3Param.SetFromString(" 1.5\t-2e1 +3 "));
+  EXPECT_TRUE(vector3Param.Get(vector3));
+  EXPECT_EQ(ignition::math::Vector3d(1.5, -20, 3), vector3);
+  EXPECT_FALSE(vector3Param.SetFromString("1 2"));
+  EXPECT_FALSE(vector3Param.SetFromString("1,2,3"));
+  EXPECT_FALSE(vector3Param.SetFromString("1 inf 3"));
+  EXPECT_FALSE(vector3Param.SetFromString("1 --2 3"));
+
+  sdf::Param vector2iParam("key", "vector2i", "0 0", false, "description");
+  ignition::math::Vector2i vector2i;
+  EXPECT_TRUE(vector2iParam.SetFromString("-4 5"));
+  EXPECT_TRUE(vector2iParam.Get(vector2i));
+  EXPECT_EQ(ignition::math::Vector2i(-4, 5), vector2i);
+  EXPECT_FALSE(vector2iParam.SetFromString("1.5 2"));
+
+  sdf::Param poseParam("key", "pose", "0 0 0 0 0 0", false, "description");
+  ignition::math::Pose3d pose;
+  EXPECT_TRUE(poseParam.SetFromString("1 2 3 0 0 0"));
+  EXPECT_TRUE(poseParam.Get(pose));
+  EXPECT_EQ(ignition::math::Pose3d(1, 2, 3, 0, 0, 0), pose);
+  EXPECT_FALSE(poseParam.SetFromString("1 2 3 0 0"));
+
+  // The alpha value of a color is optional.
+  sdf::Param colorParam("key", "color", "0 0 0 1", false, "description");
+  ignition::math::Color color;
+  EXPECT_TRUE(colorParam.SetFromString("0.1 0.2 0.3"));
+  EXPECT_TRUE(colorParam.Get(color));
+  EXPECT_EQ(ignition::math::Color(0.1f, 0.2f, 0.3f, 1.0f), color);
+  EXPECT_TRUE(colorParam.SetFromString("0.1 0.2 0.3 0.4"));
+  EXPECT_TRUE(colorParam.Get(color));
+  EXPECT_EQ(ignition::math::Color(0.1f, 0.2f, 0.3f, 0.4f), color);
+  EXPECT_FALSE(colorParam.SetFromString("0.1 0.2 0.3 a"));
+  EXPECT_FALSE(colorParam.SetFromString("0.1 0.2"));
+
+  sdf::Param timeParam("key", "time", "0 0", false, "description");
+  sdf::Time time;
+  EXPECT_TRUE(timeParam.SetFromString("8 20"));
+  EXPECT_TRUE(timeParam.Get(time));
+  EXPECT_EQ(sdf::Time(8, 20), time);
+}
+
 /////////////////////////////////////////////////
 /// Main
 int main(int argc, char **argv)
@@ -0,0 +1,307 @@
+/*
+ * Copyright 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "sdf/Filesystem.hh"
+#include "sdf/ParserConfig.hh"
+#include "sdf/Types.hh"
+#include "FindFileCache.hh"
+#include "IncludeCache.hh"
+
+using namespace sdf;
+
+/// \brief Private ParserConfig data.
+class sdf::ParserConfigPrivate
+{
+  /// \brief Collection of custom model paths.
+  public: ParserConfig::SchemeToPathMap uriPathMap;
+
+  /// \brief Callback to find files.
+  public: ParserConfig::FindFileCallbackType findFileCB;
+
+  /// \brief Number of threads used to load included files.
+  public: std::size_t includeThreadCount = 1;
+
+  /// \brief Cache of included files, or nullptr if caching is disabled.
+  public: std::shared_ptr<IncludeCache> includeCache;
+
+  /// \brief Cache of findFile results, or nullptr if caching is disabled.
+  public: std::shared_ptr<FindFileCache> findFileCache;
+
+  /// \brief Whether descendant conversion rules are applied in one pass.
+  public: bool singlePassConversion = false;
+
+  /// \brief Number of threads used to load sibling models.
+  public: std::size_t modelLoadThreadCount = 1;
+
+  /// \brief Get the private data of a parser configuration.
+  /// \param[in] _config Parser configuration.
+  /// \return The private data, or nullptr if _config was moved from.
+  public: static const ParserConfigPrivate *Get(const ParserConfig &_config)
+  {
+    return _config.dataPtr;
+  }
+
+  /// \brief Clear the caches whose contents depend on the search paths and
+  /// the find file callback.
+  public: void ClearCaches()
+  {
+    if (this->findFileCache)
+      this->findFileCache->Clear();
+    if (this->includeCache)
+    {
+      this->includeCache->Clear();
+    }
+  }
+};
+
+/////////////////////////////////////////////////
+ParserConfig::ParserConfig()
+  : dataPtr(new ParserConfigPrivate)
+{
+}
+
+/////////////////////////////////////////////////
+ParserConfig::ParserConfig(const ParserConfig &_config)
+  : dataPtr(_config.dataPtr ? new ParserConfigPrivate(*_config.dataPtr) :
+            new ParserConfigPrivate)
+{
+  // The cache holds files loaded with the original configuration, so the
+  // copy starts with a cache of its own.
+  if (this->dataPtr->includeCache)
+  {
+    this->dataPtr->includeCache = std::make_shared<IncludeCache>();
+  }
+  if (this->dataPtr->findFileCache)
+    this->dataPtr->findFileCache = std::make_shared<FindFileCache>();
+}
+
+/////////////////////////////////////////////////
+ParserConfig::ParserConfig(ParserConfig &&_config) noexcept
+  : dataPtr(std::exchange(_config.dataPtr, nullptr))
+{
+}
+
+/////////////////////////////////////////////////
+ParserConfig::~ParserConfig()
+{
+  delete this->dataPtr;
+  this->dataPtr = nullptr;
+}
+
+/////////////////////////////////////////////////
+ParserConfig &ParserConfig::operator=(const ParserConfig &_config)
+{
+  return *this = ParserConfig(_config);
+}
+
+/////////////////////////////////////////////////
+ParserConfig &ParserConfig::operator=(ParserConfig &&_config) noexcept
+{
+  std::swap(this->dataPtr, _config.dataPtr);
+  return *this;
+}
+
+/////////////////////////////////////////////////
+ParserConfig &ParserConfig::GlobalConfig()
+{
+  static ParserConfig instance;
+  return instance;
+}
+
+/////////////////////////////////////////////////
+ParserConfig::FindFileCallbackType ParserConfig::FindFileCallback() const
+{
+  if (!this->dataPtr)
+    return {};
+  return this->dataPtr->findFileCB;
+}
+
+/////////////////////////////////////////////////
+void ParserConfig::SetFindCallback(FindFileCallbackType _cb)
+{
+  if (!this->dataPtr)
+    this->dataPtr = new ParserConfigPrivate;
+  this->dataPtr->findFileCB = std::move(_cb);
+  this->dataPtr->ClearCaches();
+}
+
+/////////////////////////////////////////////////
+const ParserConfig::SchemeToPathMap &ParserConfig::URIPathMap() const
+{
+  if (!this->dataPtr)
+  {
+    static const SchemeToPathMap empty;
+    return empty;
+  }
+  return this->dataPtr->uriPathMap;
+}
+
+/////////////////////////////////////////////////
+void ParserConfig::AddURIPath(const std::string &_uri,
+                              const std::string &_path)
+{
+  if (!this->dataPtr)
+    this->dataPtr = new ParserConfigPrivate;
+
+  // Split _path on colons.
+  std::vector<std::string> parts = sdf::split(_path, ":");
+
+  // Add each part of the colon separated path to the URI map.
+  for (const auto &part : parts)
+  {
+    // Only add valid paths
+    if (!part.empty() && sdf::filesystem::is_directory(part))
+    {
+      this->dataPtr->uriPathMap[_uri].push_back(part);
+    }
+  }
+
+  this->dataPtr->ClearCaches();
+}
+
+/////////////////////////////////////////////////
+std::size_t ParserConfig::IncludeThreadCount() const
+{
+  if (!this->dataPtr)
+    return 1u;
+  return this->dataPtr->includeThreadCount;
+}
+
+/////////////////////////////////////////////////
+void ParserConfig::SetIncludeThreadCount(std::size_t _count)
+{
+  if (!this->dataPtr)
+    this->dataPtr = new ParserConfigPrivate;
+  this->dataPtr->includeThreadCount = _count;
+}
+
+/////////////////////////////////////////////////
+bool ParserConfig::IncludeCacheEnabled() const
+{
+  return this->dataPtr && this->dataPtr->includeCache != nullptr;
+}
+
+/////////////////////////////////////////////////
+void ParserConfig::SetIncludeCacheEnabled(bool _enabled)
+{
+  if (!this->dataPtr)
+    this->dataPtr = new ParserConfigPrivate;
+  if (!_enabled)
+  {
+    this->dataPtr->includeCache.reset();
+  }
+  else if (!this->dataPtr->includeCache)
+  {
+    this->dataPtr->includeCache = std::make_shared<IncludeCache>();
+  }
+}
+
+/////////////////////////////////////////////////
+std::size_t ParserConfig::IncludeCacheHits() const
+{
+  return this->IncludeCacheEnabled() ?
+    this->dataPtr->includeCache->Hits() : 0u;
+}
+
+/////////////////////////////////////////////////
+std::size_t ParserConfig::IncludeCacheMisses() const
+{
+  return this->IncludeCacheEnabled() ?
+    this->dataPtr->includeCache->Misses() : 0u;
+}
+
+/////////////////////////////////////////////////
+void ParserConfig::ClearIncludeCache()
+{
+  if (this->IncludeCacheEnabled())
+  {
+    this->dataPtr->includeCache->Clear();
+  }
+}
+
+/////////////////////////////////////////////////
+IncludeCache *sdf::includeCache(const ParserConfig &_config)
+{
+  const ParserConfigPrivate *data = ParserConfigPrivate::Get(_config);
+  return data ? data->includeCache.get() : nullptr;
+}
+
+/////////////////////////////////////////////////
+bool ParserConfig::FindFileCacheEnabled() const
+{
+  return this->dataPtr && this->dataPtr->findFileCache != nullptr;
+}
+
+/////////////////////////////////////////////////
+void ParserConfig::SetFindFileCacheEnabled(bool _enabled)
+{
+  if (!this->dataPtr)
+    this->dataPtr = new ParserConfigPrivate;
+  if (!_enabled)
+    this->dataPtr->findFileCache.reset();
+  else if (!this->dataPtr->findFileCache)
+    this->dataPtr->findFileCache = std::make_shared<FindFileCache>();
+}
+
+/////////////////////////////////////////////////
+void ParserConfig::ClearFindFileCache()
+{
+  if (this->FindFileCacheEnabled())
+    this->dataPtr->findFileCache->Clear();
+}
+
+/////////////////////////////////////////////////
+bool ParserConfig::SinglePassConversionEnabled() const
+{
+  return this->dataPtr && this->dataPtr->singlePassConversion;
+}
+
+/////////////////////////////////////////////////
+void ParserConfig::SetSinglePassConversionEnabled(bool _enabled)
+{
+  if (!this->dataPtr)
+    this->dataPtr = new ParserConfigPrivate;
+  this->dataPtr->singlePassConversion = _enabled;
+}
+
+/////////////////////////////////////////////////
+std::size_t ParserConfig::ModelLoadThreadCount() const
+{
+  if (!this->dataPtr)
+    return 1u;
+  return this->dataPtr->modelLoadThreadCount;
+}
+
+/////////////////////////////////////////////////
+void ParserConfig::SetModelLoadThreadCount(std::size_t _count)
+{
+  if (!this->dataPtr)
+    this->dataPtr = new ParserConfigPrivate;
+  this->dataPtr->modelLoadThreadCount = _count;
+}
+
+/////////////////////////////////////////////////
+FindFileCache *sdf::findFileCache(const ParserConfig &_config)
+{
+  const ParserConfigPrivate *data = ParserConfigPrivate::Get(_config);
+  return data ? data->findFileCache.get() : nullptr;
+}
@@ -0,0 +1,220 @@
+/*
+ * Copyright 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <gtest/gtest.h>
+#include <string>
+
+#include "sdf/Filesystem.hh"
+#include "sdf/ParserConfig.hh"
+#include "sdf/SDFImpl.hh"
+#include "test_config.h"
+
+/////////////////////////////////////////////////
+TEST(ParserConfig, Construction)
+{
+  sdf::ParserConfig config;
+  EXPECT_FALSE(config.FindFileCallback());
+  EXPECT_TRUE(config.URIPathMap().empty());
+
+  const std::string testDir = sdf::filesystem::append(PROJECT_SOURCE_PATH,
+      "test", "integration", "model");
+  const std::string sdfDir = sdf::filesystem::append(PROJECT_SOURCE_PATH,
+      "test", "sdf");
+
+  // Paths that are not directories are ignored.
+  config.AddURIPath("file://", "/this/path/does/not/exist");
+  EXPECT_TRUE(config.URIPathMap().empty());
+
+  config.AddURIPath("file://", testDir + ":" + sdfDir);
+  ASSERT_EQ(1u, config.URIPathMap().count("file://"));
+  ASSERT_EQ(2u, config.URIPathMap().at("file://").size());
+  EXPECT_EQ(testDir, config.URIPathMap().at("file://")[0]);
+  EXPECT_EQ(sdfDir, config.URIPathMap().at("file://")[1]);
+
+  config.SetFindCallback([](const std::string &_file)
+      {
+        return _file + "_found";
+      });
+  ASSERT_TRUE(config.FindFileCallback());
+  EXPECT_EQ("test_found", config.FindFileCallback()("test"));
+
+  // Copies are independent of the original.
+  sdf::ParserConfig copy(config);
+  copy.AddURIPath("model://", testDir);
+  copy.SetFindCallback([](const std::string &)
+      {
+        return std::string();
+      });
+  EXPECT_EQ(2u, copy.URIPathMap().size());
+  EXPECT_EQ(1u, config.URIPathMap().size());
+  EXPECT_EQ("test_found", config.FindFileCallback()("test"));
+  EXPECT_TRUE(copy.FindFileCallback()("test").empty());
+
+  sdf::ParserConfig assigned;
+  assigned = config;
+  EXPECT_EQ(1u, assigned.URIPathMap().size());
+
+  sdf::ParserConfig moved(std::move(assigned));
+  EXPECT_EQ(1u, moved.URIPathMap().size());
+  EXPECT_EQ("test_found", moved.FindFileCallback()("test"));
+
+  // A moved-from configuration has the default settings.
+  EXPECT_TRUE(assigned.URIPathMap().empty());
+  EXPECT_FALSE(assigned.FindFileCallback());
+  EXPECT_EQ(1u, assigned.IncludeThreadCount());
+  assigned.AddURIPath("file://", testDir);
+  EXPECT_EQ(1u, assigned.URIPathMap().size());
+
+  // A config can be used to find files without touching the global one.
+  EXPECT_EQ(sdf::filesystem::append(sdfDir, "empty.sdf"),
+      sdf::findFile("file://empty.sdf", false, false, config));
+  EXPECT_EQ("unknown.sdf_found",
+      sdf::findFile("unknown.sdf", false, true, config));
+}
+
+/////////////////////////////////////////////////
+TEST(ParserConfig, SinglePassConversion)
+{
+  sdf::ParserConfig config;
+  EXPECT_FALSE(config.SinglePassConversionEnabled());
+
+  config.SetSinglePassConversionEnabled(true);
+  EXPECT_TRUE(config.SinglePassConversionEnabled());
+
+  sdf::ParserConfig copy(config);
+  EXPECT_TRUE(copy.SinglePassConversionEnabled());
+
+  config.SetSinglePassConversionEnabled(false);
+  EXPECT_FALSE(config.SinglePassConversionEnabled());
+  EXPECT_TRUE(copy.SinglePassConversionEnabled());
+}
+
+/////////////////////////////////////////////////
+TEST(ParserConfig, ModelLoadThreadCount)
+{
+  sdf::ParserConfig config;
+  EXPECT_EQ(1u, config.ModelLoadThreadCount());
+
+  config.SetModelLoadThreadCount(8);
+  EXPECT_EQ(8u, config.ModelLoadThreadCount());
+
+  sdf::ParserConfig copy(config);
+  EXPECT_EQ(8u, copy.ModelLoadThreadCount());
+
+  config.SetModelLoadThreadCount(0);
+  EXPECT_EQ(0u, config.ModelLoadThreadCount());
+  EXPECT_EQ(8u, copy.ModelLoadThreadCount());
+}
+
+/////////////////////////////////////////////////
+TEST(ParserConfig, GlobalConfig)
+{
+  const std::string testDir = sdf::filesystem::append(PROJECT_SOURCE_PATH,
+      "test", "integration", "model");
+
+  sdf::ParserConfig &global = sdf::ParserConfig::GlobalConfig();
+  EXPECT_EQ(0u, global.URIPathMap().count("globaltest://"));
+
+  sdf::addURIPath("globaltest://", testDir);
+  ASSERT_EQ(1u, global.URIPathMap().count("globaltest://"));
+  EXPECT_EQ(testDir, global.URIPathMap().at("globaltest://")[0]);
+
+  sdf::setFindCallback([](const std::string &)
+      {
+        return std::string("global_found");
+      });
+  ASSERT_TRUE(global.FindFileCallback());
+  EXPECT_EQ("global_found", global.FindFileCallback()("test"));
+  EXPECT_EQ("global_found", sdf::findFile("missing_file.sdf", false, true));
+}
+
+/////////////////////////////////////////////////
+TEST(ParserConfig, FindFileCache)
+{
+  const std::string sdfDir = sdf::filesystem::append(PROJECT_SOURCE_PATH,
+      "test", "sdf");
+
+  int calls = 0;
+  sdf::ParserConfig config;
+  config.SetFindCallback([&calls](const std::string &_file)
+      {
+        ++calls;
+        return _file.find("cached") == 0 ? _file + "_found" : std::string();
+      });
+
+  // Without the cache every lookup calls the callback.
+  EXPECT_FALSE(config.FindFileCacheEnabled());
+  EXPECT_EQ("cached.sdf_found",
+      sdf::findFile("cached.sdf", false, true, config));
+  EXPECT_EQ("cached.sdf_found",
+      sdf::findFile("cached.sdf", false, true, config));
+  EXPECT_EQ(2, calls);
+
+  // With the cache, found and missing files are only searched for once.
+  config.SetFindFileCacheEnabled(true);
+  EXPECT_TRUE(config.FindFileCacheEnabled());
+  calls = 0;
+  for (int i = 0; i < 3; ++i)
+  {
+    EXPECT_EQ("cached.sdf_found",
+        sdf::findFile("cached.sdf", false, true, config));
+    EXPECT_TRUE(sdf::findFile("missing.sdf", false, true, config).empty());
+  }
+  EXPECT_EQ(2, calls);
+
+  // The search flags are part of the lookup.
+  EXPECT_EQ("cached.sdf_found",
+      sdf::findFile("cached.sdf", true, true, config));
+  EXPECT_EQ(3, calls);
+
+  // Explicit invalidation.
+  config.ClearFindFileCache();
+  EXPECT_EQ("cached.sdf_found",
+      sdf::findFile("cached.sdf", false, true, config));
+  EXPECT_EQ(4, calls);
+
+  // Adding a URI path invalidates the cache, so a file that was missing can
+  // be found.
+  EXPECT_TRUE(sdf::findFile("test://empty.sdf", false, true, config).empty());
+  EXPECT_EQ(5, calls);
+  config.AddURIPath("test://", sdfDir);
+  EXPECT_EQ(sdf::filesystem::append(sdfDir, "empty.sdf"),
+      sdf::findFile("test://empty.sdf", false, true, config));
+  EXPECT_EQ(5, calls);
+
+  // So does setting the callback.
+  config.SetFindCallback([&calls](const std::string &)
+      {
+        ++calls;
+        return std::string("new_callback");
+      });
+  EXPECT_EQ("new_callback",
+      sdf::findFile("cached.sdf", false, true, config));
+  EXPECT_EQ(6, calls);
+
+  // Copies have a cache of their own.
+  sdf::ParserConfig copy(config);
+  EXPECT_TRUE(copy.FindFileCacheEnabled());
+  EXPECT_EQ("new_callback", sdf::findFile("cached.sdf", false, true, copy));
+  EXPECT_EQ(7, calls);
+
+  config.SetFindFileCacheEnabled(false);
+  EXPECT_FALSE(config.FindFileCacheEnabled());
+  EXPECT_EQ("new_callback",
+      sdf::findFile("cached.sdf", false, true, config));
+  EXPECT_EQ(8, calls);
+}
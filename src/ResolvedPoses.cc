@@ -0,0 +1,174 @@
+/*
+ * Copyright 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "sdf/ResolvedPoses.hh"
+
+using namespace sdf;
+
+/// \brief Private ResolvedPoses data.
+class sdf::ResolvedPosesPrivate
+{
+  /// \brief Name of the frame relative to which the poses are resolved.
+  public: std::string resolveTo;
+
+  /// \brief Scoped names of the objects.
+  public: std::vector<std::string> names;
+
+  /// \brief Types of the objects.
+  public: std::vector<ResolvedPoses::PoseType> types;
+
+  /// \brief Positions of the objects.
+  public: std::vector<ignition::math::Vector3d> positions;
+
+  /// \brief Orientations of the objects.
+  public: std::vector<ignition::math::Quaterniond> orientations;
+
+  /// \brief Map from names to indices.
+  public: std::unordered_map<std::string, std::size_t> indices;
+};
+
+/////////////////////////////////////////////////
+ResolvedPoses::ResolvedPoses()
+  : dataPtr(new ResolvedPosesPrivate)
+{
+}
+
+/////////////////////////////////////////////////
+ResolvedPoses::ResolvedPoses(const ResolvedPoses &_poses)
+  : dataPtr(new ResolvedPosesPrivate(*_poses.dataPtr))
+{
+}
+
+/////////////////////////////////////////////////
+ResolvedPoses::ResolvedPoses(ResolvedPoses &&_poses) noexcept
+  : dataPtr(std::exchange(_poses.dataPtr, nullptr))
+{
+}
+
+/////////////////////////////////////////////////
+ResolvedPoses::~ResolvedPoses()
+{
+  delete this->dataPtr;
+  this->dataPtr = nullptr;
+}
+
+/////////////////////////////////////////////////
+ResolvedPoses &ResolvedPoses::operator=(const ResolvedPoses &_poses)
+{
+  return *this = ResolvedPoses(_poses);
+}
+
+/////////////////////////////////////////////////
+ResolvedPoses &ResolvedPoses::operator=(ResolvedPoses &&_poses) noexcept
+{
+  std::swap(this->dataPtr, _poses.dataPtr);
+  return *this;
+}
+
+/////////////////////////////////////////////////
+std::size_t ResolvedPoses::Count() const
+{
+  return this->dataPtr->names.size();
+}
+
+/////////////////////////////////////////////////
+const std::string &ResolvedPoses::ResolveTo() const
+{
+  return this->dataPtr->resolveTo;
+}
+
+/////////////////////////////////////////////////
+void ResolvedPoses::SetResolveTo(const std::string &_resolveTo)
+{
+  this->dataPtr->resolveTo = _resolveTo;
+}
+
+/////////////////////////////////////////////////
+const std::vector<std::string> &ResolvedPoses::Names() const
+{
+  return this->dataPtr->names;
+}
+
+/////////////////////////////////////////////////
+const std::vector<ResolvedPoses::PoseType> &ResolvedPoses::Types() const
+{
+  return this->dataPtr->types;
+}
+
+/////////////////////////////////////////////////
+const std::vector<ignition::math::Vector3d> &ResolvedPoses::Positions() const
+{
+  return this->dataPtr->positions;
+}
+
+/////////////////////////////////////////////////
+const std::vector<ignition::math::Quaterniond> &
+ResolvedPoses::Orientations() const
+{
+  return this->dataPtr->orientations;
+}
+
+/////////////////////////////////////////////////
+ignition::math::Pose3d ResolvedPoses::PoseByIndex(std::size_t _index) const
+{
+  return ignition::math::Pose3d(this->dataPtr->positions[_index],
+                                this->dataPtr->orientations[_index]);
+}
+
+/////////////////////////////////////////////////
+std::size_t ResolvedPoses::IndexByName(const std::string &_name) const
+{
+  auto it = this->dataPtr->indices.find(_name);
+  return it == this->dataPtr->indices.end() ? this->Count() : it->second;
+}
+
+/////////////////////////////////////////////////
+void ResolvedPoses::Add(const std::string &_name, PoseType _type,
+                        const ignition::math::Pose3d &_pose)
+{
+  this->dataPtr->indices.emplace(_name, this->Count());
+  this->dataPtr->names.push_back(_name);
+  this->dataPtr->types.push_back(_type);
+  this->dataPtr->positions.push_back(_pose.Pos());
+  this->dataPtr->orientations.push_back(_pose.Rot());
+}
+
+/////////////////////////////////////////////////
+void ResolvedPoses::Reserve(std::size_t _count)
+{
+  this->dataPtr->names.reserve(_count);
+  this->dataPtr->types.reserve(_count);
+  this->dataPtr->positions.reserve(_count);
+  this->dataPtr->orientations.reserve(_count);
+  this->dataPtr->indices.reserve(_count);
+}
+
+/////////////////////////////////////////////////
+void ResolvedPoses::Clear()
+{
+  this->dataPtr->resolveTo.clear();
+  this->dataPtr->names.clear();
+  this->dataPtr->types.clear();
+  this->dataPtr->positions.clear();
+  this->dataPtr->orientations.clear();
+  this->dataPtr->indices.clear();
+}
@@ -0,0 +1,83 @@
+/*
+ * Copyright 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <gtest/gtest.h>
+#include <string>
+#include <utility>
+
+#include <ignition/math/Pose3.hh>
+
+#include "sdf/ResolvedPoses.hh"
+
+/////////////////////////////////////////////////
+TEST(DOMResolvedPoses, Construction)
+{
+  sdf::ResolvedPoses poses;
+  EXPECT_EQ(0u, poses.Count());
+  EXPECT_TRUE(poses.ResolveTo().empty());
+  EXPECT_TRUE(poses.Names().empty());
+  EXPECT_TRUE(poses.Types().empty());
+  EXPECT_TRUE(poses.Positions().empty());
+  EXPECT_TRUE(poses.Orientations().empty());
+  EXPECT_EQ(0u, poses.IndexByName("link"));
+}
+
+/////////////////////////////////////////////////
+TEST(DOMResolvedPoses, Add)
+{
+  using PoseType = sdf::ResolvedPoses::PoseType;
+
+  sdf::ResolvedPoses poses;
+  poses.SetResolveTo("__model__");
+  poses.Reserve(2);
+  poses.Add("link", PoseType::LINK,
+      ignition::math::Pose3d(1, 2, 3, 0, 0, IGN_PI_2));
+  poses.Add("link::visual", PoseType::VISUAL,
+      ignition::math::Pose3d(4, 5, 6, 0, 0, 0));
+
+  EXPECT_EQ("__model__", poses.ResolveTo());
+  ASSERT_EQ(2u, poses.Count());
+  EXPECT_EQ("link", poses.Names()[0]);
+  EXPECT_EQ("link::visual", poses.Names()[1]);
+  EXPECT_EQ(PoseType::LINK, poses.Types()[0]);
+  EXPECT_EQ(PoseType::VISUAL, poses.Types()[1]);
+  EXPECT_EQ(ignition::math::Vector3d(1, 2, 3), poses.Positions()[0]);
+  EXPECT_EQ(ignition::math::Quaterniond(0, 0, IGN_PI_2),
+      poses.Orientations()[0]);
+  EXPECT_EQ(ignition::math::Pose3d(4, 5, 6, 0, 0, 0), poses.PoseByIndex(1));
+
+  EXPECT_EQ(0u, poses.IndexByName("link"));
+  EXPECT_EQ(1u, poses.IndexByName("link::visual"));
+  EXPECT_EQ(2u, poses.IndexByName("visual"));
+
+  // Copies are independent.
+  sdf::ResolvedPoses copy(poses);
+  poses.Clear();
+  EXPECT_EQ(0u, poses.Count());
+  EXPECT_TRUE(poses.ResolveTo().empty());
+  EXPECT_EQ(0u, poses.IndexByName("link"));
+  ASSERT_EQ(2u, copy.Count());
+  EXPECT_EQ(1u, copy.IndexByName("link::visual"));
+
+  sdf::ResolvedPoses assigned;
+  assigned = copy;
+  EXPECT_EQ(2u, assigned.Count());
+
+  sdf::ResolvedPoses moved(std::move(assigned));
+  EXPECT_EQ(2u, moved.Count());
+  EXPECT_EQ("__model__", moved.ResolveTo());
+}
@@ -15,6 +15,7 @@
  *
 */
 #include <string>
+#include <string_view>
 #include <vector>
 #include <utility>
 
@@ -72,20 +73,40 @@ class sdf::RootPrivate
 
 /////////////////////////////////////////////////
 template <typename T>
-sdf::ScopedGraph<FrameAttachedToGraph> addFrameAttachedToGraph(
-    std::vector<sdf::ScopedGraph<sdf::FrameAttachedToGraph>> &_graphList,
+void buildAndValidateFrameAttachedToGraph(
+    sdf::ScopedGraph<sdf::FrameAttachedToGraph> &_frameGraph,
     const T &_domObj, sdf::Errors &_errors)
 {
-  auto &frameGraph =
-      _graphList.emplace_back(std::make_shared<FrameAttachedToGraph>());
-
   sdf::Errors buildErrors =
-      sdf::buildFrameAttachedToGraph(frameGraph, &_domObj);
+      sdf::buildFrameAttachedToGraph(_frameGraph, &_domObj);
+  _errors.insert(_errors.end(), buildErrors.begin(), buildErrors.end());
+
+  sdf::Errors validateErrors = sdf::validateFrameAttachedToGraph(_frameGraph);
+  _errors.insert(_errors.end(), validateErrors.begin(), validateErrors.end());
+}
+
+/////////////////////////////////////////////////
+template <typename T>
+void buildAndValidatePoseRelativeToGraph(
+    sdf::ScopedGraph<sdf::PoseRelativeToGraph> &_poseGraph,
+    const T &_domObj, Errors &_errors)
+{
+  Errors buildErrors = buildPoseRelativeToGraph(_poseGraph, &_domObj);
   _errors.insert(_errors.end(), buildErrors.begin(), buildErrors.end());
 
-  sdf::Errors validateErrors = sdf::validateFrameAttachedToGraph(frameGraph);
+  Errors validateErrors = validatePoseRelativeToGraph(_poseGraph);
   _errors.insert(_errors.end(), validateErrors.begin(), validateErrors.end());
+}
 
+/////////////////////////////////////////////////
+template <typename T>
+sdf::ScopedGraph<FrameAttachedToGraph> addFrameAttachedToGraph(
+    std::vector<sdf::ScopedGraph<sdf::FrameAttachedToGraph>> &_graphList,
+    const T &_domObj, sdf::Errors &_errors)
+{
+  auto &frameGraph =
+      _graphList.emplace_back(std::make_shared<FrameAttachedToGraph>());
+  buildAndValidateFrameAttachedToGraph(frameGraph, _domObj, _errors);
   return frameGraph;
 }
 
@@ -97,13 +118,7 @@ ScopedGraph<PoseRelativeToGraph> addPoseRelativeToGraph(
 {
   auto &poseGraph =
       _graphList.emplace_back(std::make_shared<sdf::PoseRelativeToGraph>());
-
-  Errors buildErrors = buildPoseRelativeToGraph(poseGraph, &_domObj);
-  _errors.insert(_errors.end(), buildErrors.begin(), buildErrors.end());
-
-  Errors validateErrors = validatePoseRelativeToGraph(poseGraph);
-  _errors.insert(_errors.end(), validateErrors.begin(), validateErrors.end());
-
+  buildAndValidatePoseRelativeToGraph(poseGraph, _domObj, _errors);
   return poseGraph;
 }
 
@@ -135,11 +150,17 @@ Root::~Root()
 
 /////////////////////////////////////////////////
 Errors Root::Load(const std::string &_filename)
+{
+  return this->Load(_filename, ParserConfig::GlobalConfig());
+}
+
+/////////////////////////////////////////////////
+Errors Root::Load(const std::string &_filename, const ParserConfig &_config)
 {
   Errors errors;
 
   // Read an SDF file, and store the result in sdfParsed.
-  SDFPtr sdfParsed = readFile(_filename, errors);
+  SDFPtr sdfParsed = readFile(_filename, _config, errors);
 
   // Return if we were not able to read the file.
   if (!sdfParsed)
@@ -149,28 +170,36 @@ Errors Root::Load(const std::string &_filename)
     return errors;
   }
 
-  Errors loadErrors = this->Load(sdfParsed);
+  Errors loadErrors = this->Load(sdfParsed, _config);
   errors.insert(errors.end(), loadErrors.begin(), loadErrors.end());
 
   return errors;
 }
 
 /////////////////////////////////////////////////
-Errors Root::LoadSdfString(const std::string &_sdf)
+Errors Root::LoadSdfString(std::string_view _sdf)
+{
+  return this->LoadSdfString(_sdf, ParserConfig::GlobalConfig());
+}
+
+/////////////////////////////////////////////////
+Errors Root::LoadSdfString(std::string_view _sdf,
+                           const ParserConfig &_config)
 {
   Errors errors;
   SDFPtr sdfParsed(new SDF());
   init(sdfParsed);
 
   // Read an SDF string, and store the result in sdfParsed.
-  if (!readString(_sdf, sdfParsed, errors))
+  if (!readString(_sdf, _config, sdfParsed, errors))
   {
     errors.push_back(
-        {ErrorCode::STRING_READ, "Unable to SDF string: " + _sdf});
+        {ErrorCode::STRING_READ,
+         "Unable to SDF string: " + std::string(_sdf)});
     return errors;
   }
 
-  Errors loadErrors = this->Load(sdfParsed);
+  Errors loadErrors = this->Load(sdfParsed, _config);
   errors.insert(errors.end(), loadErrors.begin(), loadErrors.end());
 
   return errors;
@@ -178,6 +207,12 @@ Errors Root::LoadSdfString(const std::string &_sdf)
 
 /////////////////////////////////////////////////
 Errors Root::Load(SDFPtr _sdf)
+{
+  return this->Load(_sdf, ParserConfig::GlobalConfig());
+}
+
+/////////////////////////////////////////////////
+Errors Root::Load(SDFPtr _sdf, const ParserConfig &_config)
 {
   Errors errors;
 
@@ -218,7 +253,7 @@ Errors Root::Load(SDFPtr _sdf)
     {
       World world;
 
-      Errors worldErrors = world.Load(elem);
+      Errors worldErrors = world.Load(elem, _config);
 
       // Build the graphs.
       auto frameAttachedToGraph = addFrameAttachedToGraph(
@@ -255,20 +290,45 @@ Errors Root::Load(SDFPtr _sdf)
 
   // Load all the models.
   Errors modelLoadErrors = loadUniqueRepeated<Model>(
-      this->dataPtr->sdf, "model", this->dataPtr->models);
+      this->dataPtr->sdf, "model", this->dataPtr->models,
+      _config.ModelLoadThreadCount());
   errors.insert(errors.end(), modelLoadErrors.begin(), modelLoadErrors.end());
 
-  // Build the graphs.
-  for (sdf::Model &model : this->dataPtr->models)
+  // Build the graphs. The graphs of each model are independent, so they are
+  // built concurrently when requested and their errors are added in model
+  // order.
+  auto &models = this->dataPtr->models;
+  const std::size_t firstGraph =
+      this->dataPtr->modelFrameAttachedToGraphs.size();
+  for (std::size_t i = 0; i < models.size(); ++i)
   {
-    auto frameAttachedToGraph = addFrameAttachedToGraph(
-        this->dataPtr->modelFrameAttachedToGraphs, model, errors);
-
-    model.SetFrameAttachedToGraph(frameAttachedToGraph);
+    this->dataPtr->modelFrameAttachedToGraphs.emplace_back(
+        std::make_shared<FrameAttachedToGraph>());
+    this->dataPtr->modelPoseRelativeToGraphs.emplace_back(
+        std::make_shared<PoseRelativeToGraph>());
+  }
 
-    auto poseRelativeToGraph = addPoseRelativeToGraph(
-        this->dataPtr->modelPoseRelativeToGraphs, model, errors);
-    model.SetPoseRelativeToGraph(poseRelativeToGraph);
+  std::vector<Errors> graphErrors(models.size());
+  parallelFor(models.size(), _config.ModelLoadThreadCount(),
+      [&](std::size_t _i)
+      {
+        auto &frameAttachedToGraph =
+            this->dataPtr->modelFrameAttachedToGraphs[firstGraph + _i];
+        buildAndValidateFrameAttachedToGraph(
+            frameAttachedToGraph, models[_i], graphErrors[_i]);
+        models[_i].SetFrameAttachedToGraph(frameAttachedToGraph);
+
+        auto &poseRelativeToGraph =
+            this->dataPtr->modelPoseRelativeToGraphs[firstGraph + _i];
+        buildAndValidatePoseRelativeToGraph(
+            poseRelativeToGraph, models[_i], graphErrors[_i]);
+        models[_i].SetPoseRelativeToGraph(poseRelativeToGraph);
+      });
+
+  for (const Errors &modelGraphErrors : graphErrors)
+  {
+    errors.insert(errors.end(), modelGraphErrors.begin(),
+        modelGraphErrors.end());
   }
 
   // Load all the lights.
@@ -310,6 +370,14 @@ const World *Root::WorldByIndex(const uint64_t _index) const
   return nullptr;
 }
 
+/////////////////////////////////////////////////
+World *Root::WorldByIndex(const uint64_t _index)
+{
+  if (_index < this->dataPtr->worlds.size())
+    return &this->dataPtr->worlds[_index];
+  return nullptr;
+}
+
 /////////////////////////////////////////////////
 bool Root::WorldNameExists(const std::string &_name) const
 {
@@ -19,8 +19,9 @@
 #include <fstream>
 #include <sstream>
 #include <functional>
-#include <list>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -28,59 +29,113 @@
 #include "sdf/Assert.hh"
 #include "sdf/Console.hh"
 #include "sdf/Filesystem.hh"
+#include "sdf/ParserConfig.hh"
 #include "sdf/SDFImpl.hh"
 #include "SDFImplPrivate.hh"
 #include "sdf/sdf_config.h"
 #include "EmbeddedSdf.hh"
+#include "FindFileCache.hh"
 
 namespace sdf
 {
 inline namespace SDF_VERSION_NAMESPACE
 {
-typedef std::list<std::string> PathList;
-typedef std::map<std::string, PathList> URIPathMap;
-
-static URIPathMap g_uriPathMap;
-
-static std::function<std::string(const std::string &)> g_findFileCB;
-
 std::string SDF::version = SDF_VERSION;
 
+/// \brief Mutex that protects SDF::version.
+static std::mutex g_versionMutex;
+
 /////////////////////////////////////////////////
 // cppcheck-suppress passedByValue
 void setFindCallback(std::function<std::string(const std::string &)> _cb)
 {
-  g_findFileCB = _cb;
+  ParserConfig::GlobalConfig().SetFindCallback(_cb);
 }
 
 /////////////////////////////////////////////////
 std::string findFile(const std::string &_filename, bool _searchLocalPath,
                           bool _useCallback)
+{
+  return findFile(_filename, _searchLocalPath, _useCallback,
+                  ParserConfig::GlobalConfig());
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the value of the SDF_PATH environment variable.
+/// \return The value, or an empty string if it is not set.
+static std::string sdfPathVariable()
+{
+#ifndef _WIN32
+  const char *pathCStr = std::getenv("SDF_PATH");
+  return pathCStr ? std::string(pathCStr) : std::string();
+#else
+  char *pathCStr = nullptr;
+  size_t sz = 0;
+  _dupenv_s(&pathCStr, &sz, "SDF_PATH");
+  std::string value = pathCStr ? std::string(pathCStr) : std::string();
+  free(pathCStr);
+  return value;
+#endif
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the paths listed in the SDF_PATH environment variable. The
+/// variable is split once for each value it takes.
+/// \param[in] _value Value of the SDF_PATH environment variable.
+/// \return The colon separated paths of _value.
+static std::shared_ptr<const std::vector<std::string>> sdfPaths(
+    const std::string &_value)
+{
+  static std::mutex mutex;
+  static std::string cachedValue;
+  static auto cachedPaths = std::make_shared<const std::vector<std::string>>();
+
+  std::lock_guard<std::mutex> lock(mutex);
+  if (_value != cachedValue)
+  {
+    cachedPaths = std::make_shared<const std::vector<std::string>>(
+        sdf::split(_value, ":"));
+    cachedValue = _value;
+  }
+  return cachedPaths;
+}
+
+/////////////////////////////////////////////////
+/// \brief Search for a file without using the findFile cache.
+/// \param[in] _filename Name of the file to find.
+/// \param[in] _searchLocalPath True to search for the file in the current
+/// working directory.
+/// \param[in] _useCallback True to find a file based on a registered
+/// callback if the file is not found via the normal mechanism.
+/// \param[in] _config Custom parser configuration.
+/// \param[in] _sdfPath Value of the SDF_PATH environment variable.
+/// \return File's full path.
+static std::string findFileUncached(const std::string &_filename,
+    bool _searchLocalPath, bool _useCallback, const ParserConfig &_config,
+    const std::string &_sdfPath)
 {
   std::string path = _filename;
 
   // Check to see if _filename is URI. If so, resolve the URI path.
-  for (URIPathMap::iterator iter = g_uriPathMap.begin();
-       iter != g_uriPathMap.end(); ++iter)
+  for (const auto &[uri, paths] : _config.URIPathMap())
   {
-    // Check to see if the URI in the global map is the first part of the
+    // Check to see if the URI in the map is the first part of the
     // given filename
     // cppcheck-suppress stlIfStrFind
-    if (_filename.find(iter->first) == 0)
+    if (_filename.find(uri) == 0)
     {
       std::string suffix = _filename;
-      size_t index = suffix.find(iter->first);
+      size_t index = suffix.find(uri);
       if (index != std::string::npos)
       {
-        suffix.replace(index, iter->first.length(), "");
+        suffix.replace(index, uri.length(), "");
       }
 
       // Check each path in the list.
-      for (PathList::iterator pathIter = iter->second.begin();
-           pathIter != iter->second.end(); ++pathIter)
+      for (const auto &uriPath : paths)
       {
         // Return the path string if the path + suffix exists.
-        std::string pathSuffix = sdf::filesystem::append(*pathIter, suffix);
+        std::string pathSuffix = sdf::filesystem::append(uriPath, suffix);
         if (sdf::filesystem::exists(pathSuffix))
         {
           return pathSuffix;
@@ -122,21 +177,11 @@ std::string findFile(const std::string &_filename, bool _searchLocalPath,
   }
 
   // Next check SDF_PATH environment variable
-#ifndef _WIN32
-  const char *pathCStr = std::getenv("SDF_PATH");
-#else
-  char *pathCStr;
-  size_t sz = 0;
-  _dupenv_s(&pathCStr, &sz, "SDF_PATH");
-#endif
-
-  if (pathCStr)
+  if (!_sdfPath.empty())
   {
-    std::vector<std::string> paths = sdf::split(pathCStr, ":");
-    for (std::vector<std::string>::iterator iter = paths.begin();
-         iter != paths.end(); ++iter)
+    for (const auto &sdfPath : *sdfPaths(_sdfPath))
     {
-      path = sdf::filesystem::append(*iter, filename);
+      path = sdf::filesystem::append(sdfPath, filename);
       if (sdf::filesystem::exists(path))
       {
         return path;
@@ -158,7 +203,8 @@ std::string findFile(const std::string &_filename, bool _searchLocalPath,
   // flag has been set
   if (_useCallback)
   {
-    if (!g_findFileCB)
+    auto findFileCB = _config.FindFileCallback();
+    if (!findFileCB)
     {
       sdferr << "Tried to use callback in sdf::findFile(), but the callback "
         "is empty.  Did you call sdf::setFindCallback()?";
@@ -166,7 +212,7 @@ std::string findFile(const std::string &_filename, bool _searchLocalPath,
     }
     else
     {
-      return g_findFileCB(_filename);
+      return findFileCB(_filename);
     }
   }
 
@@ -174,21 +220,46 @@ std::string findFile(const std::string &_filename, bool _searchLocalPath,
 }
 
 /////////////////////////////////////////////////
-void addURIPath(const std::string &_uri, const std::string &_path)
+std::string findFile(const std::string &_filename, bool _searchLocalPath,
+                     bool _useCallback, const ParserConfig &_config)
 {
-  // Split _path on colons.
-  std::vector<std::string> parts = sdf::split(_path, ":");
+  const std::string sdfPath = sdfPathVariable();
 
-  // Add each part of the colon separated path to the global URI map.
-  for (std::vector<std::string>::iterator iter = parts.begin();
-       iter != parts.end(); ++iter)
+  FindFileCache *cache = findFileCache(_config);
+  if (!cache)
   {
-    // Only add valid paths
-    if (!(*iter).empty() && sdf::filesystem::is_directory(*iter))
-    {
-      g_uriPathMap[_uri].push_back(*iter);
-    }
+    return findFileUncached(_filename, _searchLocalPath, _useCallback,
+                            _config, sdfPath);
+  }
+
+  // The key captures every input of the search other than the contents of
+  // the file system.
+  std::string key;
+  key.reserve(_filename.size() + sdfPath.size() + 64);
+  key += _searchLocalPath ? '1' : '0';
+  key += _useCallback ? '1' : '0';
+  key += SDF::Version();
+  key += '\n';
+  key += sdf::filesystem::current_path();
+  key += '\n';
+  key += sdfPath;
+  key += '\n';
+  key += _filename;
+
+  std::string path;
+  if (!cache->Find(key, path))
+  {
+    path = findFileUncached(_filename, _searchLocalPath, _useCallback,
+                            _config, sdfPath);
+    cache->Insert(key, path);
   }
+  return path;
+}
+
+/////////////////////////////////////////////////
+void addURIPath(const std::string &_uri, const std::string &_path)
+{
+  ParserConfig::GlobalConfig().AddURIPath(_uri, _path);
 }
 
 /////////////////////////////////////////////////
@@ -424,12 +495,14 @@ const std::string &SDF::OriginalVersion() const
 /////////////////////////////////////////////////
 std::string SDF::Version()
 {
+  std::lock_guard<std::mutex> lock(g_versionMutex);
   return version;
 }
 
 /////////////////////////////////////////////////
 void SDF::Version(const std::string &_version)
 {
+  std::lock_guard<std::mutex> lock(g_versionMutex);
   version = _version;
 }
 
@@ -21,6 +21,7 @@
 #include <algorithm>
 #include <memory>
 #include <string>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -87,32 +88,13 @@ class ScopedGraph
       "Template parameter has to be either sdf::PoseRelativeToGraph or "
       "sdf::FrameAttachedToGraph");
 
-  /// \brief template for extracting the graph type from the template parameter.
-  /// \tparam G ignition::math::DirectedGraph type
-  /// \return Vertex and Edge types of G
-  public: template <typename G>
-          struct GraphTypeExtracter
-  {
-    using Vertex = void;
-    using Edge = void;
-  };
-
-  /// \brief Specialization for GraphTypeExtracter on
-  /// ignition::math::DirectedGraph
-  public: template <typename V, typename E>
-          struct GraphTypeExtracter<ignition::math::graph::DirectedGraph<V, E>>
-  {
-    using Vertex = V;
-    using Edge = E;
-  };
-
   // Type aliases
-  public: using MathGraphType = typename T::GraphType;
+  public: using GraphType = typename T::GraphType;
   public: using VertexId = ignition::math::graph::VertexId;
-  public: using VertexType = typename GraphTypeExtracter<MathGraphType>::Vertex;
-  public: using EdgeType = typename GraphTypeExtracter<MathGraphType>::Edge;
-  public: using Vertex = ignition::math::graph::Vertex<VertexType>;
-  public: using Edge = ignition::math::graph::DirectedEdge<EdgeType>;
+  public: using VertexType = typename GraphType::VertexType;
+  public: using EdgeType = typename GraphType::EdgeType;
+  public: using Vertex = typename GraphType::Vertex;
+  public: using Edge = typename GraphType::Edge;
   public: using MapType = typename T::MapType;
 
   /// \brief Default constructor. The constructed object is invalid as it
@@ -144,12 +126,16 @@ class ScopedGraph
 
   /// \brief Immutable reference to the underlying PoseRelativeTo::graph or
   /// FrameAttachedTo::graph.
-  public: const MathGraphType &Graph() const;
+  public: const GraphType &Graph() const;
 
   /// \brief Immutable reference to the underlying PoseRelativeTo::map or
   /// FrameAttachedTo::map.
   public: const MapType &Map() const;
 
+  /// \brief Immutable reference to the underlying PoseRelativeToGraph or
+  /// FrameAttachedToGraph, which also holds the data cached from the graph.
+  public: const T &GraphData() const;
+
   /// \brief Adds a scope vertex to the graph. This creates a new
   /// scope by making a copy of the current scope with a new prefix and scope
   /// type name. A new scope vertex is then added to the graph.
@@ -179,7 +165,7 @@ class ScopedGraph
               const EdgeType &_data);
 
   /// \brief Gets all the local names of the vertices in the current scope.
-  /// \return A list of vertex names in the current scope.
+  /// \return A sorted list of vertex names in the current scope.
   public: std::vector<std::string> VertexNames() const;
 
   /// \brief Get the local name of a vertex.
@@ -194,13 +180,29 @@ class ScopedGraph
   /// graph, "__null__" will be returned.
   public: std::string VertexLocalName(const Vertex &_vertex) const;
 
-  /// \brief Update the information contained by an edge
-  /// \remark Since this function has to remove the edge from the graph and add
-  /// a new one, the original edge will have a new ID.
-  /// \param[in] _edge The edge to update.
+  /// \brief Update the information contained by an edge. The edge keeps its
+  /// ID.
+  /// \param[in,out] _edge The edge to update. It is set to the updated edge.
   /// \param[in] _data The new data.
   public: void UpdateEdge(Edge &_edge, const EdgeType &_data);
 
+  /// \brief Update the information contained by several edges, which keep
+  /// their IDs. The data cached from the graph is updated once for all the
+  /// edges, which is cheaper than updating them one at a time.
+  /// \param[in] _updates IDs of the edges and their new data.
+  public: void UpdateEdges(
+              const std::vector<std::pair<ignition::math::graph::EdgeId,
+                                          EdgeType>> &_updates);
+
+  /// \brief Move an edge to other vertices and update its data. The edge
+  /// keeps its ID.
+  /// \param[in,out] _edge The edge to update. It is set to the updated edge.
+  /// \param[in] _vertexPair IDs of the new tail and head vertices.
+  /// \param[in] _data The new data.
+  public: void UpdateEdge(Edge &_edge,
+              const ignition::math::graph::VertexId_P &_vertexPair,
+              const EdgeType &_data);
+
   /// \brief Count the number of vertices with a given local name in the scope.
   /// \param[in] _name Local name query
   /// \return Number of vertices that have the given local name in the scope.
@@ -247,6 +249,10 @@ class ScopedGraph
   public: std::pair<std::string, bool> FindAndRemovePrefix(
               const std::string &_name) const;
 
+  /// \brief Discard the data cached from the graph after it has been
+  /// modified.
+  private: void InvalidateCaches();
+
   /// \brief Shared pointer to either a FrameAttachedToGraph or
   /// PoseRelativeToGraph.
   private: std::shared_ptr<T> graphPtr;
@@ -286,7 +292,7 @@ ScopedGraph<T>::operator bool() const
 
 /////////////////////////////////////////////////
 template <typename T>
-auto ScopedGraph<T>::Graph() const -> const MathGraphType &
+auto ScopedGraph<T>::Graph() const -> const GraphType &
 {
   return this->graphPtr->graph;
 }
@@ -298,6 +304,13 @@ auto ScopedGraph<T>::Map() const -> const MapType &
   return this->graphPtr->map;
 }
 
+/////////////////////////////////////////////////
+template <typename T>
+const T &ScopedGraph<T>::GraphData() const
+{
+  return *this->graphPtr;
+}
+
 /////////////////////////////////////////////////
 template <typename T>
 ScopedGraph<T> ScopedGraph<T>::AddScopeVertex(const std::string &_prefix,
@@ -321,6 +334,7 @@ auto ScopedGraph<T>::AddVertex(
   const std::string newName = this->AddPrefix(_name);
   Vertex &vert = this->graphPtr->graph.AddVertex(newName, _data);
   this->graphPtr->map[newName] = vert.Id();
+  this->InvalidateCaches();
   return vert;
 }
 
@@ -331,6 +345,7 @@ auto ScopedGraph<T>::AddEdge(
     -> Edge &
 {
   Edge &edge = this->graphPtr->graph.AddEdge(_vertexPair, _data);
+  this->InvalidateCaches();
   return edge;
 }
 
@@ -347,6 +362,8 @@ std::vector<std::string> ScopedGraph<T>::VertexNames() const
       out.push_back(idNamePair.first);
     }
   }
+  // The map is unordered, so sort the names to keep the output stable.
+  std::sort(out.begin(), out.end());
   return out;
 }
 
@@ -368,13 +385,69 @@ std::string ScopedGraph<T>::VertexLocalName(const VertexId &_id) const
 template <typename T>
 void ScopedGraph<T>::UpdateEdge(Edge &_edge, const EdgeType &_data)
 {
-  // There's no API to update the data of an edge, so we remove the edge and
-  // insert a new one with the new pose.
-  auto tailVertexId = _edge.Tail();
-  auto headVertexId = _edge.Head();
   auto &graph = this->graphPtr->graph;
-  graph.RemoveEdge(_edge.Id());
-  _edge = graph.AddEdge({tailVertexId, headVertexId}, _data);
+  if (!graph.SetEdgeData(_edge.Id(), _data))
+    return;
+  _edge = graph.EdgeFromId(_edge.Id());
+
+  // The shape of the graph didn't change, so only the poses of the
+  // vertices below the edge need to be updated. The sinks of the
+  // FrameAttachedToGraph don't depend on the data of the edges.
+  if constexpr (std::is_same_v<T, sdf::PoseRelativeToGraph>)
+  {
+    this->graphPtr->rootPoses.UpdatePoses(graph, {_edge.Head()});
+  }
+}
+
+/////////////////////////////////////////////////
+template <typename T>
+void ScopedGraph<T>::UpdateEdges(
+    const std::vector<std::pair<ignition::math::graph::EdgeId, EdgeType>>
+        &_updates)
+{
+  auto &graph = this->graphPtr->graph;
+  std::vector<ignition::math::graph::VertexId> heads;
+  for (const auto &[id, data] : _updates)
+  {
+    if (graph.SetEdgeData(id, data))
+      heads.push_back(graph.EdgeFromId(id).Head());
+  }
+
+  if constexpr (std::is_same_v<T, sdf::PoseRelativeToGraph>)
+  {
+    if (!heads.empty())
+      this->graphPtr->rootPoses.UpdatePoses(graph, heads);
+  }
+}
+
+/////////////////////////////////////////////////
+template <typename T>
+void ScopedGraph<T>::UpdateEdge(Edge &_edge,
+    const ignition::math::graph::VertexId_P &_vertexPair,
+    const EdgeType &_data)
+{
+  auto &graph = this->graphPtr->graph;
+  if (!graph.SetEdgeVertices(_edge.Id(), _vertexPair) ||
+      !graph.SetEdgeData(_edge.Id(), _data))
+  {
+    return;
+  }
+  _edge = graph.EdgeFromId(_edge.Id());
+  this->InvalidateCaches();
+}
+
+/////////////////////////////////////////////////
+template <typename T>
+void ScopedGraph<T>::InvalidateCaches()
+{
+  if constexpr (std::is_same_v<T, sdf::PoseRelativeToGraph>)
+  {
+    this->graphPtr->rootPoses.Invalidate();
+  }
+  else
+  {
+    this->graphPtr->sinks.Invalidate();
+  }
 }
 
 /////////////////////////////////////////////////
@@ -435,7 +435,7 @@ Errors Sensor::Load(ElementPtr _sdf)
 }
 
 /////////////////////////////////////////////////
-std::string Sensor::Name() const
+const std::string &Sensor::Name() const
 {
   return this->dataPtr->name;
 }
@@ -14,8 +14,23 @@
  * limitations under the License.
  *
 */
+#include <atomic>
+#include <cctype>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <exception>
+#include <limits>
+#include <locale>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
 #include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 #include "Utils.hh"
 
 namespace sdf
@@ -32,6 +47,42 @@ bool isReservedName(const std::string &_name)
        _name.compare(size-2, 2, "__") == 0);
 }
 
+/////////////////////////////////////////////////
+bool uniqueChildNames(const Element &_elem, const std::string &_type,
+                      std::set<std::string> *_duplicateTypes)
+{
+  bool result = true;
+
+  // Types of the checked children that use each name. A name is rarely
+  // shared by more than a couple of types, so a vector is enough here.
+  std::unordered_map<std::string, std::vector<std::string>> typesByName;
+
+  for (const ElementPtr &child : _elem.Children(_type))
+  {
+    ParamPtr nameParam = child->GetAttribute("name");
+    if (!nameParam)
+      continue;
+
+    std::string name;
+    nameParam->Get<std::string>(name);
+
+    std::vector<std::string> &types = typesByName[name];
+    if (!types.empty())
+    {
+      result = false;
+      if (!_duplicateTypes)
+        return result;
+    }
+
+    if (std::find(types.begin(), types.end(), child->GetName()) == types.end())
+      types.push_back(child->GetName());
+    else if (_duplicateTypes)
+      _duplicateTypes->insert(child->GetName());
+  }
+
+  return result;
+}
+
 /////////////////////////////////////////////////
 bool loadName(sdf::ElementPtr _sdf, std::string &_name)
 {
@@ -80,5 +131,235 @@ bool isValidFrameReference(const std::string &_name)
 {
   return "__root__" != _name;
 }
+
+/////////////////////////////////////////////////
+bool equalsLowercase(std::string_view _str, std::string_view _lower)
+{
+  if (_str.size() != _lower.size())
+  {
+    return false;
+  }
+
+  for (size_t i = 0; i < _str.size(); ++i)
+  {
+    if (std::tolower(static_cast<unsigned char>(_str[i])) != _lower[i])
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+/////////////////////////////////////////////////
+void skipSpace(const char *&_first, const char *_last)
+{
+  while (_first != _last && std::isspace(static_cast<unsigned char>(*_first)))
+  {
+    ++_first;
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Implementation of parseFloat for float and double.
+/// \param[in,out] _first Start of the input, advanced past the value.
+/// \param[in] _last End of the input.
+/// \param[out] _value Parsed value.
+/// \param[in] _scalar True to accept everything std::strtod accepts, such
+/// as hexadecimal values, infinity and NaN. False to accept only what a
+/// stream accepts, which is used for the components of math types.
+/// \return std::errc() on success, otherwise the error.
+template <typename T>
+static std::errc parseFloatImpl(const char *&_first, const char *_last,
+                                T &_value, bool _scalar)
+{
+  const char *iter = _first;
+  skipSpace(iter, _last);
+
+  bool negative = false;
+  if (iter != _last && (*iter == '+' || *iter == '-'))
+  {
+    negative = *iter == '-';
+    ++iter;
+  }
+
+  // std::from_chars and streams accept a minus sign of their own, so a
+  // second sign has to be rejected here.
+  if (iter != _last && (*iter == '+' || *iter == '-'))
+  {
+    return std::errc::invalid_argument;
+  }
+
+  bool hex = false;
+  if (_scalar)
+  {
+    if (_last - iter > 1 && iter[0] == '0' &&
+        (iter[1] == 'x' || iter[1] == 'X'))
+    {
+      hex = true;
+      iter += 2;
+    }
+  }
+  else if (iter == _last ||
+           !(std::isdigit(static_cast<unsigned char>(*iter)) || *iter == '.'))
+  {
+    return std::errc::invalid_argument;
+  }
+
+#if defined(__cpp_lib_to_chars)
+  auto result = std::from_chars(iter, _last, _value,
+      hex ? std::chars_format::hex : std::chars_format::general);
+  if (result.ec != std::errc())
+  {
+    return result.ec;
+  }
+  iter = result.ptr;
+#else
+  // Floating point std::from_chars is not available, so fall back to a
+  // stream with the classic locale. Hexadecimal values are read as integers
+  // and infinity and NaN are handled explicitly.
+  if (hex)
+  {
+    std::uint64_t hexValue = 0;
+    auto result = std::from_chars(iter, _last, hexValue, 16);
+    if (result.ec != std::errc())
+    {
+      return result.ec;
+    }
+    _value = static_cast<T>(hexValue);
+    iter = result.ptr;
+  }
+  else if (_scalar && _last - iter >= 3 &&
+           (equalsLowercase(std::string_view(iter, 3), "inf") ||
+            equalsLowercase(std::string_view(iter, 3), "nan")))
+  {
+    _value = equalsLowercase(std::string_view(iter, 3), "inf") ?
+        std::numeric_limits<T>::infinity() :
+        std::numeric_limits<T>::quiet_NaN();
+    iter += 3;
+    if (_last - iter >= 5 &&
+        equalsLowercase(std::string_view(iter, 5), "inity"))
+    {
+      iter += 5;
+    }
+  }
+  else
+  {
+    const char *end = iter;
+    while (end != _last && !std::isspace(static_cast<unsigned char>(*end)))
+    {
+      ++end;
+    }
+    std::istringstream ss(std::string(iter, end));
+    ss.imbue(std::locale::classic());
+    ss >> _value;
+    if (ss.fail())
+    {
+      return std::errc::invalid_argument;
+    }
+    if (!std::isfinite(_value))
+    {
+      return std::errc::result_out_of_range;
+    }
+    iter = ss.eof() ? end : iter + static_cast<std::streamoff>(ss.tellg());
+  }
+#endif
+
+  if (negative)
+  {
+    _value = -_value;
+  }
+  _first = iter;
+  return std::errc();
+}
+
+/////////////////////////////////////////////////
+std::errc parseFloat(const char *&_first, const char *_last,
+                     double &_value, bool _scalar)
+{
+  return parseFloatImpl(_first, _last, _value, _scalar);
+}
+
+/////////////////////////////////////////////////
+std::errc parseFloat(const char *&_first, const char *_last,
+                     float &_value, bool _scalar)
+{
+  return parseFloatImpl(_first, _last, _value, _scalar);
+}
+
+/////////////////////////////////////////////////
+double stringToDouble(const std::string &_str)
+{
+  const char *first = _str.data();
+  double value = 0;
+  const std::errc ec =
+      parseFloat(first, _str.data() + _str.size(), value, true);
+  if (ec == std::errc::result_out_of_range)
+  {
+    throw std::out_of_range("stringToDouble: value out of range [" +
+        _str + "]");
+  }
+  else if (ec != std::errc())
+  {
+    throw std::invalid_argument("stringToDouble: unable to convert [" +
+        _str + "]");
+  }
+  return value;
+}
+
+/////////////////////////////////////////////////
+void parallelFor(std::size_t _count, std::size_t _threadCount,
+                 const std::function<void(std::size_t)> &_func)
+{
+  const std::size_t threadCount = std::min(_threadCount, _count);
+  if (threadCount <= 1)
+  {
+    for (std::size_t i = 0; i < _count; ++i)
+    {
+      _func(i);
+    }
+    return;
+  }
+
+  std::atomic<std::size_t> next{0};
+  std::exception_ptr error;
+  std::mutex errorMutex;
+
+  auto worker = [&]()
+  {
+    for (std::size_t i = next++; i < _count; i = next++)
+    {
+      try
+      {
+        _func(i);
+      }
+      catch(...)
+      {
+        std::lock_guard<std::mutex> lock(errorMutex);
+        if (!error)
+        {
+          error = std::current_exception();
+        }
+      }
+    }
+  };
+
+  std::vector<std::thread> threads;
+  threads.reserve(threadCount - 1);
+  for (std::size_t i = 1; i < threadCount; ++i)
+  {
+    threads.emplace_back(worker);
+  }
+  worker();
+
+  for (auto &thread : threads)
+  {
+    thread.join();
+  }
+
+  if (error)
+  {
+    std::rethrow_exception(error);
+  }
+}
 }
 }
@@ -18,7 +18,12 @@
 #define SDFORMAT_UTILS_HH
 
 #include <algorithm>
+#include <functional>
+#include <set>
 #include <string>
+#include <string_view>
+#include <system_error>
+#include <unordered_set>
 #include <vector>
 #include "sdf/Error.hh"
 #include "sdf/Element.hh"
@@ -43,6 +48,77 @@ namespace sdf
   /// \returns True if the name is a valid frame reference.
   bool isValidFrameReference(const std::string &_name);
 
+  /// \brief Case insensitive comparison against a lowercase string.
+  /// \param[in] _str String to compare.
+  /// \param[in] _lower Lowercase string to compare against.
+  /// \return True if the strings are equal ignoring case.
+  bool equalsLowercase(std::string_view _str, std::string_view _lower);
+
+  /// \brief Skip whitespace, as a stream does before reading a value.
+  /// \param[in,out] _first Start of the input, advanced past the whitespace.
+  /// \param[in] _last End of the input.
+  void skipSpace(const char *&_first, const char *_last);
+
+  /// \brief Parse a floating point value independently of the global locale.
+  /// Leading whitespace is skipped and characters after the value are left
+  /// in the input.
+  /// \param[in,out] _first Start of the input, advanced past the value.
+  /// \param[in] _last End of the input.
+  /// \param[out] _value Parsed value.
+  /// \param[in] _scalar True to accept everything std::strtod accepts in the
+  /// "C" locale, such as hexadecimal values, infinity and NaN. False to
+  /// accept only what a stream accepts, which is used for the components of
+  /// math types.
+  /// \return std::errc() on success, otherwise the error.
+  std::errc parseFloat(const char *&_first, const char *_last,
+                       double &_value, bool _scalar);
+
+  /// \brief Parse a floating point value independently of the global locale.
+  /// \param[in,out] _first Start of the input, advanced past the value.
+  /// \param[in] _last End of the input.
+  /// \param[out] _value Parsed value.
+  /// \param[in] _scalar True to accept everything std::strtof accepts.
+  /// \return std::errc() on success, otherwise the error.
+  /// \sa parseFloat(const char *&, const char *, double &, bool)
+  std::errc parseFloat(const char *&_first, const char *_last,
+                       float &_value, bool _scalar);
+
+  /// \brief Convert a string to a double, like std::stod in the "C" locale,
+  /// but independently of the global locale. Leading whitespace is skipped,
+  /// hexadecimal values, infinity and NaN are accepted, and characters after
+  /// the value are ignored.
+  /// \param[in] _str String to convert.
+  /// \return The converted value.
+  /// \throws std::invalid_argument if no conversion could be performed.
+  /// \throws std::out_of_range if the value is out of the range of a double.
+  double stringToDouble(const std::string &_str);
+
+  /// \brief Call a function once for every index in [0, _count), spreading
+  /// the calls over up to _threadCount threads. The calling thread is one of
+  /// the threads doing work, and the function returns once every call has
+  /// completed. Indices are handed out to the threads in increasing order.
+  /// If any call throws, the first exception is rethrown after all threads
+  /// have finished.
+  /// \param[in] _count Number of indices.
+  /// \param[in] _threadCount Maximum number of threads to use. Values of 0 or
+  /// 1 run every call on the calling thread.
+  /// \param[in] _func Function to call with each index.
+  void parallelFor(std::size_t _count, std::size_t _threadCount,
+                   const std::function<void(std::size_t)> &_func);
+
+  /// \brief Check the name attributes of the child elements of an element in
+  /// a single pass. Names are kept in a hash table, so the cost is linear in
+  /// the number of children.
+  /// \param[in] _elem Element whose children are checked.
+  /// \param[in] _type If not empty, only children of this type are checked.
+  /// \param[out] _duplicateTypes If not null, the type of every child that
+  /// shares its name with a sibling of the same type is inserted here, and
+  /// all children are visited instead of stopping at the first duplicate.
+  /// \return True if no two checked children have the same name, regardless
+  /// of their types.
+  bool uniqueChildNames(const Element &_elem, const std::string &_type = "",
+                        std::set<std::string> *_duplicateTypes = nullptr);
+
   /// \brief Read the "name" attribute from an element.
   /// \param[in] _sdf SDF element pointer which contains the name.
   /// \param[out] _name String to hold the name value.
@@ -69,59 +145,61 @@ namespace sdf
   /// \param[out] _objs Elements that match _sdfName in _sdf are added to this
   /// vector, unless an error is encountered during load or a duplicate name
   /// exists.
+  /// \param[in] _threadCount Number of threads used to load the objects.
+  /// The objects and their errors are added in document order regardless of
+  /// the number of threads, so Class::Load must only modify its own element.
   /// \return The vector of errors. An empty vector indicates no errors were
   /// experienced.
   template <typename Class>
   sdf::Errors loadUniqueRepeated(sdf::ElementPtr _sdf,
-      const std::string &_sdfName, std::vector<Class> &_objs)
+      const std::string &_sdfName, std::vector<Class> &_objs,
+      std::size_t _threadCount = 1)
   {
     Errors errors;
 
-    std::vector<std::string> names;
-
-    // Check that an element exists.
-    if (_sdf->HasElement(_sdfName))
-    {
-      // Read all the elements.
-      sdf::ElementPtr elem = _sdf->GetElement(_sdfName);
-      while (elem)
-      {
-        Class obj;
+    // Do not add an error if the model tag is missing. This is an internal
+    // function that is called by class without checking if an element actually
+    // exists. This is a bit of safe code reduction.
+    if (!_sdf->HasElement(_sdfName))
+      return errors;
 
-        // Load the model and capture the errors.
-        Errors loadErrors = obj.Load(elem);
+    std::vector<sdf::ElementPtr> elems;
+    for (const auto &elem : _sdf->Children(_sdfName))
+      elems.push_back(elem);
 
-        // keep processing even if there are loadErrors
+    // Load the objects and capture the errors.
+    std::vector<Class> objs(elems.size());
+    std::vector<Errors> loadErrors(elems.size());
+    parallelFor(elems.size(), _threadCount, [&](std::size_t _i)
         {
-          std::string name;
-
-          // Read the name for uniqueness checks. Don't report errors here.
-          // Errors are captured in obj.Load(elem) above.
-          sdf::loadName(elem, name);
-
-          // Check that the name does not exist.
-          if (std::find(names.begin(), names.end(), name) != names.end())
-          {
-            errors.push_back({ErrorCode::DUPLICATE_NAME,
-                _sdfName + " with name[" + name + "] already exists."});
-          }
-          else
-          {
-            // Add the object to the result if no errors have been encountered.
-            _objs.push_back(std::move(obj));
-            names.push_back(name);
-          }
+          loadErrors[_i] = objs[_i].Load(elems[_i]);
+        });
 
-          // Add the load errors to the master error list.
-          errors.insert(errors.end(), loadErrors.begin(), loadErrors.end());
-        }
+    std::unordered_set<std::string> names;
+    for (std::size_t i = 0; i < elems.size(); ++i)
+    {
+      // keep processing even if there are loadErrors
+      std::string name;
 
-        elem = elem->GetNextElement(_sdfName);
+      // Read the name for uniqueness checks. Don't report errors here.
+      // Errors are captured in obj.Load(elem) above.
+      sdf::loadName(elems[i], name);
+
+      // Check that the name does not exist.
+      if (!names.insert(name).second)
+      {
+        errors.push_back({ErrorCode::DUPLICATE_NAME,
+            _sdfName + " with name[" + name + "] already exists."});
+      }
+      else
+      {
+        // Add the object to the result if no errors have been encountered.
+        _objs.push_back(std::move(objs[i]));
       }
+
+      // Add the load errors to the master error list.
+      errors.insert(errors.end(), loadErrors[i].begin(), loadErrors[i].end());
     }
-    // Do not add an error if the model tag is missing. This is an internal
-    // function that is called by class without checking if an element actually
-    // exists. This is a bit of safe code reduction.
 
     return errors;
   }
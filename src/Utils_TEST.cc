@@ -16,7 +16,13 @@
 */
 
 #include <gtest/gtest.h>
+#include <atomic>
+#include <clocale>
+#include <cmath>
+#include <set>
+#include <stdexcept>
 #include <string>
+#include <vector>
 #include <ignition/math/Pose3.hh>
 #include "sdf/Element.hh"
 #include "Utils.hh"
@@ -122,3 +128,103 @@ TEST(DOMUtils, ReservedNames)
   EXPECT_TRUE(sdf::isReservedName("__world__"));
   EXPECT_TRUE(sdf::isReservedName("__anything__"));
 }
+
+/////////////////////////////////////////////////
+TEST(DOMUtils, StringToDouble)
+{
+  EXPECT_DOUBLE_EQ(1.5, sdf::stringToDouble("1.5"));
+  EXPECT_DOUBLE_EQ(-2e3, sdf::stringToDouble("  -2e3"));
+  EXPECT_DOUBLE_EQ(3.0, sdf::stringToDouble("+3"));
+  EXPECT_DOUBLE_EQ(0.25, sdf::stringToDouble("0.25 trailing"));
+  EXPECT_DOUBLE_EQ(26.0, sdf::stringToDouble("0x1A"));
+  EXPECT_TRUE(std::isinf(sdf::stringToDouble("inf")));
+  EXPECT_TRUE(std::isinf(sdf::stringToDouble("-Infinity")));
+  EXPECT_TRUE(std::isnan(sdf::stringToDouble("nan")));
+
+  EXPECT_THROW(sdf::stringToDouble(""), std::invalid_argument);
+  EXPECT_THROW(sdf::stringToDouble("abc"), std::invalid_argument);
+  EXPECT_THROW(sdf::stringToDouble("--1"), std::invalid_argument);
+  EXPECT_THROW(sdf::stringToDouble("+-1"), std::invalid_argument);
+  EXPECT_THROW(sdf::stringToDouble("1e999"), std::out_of_range);
+
+  // The global locale does not change the decimal separator.
+  const std::string oldLocale = std::setlocale(LC_NUMERIC, nullptr);
+  if (std::setlocale(LC_NUMERIC, "de_DE.UTF-8"))
+  {
+    EXPECT_DOUBLE_EQ(1.5, sdf::stringToDouble("1.5"));
+    std::setlocale(LC_NUMERIC, oldLocale.c_str());
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(DOMUtils, ParallelFor)
+{
+  for (std::size_t threads : {0u, 1u, 4u, 64u})
+  {
+    std::vector<int> calls(100, 0);
+    sdf::parallelFor(calls.size(), threads, [&](std::size_t _index)
+        {
+          ++calls[_index];
+        });
+    for (int count : calls)
+    {
+      EXPECT_EQ(1, count);
+    }
+  }
+
+  // Exceptions are rethrown on the calling thread after all calls finish.
+  std::atomic<std::size_t> count{0};
+  EXPECT_THROW(sdf::parallelFor(10, 4, [&](std::size_t _index)
+        {
+          ++count;
+          if (_index == 3)
+          {
+            throw std::runtime_error("error");
+          }
+        }), std::runtime_error);
+  EXPECT_EQ(10u, count);
+}
+
+/////////////////////////////////////////////////
+TEST(DOMUtils, UniqueChildNames)
+{
+  sdf::ElementPtr parent = std::make_shared<sdf::Element>();
+  EXPECT_TRUE(sdf::uniqueChildNames(*parent));
+
+  auto addChild = [&parent](const std::string &_type, const std::string &_name)
+  {
+    sdf::ElementPtr child = std::make_shared<sdf::Element>();
+    child->SetParent(parent);
+    child->SetName(_type);
+    if (!_name.empty())
+      child->AddAttribute("name", "string", _name, false, "description");
+    parent->InsertElement(child);
+  };
+
+  addChild("link", "a");
+  addChild("link", "b");
+  addChild("joint", "c");
+  addChild("frame", "");
+  addChild("frame", "");
+  EXPECT_TRUE(sdf::uniqueChildNames(*parent));
+
+  // A name shared by children of different types
+  addChild("joint", "a");
+  EXPECT_FALSE(sdf::uniqueChildNames(*parent));
+  EXPECT_TRUE(sdf::uniqueChildNames(*parent, "link"));
+  EXPECT_TRUE(sdf::uniqueChildNames(*parent, "joint"));
+
+  std::set<std::string> duplicateTypes;
+  EXPECT_FALSE(sdf::uniqueChildNames(*parent, "", &duplicateTypes));
+  EXPECT_TRUE(duplicateTypes.empty());
+
+  // Names shared by children of the same type
+  addChild("joint", "c");
+  addChild("link", "b");
+  EXPECT_FALSE(sdf::uniqueChildNames(*parent, "link"));
+  EXPECT_FALSE(sdf::uniqueChildNames(*parent, "joint"));
+  EXPECT_TRUE(sdf::uniqueChildNames(*parent, "frame"));
+
+  EXPECT_FALSE(sdf::uniqueChildNames(*parent, "", &duplicateTypes));
+  EXPECT_EQ((std::set<std::string>{"joint", "link"}), duplicateTypes);
+}
@@ -22,6 +22,7 @@
 #include "sdf/Visual.hh"
 #include "sdf/Geometry.hh"
 #include "FrameSemantics.hh"
+#include "NameIndex.hh"
 #include "ScopedGraph.hh"
 #include "Utils.hh"
 
@@ -199,7 +200,7 @@ Errors Visual::Load(ElementPtr _sdf)
 }
 
 /////////////////////////////////////////////////
-std::string Visual::Name() const
+const std::string &Visual::Name() const
 {
   return this->dataPtr->name;
 }
@@ -208,6 +209,8 @@ std::string Visual::Name() const
 void Visual::SetName(const std::string &_name) const
 {
   this->dataPtr->name = _name;
+  // The owner's index of names can't see this change.
+  NameIndex::NameChanged();
 }
 
 /////////////////////////////////////////////////
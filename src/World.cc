@@ -27,6 +27,7 @@
 #include "sdf/Types.hh"
 #include "sdf/World.hh"
 #include "FrameSemantics.hh"
+#include "NameIndex.hh"
 #include "ScopedGraph.hh"
 #include "Utils.hh"
 
@@ -96,6 +97,12 @@ class sdf::WorldPrivate
   /// \brief Scoped Pose Relative-To graph that points to a graph owned by this
   /// world.
   public: sdf::ScopedGraph<sdf::PoseRelativeToGraph> poseRelativeToGraph;
+
+  /// \brief Index of the frames by name.
+  public: NameIndex frameIndex;
+
+  /// \brief Index of the models by name.
+  public: NameIndex modelIndex;
 };
 
 /////////////////////////////////////////////////
@@ -112,7 +119,9 @@ WorldPrivate::WorldPrivate(const WorldPrivate &_worldPrivate)
       sdf(_worldPrivate.sdf),
       windLinearVelocity(_worldPrivate.windLinearVelocity),
       frameAttachedToGraph(_worldPrivate.frameAttachedToGraph),
-      poseRelativeToGraph(_worldPrivate.poseRelativeToGraph)
+      poseRelativeToGraph(_worldPrivate.poseRelativeToGraph),
+      frameIndex(_worldPrivate.frameIndex),
+      modelIndex(_worldPrivate.modelIndex)
 {
   if (_worldPrivate.atmosphere)
   {
@@ -170,6 +179,12 @@ World &World::operator=(World &&_world)
 
 /////////////////////////////////////////////////
 Errors World::Load(sdf::ElementPtr _sdf)
+{
+  return this->Load(_sdf, ParserConfig::GlobalConfig());
+}
+
+/////////////////////////////////////////////////
+Errors World::Load(sdf::ElementPtr _sdf, const ParserConfig &_config)
 {
   Errors errors;
 
@@ -247,8 +262,8 @@ Errors World::Load(sdf::ElementPtr _sdf)
   std::unordered_set<std::string> frameNames;
 
   // Load all the models.
-  Errors modelLoadErrors =
-      loadUniqueRepeated<Model>(_sdf, "model", this->dataPtr->models);
+  Errors modelLoadErrors = loadUniqueRepeated<Model>(_sdf, "model",
+      this->dataPtr->models, _config.ModelLoadThreadCount());
   errors.insert(errors.end(), modelLoadErrors.begin(), modelLoadErrors.end());
 
   // Models are loaded first, and loadUniqueRepeated ensures there are no
@@ -305,6 +320,11 @@ Errors World::Load(sdf::ElementPtr _sdf)
     frameNames.insert(frameName);
   }
 
+  // Index the models and frames by name once any name collisions have been
+  // resolved.
+  this->dataPtr->modelIndex.Build(this->dataPtr->models);
+  this->dataPtr->frameIndex.Build(this->dataPtr->frames);
+
   // Load the Gui
   if (_sdf->HasElement("gui"))
   {
@@ -402,27 +422,13 @@ const Model *World::ModelByIndex(const uint64_t _index) const
 /////////////////////////////////////////////////
 bool World::ModelNameExists(const std::string &_name) const
 {
-  for (auto const &m : this->dataPtr->models)
-  {
-    if (m.Name() == _name)
-    {
-      return true;
-    }
-  }
-  return false;
+  return nullptr != this->ModelByName(_name);
 }
 
 /////////////////////////////////////////////////
 const Model *World::ModelByName(const std::string &_name) const
 {
-  for (auto const &m : this->dataPtr->models)
-  {
-    if (m.Name() == _name)
-    {
-      return &m;
-    }
-  }
-  return nullptr;
+  return this->dataPtr->modelIndex.Find(this->dataPtr->models, _name);
 }
 
 /////////////////////////////////////////////////
@@ -484,27 +490,13 @@ const Frame *World::FrameByIndex(const uint64_t _index) const
 /////////////////////////////////////////////////
 bool World::FrameNameExists(const std::string &_name) const
 {
-  for (auto const &f : this->dataPtr->frames)
-  {
-    if (f.Name() == _name)
-    {
-      return true;
-    }
-  }
-  return false;
+  return nullptr != this->FrameByName(_name);
 }
 
 /////////////////////////////////////////////////
 const Frame *World::FrameByName(const std::string &_name) const
 {
-  for (auto const &f : this->dataPtr->frames)
-  {
-    if (f.Name() == _name)
-    {
-      return &f;
-    }
-  }
-  return nullptr;
+  return this->dataPtr->frameIndex.Find(this->dataPtr->frames, _name);
 }
 
 /////////////////////////////////////////////////
@@ -606,6 +598,65 @@ bool World::PhysicsNameExists(const std::string &_name) const
   return false;
 }
 
+/////////////////////////////////////////////////
+Errors World::ResolvePoses(ResolvedPoses &_poses,
+                           const std::string &_resolveTo) const
+{
+  Errors errors;
+
+  if (!this->dataPtr->poseRelativeToGraph)
+  {
+    _poses.Clear();
+    errors.push_back({ErrorCode::POSE_RELATIVE_TO_GRAPH_ERROR,
+        "World has invalid pointer to PoseRelativeToGraph."});
+    return errors;
+  }
+
+  return resolvePoses(_poses, this->dataPtr->poseRelativeToGraph, this,
+      _resolveTo.empty() ? "world" : _resolveTo);
+}
+
+/////////////////////////////////////////////////
+Errors World::UpdateModel(const Model &_model)
+{
+  Errors errors;
+
+  if (!this->dataPtr->frameAttachedToGraph)
+  {
+    errors.push_back({ErrorCode::FRAME_ATTACHED_TO_GRAPH_ERROR,
+        "World has invalid pointer to FrameAttachedToGraph."});
+  }
+  if (!this->dataPtr->poseRelativeToGraph)
+  {
+    errors.push_back({ErrorCode::POSE_RELATIVE_TO_GRAPH_ERROR,
+        "World has invalid pointer to PoseRelativeToGraph."});
+  }
+  if (!errors.empty())
+    return errors;
+
+  const Model *found =
+      this->dataPtr->modelIndex.Find(this->dataPtr->models, _model.Name());
+  if (!found)
+  {
+    errors.push_back({ErrorCode::ELEMENT_MISSING,
+        "World with name[" + this->dataPtr->name + "] has no model with "
+        "name[" + _model.Name() + "]."});
+    return errors;
+  }
+
+  errors = updateModelGraphs(this->dataPtr->frameAttachedToGraph,
+      this->dataPtr->poseRelativeToGraph, found, &_model);
+  if (!errors.empty())
+    return errors;
+
+  Model &model =
+      this->dataPtr->models[found - this->dataPtr->models.data()];
+  model = _model;
+  model.SetFrameAttachedToGraph(this->dataPtr->frameAttachedToGraph);
+  model.SetPoseRelativeToGraph(this->dataPtr->poseRelativeToGraph);
+  return errors;
+}
+
 /////////////////////////////////////////////////
 void World::SetPoseRelativeToGraph(sdf::ScopedGraph<PoseRelativeToGraph> _graph)
 {
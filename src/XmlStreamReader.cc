@@ -0,0 +1,192 @@
+/*
+ * Copyright 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <string>
+#include <string_view>
+
+#include "XmlStreamReader.hh"
+
+using namespace sdf;
+
+/////////////////////////////////////////////////
+XmlStreamReader::XmlStreamReader(std::string_view _data)
+  : data(_data)
+{
+}
+
+/////////////////////////////////////////////////
+const std::string &XmlStreamReader::Tag() const
+{
+  return this->tag;
+}
+
+/////////////////////////////////////////////////
+const std::string &XmlStreamReader::Name() const
+{
+  return this->name;
+}
+
+/////////////////////////////////////////////////
+bool XmlStreamReader::EmptyElement() const
+{
+  return this->emptyElement;
+}
+
+/////////////////////////////////////////////////
+bool XmlStreamReader::Matches(std::string_view _str, std::size_t _pos) const
+{
+  return this->data.compare(_pos, _str.size(), _str) == 0;
+}
+
+/////////////////////////////////////////////////
+std::size_t XmlStreamReader::MarkupEnd(std::size_t _pos,
+                                       bool &_isTag) const
+{
+  _isTag = false;
+
+  // Comments, CDATA sections, processing instructions and declarations.
+  std::string_view terminator;
+  std::size_t skip = 0;
+  if (this->Matches("<!--", _pos))
+  {
+    terminator = "-->";
+    skip = 4;
+  }
+  else if (this->Matches("<![CDATA[", _pos))
+  {
+    terminator = "]]>";
+    skip = 9;
+  }
+  else if (this->Matches("<?", _pos))
+  {
+    terminator = "?>";
+    skip = 2;
+  }
+
+  if (!terminator.empty())
+  {
+    const std::size_t end = this->data.find(terminator, _pos + skip);
+    return end == std::string_view::npos ?
+      std::string::npos : end + terminator.size();
+  }
+
+  // Start, end and empty element tags, and declarations such as DOCTYPE.
+  // Quoted attribute values and DOCTYPE internal subsets may contain '>'.
+  _isTag = !this->Matches("<!", _pos);
+  char quote = 0;
+  int brackets = 0;
+  for (std::size_t i = _pos + 1; ; ++i)
+  {
+    if (i >= this->data.size())
+      return std::string::npos;
+
+    const char c = this->data[i];
+    if (quote)
+    {
+      if (c == quote)
+        quote = 0;
+    }
+    else if (c == '"' || c == '\'')
+    {
+      quote = c;
+    }
+    else if (!_isTag && c == '[')
+    {
+      ++brackets;
+    }
+    else if (!_isTag && c == ']')
+    {
+      --brackets;
+    }
+    else if (c == '>' && brackets <= 0)
+    {
+      return i + 1;
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+XmlStreamReader::Token XmlStreamReader::Next()
+{
+  this->tag.clear();
+  this->name.clear();
+  this->emptyElement = false;
+
+  while (true)
+  {
+    const std::size_t start = this->data.find('<', this->pos);
+    if (start == std::string_view::npos)
+    {
+      this->pos = this->data.size();
+      return Token::END;
+    }
+
+    bool isTag = false;
+    const std::size_t end = this->MarkupEnd(start, isTag);
+    if (end == std::string::npos)
+      return Token::ERROR;
+
+    this->pos = end;
+    if (!isTag)
+      continue;
+
+    this->tag.assign(this->data.substr(start, end - start));
+
+    const bool endTag = this->tag.size() > 1 && this->tag[1] == '/';
+    const std::size_t nameStart = endTag ? 2 : 1;
+    const std::size_t nameEnd =
+      this->tag.find_first_of(" \t\r\n/>", nameStart);
+    this->name = this->tag.substr(nameStart, nameEnd - nameStart);
+    if (this->name.empty())
+      return Token::ERROR;
+
+    if (endTag)
+      return Token::END_TAG;
+
+    this->emptyElement = this->tag[this->tag.size() - 2] == '/';
+    return Token::START_TAG;
+  }
+}
+
+/////////////////////////////////////////////////
+bool XmlStreamReader::ReadElementContent(std::string &_text)
+{
+  int depth = 1;
+  while (depth > 0)
+  {
+    const std::size_t start = this->data.find('<', this->pos);
+    if (start == std::string_view::npos)
+      return false;
+
+    bool isTag = false;
+    const std::size_t end = this->MarkupEnd(start, isTag);
+    if (end == std::string::npos)
+      return false;
+
+    if (isTag)
+    {
+      if (this->data[start + 1] == '/')
+        --depth;
+      else if (this->data[end - 2] != '/')
+        ++depth;
+    }
+
+    _text.append(this->data.substr(this->pos, end - this->pos));
+    this->pos = end;
+  }
+  return true;
+}
@@ -0,0 +1,122 @@
+/*
+ * Copyright 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef SDF_XML_STREAM_READER_HH_
+#define SDF_XML_STREAM_READER_HH_
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+#include "sdf/system_util.hh"
+
+namespace sdf
+{
+  // Inline bracket to help doxygen filtering.
+  inline namespace SDF_VERSION_NAMESPACE {
+  //
+
+  /// \brief Reads an XML document one tag at a time, so that the elements
+  /// of a large document can be parsed one by one instead of loading the
+  /// whole document into a DOM. The document is typically a memory mapped
+  /// file.
+  ///
+  /// The reader only finds the boundaries of tags and elements. It does not
+  /// validate the markup or decode entities; the text it returns is meant to
+  /// be parsed by tinyxml2. Comments, processing instructions, declarations
+  /// and text between the tags returned by Next are skipped.
+  class XmlStreamReader
+  {
+    /// \brief Kind of markup returned by Next.
+    public: enum class Token
+    {
+      /// \brief A start tag, such as <model name="m">, or an empty element
+      /// tag, such as <link name="l"/>.
+      START_TAG,
+
+      /// \brief An end tag, such as </model>.
+      END_TAG,
+
+      /// \brief The end of the document was reached.
+      END,
+
+      /// \brief The document contains malformed markup.
+      ERROR
+    };
+
+    /// \brief Constructor.
+    /// \param[in] _data Document to read. The data it refers to must
+    /// outlive the reader.
+    public: explicit XmlStreamReader(std::string_view _data);
+
+    /// \brief Read the next start or end tag.
+    /// \return The kind of tag that was read.
+    public: Token Next();
+
+    /// \brief Get the text of the last tag returned by Next, including the
+    /// angle brackets.
+    /// \return Text of the tag.
+    public: const std::string &Tag() const;
+
+    /// \brief Get the name of the element of the last tag returned by Next.
+    /// \return Name of the element.
+    public: const std::string &Name() const;
+
+    /// \brief Get whether the last tag returned by Next is an empty element
+    /// tag, which has no matching end tag.
+    /// \return True for an empty element tag.
+    public: bool EmptyElement() const;
+
+    /// \brief Read the content of the element whose start tag was just
+    /// returned by Next, including its end tag.
+    /// \param[out] _text String to which the content is appended.
+    /// \return False if the document ended before the end of the element or
+    /// contains malformed markup.
+    public: bool ReadElementContent(std::string &_text);
+
+    /// \brief Check whether the document contains a string at a position.
+    /// \param[in] _str String to compare.
+    /// \param[in] _pos Position in the document.
+    /// \return True if the document contains _str at _pos.
+    private: bool Matches(std::string_view _str, std::size_t _pos) const;
+
+    /// \brief Find the end of markup that starts at a position, such as a
+    /// comment or a tag.
+    /// \param[in] _pos Position of the '<' that starts the markup.
+    /// \param[out] _isTag True if the markup is a start, end or empty
+    /// element tag.
+    /// \return Position one past the end of the markup, or
+    /// std::string::npos if it is malformed or unterminated.
+    private: std::size_t MarkupEnd(std::size_t _pos, bool &_isTag) const;
+
+    /// \brief Document to read.
+    private: std::string_view data;
+
+    /// \brief Position of the first unconsumed character in the document.
+    private: std::size_t pos = 0;
+
+    /// \brief Text of the last tag.
+    private: std::string tag;
+
+    /// \brief Element name of the last tag.
+    private: std::string name;
+
+    /// \brief True if the last tag is an empty element tag.
+    private: bool emptyElement = false;
+  };
+  }
+}
+#endif
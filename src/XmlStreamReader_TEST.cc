@@ -0,0 +1,131 @@
+/*
+ * Copyright 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+
+#include "XmlStreamReader.hh"
+
+using Token = sdf::XmlStreamReader::Token;
+
+/////////////////////////////////////////////////
+TEST(XmlStreamReader, Tags)
+{
+  const std::string xml(R"(<?xml version="1.0" ?>
+<!DOCTYPE sdf [ <!ENTITY e "text"> ]>
+<!-- comment with <tags> -->
+<sdf version='1.8'>
+  text
+  <model name="a>b"><link name='l'/><![CDATA[<x>]]></model>
+  <light name="l" />
+</sdf>
+<!-- trailing comment -->
+)");
+
+  sdf::XmlStreamReader reader(xml);
+
+  ASSERT_EQ(Token::START_TAG, reader.Next());
+  EXPECT_EQ("sdf", reader.Name());
+  EXPECT_EQ("<sdf version='1.8'>", reader.Tag());
+  EXPECT_FALSE(reader.EmptyElement());
+
+  ASSERT_EQ(Token::START_TAG, reader.Next());
+  EXPECT_EQ("model", reader.Name());
+  EXPECT_EQ("<model name=\"a>b\">", reader.Tag());
+  EXPECT_FALSE(reader.EmptyElement());
+
+  std::string content;
+  ASSERT_TRUE(reader.ReadElementContent(content));
+  EXPECT_EQ("<link name='l'/><![CDATA[<x>]]></model>", content);
+
+  ASSERT_EQ(Token::START_TAG, reader.Next());
+  EXPECT_EQ("light", reader.Name());
+  EXPECT_TRUE(reader.EmptyElement());
+
+  ASSERT_EQ(Token::END_TAG, reader.Next());
+  EXPECT_EQ("sdf", reader.Name());
+  EXPECT_EQ("</sdf>", reader.Tag());
+
+  EXPECT_EQ(Token::END, reader.Next());
+}
+
+/////////////////////////////////////////////////
+TEST(XmlStreamReader, LargeElements)
+{
+  // Elements larger than a page.
+  const std::string value(100000, 'x');
+  std::ostringstream xml;
+  xml << "<world>";
+  for (int i = 0; i < 5; ++i)
+  {
+    xml << "<model name='m" << i << "'><value a='" << value << "'>"
+        << value << "</value></model>";
+  }
+  xml << "</world>";
+
+  const std::string data = xml.str();
+  sdf::XmlStreamReader reader(data);
+  ASSERT_EQ(Token::START_TAG, reader.Next());
+  EXPECT_EQ("world", reader.Name());
+
+  for (int i = 0; i < 5; ++i)
+  {
+    ASSERT_EQ(Token::START_TAG, reader.Next());
+    EXPECT_EQ("model", reader.Name());
+    EXPECT_EQ("<model name='m" + std::to_string(i) + "'>", reader.Tag());
+
+    std::string content;
+    ASSERT_TRUE(reader.ReadElementContent(content));
+    EXPECT_EQ("<value a='" + value + "'>" + value + "</value></model>",
+              content);
+  }
+
+  ASSERT_EQ(Token::END_TAG, reader.Next());
+  EXPECT_EQ("world", reader.Name());
+  EXPECT_EQ(Token::END, reader.Next());
+}
+
+/////////////////////////////////////////////////
+TEST(XmlStreamReader, Malformed)
+{
+  {
+    sdf::XmlStreamReader reader("<sdf version='1.8");
+    EXPECT_EQ(Token::ERROR, reader.Next());
+  }
+
+  {
+    sdf::XmlStreamReader reader("<sdf><!-- unterminated");
+    ASSERT_EQ(Token::START_TAG, reader.Next());
+    EXPECT_EQ(Token::ERROR, reader.Next());
+  }
+
+  {
+    sdf::XmlStreamReader reader("<sdf><model><link/>");
+    ASSERT_EQ(Token::START_TAG, reader.Next());
+    ASSERT_EQ(Token::START_TAG, reader.Next());
+    std::string content;
+    EXPECT_FALSE(reader.ReadElementContent(content));
+  }
+
+  {
+    // Truncated markup at the end of the document.
+    sdf::XmlStreamReader reader("<sdf><!-");
+    ASSERT_EQ(Token::START_TAG, reader.Next());
+    EXPECT_EQ(Token::ERROR, reader.Next());
+  }
+}
@@ -15,9 +15,17 @@
  *
 */
 
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
 #include <cstring>
+#include <fstream>
 #include <iostream>
+#include <sstream>
+#include <string>
 #include <string.h>
+#include <thread>
+#include <vector>
 
 #include "sdf/sdf_config.h"
 #include "sdf/Filesystem.hh"
@@ -27,13 +35,22 @@
 
 #include "FrameSemantics.hh"
 #include "ScopedGraph.hh"
+#include "Utils.hh"
 #include "ign.hh"
 
 //////////////////////////////////////////////////
-// cppcheck-suppress unusedFunction
-extern "C" SDFORMAT_VISIBLE int cmdCheck(const char *_path)
+/// \brief Load and check a single file. The file is parsed once by
+/// Root::Load, whose frame graphs are reused by the remaining checks.
+/// \param[in] _path Path to the file to validate.
+/// \param[out] _err Stream that errors are written to.
+/// \return Zero on success, negative one otherwise.
+static int checkFile(const char *_path, std::ostream &_err)
 {
-  int result = 0;
+  if (!sdf::filesystem::exists(_path))
+  {
+    _err << "Error: File [" << _path << "] does not exist.\n";
+    return -1;
+  }
 
   sdf::Root root;
   sdf::Errors errors = root.Load(_path);
@@ -41,104 +58,32 @@ extern "C" SDFORMAT_VISIBLE int cmdCheck(const char *_path)
   {
     for (auto &error : errors)
     {
-      std::cerr << "Error: " << error.Message() << std::endl;
+      _err << "Error: " << error.Message() << std::endl;
     }
     return -1;
   }
 
-  if (!sdf::checkCanonicalLinkNames(&root))
-  {
-    result = -1;
-  }
-
-  if (!sdf::checkJointParentChildLinkNames(&root))
-  {
-    result = -1;
-  }
-
-  if (!sdf::checkFrameAttachedToGraph(&root))
-  {
-    result = -1;
-  }
-
-  if (!sdf::checkPoseRelativeToGraph(&root))
-  {
-    result = -1;
-  }
-
-  if (!sdf::recursiveSiblingUniqueNames(root.Element()))
-  {
-    result = -1;
-  }
-
-  if (!sdf::filesystem::exists(_path))
-  {
-    std::cerr << "Error: File [" << _path << "] does not exist.\n";
-    return -1;
-  }
-
-  sdf::SDFPtr sdf(new sdf::SDF());
-
-  if (!sdf::init(sdf))
-  {
-    std::cerr << "Error: SDF schema initialization failed.\n";
-    return -1;
-  }
-
-  if (!sdf::readFile(_path, sdf))
-  {
-    std::cerr << "Error: SDF parsing the xml failed.\n";
-    return -1;
-  }
-
-  if (result == 0)
-  {
-    std::cout << "Valid.\n";
-  }
-  return result;
-}
-
-//////////////////////////////////////////////////
-// cppcheck-suppress unusedFunction
-extern "C" SDFORMAT_VISIBLE char *ignitionVersion()
-{
-#ifdef _MSC_VER
-  return _strdup(SDF_VERSION_FULL);
-#else
-  return strdup(SDF_VERSION_FULL);
-#endif
-}
-
-//////////////////////////////////////////////////
-/// \brief Print the full description of the SDF spec.
-/// \return 0 on success, -1 if SDF could not be initialized.
-// cppcheck-suppress unusedFunction
-extern "C" SDFORMAT_VISIBLE int cmdDescribe(const char *_version)
-{
-  sdf::SDFPtr sdf(new sdf::SDF());
-
-  if (nullptr != _version)
+  if (!sdf::checkLoadedRoot(&root, _err))
   {
-    sdf->Version(_version);
-  }
-  if (!sdf::init(sdf))
-  {
-    std::cerr << "Error: SDF schema initialization failed.\n";
     return -1;
   }
 
-  sdf->PrintDescription();
-
   return 0;
 }
 
 //////////////////////////////////////////////////
-// cppcheck-suppress unusedFunction
-extern "C" SDFORMAT_VISIBLE int cmdPrint(const char *_path)
+/// \brief Read a file, converting it to the latest version, and print its
+/// values. Errors found while reading are written to _err.
+/// \param[in] _path Path to the file to print.
+/// \param[out] _out Stream that the values are written to.
+/// \param[out] _err Stream that errors are written to.
+/// \return Zero on success, negative one otherwise.
+static int printFile(const char *_path, std::ostream &_out,
+    std::ostream &_err)
 {
   if (!sdf::filesystem::exists(_path))
   {
-    std::cerr << "Error: File [" << _path << "] does not exist.\n";
+    _err << "Error: File [" << _path << "] does not exist.\n";
     return -1;
   }
 
@@ -146,37 +91,53 @@ extern "C" SDFORMAT_VISIBLE int cmdPrint(const char *_path)
 
   if (!sdf::init(sdf))
   {
-    std::cerr << "Error: SDF schema initialization failed.\n";
+    _err << "Error: SDF schema initialization failed.\n";
     return -1;
   }
 
-  if (!sdf::readFile(_path, sdf))
+  sdf::Errors errors;
+  const bool read = sdf::readFile(_path, sdf, errors);
+  if (!errors.empty())
+  {
+    _err << errors << std::endl;
+  }
+  if (!read)
   {
-    std::cerr << "Error: SDF parsing the xml failed.\n";
+    _err << "Error: SDF parsing the xml failed.\n";
     return -1;
   }
 
-  sdf->PrintValues();
+  _out << sdf->Root()->ToString("");
 
   return 0;
 }
 
 //////////////////////////////////////////////////
-// cppcheck-suppress unusedFunction
-extern "C" SDFORMAT_VISIBLE int cmdGraph(
-    const char *_graphType, const char *_path)
+/// \brief Load a file and print one of the frame graphs of its first world
+/// or model. The graph is printed even if the file has errors.
+/// \param[in] _graphType Either "pose" or "frame".
+/// \param[in] _path Path to the file.
+/// \param[out] _out Stream that the graph is written to.
+/// \param[out] _err Stream that errors are written to.
+/// \return Zero on success, negative one if the file does not exist, the
+/// graph type is unknown, or errors were found while loading the file or
+/// building the graph.
+static int graphFile(const char *_graphType, const char *_path,
+    std::ostream &_out, std::ostream &_err)
 {
   if (!sdf::filesystem::exists(_path))
   {
-    std::cerr << "Error: File [" << _path << "] does not exist.\n";
+    _err << "Error: File [" << _path << "] does not exist.\n";
     return -1;
   }
 
+  int result = 0;
   sdf::Root root;
   sdf::Errors errors = root.Load(_path);
   if (!errors.empty())
   {
-    std::cerr << errors << std::endl;
+    _err << errors << std::endl;
+    result = -1;
   }
 
   if (std::strcmp(_graphType, "pose") == 0)
@@ -194,9 +155,10 @@ extern "C" SDFORMAT_VISIBLE int cmdGraph(
 
     if (!errors.empty())
     {
-      std::cerr << errors << std::endl;
+      _err << errors << std::endl;
+      result = -1;
     }
-    std::cout << graph.Graph() << std::endl;
+    _out << graph.Graph() << std::endl;
   }
   else if (std::strcmp(_graphType, "frame") == 0)
   {
@@ -213,15 +175,316 @@ extern "C" SDFORMAT_VISIBLE int cmdGraph(
 
     if (!errors.empty())
     {
-      std::cerr << errors << std::endl;
+      _err << errors << std::endl;
+      result = -1;
     }
-    std::cout << graph.Graph() << std::endl;
+    _out << graph.Graph() << std::endl;
   }
   else
+  {
+    _err << R"(Only "pose" and "frame" graph types are supported)"
+         << std::endl;
+    result = -1;
+  }
+
+  return result;
+}
+
+//////////////////////////////////////////////////
+/// \brief Add the SDFormat and URDF files found under a path. Files are
+/// added as given, while directories are searched recursively with their
+/// entries sorted by name so that the order does not depend on the
+/// filesystem.
+/// \param[in] _path File or directory path.
+/// \param[in,out] _files List that the file paths are appended to.
+static void collectFiles(const std::string &_path,
+    std::vector<std::string> &_files)
+{
+  if (!sdf::filesystem::is_directory(_path))
+  {
+    _files.push_back(_path);
+    return;
+  }
+
+  std::vector<std::string> entries;
+  sdf::filesystem::DirIter endIter;
+  for (sdf::filesystem::DirIter dirIter(_path); dirIter != endIter; ++dirIter)
+  {
+    entries.push_back(*dirIter);
+  }
+  std::sort(entries.begin(), entries.end());
+
+  for (const std::string &entry : entries)
+  {
+    if (sdf::filesystem::is_directory(entry))
+    {
+      collectFiles(entry, _files);
+      continue;
+    }
+
+    const std::size_t dot = entry.rfind('.');
+    if (dot == std::string::npos)
+    {
+      continue;
+    }
+    const std::string extension = entry.substr(dot);
+    if (extension == ".sdf" || extension == ".world" || extension == ".urdf")
+    {
+      _files.push_back(entry);
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+/// \brief Quote and escape a string for use in JSON.
+/// \param[in] _str String to quote.
+/// \return The JSON string literal.
+static std::string jsonString(const std::string &_str)
+{
+  std::string result = "\"";
+  for (const char c : _str)
+  {
+    switch (c)
+    {
+      case '"':
+        result += "\\\"";
+        break;
+      case '\\':
+        result += "\\\\";
+        break;
+      case '\n':
+        result += "\\n";
+        break;
+      case '\t':
+        result += "\\t";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20)
+        {
+          char buffer[8];
+          std::snprintf(buffer, sizeof(buffer), "\\u%04x", c);
+          result += buffer;
+        }
+        else
+        {
+          result += c;
+        }
+    }
+  }
+  result += "\"";
+  return result;
+}
+
+//////////////////////////////////////////////////
+/// \brief Result of running a command on one file in batch mode.
+struct BatchResult
+{
+  /// \brief Zero on success, negative one otherwise.
+  int result = 0;
+
+  /// \brief Output of the command.
+  std::string out;
+
+  /// \brief Errors reported by the command.
+  std::string err;
+
+  /// \brief Time taken by the command in seconds.
+  double seconds = 0;
+};
+
+//////////////////////////////////////////////////
+// cppcheck-suppress unusedFunction
+extern "C" SDFORMAT_VISIBLE int cmdCheck(const char *_path)
+{
+  int result = checkFile(_path, std::cerr);
+  if (result == 0)
+  {
+    std::cout << "Valid.\n";
+  }
+  return result;
+}
+
+//////////////////////////////////////////////////
+// cppcheck-suppress unusedFunction
+extern "C" SDFORMAT_VISIBLE int cmdBatch(const char *_command,
+    const char *_graphType, int _count, const char **_paths, int _jobs,
+    const char *_summaryPath)
+{
+  const std::string command = _command;
+  if (command != "check" && command != "print" && command != "graph")
+  {
+    std::cerr << "Error: Unknown batch command [" << command << "].\n";
+    return -1;
+  }
+  if (command == "graph" && std::strcmp(_graphType, "pose") != 0 &&
+      std::strcmp(_graphType, "frame") != 0)
   {
     std::cerr << R"(Only "pose" and "frame" graph types are supported)"
               << std::endl;
+    return -1;
+  }
+
+  std::vector<std::string> files;
+  for (int i = 0; i < _count; ++i)
+  {
+    collectFiles(_paths[i], files);
+  }
+
+  std::size_t jobs = _jobs > 0 ? static_cast<std::size_t>(_jobs) :
+      std::max(1u, std::thread::hardware_concurrency());
+
+  // Build the schema before starting the workers, which all share it.
+  {
+    sdf::SDFPtr sdf(new sdf::SDF());
+    if (!sdf::init(sdf))
+    {
+      std::cerr << "Error: SDF schema initialization failed.\n";
+      return -1;
+    }
+  }
+
+  const auto batchStart = std::chrono::steady_clock::now();
+
+  // Each worker writes to its own result so that the report below is in
+  // the order of the files regardless of which worker finished first.
+  // Messages that the parser logs through sdferr and sdfwarn go to the
+  // shared console instead, so they are not grouped by file.
+  std::vector<BatchResult> results(files.size());
+  sdf::parallelFor(files.size(), jobs, [&](std::size_t _index)
+  {
+    const char *path = files[_index].c_str();
+    BatchResult &batchResult = results[_index];
+    std::ostringstream out;
+    std::ostringstream err;
+
+    const auto start = std::chrono::steady_clock::now();
+    if (command == "check")
+      batchResult.result = checkFile(path, err);
+    else if (command == "print")
+      batchResult.result = printFile(path, out, err);
+    else
+      batchResult.result = graphFile(_graphType, path, out, err);
+    const auto end = std::chrono::steady_clock::now();
+
+    batchResult.seconds = std::chrono::duration<double>(end - start).count();
+    batchResult.out = out.str();
+    batchResult.err = err.str();
+  });
+
+  const double batchSeconds = std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - batchStart).count();
+
+  int result = 0;
+  std::size_t failedCount = 0;
+  for (std::size_t i = 0; i < files.size(); ++i)
+  {
+    const BatchResult &batchResult = results[i];
+    std::cerr << batchResult.err;
+    std::cout << batchResult.out;
+
+    if (batchResult.result != 0)
+    {
+      ++failedCount;
+      result = -1;
+    }
+
+    if (command == "check")
+    {
+      std::cout << (batchResult.result == 0 ? "Valid: " : "Invalid: ")
+                << files[i] << "\n";
+    }
+  }
+
+  if (command == "check")
+  {
+    std::cout << "Checked " << files.size() << " files, " << failedCount
+              << " invalid.\n";
   }
+  else
+  {
+    std::cerr << "Processed " << files.size() << " files, " << failedCount
+              << " failed.\n";
+  }
+
+  if (_summaryPath != nullptr && _summaryPath[0] != '\0')
+  {
+    std::ofstream summary(_summaryPath);
+    if (!summary)
+    {
+      std::cerr << "Error: Unable to write summary to [" << _summaryPath
+                << "].\n";
+      return -1;
+    }
+
+    summary << "{\n"
+            << "  \"command\": " << jsonString(command) << ",\n"
+            << "  \"jobs\": " << jobs << ",\n"
+            << "  \"files\": " << files.size() << ",\n"
+            << "  \"failed\": " << failedCount << ",\n"
+            << "  \"seconds\": " << batchSeconds << ",\n"
+            << "  \"results\": [";
+    for (std::size_t i = 0; i < files.size(); ++i)
+    {
+      summary << (i == 0 ? "\n" : ",\n")
+              << "    {\"path\": " << jsonString(files[i])
+              << ", \"success\": "
+              << (results[i].result == 0 ? "true" : "false")
+              << ", \"seconds\": " << results[i].seconds << "}";
+    }
+    summary << "\n  ]\n}\n";
+  }
+
+  return result;
+}
+
+//////////////////////////////////////////////////
+// cppcheck-suppress unusedFunction
+extern "C" SDFORMAT_VISIBLE char *ignitionVersion()
+{
+#ifdef _MSC_VER
+  return _strdup(SDF_VERSION_FULL);
+#else
+  return strdup(SDF_VERSION_FULL);
+#endif
+}
+
+//////////////////////////////////////////////////
+/// \brief Print the full description of the SDF spec.
+/// \return 0 on success, -1 if SDF could not be initialized.
+// cppcheck-suppress unusedFunction
+extern "C" SDFORMAT_VISIBLE int cmdDescribe(const char *_version)
+{
+  sdf::SDFPtr sdf(new sdf::SDF());
+
+  if (nullptr != _version)
+  {
+    sdf->Version(_version);
+  }
+  if (!sdf::init(sdf))
+  {
+    std::cerr << "Error: SDF schema initialization failed.\n";
+    return -1;
+  }
+
+  sdf->PrintDescription();
 
   return 0;
 }
+
+//////////////////////////////////////////////////
+// cppcheck-suppress unusedFunction
+extern "C" SDFORMAT_VISIBLE int cmdPrint(const char *_path)
+{
+  return printFile(_path, std::cout, std::cerr);
+}
+
+//////////////////////////////////////////////////
+// cppcheck-suppress unusedFunction
+extern "C" SDFORMAT_VISIBLE int cmdGraph(
+    const char *_graphType, const char *_path)
+{
+  // The command itself has always succeeded when the file exists, even if
+  // errors were printed, so only the batch mode reports them as failures.
+  const int result = graphFile(_graphType, _path, std::cout, std::cerr);
+  return sdf::filesystem::exists(_path) ? 0 : result;
+}
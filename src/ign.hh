@@ -32,6 +32,24 @@ inline namespace SDF_VERSION_NAMESPACE {
 /// \return Zero on success, negative one otherwise.
 extern "C" SDFORMAT_VISIBLE int cmdCheck(const char *_path);
 
+/// \brief External hook to run 'ign sdf' with the check, print or graph
+/// commands over many files in one process. Directories are searched
+/// recursively for .sdf, .world and .urdf files. The files are processed by
+/// a pool of worker threads sharing the parsed SDFormat schema, and the output
+/// of each file is reported in the order of the files.
+/// \param[in] _command One of "check", "print" or "graph".
+/// \param[in] _graphType Graph type, "pose" or "frame", used by "graph".
+/// \param[in] _count Number of paths in _paths.
+/// \param[in] _paths Paths to files or directories.
+/// \param[in] _jobs Number of worker threads, or zero to use one per
+/// hardware thread.
+/// \param[in] _summaryPath If not empty, path of a JSON file that receives
+/// the result and time taken for each file.
+/// \return Zero if every file succeeded, negative one otherwise.
+extern "C" SDFORMAT_VISIBLE int cmdBatch(const char *_command,
+    const char *_graphType, int _count, const char **_paths, int _jobs,
+    const char *_summaryPath);
+
 /// \brief External hook to read the library version.
 /// \return C-string representing the version. Ex.: 0.1.2
 extern "C" SDFORMAT_VISIBLE char *ignitionVersion();
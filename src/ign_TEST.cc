@@ -18,6 +18,8 @@
 #include <gtest/gtest.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <fstream>
+#include <sstream>
 #include <string>
 
 #include "sdf/parser.hh"
@@ -858,6 +860,147 @@ TEST(check_model_sdf, SDF)
   }
 }
 
+/////////////////////////////////////////////////
+TEST(check_multiple_files, SDF)
+{
+  std::string pathBase = PROJECT_SOURCE_PATH;
+  pathBase += "/test/sdf";
+
+  // Check several good SDF files in one invocation
+  {
+    std::string path1 = pathBase + "/shapes.sdf";
+    std::string path2 = pathBase + "/shapes_world.sdf";
+
+    std::string output =
+      custom_exec_str(g_ignCommand + " sdf -k " + path1 + " " + path2 +
+                      g_sdfVersion);
+    EXPECT_NE(output.find("Valid: " + path1 + "\n"), std::string::npos)
+      << output;
+    EXPECT_NE(output.find("Valid: " + path2 + "\n"), std::string::npos)
+      << output;
+    EXPECT_NE(output.find("Checked 2 files, 0 invalid.\n"),
+              std::string::npos) << output;
+  }
+
+  // An invalid file is reported without stopping the remaining checks
+  {
+    std::string path1 = pathBase + "/box_bad_test.world";
+    std::string path2 = pathBase + "/shapes.sdf";
+
+    std::string output =
+      custom_exec_str(g_ignCommand + " sdf -k " + path1 + " " + path2 +
+                      g_sdfVersion);
+    EXPECT_NE(output.find("Required attribute"), std::string::npos)
+      << output;
+    EXPECT_NE(output.find("Invalid: " + path1 + "\n"), std::string::npos)
+      << output;
+    EXPECT_NE(output.find("Valid: " + path2 + "\n"), std::string::npos)
+      << output;
+    EXPECT_NE(output.find("Checked 2 files, 1 invalid.\n"),
+              std::string::npos) << output;
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(batch, SDF)
+{
+  std::string pathBase = PROJECT_SOURCE_PATH;
+  pathBase += "/test/sdf";
+
+  // Check several files on a worker pool and write a summary
+  {
+    std::string path1 = pathBase + "/shapes.sdf";
+    std::string path2 = pathBase + "/box_bad_test.world";
+    std::string path3 = pathBase + "/shapes_world.sdf";
+    std::string summaryPath =
+      std::string(PROJECT_BINARY_DIR) + "/test/batch_summary.json";
+
+    std::string output =
+      custom_exec_str(g_ignCommand + " sdf -k " + path1 + " " + path2 + " " +
+                      path3 + " -j 3 --summary " + summaryPath +
+                      g_sdfVersion);
+
+    // Results are reported in the order of the files.
+    auto pos1 = output.find("Valid: " + path1 + "\n");
+    auto pos2 = output.find("Invalid: " + path2 + "\n");
+    auto pos3 = output.find("Valid: " + path3 + "\n");
+    ASSERT_NE(std::string::npos, pos1) << output;
+    ASSERT_NE(std::string::npos, pos2) << output;
+    ASSERT_NE(std::string::npos, pos3) << output;
+    EXPECT_LT(pos1, pos2);
+    EXPECT_LT(pos2, pos3);
+    EXPECT_NE(output.find("Checked 3 files, 1 invalid.\n"),
+              std::string::npos) << output;
+
+    std::ifstream summaryFile(summaryPath);
+    ASSERT_TRUE(summaryFile.good());
+    std::stringstream summary;
+    summary << summaryFile.rdbuf();
+    EXPECT_NE(summary.str().find("\"command\": \"check\""),
+              std::string::npos) << summary.str();
+    EXPECT_NE(summary.str().find("\"jobs\": 3"), std::string::npos)
+      << summary.str();
+    EXPECT_NE(summary.str().find("\"files\": 3"), std::string::npos)
+      << summary.str();
+    EXPECT_NE(summary.str().find("\"failed\": 1"), std::string::npos)
+      << summary.str();
+    EXPECT_NE(summary.str().find("{\"path\": \"" + path2 +
+                                 "\", \"success\": false, \"seconds\": "),
+              std::string::npos) << summary.str();
+  }
+
+  // A directory is searched for SDFormat files
+  {
+    std::string path = std::string(PROJECT_SOURCE_PATH) +
+      "/test/integration/model/box";
+
+    std::string output =
+      custom_exec_str(g_ignCommand + " sdf -k " + path + g_sdfVersion);
+    EXPECT_NE(output.find("Valid: " + path + "/model.sdf\n"),
+              std::string::npos) << output;
+    EXPECT_NE(output.find("Checked 1 files, 0 invalid.\n"),
+              std::string::npos) << output;
+  }
+
+  // Print several files
+  {
+    std::string path1 = pathBase + "/shapes.sdf";
+    std::string path2 = pathBase + "/box_plane_low_friction_test.world";
+    sdf::SDFPtr sdf1(new sdf::SDF());
+    EXPECT_TRUE(sdf::init(sdf1));
+    EXPECT_TRUE(sdf::readFile(path1, sdf1));
+    sdf::SDFPtr sdf2(new sdf::SDF());
+    EXPECT_TRUE(sdf::init(sdf2));
+    EXPECT_TRUE(sdf::readFile(path2, sdf2));
+
+    std::string output =
+      custom_exec_str(g_ignCommand + " sdf -p " + path1 + " " + path2 +
+                      " -j 2" + g_sdfVersion);
+    EXPECT_NE(output.find(sdf1->Root()->ToString("") +
+                          sdf2->Root()->ToString("")),
+              std::string::npos) << output;
+    EXPECT_NE(output.find("Processed 2 files, 0 failed.\n"),
+              std::string::npos) << output;
+  }
+
+  // Graph several files. A file with errors is still graphed, but counts
+  // as failed.
+  {
+    std::string path1 = pathBase + "/world_relative_to_nested_reference.sdf";
+    std::string path2 = pathBase + "/box_bad_test.world";
+
+    std::string output =
+      custom_exec_str(g_ignCommand + " sdf -g pose " + path1 + " " + path2 +
+                      " -j 2" + g_sdfVersion);
+    // The graphs are printed in the order of the files.
+    auto pos1 = output.find("  2 [label=\"M1 (2)\"];\n");
+    ASSERT_NE(std::string::npos, pos1) << output;
+    EXPECT_NE(std::string::npos, output.find("digraph {", pos1)) << output;
+    EXPECT_NE(output.find("Processed 2 files, 1 failed.\n"),
+              std::string::npos) << output;
+  }
+}
+
 /////////////////////////////////////////////////
 TEST(describe, SDF)
 {
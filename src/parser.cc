@@ -15,11 +15,18 @@
  *
  */
 
+#include <atomic>
 #include <iostream>
 #include <cstdlib>
+#include <fstream>
 #include <map>
+#include <mutex>
+#include <optional>
 #include <set>
 #include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
 
 #include <ignition/math/SemanticVersion.hh>
 
@@ -38,8 +45,11 @@
 
 #include "Converter.hh"
 #include "FrameSemantics.hh"
+#include "IncludeCache.hh"
+#include "MappedFile.hh"
 #include "ScopedGraph.hh"
 #include "Utils.hh"
+#include "XmlStreamReader.hh"
 #include "parser_private.hh"
 #include "parser_urdf.hh"
 
@@ -56,12 +66,14 @@ inline namespace SDF_VERSION_NAMESPACE {
 /// \param[in] _filename Name of the SDF file
 /// \param[in] _sdf Pointer to an SDF object.
 /// \param[in] _convert Convert to the latest version if true.
+/// \param[in] _config Parser configuration.
 /// \param[out] _errors Parsing errors will be appended to this variable.
 /// \return True if successful.
 bool readFileInternal(
     const std::string &_filename,
     SDFPtr _sdf,
     const bool _convert,
+    const ParserConfig &_config,
     Errors &_errors);
 
 /// \brief Internal helper for readString, which populates the SDF values
@@ -73,14 +85,52 @@ bool readFileInternal(
 /// \param[in] _xmlString XML string to be parsed.
 /// \param[in] _sdf Pointer to an SDF object.
 /// \param[in] _convert Convert to the latest version if true.
+/// \param[in] _config Parser configuration.
 /// \param[out] _errors Parsing errors will be appended to this variable.
 /// \return True if successful.
 bool readStringInternal(
-    const std::string &_xmlString,
+    std::string_view _xmlString,
     SDFPtr _sdf,
     const bool _convert,
+    const ParserConfig &_config,
     Errors &_errors);
 
+/// \brief Read an SDFormat file that doesn't need to be converted one
+/// top-level element at a time, without loading the whole document into
+/// a tinyxml2 DOM.
+///
+/// The children of the <sdf> element and of its <world> elements are parsed
+/// in small batches, so peak memory depends on the size of the largest
+/// model rather than the size of the file. The result is the same as
+/// reading the file with readDoc.
+/// \param[in] _filename Path to the file.
+/// \param[in] _data Contents of the file.
+/// \param[in] _sdf Pointer to an SDF object.
+/// \param[in] _convert True if the file should be converted to the latest
+/// version.
+/// \param[in] _config Parser configuration.
+/// \param[out] _handled False if the file can't be streamed, in which case
+/// it must be read with readDoc. Nothing has been modified in that case.
+/// \param[out] _errors Parsing errors will be appended to this variable.
+/// \return True if the file was read successfully.
+static bool readFileStreaming(const std::string &_filename,
+                              std::string_view _data, SDFPtr _sdf,
+                              bool _convert, const ParserConfig &_config,
+                              bool &_handled, Errors &_errors);
+
+/// \brief Convert a URDF document to SDFormat at the current version.
+/// \param[in] _urdfXml The parsed URDF document.
+/// \param[in] _urdfStr Text of the URDF document.
+/// \param[out] _sdfXmlOut Converted SDFormat document.
+/// \return False if the document isn't a valid URDF model.
+static bool convertURDF(tinyxml2::XMLDocument &_urdfXml,
+                        std::string_view _urdfStr,
+                        tinyxml2::XMLDocument *_sdfXmlOut)
+{
+  URDF2SDF u2g;
+  return u2g.ConvertDoc(_urdfXml, _urdfStr, _sdfXmlOut);
+}
+
 //////////////////////////////////////////////////
 template <typename TPtr>
 static inline bool _initFile(const std::string &_filename, TPtr _sdf)
@@ -97,23 +147,90 @@ static inline bool _initFile(const std::string &_filename, TPtr _sdf)
 }
 
 //////////////////////////////////////////////////
-bool init(SDFPtr _sdf)
+/// \brief Get the schema built from an embedded SDFormat spec file.
+///
+/// The description tree of each embedded spec file is built only once per
+/// spec version and then shared by every Element initialized from it. The
+/// returned schema must be treated as immutable.
+/// \param[in] _filename Base name of the spec file, such as "root.sdf".
+/// \param[in] _quiet True to suppress console messages if the file is not
+/// found.
+/// \return The schema, or nullptr if the spec file is not embedded or could
+/// not be parsed.
+static ElementPtr embeddedSchema(const std::string &_filename, bool _quiet)
 {
-  std::string xmldata = SDF::EmbeddedSpec("root.sdf", false);
+  // A recursive mutex is required because building a schema recursively
+  // builds the schemas of the spec files it includes.
+  static std::recursive_mutex schemaMutex;
+  static std::map<std::string, ElementPtr> schemas;
+
+  const std::string key = SDF::Version() + "/" + _filename;
+
+  std::lock_guard<std::recursive_mutex> lock(schemaMutex);
+  auto it = schemas.find(key);
+  if (it != schemas.end())
+  {
+    return it->second;
+  }
+
+  const std::string &xmldata = SDF::EmbeddedSpec(_filename, _quiet);
+  if (xmldata.empty())
+  {
+    return ElementPtr();
+  }
+
   tinyxml2::XMLDocument xmlDoc;
   xmlDoc.Parse(xmldata.c_str());
-  return initDoc(&xmlDoc, _sdf);
+
+  ElementPtr schema(new Element);
+  if (!initDoc(&xmlDoc, schema))
+  {
+    return ElementPtr();
+  }
+
+  schemas[key] = schema;
+  return schema;
+}
+
+//////////////////////////////////////////////////
+/// \brief Initialize an Element from a schema returned by embeddedSchema.
+/// The element descriptions are shared with the schema, while attributes and
+/// values are copied so that they can be set independently.
+/// \param[in] _schema Schema to copy from.
+/// \param[in,out] _sdf Element to initialize.
+static void initFromSchema(const ElementPtr &_schema, ElementPtr _sdf)
+{
+  // Element::Copy overwrites these with the empty values of the schema.
+  const std::string path = _sdf->FilePath();
+  const std::string originalVersion = _sdf->OriginalVersion();
+
+  _sdf->Copy(_schema);
+
+  _sdf->SetFilePath(path);
+  _sdf->SetOriginalVersion(originalVersion);
+}
+
+//////////////////////////////////////////////////
+bool init(SDFPtr _sdf)
+{
+  ElementPtr schema = embeddedSchema("root.sdf", false);
+  if (!schema)
+  {
+    return false;
+  }
+
+  initFromSchema(schema, _sdf->Root());
+  return true;
 }
 
 //////////////////////////////////////////////////
 bool initFile(const std::string &_filename, SDFPtr _sdf)
 {
-  std::string xmldata = SDF::EmbeddedSpec(_filename, true);
-  if (!xmldata.empty())
+  ElementPtr schema = embeddedSchema(_filename, true);
+  if (schema)
   {
-    tinyxml2::XMLDocument xmlDoc;
-    xmlDoc.Parse(xmldata.c_str());
-    return initDoc(&xmlDoc, _sdf);
+    initFromSchema(schema, _sdf->Root());
+    return true;
   }
   return _initFile(sdf::findFile(_filename), _sdf);
 }
@@ -121,21 +238,20 @@ bool initFile(const std::string &_filename, SDFPtr _sdf)
 //////////////////////////////////////////////////
 bool initFile(const std::string &_filename, ElementPtr _sdf)
 {
-  std::string xmldata = SDF::EmbeddedSpec(_filename, true);
-  if (!xmldata.empty())
+  ElementPtr schema = embeddedSchema(_filename, true);
+  if (schema)
   {
-    tinyxml2::XMLDocument xmlDoc;
-    xmlDoc.Parse(xmldata.c_str());
-    return initDoc(&xmlDoc, _sdf);
+    initFromSchema(schema, _sdf);
+    return true;
   }
   return _initFile(sdf::findFile(_filename), _sdf);
 }
 
 //////////////////////////////////////////////////
-bool initString(const std::string &_xmlString, SDFPtr _sdf)
+bool initString(std::string_view _xmlString, SDFPtr _sdf)
 {
   tinyxml2::XMLDocument xmlDoc;
-  if (xmlDoc.Parse(_xmlString.c_str()))
+  if (xmlDoc.Parse(_xmlString.data(), _xmlString.size()))
   {
     sdferr << "Failed to parse string as XML: " << xmlDoc.ErrorStr() << '\n';
     return false;
@@ -336,13 +452,20 @@ bool initXml(tinyxml2::XMLElement *_xml, ElementPtr _sdf)
 
 //////////////////////////////////////////////////
 SDFPtr readFile(const std::string &_filename, Errors &_errors)
+{
+  return readFile(_filename, ParserConfig::GlobalConfig(), _errors);
+}
+
+//////////////////////////////////////////////////
+SDFPtr readFile(const std::string &_filename, const ParserConfig &_config,
+                Errors &_errors)
 {
   // Create and initialize the data structure that will hold the parsed SDF data
   sdf::SDFPtr sdfParsed(new sdf::SDF());
   sdf::init(sdfParsed);
 
   // Read an SDF file, and store the result in sdfParsed.
-  if (!sdf::readFile(_filename, sdfParsed, _errors))
+  if (!sdf::readFile(_filename, _config, sdfParsed, _errors))
   {
     return SDFPtr();
   }
@@ -379,22 +502,38 @@ bool readFile(const std::string &_filename, SDFPtr _sdf)
 //////////////////////////////////////////////////
 bool readFile(const std::string &_filename, SDFPtr _sdf, Errors &_errors)
 {
-  return readFileInternal(_filename, _sdf, true, _errors);
+  return readFileInternal(
+      _filename, _sdf, true, ParserConfig::GlobalConfig(), _errors);
+}
+
+//////////////////////////////////////////////////
+bool readFile(const std::string &_filename, const ParserConfig &_config,
+              SDFPtr _sdf, Errors &_errors)
+{
+  return readFileInternal(_filename, _sdf, true, _config, _errors);
 }
 
 //////////////////////////////////////////////////
 bool readFileWithoutConversion(
     const std::string &_filename, SDFPtr _sdf, Errors &_errors)
 {
-  return readFileInternal(_filename, _sdf, false, _errors);
+  return readFileInternal(
+      _filename, _sdf, false, ParserConfig::GlobalConfig(), _errors);
+}
+
+//////////////////////////////////////////////////
+bool readFileWithoutConversion(const std::string &_filename,
+    const ParserConfig &_config, SDFPtr _sdf, Errors &_errors)
+{
+  return readFileInternal(_filename, _sdf, false, _config, _errors);
 }
 
 //////////////////////////////////////////////////
 bool readFileInternal(const std::string &_filename, SDFPtr _sdf,
-      const bool _convert, Errors &_errors)
+      const bool _convert, const ParserConfig &_config, Errors &_errors)
 {
   tinyxml2::XMLDocument xmlDoc;
-  std::string filename = sdf::findFile(_filename, true, true);
+  std::string filename = sdf::findFile(_filename, true, true, _config);
 
   if (filename.empty())
   {
@@ -413,7 +552,22 @@ bool readFileInternal(const std::string &_filename, SDFPtr _sdf,
     return false;
   }
 
-  auto error_code = xmlDoc.LoadFile(filename.c_str());
+  // The file is mapped rather than read into a buffer, so that its pages
+  // are shared with other processes that load the same file.
+  MappedFile file(filename);
+  if (!file.Valid())
+  {
+    sdferr << "Unable to read file [" << filename << "].\n";
+    return false;
+  }
+
+  bool streamed = false;
+  bool result = readFileStreaming(filename, file.Data(), _sdf, _convert,
+                                  _config, streamed, _errors);
+  if (streamed)
+    return result;
+
+  auto error_code = xmlDoc.Parse(file.Data().data(), file.Data().size());
   if (error_code)
   {
     sdferr << "Error parsing XML in file [" << filename << "]: "
@@ -421,17 +575,21 @@ bool readFileInternal(const std::string &_filename, SDFPtr _sdf,
     return false;
   }
 
-  // Suppress deprecation for sdf::URDF2SDF
-  if (readDoc(&xmlDoc, _sdf, filename, _convert, _errors))
+  if (readDoc(&xmlDoc, _sdf, filename, _convert, _config, _errors))
   {
     return true;
   }
-  else if (URDF2SDF::IsURDF(filename))
+  else if (xmlDoc.FirstChildElement("robot"))
   {
-    URDF2SDF u2g;
+    // Convert the document that was already parsed instead of loading the
+    // file again.
     tinyxml2::XMLDocument doc;
-    u2g.InitModelFile(filename, &doc);
-    if (sdf::readDoc(&doc, _sdf, "urdf file", _convert, _errors))
+    if (!convertURDF(xmlDoc, file.Data(), &doc))
+    {
+      return false;
+    }
+
+    if (sdf::readDoc(&doc, _sdf, "urdf file", _convert, _config, _errors))
     {
       sdfdbg << "parse from urdf file [" << _filename << "].\n";
       return true;
@@ -447,7 +605,7 @@ bool readFileInternal(const std::string &_filename, SDFPtr _sdf,
 }
 
 //////////////////////////////////////////////////
-bool readString(const std::string &_xmlString, SDFPtr _sdf)
+bool readString(std::string_view _xmlString, SDFPtr _sdf)
 {
   Errors errors;
   bool result = readString(_xmlString, _sdf, errors);
@@ -460,40 +618,59 @@ bool readString(const std::string &_xmlString, SDFPtr _sdf)
 }
 
 //////////////////////////////////////////////////
-bool readString(const std::string &_xmlString, SDFPtr _sdf, Errors &_errors)
+bool readString(std::string_view _xmlString, SDFPtr _sdf, Errors &_errors)
+{
+  return readStringInternal(
+      _xmlString, _sdf, true, ParserConfig::GlobalConfig(), _errors);
+}
+
+//////////////////////////////////////////////////
+bool readString(std::string_view _xmlString, const ParserConfig &_config,
+                SDFPtr _sdf, Errors &_errors)
 {
-  return readStringInternal(_xmlString, _sdf, true, _errors);
+  return readStringInternal(_xmlString, _sdf, true, _config, _errors);
 }
 
 //////////////////////////////////////////////////
 bool readStringWithoutConversion(
-    const std::string &_filename, SDFPtr _sdf, Errors &_errors)
+    std::string_view _filename, SDFPtr _sdf, Errors &_errors)
+{
+  return readStringInternal(
+      _filename, _sdf, false, ParserConfig::GlobalConfig(), _errors);
+}
+
+//////////////////////////////////////////////////
+bool readStringWithoutConversion(std::string_view _xmlString,
+    const ParserConfig &_config, SDFPtr _sdf, Errors &_errors)
 {
-  return readStringInternal(_filename, _sdf, false, _errors);
+  return readStringInternal(_xmlString, _sdf, false, _config, _errors);
 }
 
 //////////////////////////////////////////////////
-bool readStringInternal(const std::string &_xmlString, SDFPtr _sdf,
-    const bool _convert, Errors &_errors)
+bool readStringInternal(std::string_view _xmlString, SDFPtr _sdf,
+    const bool _convert, const ParserConfig &_config, Errors &_errors)
 {
   tinyxml2::XMLDocument xmlDoc;
-  xmlDoc.Parse(_xmlString.c_str());
+  xmlDoc.Parse(_xmlString.data(), _xmlString.size());
   if (xmlDoc.Error())
   {
     sdferr << "Error parsing XML from string: " << xmlDoc.ErrorStr() << '\n';
     return false;
   }
-  if (readDoc(&xmlDoc, _sdf, "data-string", _convert, _errors))
+  if (readDoc(&xmlDoc, _sdf, "data-string", _convert, _config, _errors))
   {
     return true;
   }
   else
   {
-    URDF2SDF u2g;
     tinyxml2::XMLDocument doc;
-    u2g.InitModelString(_xmlString, &doc);
+    if (!convertURDF(xmlDoc, _xmlString, &doc))
+    {
+      sdferr << "Unable to call parseURDF on robot model\n";
+      return false;
+    }
 
-    if (sdf::readDoc(&doc, _sdf, "urdf string", _convert, _errors))
+    if (sdf::readDoc(&doc, _sdf, "urdf string", _convert, _config, _errors))
     {
       sdfdbg << "Parsing from urdf.\n";
       return true;
@@ -509,7 +686,7 @@ bool readStringInternal(const std::string &_xmlString, SDFPtr _sdf,
 }
 
 //////////////////////////////////////////////////
-bool readString(const std::string &_xmlString, ElementPtr _sdf)
+bool readString(std::string_view _xmlString, ElementPtr _sdf)
 {
   Errors errors;
   bool result = readString(_xmlString, _sdf, errors);
@@ -522,16 +699,23 @@ bool readString(const std::string &_xmlString, ElementPtr _sdf)
 }
 
 //////////////////////////////////////////////////
-bool readString(const std::string &_xmlString, ElementPtr _sdf, Errors &_errors)
+bool readString(std::string_view _xmlString, ElementPtr _sdf, Errors &_errors)
+{
+  return readString(_xmlString, ParserConfig::GlobalConfig(), _sdf, _errors);
+}
+
+//////////////////////////////////////////////////
+bool readString(std::string_view _xmlString, const ParserConfig &_config,
+                ElementPtr _sdf, Errors &_errors)
 {
   tinyxml2::XMLDocument xmlDoc;
-  xmlDoc.Parse(_xmlString.c_str());
+  xmlDoc.Parse(_xmlString.data(), _xmlString.size());
   if (xmlDoc.Error())
   {
     sdferr << "Error parsing XML from string: " << xmlDoc.ErrorStr() << '\n';
     return false;
   }
-  if (readDoc(&xmlDoc, _sdf, "data-string", true, _errors))
+  if (readDoc(&xmlDoc, _sdf, "data-string", true, _config, _errors))
   {
     return true;
   }
@@ -545,7 +729,8 @@ bool readString(const std::string &_xmlString, ElementPtr _sdf, Errors &_errors)
 
 //////////////////////////////////////////////////
 bool readDoc(tinyxml2::XMLDocument *_xmlDoc, SDFPtr _sdf,
-    const std::string &_source, bool _convert, Errors &_errors)
+    const std::string &_source, bool _convert, const ParserConfig &_config,
+    Errors &_errors)
 {
   if (!_xmlDoc)
   {
@@ -587,12 +772,12 @@ bool readDoc(tinyxml2::XMLDocument *_xmlDoc, SDFPtr _sdf,
         && strcmp(sdfNode->Attribute("version"), SDF::Version().c_str()) != 0)
     {
       sdfdbg << "Converting a deprecated source[" << _source << "].\n";
-      Converter::Convert(_xmlDoc, SDF::Version());
+      Converter::Convert(_xmlDoc, SDF::Version(), _config);
     }
 
     // parse new sdf xml
     auto *elemXml = _xmlDoc->FirstChildElement(_sdf->Root()->GetName().c_str());
-    if (!readXml(elemXml, _sdf->Root(), _errors))
+    if (!readXml(elemXml, _sdf->Root(), _config, _errors))
     {
       _errors.push_back({ErrorCode::ELEMENT_INVALID,
           "Error reading element <" + _sdf->Root()->GetName() + ">"});
@@ -618,7 +803,8 @@ bool readDoc(tinyxml2::XMLDocument *_xmlDoc, SDFPtr _sdf,
 
 //////////////////////////////////////////////////
 bool readDoc(tinyxml2::XMLDocument *_xmlDoc, ElementPtr _sdf,
-             const std::string &_source, bool _convert, Errors &_errors)
+             const std::string &_source, bool _convert,
+             const ParserConfig &_config, Errors &_errors)
 {
   if (!_xmlDoc)
   {
@@ -649,7 +835,7 @@ bool readDoc(tinyxml2::XMLDocument *_xmlDoc, ElementPtr _sdf,
         && strcmp(sdfNode->Attribute("version"), SDF::Version().c_str()) != 0)
     {
       sdfwarn << "Converting a deprecated SDF source[" << _source << "].\n";
-      Converter::Convert(_xmlDoc, SDF::Version());
+      Converter::Convert(_xmlDoc, SDF::Version(), _config);
     }
 
     tinyxml2::XMLElement *elemXml = sdfNode;
@@ -660,7 +846,7 @@ bool readDoc(tinyxml2::XMLDocument *_xmlDoc, ElementPtr _sdf,
     }
 
     // parse new sdf xml
-    if (!readXml(elemXml, _sdf, _errors))
+    if (!readXml(elemXml, _sdf, _config, _errors))
     {
       _errors.push_back({ErrorCode::ELEMENT_INVALID,
           "Unable to parse sdf element["+ _sdf->GetName() + "]"});
@@ -800,28 +986,149 @@ std::string getModelFilePath(const std::string &_modelDirPath)
 }
 
 //////////////////////////////////////////////////
-bool readXml(tinyxml2::XMLElement *_xml, ElementPtr _sdf, Errors &_errors)
+/// \brief True while the current thread loads an included file for
+/// concurrent include resolution. Includes nested in that file are then
+/// loaded serially.
+static thread_local bool tl_loadingIncludes = false;
+
+//////////////////////////////////////////////////
+/// \brief Sets tl_loadingIncludes while it exists, and restores the previous
+/// value when it is destroyed, even if loading an include throws.
+class LoadingIncludesGuard
 {
-  // Check if the element pointer is deprecated.
-  if (_sdf->GetRequired() == "-1")
+  /// \brief Constructor.
+  public: LoadingIncludesGuard()
+    : previous(tl_loadingIncludes)
   {
-    sdfwarn << "SDF Element[" + _sdf->GetName() + "] is deprecated\n";
+    tl_loadingIncludes = true;
   }
 
-  if (!_xml)
+  /// \brief Destructor.
+  public: ~LoadingIncludesGuard()
   {
-    if (_sdf->GetRequired() == "1" || _sdf->GetRequired() =="+")
+    tl_loadingIncludes = this->previous;
+  }
+
+  /// \brief Value of tl_loadingIncludes before the guard was created.
+  private: const bool previous;
+};
+
+//////////////////////////////////////////////////
+/// \brief A file referenced by an <include> element, loaded into its own
+/// SDF object but not yet inserted into the including element.
+struct IncludedFile
+{
+  /// \brief Errors that occurred while looking up the included file. If not
+  /// empty, the include is skipped.
+  Errors lookupErrors;
+
+  /// \brief Full path to the included file.
+  std::string filename;
+
+  /// \brief The loaded file.
+  SDFPtr sdf;
+
+  /// \brief Errors that occurred while reading the included file.
+  Errors readErrors;
+
+  /// \brief True if the included file was read successfully.
+  bool read = false;
+};
+
+//////////////////////////////////////////////////
+/// \brief Find and read the file referenced by an <include> element. This
+/// does not modify any shared state, so several includes can be loaded
+/// concurrently.
+/// \param[in] _includeXml The <include> element.
+/// \param[in] _config Custom parser configuration.
+/// \return The loaded file.
+static IncludedFile loadIncludedFile(tinyxml2::XMLElement *_includeXml,
+                                     const ParserConfig &_config)
+{
+  IncludedFile result;
+
+  if (!_includeXml->FirstChildElement("uri"))
+  {
+    result.lookupErrors.push_back({ErrorCode::ATTRIBUTE_MISSING,
+        "<include> element missing 'uri' attribute"});
+    return result;
+  }
+
+  std::string uri = _includeXml->FirstChildElement("uri")->GetText();
+  std::string modelPath = sdf::findFile(uri, true, true, _config);
+
+  // Test the model path
+  if (modelPath.empty())
+  {
+    result.lookupErrors.push_back({ErrorCode::URI_LOOKUP,
+        "Unable to find uri[" + uri + "]"});
+
+    size_t modelFound = uri.find("model://");
+    if (modelFound != 0u)
     {
-      _errors.push_back({ErrorCode::ELEMENT_MISSING,
-          "SDF Element<" + _sdf->GetName() + "> is missing"});
-      return false;
+      result.lookupErrors.push_back({ErrorCode::URI_INVALID,
+          "Invalid uri[" + uri + "]. Should be model://" + uri});
     }
-    else
+    return result;
+  }
+  else
+  {
+    if (!sdf::filesystem::is_directory(modelPath))
     {
-      return true;
+      result.lookupErrors.push_back({ErrorCode::DIRECTORY_NONEXISTANT,
+          "Directory doesn't exist[" + modelPath + "]"});
+      return result;
     }
   }
 
+  // Get the config.xml filename
+  result.filename = getModelFilePath(modelPath);
+
+  // sdf::init is cheap since the schema is built only once and
+  // shared between all SDF objects.
+  result.sdf.reset(new SDF);
+  init(result.sdf);
+
+  IncludeCache *cache = includeCache(_config);
+  if (!cache)
+  {
+    result.read = readFile(result.filename, _config, result.sdf,
+                           result.readErrors);
+    return result;
+  }
+
+  // Reuse the file if it has already been loaded. The cached elements are
+  // never modified, since the include overrides are applied to a clone.
+  IncludeCache::Entry cached;
+  if (cache->Load(result.filename,
+        [&](IncludeCache::Entry &_loaded)
+        {
+          result.read = readFile(result.filename, _config, result.sdf,
+                                 result.readErrors);
+          if (result.read)
+          {
+            _loaded = {result.sdf->Root()->Clone(), result.readErrors};
+          }
+          return result.read;
+        }, cached))
+  {
+    result.sdf->Root(cached.root->Clone());
+    result.readErrors = cached.errors;
+    result.read = true;
+  }
+  return result;
+}
+
+//////////////////////////////////////////////////
+/// \brief Read the value and the attributes of an XML element into an SDF
+/// element.
+/// \param[in] _xml The XML element.
+/// \param[in,out] _sdf SDF element to parse data into.
+/// \param[out] _errors Captures errors found during parsing.
+/// \return True on success, false on error.
+static bool readXmlAttributes(tinyxml2::XMLElement *_xml, ElementPtr _sdf,
+                              Errors &_errors)
+{
   if (_xml->GetText() != nullptr && _sdf->GetValue())
   {
     if (!_sdf->GetValue()->SetFromString(_xml->GetText()))
@@ -842,7 +1149,8 @@ bool readXml(tinyxml2::XMLElement *_xml, ElementPtr _sdf, Errors &_errors)
 
   // A list of parent element-attributes pairs where a frame name is referenced
   // in the attribute. This is used to check if the reference is invalid.
-  std::set<std::pair<std::string, std::string>> frameReferenceAttributes {
+  static const std::set<std::pair<std::string, std::string>>
+      frameReferenceAttributes {
       // //frame/[@attached_to]
       {"frame", "attached_to"},
       // //pose/[@relative_to]
@@ -856,8 +1164,6 @@ bool readXml(tinyxml2::XMLElement *_xml, ElementPtr _sdf, Errors &_errors)
 
   const tinyxml2::XMLAttribute *attribute = _xml->FirstAttribute();
 
-  unsigned int i = 0;
-
   // Iterate over all the attributes defined in the give XML element
   while (attribute)
   {
@@ -872,35 +1178,30 @@ bool readXml(tinyxml2::XMLElement *_xml, ElementPtr _sdf, Errors &_errors)
       continue;
     }
     // Find the matching attribute in SDF
-    for (i = 0; i < _sdf->GetAttributeCount(); ++i)
+    ParamPtr p = _sdf->GetAttribute(attribute->Name());
+    if (p)
     {
-      ParamPtr p = _sdf->GetAttribute(i);
-      if (p->GetKey() == attribute->Name())
+      if (frameReferenceAttributes.count(
+              std::make_pair(_sdf->GetName(), attribute->Name())) != 0)
       {
-        if (frameReferenceAttributes.count(
-                std::make_pair(_sdf->GetName(), attribute->Name())) != 0)
-        {
-          if (!isValidFrameReference(attribute->Value()))
-          {
-            _errors.push_back({ErrorCode::ATTRIBUTE_INVALID,
-                "'" + std::string(attribute->Value()) +
-                    "' is reserved; it cannot be used as a value of "
-                    "attribute [" +
-                    p->GetKey() + "]"});
-            }
-        }
-        // Set the value of the SDF attribute
-        if (!p->SetFromString(attribute->Value()))
+        if (!isValidFrameReference(attribute->Value()))
         {
           _errors.push_back({ErrorCode::ATTRIBUTE_INVALID,
-              "Unable to read attribute[" + p->GetKey() + "]"});
-          return false;
+              "'" + std::string(attribute->Value()) +
+                  "' is reserved; it cannot be used as a value of "
+                  "attribute [" +
+                  p->GetKey() + "]"});
         }
-        break;
+      }
+      // Set the value of the SDF attribute
+      if (!p->SetFromString(attribute->Value()))
+      {
+        _errors.push_back({ErrorCode::ATTRIBUTE_INVALID,
+            "Unable to read attribute[" + p->GetKey() + "]"});
+        return false;
       }
     }
-
-    if (i == _sdf->GetAttributeCount())
+    else
     {
       sdfwarn << "XML Attribute[" << attribute->Name()
               << "] in element[" << _xml->Value()
@@ -911,7 +1212,7 @@ bool readXml(tinyxml2::XMLElement *_xml, ElementPtr _sdf, Errors &_errors)
   }
 
   // Check that all required attributes have been set
-  for (i = 0; i < _sdf->GetAttributeCount(); ++i)
+  for (unsigned int i = 0; i < _sdf->GetAttributeCount(); ++i)
   {
     ParamPtr p = _sdf->GetAttribute(i);
     if (p->GetRequired() && !p->GetSet())
@@ -923,280 +1224,299 @@ bool readXml(tinyxml2::XMLElement *_xml, ElementPtr _sdf, Errors &_errors)
     }
   }
 
-  if (_sdf->GetCopyChildren())
-  {
-    copyChildren(_sdf, _xml, false);
-  }
-  else
-  {
-    std::string filename;
+  return true;
+}
 
-    // Iterate over all the child elements
-    tinyxml2::XMLElement *elemXml = nullptr;
-    for (elemXml = _xml->FirstChildElement(); elemXml;
-         elemXml = elemXml->NextSiblingElement())
+//////////////////////////////////////////////////
+/// \brief Read the child elements of an XML element into an SDF element,
+/// including the files referenced by <include> elements.
+/// \param[in] _xml The XML element.
+/// \param[in,out] _sdf SDF element to parse data into.
+/// \param[in] _config Parser configuration.
+/// \param[in] _copyUnknown True to also copy the child elements that are
+/// not part of the SDFormat spec.
+/// \param[out] _errors Captures errors found during parsing.
+/// \return True on success, false on error.
+static bool readXmlChildren(tinyxml2::XMLElement *_xml, ElementPtr _sdf,
+                            const ParserConfig &_config, bool _copyUnknown,
+                            Errors &_errors)
+{
+  // When requested, load all the included files concurrently up front.
+  // They are inserted below in document order, exactly as if they had
+  // been loaded one at a time. Reading stops at the first included file
+  // that can't be read, so no new includes are scheduled after that.
+  // Includes that were skipped come after the failed one, so they are
+  // never needed, but they are loaded below if they are.
+  std::vector<std::optional<IncludedFile>> preloaded;
+  if (_config.IncludeThreadCount() > 1 && !tl_loadingIncludes)
+  {
+    std::vector<tinyxml2::XMLElement *> includes;
+    for (auto *includeXml = _xml->FirstChildElement("include"); includeXml;
+         includeXml = includeXml->NextSiblingElement("include"))
     {
-      if (std::string("include") == elemXml->Value())
-      {
-        std::string modelPath;
-
-        if (elemXml->FirstChildElement("uri"))
-        {
-          std::string uri = elemXml->FirstChildElement("uri")->GetText();
-          modelPath = sdf::findFile(uri, true, true);
+      includes.push_back(includeXml);
+    }
 
-          // Test the model path
-          if (modelPath.empty())
+    if (includes.size() > 1)
+    {
+      preloaded.resize(includes.size());
+      std::atomic<bool> readFailed{false};
+      parallelFor(includes.size(), _config.IncludeThreadCount(),
+          [&](std::size_t _index)
           {
-            _errors.push_back({ErrorCode::URI_LOOKUP,
-                "Unable to find uri[" + uri + "]"});
-
-            size_t modelFound = uri.find("model://");
-            if (modelFound != 0u)
+            if (readFailed)
             {
-              _errors.push_back({ErrorCode::URI_INVALID,
-                  "Invalid uri[" + uri + "]. Should be model://" + uri});
+              return;
             }
-            continue;
-          }
-          else
-          {
-            if (!sdf::filesystem::is_directory(modelPath))
+
+            // Includes nested in the included files are loaded serially
+            // by the thread that loads their parent.
+            LoadingIncludesGuard guard;
+            preloaded[_index] = loadIncludedFile(includes[_index], _config);
+            if (preloaded[_index]->lookupErrors.empty() &&
+                !preloaded[_index]->read)
             {
-              _errors.push_back({ErrorCode::DIRECTORY_NONEXISTANT,
-                  "Directory doesn't exist[" + modelPath + "]"});
-              continue;
+              readFailed = true;
             }
-          }
+          });
+    }
+  }
+  std::size_t includeIndex = 0;
 
-          // Get the config.xml filename
-          filename = getModelFilePath(modelPath);
-        }
-        else
-        {
-          _errors.push_back({ErrorCode::ATTRIBUTE_MISSING,
-              "<include> element missing 'uri' attribute"});
-          continue;
-        }
+  // Iterate over all the child elements
+  tinyxml2::XMLElement *elemXml = nullptr;
+  for (elemXml = _xml->FirstChildElement(); elemXml;
+       elemXml = elemXml->NextSiblingElement())
+  {
+    if (std::string("include") == elemXml->Value())
+    {
+      IncludedFile included =
+        preloaded.empty() || !preloaded[includeIndex] ?
+        loadIncludedFile(elemXml, _config) :
+        std::move(*preloaded[includeIndex]);
+      ++includeIndex;
 
-        // NOTE: sdf::init is an expensive call. For performance reason,
-        // a new sdf pointer is created here by cloning a fresh sdf template
-        // pointer instead of calling init every iteration.
-        // SDFPtr includeSDF(new SDF);
-        // init(includeSDF);
-        static SDFPtr includeSDFTemplate;
-        if (!includeSDFTemplate)
-        {
-          includeSDFTemplate.reset(new SDF);
-          init(includeSDFTemplate);
-        }
-        SDFPtr includeSDF(new SDF);
-        includeSDF->Root(includeSDFTemplate->Root()->Clone());
+      if (!included.lookupErrors.empty())
+      {
+        _errors.insert(_errors.end(), included.lookupErrors.begin(),
+                       included.lookupErrors.end());
+        continue;
+      }
 
-        if (!readFile(filename, includeSDF))
-        {
-          _errors.push_back({ErrorCode::FILE_READ,
-              "Unable to read file[" + filename + "]"});
-          return false;
-        }
+      SDFPtr includeSDF = included.sdf;
+
+      // Output errors
+      for (auto const &e : included.readErrors)
+        std::cerr << e << std::endl;
 
-        // For now there is only a warning if there is more than one model,
-        // actor or light element, or two different types of those elements. For
-        // compatibility with old behavior, this chooses the first element
-        // in the preference order: model->actor->light
-        sdf::ElementPtr topLevelElem;
-        for (const auto & elementType : {"model", "actor", "light"})
+      if (!included.read)
+      {
+        _errors.push_back({ErrorCode::FILE_READ,
+            "Unable to read file[" + included.filename + "]"});
+        return false;
+      }
+
+      // For now there is only a warning if there is more than one model,
+      // actor or light element, or two different types of those elements. For
+      // compatibility with old behavior, this chooses the first element
+      // in the preference order: model->actor->light
+      sdf::ElementPtr topLevelElem;
+      for (const auto & elementType : {"model", "actor", "light"})
+      {
+        if (includeSDF->Root()->HasElement(elementType))
         {
-          if (includeSDF->Root()->HasElement(elementType))
+          if (nullptr == topLevelElem)
           {
-            if (nullptr == topLevelElem)
-            {
-              topLevelElem = includeSDF->Root()->GetElement(elementType);
-            }
-            else
-            {
-              sdfwarn << "Found other top level element <" << elementType
-                      << "> in addition to <" << topLevelElem->GetName()
-                      << "> in include file. This is unsupported and in future "
-                      << "versions of libsdformat will become an error";
-            }
+            topLevelElem = includeSDF->Root()->GetElement(elementType);
+          }
+          else
+          {
+            sdfwarn << "Found other top level element <" << elementType
+                    << "> in addition to <" << topLevelElem->GetName()
+                    << "> in include file. This is unsupported and in future "
+                    << "versions of libsdformat will become an error";
           }
         }
+      }
 
-        if (nullptr == topLevelElem)
-        {
-          _errors.push_back({ErrorCode::ELEMENT_MISSING,
-              "Failed to find top level <model> / <actor> / <light> for "
-              "<include>\n"});
-          continue;
-        }
+      if (nullptr == topLevelElem)
+      {
+        _errors.push_back({ErrorCode::ELEMENT_MISSING,
+            "Failed to find top level <model> / <actor> / <light> for "
+            "<include>\n"});
+        continue;
+      }
 
-        const auto topLevelElementType = topLevelElem->GetName();
-        // Check for more than one of the discovered top-level element type
-        if (nullptr != topLevelElem->GetNextElement(topLevelElementType))
-        {
-          sdfwarn << "Found more than one of " << topLevelElem->GetName()
-                  << " for <include>. This is unsupported and in future "
-                  << "versions of libsdformat will become an error";
-        }
+      const auto topLevelElementType = topLevelElem->GetName();
+      // Check for more than one of the discovered top-level element type
+      if (nullptr != topLevelElem->GetNextElement(topLevelElementType))
+      {
+        sdfwarn << "Found more than one of " << topLevelElem->GetName()
+                << " for <include>. This is unsupported and in future "
+                << "versions of libsdformat will become an error";
+      }
+
+      bool isModel = topLevelElementType == "model";
+      bool isActor = topLevelElementType == "actor";
+
+      if (elemXml->FirstChildElement("name"))
+      {
+        topLevelElem->GetAttribute("name")->SetFromString(
+              elemXml->FirstChildElement("name")->GetText());
+      }
 
-        bool isModel = topLevelElementType == "model";
-        bool isActor = topLevelElementType == "actor";
+      tinyxml2::XMLElement *poseElemXml = elemXml->FirstChildElement("pose");
+      if (poseElemXml)
+      {
+        sdf::ElementPtr poseElem = topLevelElem->GetElement("pose");
 
-        if (elemXml->FirstChildElement("name"))
+        if (poseElemXml->GetText())
         {
-          topLevelElem->GetAttribute("name")->SetFromString(
-                elemXml->FirstChildElement("name")->GetText());
+          poseElem->GetValue()->SetFromString(poseElemXml->GetText());
         }
-
-        tinyxml2::XMLElement *poseElemXml = elemXml->FirstChildElement("pose");
-        if (poseElemXml)
+        else
         {
-          sdf::ElementPtr poseElem = topLevelElem->GetElement("pose");
-
-          if (poseElemXml->GetText())
-          {
-            poseElem->GetValue()->SetFromString(poseElemXml->GetText());
-          }
-          else
-          {
-            poseElem->GetValue()->Reset();
-          }
-
-          const char *relativeTo = poseElemXml->Attribute("relative_to");
-          if (relativeTo)
-          {
-            poseElem->GetAttribute("relative_to")->SetFromString(relativeTo);
-          }
-          else
-          {
-            poseElem->GetAttribute("relative_to")->Reset();
-          }
+          poseElem->GetValue()->Reset();
         }
 
-        if (isModel && elemXml->FirstChildElement("static"))
+        const char *relativeTo = poseElemXml->Attribute("relative_to");
+        if (relativeTo)
+        {
+          poseElem->GetAttribute("relative_to")->SetFromString(relativeTo);
+        }
+        else
         {
-          topLevelElem->GetElement("static")->GetValue()->SetFromString(
-                elemXml->FirstChildElement("static")->GetText());
+          poseElem->GetAttribute("relative_to")->Reset();
         }
+      }
+
+      if (isModel && elemXml->FirstChildElement("static"))
+      {
+        topLevelElem->GetElement("static")->GetValue()->SetFromString(
+              elemXml->FirstChildElement("static")->GetText());
+      }
 
-        if (isModel && elemXml->FirstChildElement("placement_frame"))
+      if (isModel && elemXml->FirstChildElement("placement_frame"))
+      {
+        if (nullptr == elemXml->FirstChildElement("pose"))
         {
-          if (nullptr == elemXml->FirstChildElement("pose"))
-          {
-            _errors.push_back({ErrorCode::MODEL_PLACEMENT_FRAME_INVALID,
-                "<pose> is required when specifying the placement_frame "
-                "element"});
-            return false;
-          }
+          _errors.push_back({ErrorCode::MODEL_PLACEMENT_FRAME_INVALID,
+              "<pose> is required when specifying the placement_frame "
+              "element"});
+          return false;
+        }
 
-          const std::string placementFrameVal =
-              elemXml->FirstChildElement("placement_frame")->GetText();
+        const std::string placementFrameVal =
+            elemXml->FirstChildElement("placement_frame")->GetText();
 
-          if (!isValidFrameReference(placementFrameVal))
-          {
-            _errors.push_back({ErrorCode::RESERVED_NAME,
-                "'" + placementFrameVal +
-                    "' is reserved; it cannot be used as a value of "
-                    "element [placement_frame]"});
-          }
-          topLevelElem->GetAttribute("placement_frame")
-              ->SetFromString(placementFrameVal);
+        if (!isValidFrameReference(placementFrameVal))
+        {
+          _errors.push_back({ErrorCode::RESERVED_NAME,
+              "'" + placementFrameVal +
+                  "' is reserved; it cannot be used as a value of "
+                  "element [placement_frame]"});
         }
+        topLevelElem->GetAttribute("placement_frame")
+            ->SetFromString(placementFrameVal);
+      }
 
-        if (isModel || isActor)
+      if (isModel || isActor)
+      {
+        for (auto *childElemXml = elemXml->FirstChildElement();
+             childElemXml; childElemXml = childElemXml->NextSiblingElement())
         {
-          for (auto *childElemXml = elemXml->FirstChildElement();
-               childElemXml; childElemXml = childElemXml->NextSiblingElement())
+          if (std::string("plugin") == childElemXml->Value())
           {
-            if (std::string("plugin") == childElemXml->Value())
+            sdf::ElementPtr pluginElem;
+            pluginElem = topLevelElem->AddElement("plugin");
+
+            if (!readXml(childElemXml, pluginElem, _config, _errors))
             {
-              sdf::ElementPtr pluginElem;
-              pluginElem = topLevelElem->AddElement("plugin");
-
-              if (!readXml(childElemXml, pluginElem, _errors))
-              {
-                _errors.push_back({ErrorCode::ELEMENT_INVALID,
-                                   "Error reading plugin element"});
-                return false;
-              }
+              _errors.push_back({ErrorCode::ELEMENT_INVALID,
+                                 "Error reading plugin element"});
+              return false;
             }
           }
         }
+      }
 
-        includeSDF->Root()->GetFirstElement()->SetParent(_sdf);
-        _sdf->InsertElement(includeSDF->Root()->GetFirstElement());
-        // TODO: This was used to store the included filename so that when
-        // a world is saved, the included model's SDF is not stored in the
-        // world file. This highlights the need to make model inclusion
-        // a core feature of SDF, and not a hack that that parser handles
-        // includeSDF->Root()->GetFirstElement()->SetInclude(
-        // elemXml->Attribute("filename"));
+      includeSDF->Root()->GetFirstElement()->SetParent(_sdf);
+      _sdf->InsertElement(includeSDF->Root()->GetFirstElement());
+      // TODO: This was used to store the included filename so that when
+      // a world is saved, the included model's SDF is not stored in the
+      // world file. This highlights the need to make model inclusion
+      // a core feature of SDF, and not a hack that that parser handles
+      // includeSDF->Root()->GetFirstElement()->SetInclude(
+      // elemXml->Attribute("filename"));
 
-        continue;
-      }
+      continue;
+    }
 
-      // Find the matching element in SDF
-      unsigned int descCounter = 0;
-      for (descCounter = 0;
-           descCounter != _sdf->GetElementDescriptionCount(); ++descCounter)
+    // Find the matching element in SDF
+    ElementPtr elemDesc = _sdf->GetElementDescription(elemXml->Value());
+    if (elemDesc)
+    {
+      ElementPtr element = elemDesc->Clone();
+      element->SetParent(_sdf);
+      if (readXml(elemXml, element, _config, _errors))
       {
-        ElementPtr elemDesc = _sdf->GetElementDescription(descCounter);
-        if (elemDesc->GetName() == elemXml->Value())
-        {
-          ElementPtr element = elemDesc->Clone();
-          element->SetParent(_sdf);
-          if (readXml(elemXml, element, _errors))
-          {
-            _sdf->InsertElement(element);
-          }
-          else
-          {
-            _errors.push_back({ErrorCode::ELEMENT_INVALID,
-                std::string("Error reading element <") +
-                elemXml->Value() + ">"});
-            return false;
-          }
-          break;
-        }
+        _sdf->InsertElement(element);
       }
-
-      if (descCounter == _sdf->GetElementDescriptionCount())
+      else
       {
-        sdfdbg << "XML Element[" << elemXml->Value()
-               << "], child of element[" << _xml->Value()
-               << "], not defined in SDF. Copying[" << elemXml->Value() << "] "
-               << "as children of [" << _xml->Value() << "].\n";
-        continue;
+        _errors.push_back({ErrorCode::ELEMENT_INVALID,
+            std::string("Error reading element <") +
+            elemXml->Value() + ">"});
+        return false;
       }
     }
-
-    // Copy unknown elements outside the loop so it only happens one time
+    else
+    {
+      sdfdbg << "XML Element[" << elemXml->Value()
+             << "], child of element[" << _xml->Value()
+             << "], not defined in SDF. Copying[" << elemXml->Value() << "] "
+             << "as children of [" << _xml->Value() << "].\n";
+      continue;
+    }
+  }
+
+  // Copy unknown elements outside the loop so it only happens one time
+  if (_copyUnknown)
     copyChildren(_sdf, _xml, true);
 
-    // Check that all required elements have been set
-    for (unsigned int descCounter = 0;
-         descCounter != _sdf->GetElementDescriptionCount(); ++descCounter)
-    {
-      ElementPtr elemDesc = _sdf->GetElementDescription(descCounter);
+  return true;
+}
 
-      if (elemDesc->GetRequired() == "1" || elemDesc->GetRequired() == "+")
+//////////////////////////////////////////////////
+/// \brief Add default values for the required child elements of an SDF
+/// element that were not read from XML.
+/// \param[in,out] _sdf The SDF element.
+/// \param[out] _errors Captures errors found during parsing.
+/// \return False if a required element can't have a default value.
+static bool addRequiredElements(ElementPtr _sdf, Errors &_errors)
+{
+  // Check that all required elements have been set
+  for (unsigned int descCounter = 0;
+       descCounter != _sdf->GetElementDescriptionCount(); ++descCounter)
+  {
+    ElementPtr elemDesc = _sdf->GetElementDescription(descCounter);
+
+    if (elemDesc->GetRequired() == "1" || elemDesc->GetRequired() == "+")
+    {
+      if (!_sdf->HasElement(elemDesc->GetName()))
       {
-        if (!_sdf->HasElement(elemDesc->GetName()))
+        if (_sdf->GetName() == "joint" &&
+            _sdf->Get<std::string>("type") != "ball")
         {
-          if (_sdf->GetName() == "joint" &&
-              _sdf->Get<std::string>("type") != "ball")
-          {
-            _errors.push_back({ErrorCode::ELEMENT_MISSING,
-                "XML Missing required element[" + elemDesc->GetName() +
-                "], child of element[" + _sdf->GetName() + "]"});
-            return false;
-          }
-          else
-          {
-            // Add default element
-            _sdf->AddElement(elemDesc->GetName());
-          }
+          _errors.push_back({ErrorCode::ELEMENT_MISSING,
+              "XML Missing required element[" + elemDesc->GetName() +
+              "], child of element[" + _sdf->GetName() + "]"});
+          return false;
+        }
+        else
+        {
+          // Add default element
+          _sdf->AddElement(elemDesc->GetName());
         }
       }
     }
@@ -1205,6 +1525,291 @@ bool readXml(tinyxml2::XMLElement *_xml, ElementPtr _sdf, Errors &_errors)
   return true;
 }
 
+//////////////////////////////////////////////////
+bool readXml(tinyxml2::XMLElement *_xml, ElementPtr _sdf,
+             const ParserConfig &_config, Errors &_errors)
+{
+  // Check if the element pointer is deprecated.
+  if (_sdf->GetRequired() == "-1")
+  {
+    sdfwarn << "SDF Element[" + _sdf->GetName() + "] is deprecated\n";
+  }
+
+  if (!_xml)
+  {
+    if (_sdf->GetRequired() == "1" || _sdf->GetRequired() =="+")
+    {
+      _errors.push_back({ErrorCode::ELEMENT_MISSING,
+          "SDF Element<" + _sdf->GetName() + "> is missing"});
+      return false;
+    }
+    else
+    {
+      return true;
+    }
+  }
+
+  if (!readXmlAttributes(_xml, _sdf, _errors))
+    return false;
+
+  if (_sdf->GetCopyChildren())
+  {
+    copyChildren(_sdf, _xml, false);
+  }
+  else
+  {
+    if (!readXmlChildren(_xml, _sdf, _config, true, _errors))
+      return false;
+
+    if (!addRequiredElements(_sdf, _errors))
+      return false;
+  }
+
+  return true;
+}
+
+//////////////////////////////////////////////////
+/// \brief Parse the child elements read from an XML stream into an SDF
+/// element.
+/// \param[in] _children Text of the child elements.
+/// \param[in,out] _sdf SDF element to parse data into.
+/// \param[in] _config Parser configuration.
+/// \param[in] _copyUnknown True to copy the child elements that are not part
+/// of the SDFormat spec instead of reading the known ones.
+/// \param[in] _source Name of the file being read.
+/// \param[out] _errors Captures errors found during parsing.
+/// \return True on success, false on error.
+static bool readStreamedChildren(const std::string &_children,
+                                 ElementPtr _sdf, const ParserConfig &_config,
+                                 bool _copyUnknown, const std::string &_source,
+                                 Errors &_errors)
+{
+  if (_children.empty())
+    return true;
+
+  const std::string &name = _sdf->GetName();
+  const std::string text = "<" + name + ">" + _children + "</" + name + ">";
+
+  tinyxml2::XMLDocument xmlDoc;
+  if (xmlDoc.Parse(text.c_str(), text.size()) != tinyxml2::XML_SUCCESS)
+  {
+    sdferr << "Error parsing XML in file [" << _source << "]: "
+           << xmlDoc.ErrorStr() << '\n';
+    return false;
+  }
+
+  if (_copyUnknown)
+  {
+    copyChildren(_sdf, xmlDoc.RootElement(), true);
+    return true;
+  }
+  return readXmlChildren(xmlDoc.RootElement(), _sdf, _config, false, _errors);
+}
+
+//////////////////////////////////////////////////
+/// \brief Parse the start tag of an element read from an XML stream.
+/// \param[in] _reader Reader that just returned the start tag.
+/// \param[out] _xmlDoc Document that receives the element, without
+/// children.
+/// \param[in] _source Name of the file being read.
+/// \return The element, or nullptr on error.
+static tinyxml2::XMLElement *parseStartTag(const XmlStreamReader &_reader,
+    tinyxml2::XMLDocument &_xmlDoc, const std::string &_source)
+{
+  std::string text = _reader.Tag();
+  if (!_reader.EmptyElement())
+    text.insert(text.size() - 1, "/");
+
+  if (_xmlDoc.Parse(text.c_str(), text.size()) != tinyxml2::XML_SUCCESS)
+  {
+    sdferr << "Error parsing XML in file [" << _source << "]: "
+           << _xmlDoc.ErrorStr() << '\n';
+    return nullptr;
+  }
+  return _xmlDoc.RootElement();
+}
+
+//////////////////////////////////////////////////
+/// \brief Read an element from an XML stream. The start tag of the element
+/// has already been read. This is equivalent to readXml, except that
+/// children are parsed in batches as they are read, and <world> children of
+/// <sdf> are read from the stream recursively.
+/// \param[in] _reader Reader positioned after the start tag of the element.
+/// \param[in] _xml The element, parsed from its start tag.
+/// \param[in,out] _sdf SDF element to parse data into.
+/// \param[in] _config Parser configuration.
+/// \param[in] _source Name of the file being read.
+/// \param[out] _errors Captures errors found during parsing.
+/// \return True on success, false on error.
+static bool readXmlStream(XmlStreamReader &_reader,
+                          tinyxml2::XMLElement *_xml, ElementPtr _sdf,
+                          const ParserConfig &_config,
+                          const std::string &_source, Errors &_errors)
+{
+  // Batches of children are parsed once they reach this size.
+  const std::size_t batchSize = 256 * 1024;
+
+  // Check if the element pointer is deprecated.
+  if (_sdf->GetRequired() == "-1")
+  {
+    sdfwarn << "SDF Element[" + _sdf->GetName() + "] is deprecated\n";
+  }
+
+  if (!readXmlAttributes(_xml, _sdf, _errors))
+    return false;
+
+  // Elements that are not part of the spec are also collected separately,
+  // since readXml copies them after all the other children.
+  std::string batch;
+  std::string unknown;
+  while (true)
+  {
+    XmlStreamReader::Token token = _reader.Next();
+    if (token == XmlStreamReader::Token::END_TAG &&
+        _reader.Name() == _xml->Name())
+    {
+      break;
+    }
+
+    if (token != XmlStreamReader::Token::START_TAG)
+    {
+      sdferr << "Error parsing XML in file [" << _source << "]: "
+             << "unexpected markup or end of file in element <"
+             << _xml->Name() << ">\n";
+      return false;
+    }
+
+    const std::string name = _reader.Name();
+    ElementPtr elemDesc;
+    if (_sdf->GetName() == "sdf" && name == "world" &&
+        !_reader.EmptyElement() && !_sdf->GetCopyChildren())
+    {
+      elemDesc = _sdf->GetElementDescription(name);
+    }
+
+    if (elemDesc && !elemDesc->GetCopyChildren())
+    {
+      // Keep document order.
+      if (!readStreamedChildren(batch, _sdf, _config, false, _source,
+                                _errors))
+      {
+        return false;
+      }
+      batch.clear();
+
+      tinyxml2::XMLDocument startDoc;
+      tinyxml2::XMLElement *startXml =
+        parseStartTag(_reader, startDoc, _source);
+      if (!startXml)
+        return false;
+
+      ElementPtr element = elemDesc->Clone();
+      element->SetParent(_sdf);
+      if (readXmlStream(_reader, startXml, element, _config, _source,
+                        _errors))
+      {
+        _sdf->InsertElement(element);
+      }
+      else
+      {
+        _errors.push_back({ErrorCode::ELEMENT_INVALID,
+            std::string("Error reading element <") + name + ">"});
+        return false;
+      }
+      continue;
+    }
+
+    std::string text = _reader.Tag();
+    if (!_reader.EmptyElement() && !_reader.ReadElementContent(text))
+    {
+      sdferr << "Error parsing XML in file [" << _source << "]: "
+             << "unexpected end of file in element <" << name << ">\n";
+      return false;
+    }
+
+    if (!_sdf->HasElementDescription(name))
+      unknown += text;
+
+    batch += text;
+    if (batch.size() >= batchSize)
+    {
+      if (!readStreamedChildren(batch, _sdf, _config, false, _source,
+                                _errors))
+      {
+        return false;
+      }
+      batch.clear();
+    }
+  }
+
+  if (_sdf->GetCopyChildren())
+  {
+    return readStreamedChildren(batch, _sdf, _config, true, _source, _errors);
+  }
+
+  if (!readStreamedChildren(batch, _sdf, _config, false, _source, _errors) ||
+      !readStreamedChildren(unknown, _sdf, _config, true, _source, _errors))
+  {
+    return false;
+  }
+
+  return addRequiredElements(_sdf, _errors);
+}
+
+//////////////////////////////////////////////////
+static bool readFileStreaming(const std::string &_filename,
+                              std::string_view _data, SDFPtr _sdf,
+                              bool _convert, const ParserConfig &_config,
+                              bool &_handled, Errors &_errors)
+{
+  _handled = false;
+
+  if (nullptr == _sdf || nullptr == _sdf->Root() ||
+      _sdf->Root()->GetName() != "sdf")
+  {
+    return false;
+  }
+
+  XmlStreamReader reader(_data);
+  if (reader.Next() != XmlStreamReader::Token::START_TAG ||
+      reader.Name() != "sdf" || reader.EmptyElement())
+  {
+    return false;
+  }
+
+  tinyxml2::XMLDocument startDoc;
+  tinyxml2::XMLElement *sdfNode = parseStartTag(reader, startDoc, _filename);
+  if (!sdfNode || !sdfNode->Attribute("version"))
+    return false;
+
+  // Files that need to be converted are read with the DOM.
+  const std::string version = sdfNode->Attribute("version");
+  if (_convert && version != SDF::Version())
+    return false;
+
+  _handled = true;
+
+  _sdf->SetFilePath(_filename);
+  if (_sdf->OriginalVersion().empty())
+  {
+    _sdf->SetOriginalVersion(version);
+  }
+  if (_sdf->Root()->OriginalVersion().empty())
+  {
+    _sdf->Root()->SetOriginalVersion(version);
+  }
+
+  if (!readXmlStream(reader, sdfNode, _sdf->Root(), _config, _filename,
+                     _errors))
+  {
+    _errors.push_back({ErrorCode::ELEMENT_INVALID,
+        "Error reading element <" + _sdf->Root()->GetName() + ">"});
+    return false;
+  }
+
+  return true;
+}
+
 /////////////////////////////////////////////////
 void copyChildren(ElementPtr _sdf,
                   tinyxml2::XMLElement *_xml,
@@ -1243,8 +1848,8 @@ void copyChildren(ElementPtr _sdf,
     else
     {
       ElementPtr element(new Element);
-      element->SetParent(_sdf);
       element->SetName(elem_name);
+      element->SetParent(_sdf);
       if (elemXml->GetText() != nullptr)
       {
         element->AddValue("string", elemXml->GetText(), "1");
@@ -1300,7 +1905,8 @@ bool convertFile(const std::string &_filename, const std::string &_version,
     if (sdf::Converter::Convert(&xmlDoc, _version, true))
     {
       Errors errors;
-      bool result = sdf::readDoc(&xmlDoc, _sdf, filename, false, errors);
+      bool result = sdf::readDoc(&xmlDoc, _sdf, filename, false,
+                                 ParserConfig::GlobalConfig(), errors);
 
       // Output errors
       for (auto const &e : errors)
@@ -1347,7 +1953,8 @@ bool convertString(const std::string &_sdfString, const std::string &_version,
     if (sdf::Converter::Convert(&xmlDoc, _version, true))
     {
       Errors errors;
-      bool result = sdf::readDoc(&xmlDoc, _sdf, "data-string", false, errors);
+      bool result = sdf::readDoc(&xmlDoc, _sdf, "data-string", false,
+                                 ParserConfig::GlobalConfig(), errors);
 
       // Output errors
       for (auto const &e : errors)
@@ -1364,6 +1971,28 @@ bool convertString(const std::string &_sdfString, const std::string &_version,
   return false;
 }
 
+//////////////////////////////////////////////////
+/// \brief Check that the canonical_link attribute of a model, if set,
+/// matches the name of one of its links.
+/// \param[in] _model Model to check.
+/// \param[out] _out Stream that errors are written to.
+/// \return True if the canonical link name is valid.
+static bool checkModelCanonicalLinkName(const sdf::Model *_model,
+    std::ostream &_out)
+{
+  bool modelResult = true;
+  std::string canonicalLink = _model->CanonicalLinkName();
+  if (!canonicalLink.empty() && !_model->LinkNameExists(canonicalLink))
+  {
+    _out << "Error: canonical_link with name[" << canonicalLink
+              << "] not found in model with name[" << _model->Name()
+              << "]."
+              << std::endl;
+    modelResult = false;
+  }
+  return modelResult;
+}
+
 //////////////////////////////////////////////////
 bool checkCanonicalLinkNames(const sdf::Root *_root)
 {
@@ -1377,26 +2006,10 @@ bool checkCanonicalLinkNames(const sdf::Root *_root)
 
   bool result = true;
 
-  auto checkModelCanonicalLinkName = [](
-      const sdf::Model *_model) -> bool
-  {
-    bool modelResult = true;
-    std::string canonicalLink = _model->CanonicalLinkName();
-    if (!canonicalLink.empty() && !_model->LinkNameExists(canonicalLink))
-    {
-      std::cerr << "Error: canonical_link with name[" << canonicalLink
-                << "] not found in model with name[" << _model->Name()
-                << "]."
-                << std::endl;
-      modelResult = false;
-    }
-    return modelResult;
-  };
-
   for (uint64_t m = 0; m < _root->ModelCount(); ++m)
   {
     auto model = _root->ModelByIndex(m);
-    result = checkModelCanonicalLinkName(model) && result;
+    result = checkModelCanonicalLinkName(model, std::cerr) && result;
   }
 
   for (uint64_t w = 0; w < _root->WorldCount(); ++w)
@@ -1405,7 +2018,7 @@ bool checkCanonicalLinkNames(const sdf::Root *_root)
     for (uint64_t m = 0; m < world->ModelCount(); ++m)
     {
       auto model = world->ModelByIndex(m);
-      result = checkModelCanonicalLinkName(model) && result;
+      result = checkModelCanonicalLinkName(model, std::cerr) && result;
     }
   }
 
@@ -1557,17 +2170,15 @@ bool recursiveSameTypeUniqueNames(sdf::ElementPtr _elem)
     return true;
 
   bool result = true;
-  auto typeNames = _elem->GetElementTypeNames();
-  for (const std::string &typeName : typeNames)
+  std::set<std::string> duplicateTypes;
+  uniqueChildNames(*_elem, "", &duplicateTypes);
+  for (const std::string &typeName : duplicateTypes)
   {
-    if (!_elem->HasUniqueChildNames(typeName))
-    {
-      std::cerr << "Error: Non-unique names detected in type "
-                << typeName << " in\n"
-                << _elem->ToString("")
-                << std::endl;
-      result = false;
-    }
+    std::cerr << "Error: Non-unique names detected in type "
+              << typeName << " in\n"
+              << _elem->ToString("")
+              << std::endl;
+    result = false;
   }
 
   sdf::ElementPtr child = _elem->GetFirstElement();
@@ -1581,30 +2192,41 @@ bool recursiveSameTypeUniqueNames(sdf::ElementPtr _elem)
 }
 
 //////////////////////////////////////////////////
-bool recursiveSiblingUniqueNames(sdf::ElementPtr _elem)
+/// \brief Implementation of recursiveSiblingUniqueNames.
+/// \param[in] _elem sdf Element to check recursively.
+/// \param[out] _out Stream that errors are written to.
+/// \return True if no element shares a name with a sibling.
+static bool recursiveSiblingUniqueNames(sdf::ElementPtr _elem,
+    std::ostream &_out)
 {
   if (!shouldValidateElement(_elem))
     return true;
 
-  bool result = _elem->HasUniqueChildNames();
+  bool result = uniqueChildNames(*_elem);
   if (!result)
   {
-    std::cerr << "Error: Non-unique names detected in "
-              << _elem->ToString("")
-              << std::endl;
+    _out << "Error: Non-unique names detected in "
+         << _elem->ToString("")
+         << std::endl;
     result = false;
   }
 
   sdf::ElementPtr child = _elem->GetFirstElement();
   while (child)
   {
-    result = recursiveSiblingUniqueNames(child) && result;
+    result = recursiveSiblingUniqueNames(child, _out) && result;
     child = child->GetNextElement();
   }
 
   return result;
 }
 
+//////////////////////////////////////////////////
+bool recursiveSiblingUniqueNames(sdf::ElementPtr _elem)
+{
+  return recursiveSiblingUniqueNames(_elem, std::cerr);
+}
+
 //////////////////////////////////////////////////
 bool checkFrameAttachedToGraph(const sdf::Root *_root)
 {
@@ -1772,117 +2394,123 @@ bool checkPoseRelativeToGraph(const sdf::Root *_root)
 }
 
 //////////////////////////////////////////////////
-bool checkJointParentChildLinkNames(const sdf::Root *_root)
+/// \brief Check that the parent and child frames of every joint in a model
+/// exist and resolve to different links.
+/// \param[in] _model Model to check.
+/// \param[out] _out Stream that errors are written to.
+/// \return True if all joint parent and child names are valid.
+static bool checkModelJointParentChildNames(const sdf::Model *_model,
+    std::ostream &_out)
 {
-  bool result = true;
-
-  auto checkModelJointParentChildNames = [](
-      const sdf::Model *_model) -> bool
+  bool modelResult = true;
+  for (uint64_t j = 0; j < _model->JointCount(); ++j)
   {
-    bool modelResult = true;
-    for (uint64_t j = 0; j < _model->JointCount(); ++j)
-    {
-      auto joint = _model->JointByIndex(j);
+    auto joint = _model->JointByIndex(j);
 
-      const std::string &parentName = joint->ParentLinkName();
-      if (parentName != "world" && !_model->LinkNameExists(parentName) &&
-          !_model->JointNameExists(parentName) &&
-          !_model->FrameNameExists(parentName))
-      {
-        std::cerr << "Error: parent frame with name[" << parentName
-                  << "] specified by joint with name[" << joint->Name()
-                  << "] not found in model with name[" << _model->Name()
-                  << "]."
-                  << std::endl;
-        modelResult = false;
-      }
+    const std::string &parentName = joint->ParentLinkName();
+    if (parentName != "world" && !_model->LinkNameExists(parentName) &&
+        !_model->JointNameExists(parentName) &&
+        !_model->FrameNameExists(parentName))
+    {
+      _out << "Error: parent frame with name[" << parentName
+                << "] specified by joint with name[" << joint->Name()
+                << "] not found in model with name[" << _model->Name()
+                << "]."
+                << std::endl;
+      modelResult = false;
+    }
 
-      const std::string &childName = joint->ChildLinkName();
-      if (childName == "world")
-      {
-        std::cerr << "Error: invalid child name[world"
-                  << "] specified by joint with name[" << joint->Name()
-                  << "] in model with name[" << _model->Name()
-                  << "]."
-                  << std::endl;
-        modelResult = false;
-      }
+    const std::string &childName = joint->ChildLinkName();
+    if (childName == "world")
+    {
+      _out << "Error: invalid child name[world"
+                << "] specified by joint with name[" << joint->Name()
+                << "] in model with name[" << _model->Name()
+                << "]."
+                << std::endl;
+      modelResult = false;
+    }
 
-      if (!_model->LinkNameExists(childName) &&
-          !_model->JointNameExists(childName) &&
-          !_model->FrameNameExists(childName) &&
-          !_model->ModelNameExists(childName))
-      {
-        std::cerr << "Error: child frame with name[" << childName
-                  << "] specified by joint with name[" << joint->Name()
-                  << "] not found in model with name[" << _model->Name()
-                  << "]."
-                  << std::endl;
-        modelResult = false;
-      }
+    if (!_model->LinkNameExists(childName) &&
+        !_model->JointNameExists(childName) &&
+        !_model->FrameNameExists(childName) &&
+        !_model->ModelNameExists(childName))
+    {
+      _out << "Error: child frame with name[" << childName
+                << "] specified by joint with name[" << joint->Name()
+                << "] not found in model with name[" << _model->Name()
+                << "]."
+                << std::endl;
+      modelResult = false;
+    }
 
-      if (childName == joint->Name())
-      {
-        std::cerr << "Error: joint with name[" << joint->Name()
-                  << "] in model with name[" << _model->Name()
-                  << "] must not specify its own name as the child frame."
-                  << std::endl;
-        modelResult = false;
-      }
+    if (childName == joint->Name())
+    {
+      _out << "Error: joint with name[" << joint->Name()
+                << "] in model with name[" << _model->Name()
+                << "] must not specify its own name as the child frame."
+                << std::endl;
+      modelResult = false;
+    }
 
-      if (parentName == joint->Name())
-      {
-        std::cerr << "Error: joint with name[" << joint->Name()
-                  << "] in model with name[" << _model->Name()
-                  << "] must not specify its own name as the parent frame."
-                  << std::endl;
-        modelResult = false;
-      }
+    if (parentName == joint->Name())
+    {
+      _out << "Error: joint with name[" << joint->Name()
+                << "] in model with name[" << _model->Name()
+                << "] must not specify its own name as the parent frame."
+                << std::endl;
+      modelResult = false;
+    }
 
-      // Check that parent and child frames resolve to different links
-      std::string resolvedChildName;
-      std::string resolvedParentName;
-      auto errors = joint->ResolveChildLink(resolvedChildName);
-      if (!errors.empty())
-      {
-        std::cerr << "Error when attempting to resolve child link name:"
-                  << std::endl;
-        for (auto error : errors)
-        {
-          std::cerr << error.Message() << std::endl;
-        }
-        modelResult = false;
-      }
-      errors = joint->ResolveParentLink(resolvedParentName);
-      if (!errors.empty())
+    // Check that parent and child frames resolve to different links
+    std::string resolvedChildName;
+    std::string resolvedParentName;
+    auto errors = joint->ResolveChildLink(resolvedChildName);
+    if (!errors.empty())
+    {
+      _out << "Error when attempting to resolve child link name:"
+                << std::endl;
+      for (auto error : errors)
       {
-        std::cerr << "Error when attempting to resolve parent link name:"
-                  << std::endl;
-        for (auto error : errors)
-        {
-          std::cerr << error.Message() << std::endl;
-        }
-        modelResult = false;
+        _out << error.Message() << std::endl;
       }
-      if (resolvedChildName == resolvedParentName)
+      modelResult = false;
+    }
+    errors = joint->ResolveParentLink(resolvedParentName);
+    if (!errors.empty())
+    {
+      _out << "Error when attempting to resolve parent link name:"
+                << std::endl;
+      for (auto error : errors)
       {
-        std::cerr << "Error: joint with name[" << joint->Name()
-                  << "] in model with name[" << _model->Name()
-                  << "] specified parent frame [" << parentName
-                  << "] and child frame [" << childName
-                  << "] that both resolve to [" << resolvedChildName
-                  << "], but they should resolve to different values."
-                  << std::endl;
-        modelResult = false;
+        _out << error.Message() << std::endl;
       }
+      modelResult = false;
     }
-    return modelResult;
-  };
+    if (resolvedChildName == resolvedParentName)
+    {
+      _out << "Error: joint with name[" << joint->Name()
+                << "] in model with name[" << _model->Name()
+                << "] specified parent frame [" << parentName
+                << "] and child frame [" << childName
+                << "] that both resolve to [" << resolvedChildName
+                << "], but they should resolve to different values."
+                << std::endl;
+      modelResult = false;
+    }
+  }
+  return modelResult;
+}
+
+//////////////////////////////////////////////////
+bool checkJointParentChildLinkNames(const sdf::Root *_root)
+{
+  bool result = true;
 
   for (uint64_t m = 0; m < _root->ModelCount(); ++m)
   {
     auto model = _root->ModelByIndex(m);
-    result = checkModelJointParentChildNames(model) && result;
+    result = checkModelJointParentChildNames(model, std::cerr) && result;
   }
 
   for (uint64_t w = 0; w < _root->WorldCount(); ++w)
@@ -1891,10 +2519,59 @@ bool checkJointParentChildLinkNames(const sdf::Root *_root)
     for (uint64_t m = 0; m < world->ModelCount(); ++m)
     {
       auto model = world->ModelByIndex(m);
-      result = checkModelJointParentChildNames(model) && result;
+      result = checkModelJointParentChildNames(model, std::cerr) && result;
+    }
+  }
+
+  return result;
+}
+
+//////////////////////////////////////////////////
+bool checkLoadedRoot(const sdf::Root *_root)
+{
+  return checkLoadedRoot(_root, std::cerr);
+}
+
+//////////////////////////////////////////////////
+bool checkLoadedRoot(const sdf::Root *_root, std::ostream &_out)
+{
+  if (!_root)
+  {
+    _out << "Error: invalid sdf::Root pointer, unable to check root."
+         << std::endl;
+    return false;
+  }
+
+  bool result = true;
+
+  // The frame graphs of every world and model were built and validated by
+  // Root::Load, so only the checks that the graphs do not cover are run here,
+  // visiting each model once.
+  auto checkModel = [&_out](const sdf::Model *_model) -> bool
+  {
+    bool modelResult = checkModelCanonicalLinkName(_model, _out);
+    return checkModelJointParentChildNames(_model, _out) && modelResult;
+  };
+
+  for (uint64_t m = 0; m < _root->ModelCount(); ++m)
+  {
+    result = checkModel(_root->ModelByIndex(m)) && result;
+  }
+
+  for (uint64_t w = 0; w < _root->WorldCount(); ++w)
+  {
+    auto world = _root->WorldByIndex(w);
+    for (uint64_t m = 0; m < world->ModelCount(); ++m)
+    {
+      result = checkModel(world->ModelByIndex(m)) && result;
     }
   }
 
+  if (_root->Element())
+  {
+    result = recursiveSiblingUniqueNames(_root->Element(), _out) && result;
+  }
+
   return result;
 }
 
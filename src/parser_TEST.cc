@@ -60,6 +60,41 @@ sdf::SDFPtr InitSDF()
   return sdf;
 }
 
+/////////////////////////////////////////////////
+TEST(Parser, SharedSchema)
+{
+  sdf::SDFPtr sdf1 = InitSDF();
+  sdf::SDFPtr sdf2 = InitSDF();
+  ASSERT_NE(sdf1->Root(), sdf2->Root());
+
+  // The element descriptions are built once and shared.
+  ASSERT_GT(sdf1->Root()->GetElementDescriptionCount(), 0u);
+  ASSERT_EQ(sdf1->Root()->GetElementDescriptionCount(),
+            sdf2->Root()->GetElementDescriptionCount());
+  ASSERT_NE(nullptr, sdf1->Root()->GetElementDescription("world"));
+  EXPECT_EQ(sdf1->Root()->GetElementDescription("world"),
+            sdf2->Root()->GetElementDescription("world"));
+
+  // Attributes are not shared.
+  ASSERT_NE(sdf1->Root()->GetAttribute("version"),
+            sdf2->Root()->GetAttribute("version"));
+  EXPECT_TRUE(sdf1->Root()->GetAttribute("version")->Set<std::string>("1.0"));
+  EXPECT_EQ("1.0", sdf1->Root()->Get<std::string>("version"));
+  EXPECT_NE("1.0", sdf2->Root()->Get<std::string>("version"));
+
+  // Elements added from a shared description are independent.
+  sdf::ElementPtr world1 = sdf1->Root()->AddElement("world");
+  sdf::ElementPtr world2 = sdf2->Root()->AddElement("world");
+  ASSERT_NE(nullptr, world1);
+  ASSERT_NE(nullptr, world2);
+  world1->GetAttribute("name")->Set<std::string>("world1");
+  world2->GetAttribute("name")->Set<std::string>("world2");
+  EXPECT_EQ("world1", world1->Get<std::string>("name"));
+  EXPECT_EQ("world2", world2->Get<std::string>("name"));
+  EXPECT_EQ("__default__",
+      sdf1->Root()->GetElementDescription("world")->Get<std::string>("name"));
+}
+
 /////////////////////////////////////////////////
 TEST(Parser, ReusedSDFVersion)
 {
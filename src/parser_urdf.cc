@@ -22,6 +22,7 @@
 #include <set>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
@@ -33,6 +34,7 @@
 
 #include "sdf/sdf.hh"
 
+#include "Utils.hh"
 #include "XmlUtils.hh"
 #include "SDFExtension.hh"
 #include "parser_urdf.hh"
@@ -49,19 +51,164 @@ typedef std::shared_ptr<SDFExtension> SDFExtensionPtr;
 typedef std::map<std::string, std::vector<SDFExtensionPtr> >
   StringSDFExtensionPtrMap;
 
-/// create SDF geometry block based on URDF
-StringSDFExtensionPtrMap g_extensions;
-bool g_reduceFixedJoints;
-bool g_enforceLimits;
-std::string g_collisionExt = "_collision";
-std::string g_visualExt = "_visual";
-std::string g_lumpPrefix = "_fixed_joint_lump__";
-urdf::Pose g_initialRobotPose;
-bool g_initialRobotPoseValid = false;
-std::set<std::string> g_fixedJointsTransformedInRevoluteJoints;
-std::set<std::string> g_fixedJointsTransformedInFixedJoints;
+const std::string g_collisionExt = "_collision";
+const std::string g_visualExt = "_visual";
+const std::string g_lumpPrefix = "_fixed_joint_lump__";
 const int g_outputDecimalPrecision = 16;
 
+/// \brief Destination of a link removed by fixed joint reduction.
+struct LumpedLink
+{
+  /// \brief Nearest ancestor that is kept in the model and absorbs the
+  /// lumped link.
+  urdf::LinkSharedPtr target;
+
+  /// \brief Pose of the lumped link in the frame of the target link.
+  ignition::math::Pose3d pose;
+};
+
+/// \brief Reference from an extension to one of its blobs.
+typedef std::pair<SDFExtensionPtr, std::size_t> SDFExtensionBlobRef;
+
+/// \brief State of a single URDF to SDF conversion, and the conversion steps
+/// that use it. Each URDF2SDF owns one, so independent conversions can run
+/// concurrently.
+class URDF2SDFPrivate
+{
+  /// reduce fixed joints by lumping inertial, visual and
+  /// collision elements of the child link into the parent link
+  public: void ReduceFixedJoints(tinyxml2::XMLElement *_root,
+                                 urdf::LinkSharedPtr _link);
+
+  /// \brief Lump the subtree of a link in a single pass. On the way down,
+  /// each reduced link records its target in lumpedLinks and hands its
+  /// visuals and collisions directly to that target. On the way up, inertia
+  /// and extensions are merged into the parent link.
+  /// \param[in] _link Root of the subtree to reduce.
+  public: void LumpFixedJoints(urdf::LinkSharedPtr _link);
+
+  /// \brief Add the links referred to by an extension blob to
+  /// linkReferences.
+  /// \param[in] _ge Extension holding the blob.
+  /// \param[in] _blobIndex Index of the blob in _ge->blobs.
+  public: void IndexSDFExtensionBlob(SDFExtensionPtr _ge,
+                                     std::size_t _blobIndex);
+
+  /// reduce fixed joints:  lump joints to parent link
+  public: void ReduceJointsToParent(urdf::LinkSharedPtr _link);
+
+  /// \brief reduced fixed joints:  apply appropriate updates to urdf
+  ///   extensions when doing fixed joint reduction
+  ///
+  /// Take the link's existing list of gazebo extensions, transfer them
+  /// into parent link.  Along the way, update local transforms by adding
+  /// the additional transform to parent.  Also, look through all
+  /// referenced link names with plugins and update references to current
+  /// link to the parent link. (ReduceSDFExtensionFrameReplace())
+  ///
+  /// \param[in] _link pointer to urdf link, its extensions will be reduced
+  public: void ReduceSDFExtensionToParent(urdf::LinkSharedPtr _link);
+
+  /// reduced fixed joints:  check if a fixed joint should be lumped
+  ///   checking both the joint type and if disabledFixedJointLumping
+  ///   option is set
+  public: bool FixedJointShouldBeReduced(urdf::JointSharedPtr _jnt);
+
+  /// parse the <origin> of the <robot> element
+  public: void ParseRobotOrigin(tinyxml2::XMLDocument &_urdfXml);
+
+  /// insert the pose parsed by ParseRobotOrigin into the model
+  public: void InsertRobotOrigin(tinyxml2::XMLElement *_elem);
+
+  /// insert extensions into collision geoms
+  public: void InsertSDFExtensionCollision(tinyxml2::XMLElement *_elem,
+                                           const std::string &_linkName);
+
+  /// insert extensions into model
+  public: void InsertSDFExtensionRobot(tinyxml2::XMLElement *_elem);
+
+  /// insert extensions into visuals
+  public: void InsertSDFExtensionVisual(tinyxml2::XMLElement *_elem,
+                                        const std::string &_linkName);
+
+  /// insert extensions into joints
+  public: void InsertSDFExtensionJoint(tinyxml2::XMLElement *_elem,
+                                       const std::string &_jointName);
+
+  /// insert extensions into links
+  public: void InsertSDFExtensionLink(tinyxml2::XMLElement *_elem,
+                                      const std::string &_linkName);
+
+  /// create SDF from URDF link
+  public: void CreateSDF(tinyxml2::XMLElement *_root,
+                         urdf::LinkConstSharedPtr _link,
+                         const ignition::math::Pose3d &_transform);
+
+  /// create SDF Link block based on URDF
+  public: void CreateLink(tinyxml2::XMLElement *_root,
+                          urdf::LinkConstSharedPtr _link,
+                          ignition::math::Pose3d &_currentTransform);
+
+  /// create SDF Joint block based on URDF
+  public: void CreateJoint(tinyxml2::XMLElement *_root,
+                           urdf::LinkConstSharedPtr _link,
+                           ignition::math::Pose3d &_currentTransform);
+
+  /// create collision blocks from urdf collisions
+  public: void CreateCollisions(tinyxml2::XMLElement* _elem,
+                                urdf::LinkConstSharedPtr _link);
+
+  /// create visual blocks from urdf visuals
+  public: void CreateVisuals(tinyxml2::XMLElement* _elem,
+                             urdf::LinkConstSharedPtr _link);
+
+  /// create SDF Collision block based on URDF
+  public: void CreateCollision(tinyxml2::XMLElement* _elem,
+              urdf::LinkConstSharedPtr _link,
+              urdf::CollisionSharedPtr _collision,
+              const std::string &_oldLinkName = std::string(""));
+
+  /// create SDF Visual block based on URDF
+  public: void CreateVisual(tinyxml2::XMLElement *_elem,
+              urdf::LinkConstSharedPtr _link,
+              urdf::VisualSharedPtr _visual,
+              const std::string &_oldLinkName = std::string(""));
+
+  /// \brief SDF extensions, indexed by the name of the link or joint they
+  /// refer to. Extensions of the model have an empty name.
+  public: StringSDFExtensionPtrMap extensions;
+
+  /// \brief Whether fixed joints are lumped into their parent link.
+  public: bool reduceFixedJoints = true;
+
+  /// \brief Whether joint limits are enforced.
+  public: bool enforceLimits = true;
+
+  /// \brief Pose of the <origin> of the <robot> element.
+  public: urdf::Pose initialRobotPose;
+
+  /// \brief Whether the <robot> element has an <origin>.
+  public: bool initialRobotPoseValid = false;
+
+  /// \brief Fixed joints converted to revolute joints by the
+  /// disableFixedJointLumping extension.
+  public: std::set<std::string> fixedJointsTransformedInRevoluteJoints;
+
+  /// \brief Fixed joints preserved by the preserveFixedJoint extension.
+  public: std::set<std::string> fixedJointsTransformedInFixedJoints;
+
+  /// \brief Links removed by fixed joint reduction, indexed by name.
+  public: std::map<std::string, LumpedLink> lumpedLinks;
+
+  /// \brief Extension blobs indexed by the names of the links they refer
+  /// to, so that lumping a link only rewrites the blobs that mention it.
+  public: std::map<std::string, std::vector<SDFExtensionBlobRef>>
+      linkReferences;
+
+  /// \brief Extensions moved to a parent link by fixed joint reduction.
+  public: std::set<SDFExtensionPtr> reducedExtensions;
+};
+
 
 /// \brief parser xml string into urdf::Vector3
 /// \param[in] _key XML key where vector3 value might be
@@ -70,26 +217,6 @@ const int g_outputDecimalPrecision = 16;
 urdf::Vector3 ParseVector3(tinyxml2::XMLNode *_key, double _scale = 1.0);
 urdf::Vector3 ParseVector3(const std::string &_str, double _scale = 1.0);
 
-/// insert extensions into collision geoms
-void InsertSDFExtensionCollision(tinyxml2::XMLElement *_elem,
-                                 const std::string &_linkName);
-
-/// insert extensions into model
-void InsertSDFExtensionRobot(tinyxml2::XMLElement *_elem);
-
-/// insert extensions into visuals
-void InsertSDFExtensionVisual(tinyxml2::XMLElement *_elem,
-                              const std::string &_linkName);
-
-
-/// insert extensions into joints
-void InsertSDFExtensionJoint(tinyxml2::XMLElement *_elem,
-                             const std::string &_jointName);
-
-/// reduced fixed joints:  check if a fixed joint should be lumped
-///   checking both the joint type and if disabledFixedJointLumping
-///   option is set
-bool FixedJointShouldBeReduced(urdf::JointSharedPtr _jnt);
 
 /// reduced fixed joints:  apply transform reduction for ray sensors
 ///   in extensions when doing fixed joint reduction
@@ -108,44 +235,17 @@ void ReduceSDFExtensionProjectorTransformReduction(
 ///   when doing fixed joint reduction
 void ReduceSDFExtensionsTransform(SDFExtensionPtr _ge);
 
-/// reduce fixed joints:  lump joints to parent link
-void ReduceJointsToParent(urdf::LinkSharedPtr _link);
+/// reduce fixed joints:  lump collisions to the target link
+void ReduceCollisionsToParent(urdf::LinkSharedPtr _link,
+                              const LumpedLink &_lump);
 
-/// reduce fixed joints:  lump collisions to parent link
-void ReduceCollisionsToParent(urdf::LinkSharedPtr _link);
-
-/// reduce fixed joints:  lump visuals to parent link
-void ReduceVisualsToParent(urdf::LinkSharedPtr _link);
+/// reduce fixed joints:  lump visuals to the target link
+void ReduceVisualsToParent(urdf::LinkSharedPtr _link,
+                           const LumpedLink &_lump);
 
 /// reduce fixed joints:  lump inertial to parent link
 void ReduceInertialToParent(urdf::LinkSharedPtr /*_link*/);
 
-/// create SDF Collision block based on URDF
-void CreateCollision(tinyxml2::XMLElement* _elem,
-                     urdf::LinkConstSharedPtr _link,
-                     urdf::CollisionSharedPtr _collision,
-                     const std::string &_oldLinkName = std::string(""));
-
-/// create SDF Visual block based on URDF
-void CreateVisual(tinyxml2::XMLElement *_elem, urdf::LinkConstSharedPtr _link,
-                  urdf::VisualSharedPtr _visual,
-                  const std::string &_oldLinkName = std::string(""));
-
-/// create SDF Joint block based on URDF
-void CreateJoint(tinyxml2::XMLElement *_root, urdf::LinkConstSharedPtr _link,
-                 ignition::math::Pose3d &_currentTransform);
-
-/// insert extensions into links
-void InsertSDFExtensionLink(tinyxml2::XMLElement *_elem,
-                            const std::string &_linkName);
-
-/// create visual blocks from urdf visuals
-void CreateVisuals(tinyxml2::XMLElement* _elem, urdf::LinkConstSharedPtr _link);
-
-/// create collision blocks from urdf collisions
-void CreateCollisions(tinyxml2::XMLElement* _elem,
-                      urdf::LinkConstSharedPtr _link);
-
 /// create SDF Inertial block based on URDF
 void CreateInertial(tinyxml2::XMLElement *_elem,
                     urdf::LinkConstSharedPtr _link);
@@ -154,14 +254,6 @@ void CreateInertial(tinyxml2::XMLElement *_elem,
 void AddTransform(tinyxml2::XMLElement *_elem,
     const ignition::math::Pose3d &_transform);
 
-/// create SDF from URDF link
-void CreateSDF(tinyxml2::XMLElement *_root, urdf::LinkConstSharedPtr _link,
-               const ignition::math::Pose3d &_transform);
-
-/// create SDF Link block based on URDF
-void CreateLink(tinyxml2::XMLElement *_root, urdf::LinkConstSharedPtr _link,
-                ignition::math::Pose3d &_currentTransform);
-
 /// reduced fixed joints:  apply appropriate frame updates in joint
 ///   inside urdf extensions when doing fixed joint reduction
 void ReduceSDFExtensionJointFrameReplace(
@@ -194,23 +286,19 @@ void ReduceSDFExtensionContactSensorFrameReplace(
     std::vector<XMLDocumentPtr>::iterator _blobIt,
     urdf::LinkSharedPtr _link);
 
-/// \brief reduced fixed joints:  apply appropriate updates to urdf
-///   extensions when doing fixed joint reduction
-///
-/// Take the link's existing list of gazebo extensions, transfer them
-/// into parent link.  Along the way, update local transforms by adding
-/// the additional transform to parent.  Also, look through all
-/// referenced link names with plugins and update references to current
-/// link to the parent link. (ReduceSDFExtensionFrameReplace())
-///
-/// \param[in] _link pointer to urdf link, its extensions will be reduced
-void ReduceSDFExtensionToParent(urdf::LinkSharedPtr _link);
-
 /// reduced fixed joints:  apply appropriate frame updates
-///   in urdf extensions when doing fixed joint reduction
-void ReduceSDFExtensionFrameReplace(SDFExtensionPtr _ge,
+///   in an urdf extension blob when doing fixed joint reduction
+void ReduceSDFExtensionFrameReplace(
+    std::vector<XMLDocumentPtr>::iterator _blobIt,
+    const ignition::math::Pose3d &_reductionTransform,
     urdf::LinkSharedPtr _link);
 
+/// \brief Names of the links an extension blob refers to, as matched by the
+/// ReduceSDFExtension*FrameReplace functions.
+/// \param[in] _blob The extension blob.
+/// \return Referenced link names.
+std::vector<std::string> SDFExtensionBlobLinkNames(const XMLDocumentPtr &_blob);
+
 /// get value from <key value="..."/> pair and return it as string
 std::string GetKeyValueAsString(tinyxml2::XMLElement* _elem);
 
@@ -256,6 +344,30 @@ ignition::math::Pose3d CopyPose(urdf::Pose _pose);
 ///   math::Pose
 urdf::Pose CopyPose(ignition::math::Pose3d _pose);
 
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Parse a URDF document with urdfdom. The internal copy of urdfdom
+/// reads the tinyxml2 document, while a system installation has to parse the
+/// text of the document.
+/// \param[in] _urdfXml The parsed URDF document.
+/// \param[in] _urdfStr Text of the URDF document. If empty, _urdfXml is
+/// printed when the text is needed.
+/// \return The robot model, or nullptr if the document isn't a valid URDF.
+static urdf::ModelInterfaceSharedPtr parseURDF(
+    tinyxml2::XMLDocument &_urdfXml, std::string_view _urdfStr)
+{
+#ifdef USE_INTERNAL_URDF
+  static_cast<void>(_urdfStr);
+  return urdf::parseURDF(_urdfXml);
+#else
+  if (!_urdfStr.empty())
+    return urdf::parseURDF(std::string(_urdfStr));
+
+  tinyxml2::XMLPrinter printer;
+  _urdfXml.Print(&printer);
+  return urdf::parseURDF(printer.CStr());
+#endif
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 bool URDF2SDF::IsURDF(const std::string &_filename)
 {
@@ -263,10 +375,7 @@ bool URDF2SDF::IsURDF(const std::string &_filename)
 
   if (tinyxml2::XML_SUCCESS == xmlDoc.LoadFile(_filename.c_str()))
   {
-    tinyxml2::XMLPrinter printer;
-    xmlDoc.Print(&printer);
-    std::string urdfStr = printer.CStr();
-    urdf::ModelInterfaceSharedPtr robotModel = urdf::parseURDF(urdfStr);
+    urdf::ModelInterfaceSharedPtr robotModel = parseURDF(xmlDoc, "");
     return robotModel != nullptr;
   }
 
@@ -285,7 +394,7 @@ urdf::Vector3 ParseVector3(const std::string &_str, double _scale)
     {
       try
       {
-        vals.push_back(_scale * std::stod(pieces[i]));
+        vals.push_back(_scale * sdf::stringToDouble(pieces[i]));
       }
       catch(std::invalid_argument &)
       {
@@ -343,114 +452,118 @@ std::string Vector32Str(const urdf::Vector3 _vector)
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// \brief Check and add collision to parent link
-/// \param[in] _parentLink destination for _collision
-/// \param[in] _name urdfdom 0.3+: urdf collision group name with lumped
-///            collision info (see ReduceCollisionsToParent).
-///            urdfdom 0.2: collision name with lumped
-///            collision info (see ReduceCollisionsToParent).
-/// \param[in] _collision move this collision to _parentLink
-void ReduceCollisionToParent(urdf::LinkSharedPtr _parentLink,
-                             const std::string &_name,
-                             urdf::CollisionSharedPtr _collision)
-{
-  // added a check to see if _collision already exist in
-  // _parentLink::collision_array if not, add it.
-  _collision->name = _name;
-  std::vector<urdf::CollisionSharedPtr>::iterator collisionIt =
-    find(_parentLink->collision_array.begin(),
-         _parentLink->collision_array.end(),
-         _collision);
-  if (collisionIt != _parentLink->collision_array.end())
-  {
-    sdfwarn << "attempted to add collision [" << _collision->name
-            << "] to link ["
-            << _parentLink->name
-            << "], but it already exists in collision_array under name ["
-            << (*collisionIt)->name << "]\n";
-  }
-  else
+/// reduce fixed joints by lumping inertial, visual and
+// collision elements of the child link into the parent link
+void URDF2SDFPrivate::ReduceFixedJoints(tinyxml2::XMLElement * /*_root*/,
+                                        urdf::LinkSharedPtr _link)
+{
+  this->lumpedLinks.clear();
+  this->linkReferences.clear();
+  this->reducedExtensions.clear();
+
+  // index the extension blobs by the links they refer to, so that lumping a
+  // link only visits the blobs that need renaming
+  for (auto &ext : this->extensions)
   {
-    _parentLink->collision_array.push_back(_collision);
+    for (auto &ge : ext.second)
+    {
+      for (std::size_t i = 0; i < ge->blobs.size(); ++i)
+      {
+        this->IndexSDFExtensionBlob(ge, i);
+      }
+    }
   }
-}
 
-////////////////////////////////////////////////////////////////////////////////
-/// \brief Check and add visual to parent link
-/// \param[in] _parentLink destination for _visual
-/// \param[in] _name urdfdom 0.3+: urdf visual group name with lumped
-///            visual info (see ReduceVisualsToParent).
-///            urdfdom 0.2: visual name with lumped
-///            visual info (see ReduceVisualsToParent).
-/// \param[in] _visual move this visual to _parentLink
-void ReduceVisualToParent(urdf::LinkSharedPtr _parentLink,
-                          const std::string &_name,
-                          urdf::VisualSharedPtr _visual)
-{
-  // added a check to see if _visual already exist in
-  // _parentLink::visual_array if not, add it.
-  _visual->name = _name;
-  std::vector<urdf::VisualSharedPtr>::iterator visualIt =
-    find(_parentLink->visual_array.begin(),
-         _parentLink->visual_array.end(),
-         _visual);
-  if (visualIt != _parentLink->visual_array.end())
-  {
-    sdfwarn << "attempted to add visual [" << _visual->name
-            << "] to link ["
-            << _parentLink->name
-            << "], but it already exists in visual_array under name ["
-            << (*visualIt)->name << "]\n";
-  }
-  else
+  this->LumpFixedJoints(_link);
+
+  // write the final reduction transform of the moved extensions
+  // (for sensor and projector blocks only)
+  for (auto &ge : this->reducedExtensions)
   {
-    _parentLink->visual_array.push_back(_visual);
+    ReduceSDFExtensionsTransform(ge);
   }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// reduce fixed joints by lumping inertial, visual and
-// collision elements of the child link into the parent link
-void ReduceFixedJoints(tinyxml2::XMLElement *_root, urdf::LinkSharedPtr _link)
+void URDF2SDFPrivate::LumpFixedJoints(urdf::LinkSharedPtr _link)
 {
+  // reduce this _link's stuff up the tree to parent but skip first joint
+  //   if it's the world
+  const bool reduce = _link->getParent() &&
+      _link->getParent()->name != "world" && _link->parent_joint &&
+      this->FixedJointShouldBeReduced(_link->parent_joint);
+
+  if (reduce)
+  {
+    // the parent is visited first, so it already knows its own target
+    LumpedLink lump;
+    ignition::math::Pose3d jointPose =
+      CopyPose(_link->parent_joint->parent_to_joint_origin_transform);
+    auto parentLump = this->lumpedLinks.find(_link->getParent()->name);
+    if (parentLump != this->lumpedLinks.end())
+    {
+      lump.target = parentLump->second.target;
+      lump.pose = TransformToParentFrame(jointPose, parentLump->second.pose);
+    }
+    else
+    {
+      lump.target = _link->getParent();
+      lump.pose = jointPose;
+    }
+    this->lumpedLinks[_link->name] = lump;
+
+    sdfdbg << "Fixed Joint Reduction: lumping [" << _link->name
+           << "] into [" << lump.target->name << "]\n";
+
+    // visuals and collisions are moved once, straight to the target, in
+    // depth-first order so they keep the order of the recursive lumping
+    ReduceVisualsToParent(_link, lump);
+    ReduceCollisionsToParent(_link, lump);
+  }
+
   // if child is attached to self by fixed _link first go up the tree,
   //   check it's children recursively
   for (unsigned int i = 0 ; i < _link->child_links.size() ; ++i)
   {
-    if (FixedJointShouldBeReduced(_link->child_links[i]->parent_joint))
+    if (this->FixedJointShouldBeReduced(_link->child_links[i]->parent_joint))
     {
-      ReduceFixedJoints(_root, _link->child_links[i]);
+      this->LumpFixedJoints(_link->child_links[i]);
     }
   }
 
-  // reduce this _link's stuff up the tree to parent but skip first joint
-  //   if it's the world
-  if (_link->getParent() && _link->getParent()->name != "world" &&
-      _link->parent_joint && FixedJointShouldBeReduced(_link->parent_joint) )
+  if (reduce)
   {
     sdfdbg << "Fixed Joint Reduction: extension lumping from ["
            << _link->name << "] to [" << _link->getParent()->name << "]\n";
 
     // lump sdf extensions to parent, (give them new reference _link names)
-    ReduceSDFExtensionToParent(_link);
+    this->ReduceSDFExtensionToParent(_link);
 
-    // reduce _link elements to parent
+    // the inertia of the children is already accumulated in _link
     ReduceInertialToParent(_link);
-    ReduceVisualsToParent(_link);
-    ReduceCollisionsToParent(_link);
-    ReduceJointsToParent(_link);
+    this->ReduceJointsToParent(_link);
   }
 
   // continue down the tree for non-fixed joints
   for (unsigned int i = 0 ; i < _link->child_links.size() ; ++i)
   {
-    if (!FixedJointShouldBeReduced(_link->child_links[i]->parent_joint))
+    if (!this->FixedJointShouldBeReduced(_link->child_links[i]->parent_joint))
     {
-      ReduceFixedJoints(_root, _link->child_links[i]);
+      this->LumpFixedJoints(_link->child_links[i]);
     }
   }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+void URDF2SDFPrivate::IndexSDFExtensionBlob(SDFExtensionPtr _ge,
+                                            std::size_t _blobIndex)
+{
+  for (const auto &name : SDFExtensionBlobLinkNames(_ge->blobs[_blobIndex]))
+  {
+    this->linkReferences[name].emplace_back(_ge, _blobIndex);
+  }
+}
+
 // ODE dMatrix
 typedef double dMatrix3[4*3];
 typedef double dVector3[4];
@@ -913,12 +1026,14 @@ void ReduceInertialToParent(urdf::LinkSharedPtr _link)
 }
 
 /////////////////////////////////////////////////
-/// \brief reduce fixed joints:  lump visuals to parent link
+/// \brief reduce fixed joints:  lump visuals to the target link
 /// \param[in] _link take all visuals from _link and lump/move them
-///            to the parent link (_link->getParentLink()).
-void ReduceVisualsToParent(urdf::LinkSharedPtr _link)
+///            to the nearest ancestor that is not reduced.
+/// \param[in] _lump target link and pose of _link in the target frame.
+void ReduceVisualsToParent(urdf::LinkSharedPtr _link,
+                           const LumpedLink &_lump)
 {
-  // lump all visuals of _link to _link->getParent().
+  // lump all visuals of _link to _lump.target.
   // modify visual name (urdf 0.3.x) or
   //        visual group name (urdf 0.2.x)
   // to indicate that it was lumped (fixed joint reduced)
@@ -941,7 +1056,7 @@ void ReduceVisualsToParent(urdf::LinkSharedPtr _link)
       newVisualName = (*visualIt)->name;
       sdfdbg << "re-lumping visual [" << (*visualIt)->name
              << "] for link [" << _link->name
-             << "] to parent [" << _link->getParent()->name
+             << "] to [" << _lump.target->name
              << "] with name [" << newVisualName << "]\n";
     }
     else
@@ -956,29 +1071,30 @@ void ReduceVisualsToParent(urdf::LinkSharedPtr _link)
       }
       sdfdbg << "lumping visual [" << (*visualIt)->name
              << "] for link [" << _link->name
-             << "] to parent [" << _link->getParent()->name
+             << "] to [" << _lump.target->name
              << "] with name [" << newVisualName << "]\n";
     }
 
     // transform visual origin from _link frame to
-    // parent link frame before adding to parent
-    (*visualIt)->origin = TransformToParentFrame(
-        (*visualIt)->origin,
-        _link->parent_joint->parent_to_joint_origin_transform);
+    // target link frame before adding to the target
+    (*visualIt)->origin = CopyPose(TransformToParentFrame(
+        CopyPose((*visualIt)->origin), _lump.pose));
 
-    // add the modified visual to parent
-    ReduceVisualToParent(_link->getParent(), newVisualName,
-                         *visualIt);
+    // add the modified visual to the target
+    (*visualIt)->name = newVisualName;
+    _lump.target->visual_array.push_back(*visualIt);
   }
 }
 
 /////////////////////////////////////////////////
-/// \brief reduce fixed joints:  lump collisions to parent link
+/// \brief reduce fixed joints:  lump collisions to the target link
 /// \param[in] _link take all collisions from _link and lump/move them
-///            to the parent link (_link->getParentLink()).
-void ReduceCollisionsToParent(urdf::LinkSharedPtr _link)
+///            to the nearest ancestor that is not reduced.
+/// \param[in] _lump target link and pose of _link in the target frame.
+void ReduceCollisionsToParent(urdf::LinkSharedPtr _link,
+                              const LumpedLink &_lump)
 {
-  // lump all collisions of _link to _link->getParent().
+  // lump all collisions of _link to _lump.target.
   // modify collision name (urdf 0.3.x) or
   //        collision group name (urdf 0.2.x)
   // to indicate that it was lumped (fixed joint reduced)
@@ -1000,7 +1116,7 @@ void ReduceCollisionsToParent(urdf::LinkSharedPtr _link)
       newCollisionName = (*collisionIt)->name;
       sdfdbg << "re-lumping collision [" << (*collisionIt)->name
              << "] for link [" << _link->name
-             << "] to parent [" << _link->getParent()->name
+             << "] to [" << _lump.target->name
              << "] with name [" << newCollisionName << "]\n";
     }
     else
@@ -1015,52 +1131,42 @@ void ReduceCollisionsToParent(urdf::LinkSharedPtr _link)
       }
       sdfdbg << "lumping collision [" << (*collisionIt)->name
              << "] for link [" << _link->name
-             << "] to parent [" << _link->getParent()->name
+             << "] to [" << _lump.target->name
              << "] with name [" << newCollisionName << "]\n";
     }
     // transform collision origin from _link frame to
-    // parent link frame before adding to parent
-    (*collisionIt)->origin = TransformToParentFrame(
-        (*collisionIt)->origin,
-        _link->parent_joint->parent_to_joint_origin_transform);
+    // target link frame before adding to the target
+    (*collisionIt)->origin = CopyPose(TransformToParentFrame(
+        CopyPose((*collisionIt)->origin), _lump.pose));
 
-    // add the modified collision to parent
-    ReduceCollisionToParent(_link->getParent(), newCollisionName,
-                            *collisionIt);
+    // add the modified collision to the target
+    (*collisionIt)->name = newCollisionName;
+    _lump.target->collision_array.push_back(*collisionIt);
   }
 }
 
 /////////////////////////////////////////////////
 /// reduce fixed joints:  lump joints to parent link
-void ReduceJointsToParent(urdf::LinkSharedPtr _link)
+void URDF2SDFPrivate::ReduceJointsToParent(urdf::LinkSharedPtr _link)
 {
   // set child link's parentJoint's parent link to
-  // a parent link up stream that does not have a fixed parentJoint
+  // the link up stream that _link is lumped into
+  const LumpedLink &lump = this->lumpedLinks.at(_link->name);
   for (unsigned int i = 0 ; i < _link->child_links.size() ; ++i)
   {
     urdf::JointSharedPtr parentJoint = _link->child_links[i]->parent_joint;
-    if (!FixedJointShouldBeReduced(parentJoint))
-    {
-      // go down the tree until we hit a parent joint that is not fixed
-      urdf::LinkSharedPtr newParentLink = _link;
-      ignition::math::Pose3d jointAnchorTransform;
-      while (newParentLink->parent_joint &&
-             newParentLink->getParent()->name != "world" &&
-             FixedJointShouldBeReduced(newParentLink->parent_joint) )
-      {
-        jointAnchorTransform = jointAnchorTransform * jointAnchorTransform;
-        parentJoint->parent_to_joint_origin_transform =
-          TransformToParentFrame(
-              parentJoint->parent_to_joint_origin_transform,
-              newParentLink->parent_joint->parent_to_joint_origin_transform);
-        newParentLink = newParentLink->getParent();
-      }
+    if (!this->FixedJointShouldBeReduced(parentJoint))
+    {
+      // express the joint origin in the frame of the new parent link
+      parentJoint->parent_to_joint_origin_transform =
+        CopyPose(TransformToParentFrame(
+              CopyPose(parentJoint->parent_to_joint_origin_transform),
+              lump.pose));
+
       // now set the _link->child_links[i]->parent_joint's parent link to
-      // the newParentLink
-      _link->child_links[i]->setParent(newParentLink);
-      parentJoint->parent_link_name = newParentLink->name;
-      // and set the _link->child_links[i]->parent_joint's
-      // parent_to_joint_origin_transform as the aggregated anchor transform?
+      // the lump target
+      _link->child_links[i]->setParent(lump.target);
+      parentJoint->parent_link_name = lump.target->name;
     }
   }
 }
@@ -1079,17 +1185,8 @@ std::string lowerStr(const std::string &_str)
 
 ////////////////////////////////////////////////////////////////////////////////
 URDF2SDF::URDF2SDF()
+  : dataPtr(std::make_unique<URDF2SDFPrivate>())
 {
-  // default options
-  g_enforceLimits = true;
-  g_reduceFixedJoints = true;
-  g_extensions.clear();
-  g_collisionExt = "_collision";
-  g_visualExt = "_visual";
-  g_lumpPrefix = "_fixed_joint_lump__";
-  g_initialRobotPoseValid = false;
-  g_fixedJointsTransformedInRevoluteJoints.clear();
-  g_fixedJointsTransformedInFixedJoints.clear();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1200,7 +1297,7 @@ std::string GetKeyValueAsString(tinyxml2::XMLElement* _elem)
 }
 
 /////////////////////////////////////////////////
-void ParseRobotOrigin(tinyxml2::XMLDocument &_urdfXml)
+void URDF2SDFPrivate::ParseRobotOrigin(tinyxml2::XMLDocument &_urdfXml)
 {
   tinyxml2::XMLElement *robotXml = _urdfXml.FirstChildElement("robot");
   tinyxml2::XMLElement *originXml = robotXml->FirstChildElement("origin");
@@ -1209,11 +1306,11 @@ void ParseRobotOrigin(tinyxml2::XMLDocument &_urdfXml)
     const char *xyzstr = originXml->Attribute("xyz");
     if (xyzstr == nullptr)
     {
-      g_initialRobotPose.position = urdf::Vector3(0, 0, 0);
+      this->initialRobotPose.position = urdf::Vector3(0, 0, 0);
     }
     else
     {
-      g_initialRobotPose.position = ParseVector3(std::string(xyzstr));
+      this->initialRobotPose.position = ParseVector3(std::string(xyzstr));
     }
     const char *rpystr = originXml->Attribute("rpy");
     urdf::Vector3 rpy;
@@ -1225,22 +1322,22 @@ void ParseRobotOrigin(tinyxml2::XMLDocument &_urdfXml)
     {
       rpy = ParseVector3(std::string(rpystr));
     }
-    g_initialRobotPose.rotation.setFromRPY(rpy.x, rpy.y, rpy.z);
-    g_initialRobotPoseValid = true;
+    this->initialRobotPose.rotation.setFromRPY(rpy.x, rpy.y, rpy.z);
+    this->initialRobotPoseValid = true;
   }
 }
 
 /////////////////////////////////////////////////
-void InsertRobotOrigin(tinyxml2::XMLElement *_elem)
+void URDF2SDFPrivate::InsertRobotOrigin(tinyxml2::XMLElement *_elem)
 {
-  if (g_initialRobotPoseValid)
+  if (this->initialRobotPoseValid)
   {
     // set transform
     double pose[6];
-    pose[0] = g_initialRobotPose.position.x;
-    pose[1] = g_initialRobotPose.position.y;
-    pose[2] = g_initialRobotPose.position.z;
-    g_initialRobotPose.rotation.getRPY(pose[3], pose[4], pose[5]);
+    pose[0] = this->initialRobotPose.position.x;
+    pose[1] = this->initialRobotPose.position.y;
+    pose[2] = this->initialRobotPose.position.z;
+    this->initialRobotPose.rotation.getRPY(pose[3], pose[4], pose[5]);
     AddKeyValue(_elem, "pose", Values2str(6, pose));
   }
 }
@@ -1251,7 +1348,7 @@ void URDF2SDF::ParseSDFExtension(tinyxml2::XMLDocument &_urdfXml)
   tinyxml2::XMLElement* robotXml = _urdfXml.FirstChildElement("robot");
 
   // Get all SDF extension elements, put everything in
-  //   g_extensions map, containing a key string
+  //   extensions map, containing a key string
   //   (link/joint name) and values
   for (tinyxml2::XMLElement* sdfXml = robotXml->FirstChildElement("gazebo");
        sdfXml; sdfXml = sdfXml->NextSiblingElement("gazebo"))
@@ -1269,11 +1366,12 @@ void URDF2SDF::ParseSDFExtension(tinyxml2::XMLDocument &_urdfXml)
       refStr = std::string(ref);
     }
 
-    if (g_extensions.find(refStr) == g_extensions.end())
+    if (this->dataPtr->extensions.find(refStr) ==
+        this->dataPtr->extensions.end())
     {
       // create extension map for reference
       std::vector<SDFExtensionPtr> ge;
-      g_extensions.insert(std::make_pair(refStr, ge));
+      this->dataPtr->extensions.insert(std::make_pair(refStr, ge));
     }
 
     // create and insert a new SDFExtension into the map
@@ -1372,27 +1470,28 @@ void URDF2SDF::ParseSDFExtension(tinyxml2::XMLDocument &_urdfXml)
       else if (strcmp(childElem->Name(), "dampingFactor") == 0)
       {
         sdf->isDampingFactor = true;
-        sdf->dampingFactor = std::stod(GetKeyValueAsString(childElem));
+        sdf->dampingFactor =
+            sdf::stringToDouble(GetKeyValueAsString(childElem));
       }
       else if (strcmp(childElem->Name(), "maxVel") == 0)
       {
         sdf->isMaxVel = true;
-        sdf->maxVel = std::stod(GetKeyValueAsString(childElem));
+        sdf->maxVel = sdf::stringToDouble(GetKeyValueAsString(childElem));
       }
       else if (strcmp(childElem->Name(), "minDepth") == 0)
       {
         sdf->isMinDepth = true;
-        sdf->minDepth = std::stod(GetKeyValueAsString(childElem));
+        sdf->minDepth = sdf::stringToDouble(GetKeyValueAsString(childElem));
       }
       else if (strcmp(childElem->Name(), "mu1") == 0)
       {
         sdf->isMu1 = true;
-        sdf->mu1 = std::stod(GetKeyValueAsString(childElem));
+        sdf->mu1 = sdf::stringToDouble(GetKeyValueAsString(childElem));
       }
       else if (strcmp(childElem->Name(), "mu2") == 0)
       {
         sdf->isMu2 = true;
-        sdf->mu2 = std::stod(GetKeyValueAsString(childElem));
+        sdf->mu2 = sdf::stringToDouble(GetKeyValueAsString(childElem));
       }
       else if (strcmp(childElem->Name(), "fdir1") == 0)
       {
@@ -1401,12 +1500,12 @@ void URDF2SDF::ParseSDFExtension(tinyxml2::XMLDocument &_urdfXml)
       else if (strcmp(childElem->Name(), "kp") == 0)
       {
         sdf->isKp = true;
-        sdf->kp = std::stod(GetKeyValueAsString(childElem));
+        sdf->kp = sdf::stringToDouble(GetKeyValueAsString(childElem));
       }
       else if (strcmp(childElem->Name(), "kd") == 0)
       {
         sdf->isKd = true;
-        sdf->kd = std::stod(GetKeyValueAsString(childElem));
+        sdf->kd = sdf::stringToDouble(GetKeyValueAsString(childElem));
       }
       else if (strcmp(childElem->Name(), "selfCollide") == 0)
       {
@@ -1432,32 +1531,34 @@ void URDF2SDF::ParseSDFExtension(tinyxml2::XMLDocument &_urdfXml)
       else if (strcmp(childElem->Name(), "laserRetro") == 0)
       {
         sdf->isLaserRetro = true;
-        sdf->laserRetro = std::stod(GetKeyValueAsString(childElem));
+        sdf->laserRetro = sdf::stringToDouble(GetKeyValueAsString(childElem));
       }
       else if (strcmp(childElem->Name(), "springReference") == 0)
       {
         sdf->isSpringReference = true;
-        sdf->springReference = std::stod(GetKeyValueAsString(childElem));
+        sdf->springReference =
+            sdf::stringToDouble(GetKeyValueAsString(childElem));
       }
       else if (strcmp(childElem->Name(), "springStiffness") == 0)
       {
         sdf->isSpringStiffness = true;
-        sdf->springStiffness = std::stod(GetKeyValueAsString(childElem));
+        sdf->springStiffness =
+            sdf::stringToDouble(GetKeyValueAsString(childElem));
       }
       else if (strcmp(childElem->Name(), "stopCfm") == 0)
       {
         sdf->isStopCfm = true;
-        sdf->stopCfm = std::stod(GetKeyValueAsString(childElem));
+        sdf->stopCfm = sdf::stringToDouble(GetKeyValueAsString(childElem));
       }
       else if (strcmp(childElem->Name(), "stopErp") == 0)
       {
         sdf->isStopErp = true;
-        sdf->stopErp = std::stod(GetKeyValueAsString(childElem));
+        sdf->stopErp = sdf::stringToDouble(GetKeyValueAsString(childElem));
       }
       else if (strcmp(childElem->Name(), "fudgeFactor") == 0)
       {
         sdf->isFudgeFactor = true;
-        sdf->fudgeFactor = std::stod(GetKeyValueAsString(childElem));
+        sdf->fudgeFactor = sdf::stringToDouble(GetKeyValueAsString(childElem));
       }
       else if (strcmp(childElem->Name(), "provideFeedback") == 0)
       {
@@ -1508,7 +1609,7 @@ void URDF2SDF::ParseSDFExtension(tinyxml2::XMLDocument &_urdfXml)
         if (lowerStr(valueStr) == "true" || lowerStr(valueStr) == "yes" ||
             valueStr == "1")
         {
-          g_fixedJointsTransformedInRevoluteJoints.insert(refStr);
+          this->dataPtr->fixedJointsTransformedInRevoluteJoints.insert(refStr);
         }
       }
       else if (strcmp(childElem->Name(), "preserveFixedJoint") == 0)
@@ -1518,7 +1619,7 @@ void URDF2SDF::ParseSDFExtension(tinyxml2::XMLDocument &_urdfXml)
         if (lowerStr(valueStr) == "true" || lowerStr(valueStr) == "yes" ||
             valueStr == "1")
         {
-          g_fixedJointsTransformedInFixedJoints.insert(refStr);
+          this->dataPtr->fixedJointsTransformedInFixedJoints.insert(refStr);
         }
       }
       else
@@ -1538,20 +1639,21 @@ void URDF2SDF::ParseSDFExtension(tinyxml2::XMLDocument &_urdfXml)
     }
 
     // insert into my map
-    (g_extensions.find(refStr))->second.push_back(sdf);
+    (this->dataPtr->extensions.find(refStr))->second.push_back(sdf);
   }
 
   // Handle fixed joints for which both disableFixedJointLumping
   // and preserveFixedJoint options are present
   for (auto& fixedJointConvertedToFixed:
-             g_fixedJointsTransformedInFixedJoints)
+             this->dataPtr->fixedJointsTransformedInFixedJoints)
   {
     // If both options are present, the model creator is aware of the
     // existence of the preserveFixedJoint option and the
     // disableFixedJointLumping option is there only for backward compatibility
     // For this reason, if both options are present then the preserveFixedJoint
     // option has the precedence
-    g_fixedJointsTransformedInRevoluteJoints.erase(fixedJointConvertedToFixed);
+    this->dataPtr->fixedJointsTransformedInRevoluteJoints.erase(
+        fixedJointConvertedToFixed);
   }
 }
 
@@ -1575,8 +1677,8 @@ void CopyBlob(tinyxml2::XMLElement *_src, tinyxml2::XMLElement *_blob_parent)
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void InsertSDFExtensionCollision(tinyxml2::XMLElement *_elem,
-                                 const std::string &_linkName)
+void URDF2SDFPrivate::InsertSDFExtensionCollision(tinyxml2::XMLElement *_elem,
+                                                  const std::string &_linkName)
 {
   // loop through extensions for the whole model
   // and see which ones belong to _linkName
@@ -1584,13 +1686,13 @@ void InsertSDFExtensionCollision(tinyxml2::XMLElement *_elem,
   //   - urdf collision name -> sdf collision name conversion
   //   - fixed joint reduction / lumping
   for (StringSDFExtensionPtrMap::iterator
-      sdfIt = g_extensions.begin();
-      sdfIt != g_extensions.end(); ++sdfIt)
+      sdfIt = this->extensions.begin();
+      sdfIt != this->extensions.end(); ++sdfIt)
   {
     if (sdfIt->first == _linkName)
     {
       // std::cerr << "============================\n";
-      // std::cerr << "working on g_extensions for link ["
+      // std::cerr << "working on extensions for link ["
       //           << sdfIt->first << "]\n";
       // if _elem already has a surface element, use it
       tinyxml2::XMLNode *surface = _elem->FirstChildElement("surface");
@@ -1885,8 +1987,8 @@ void InsertSDFExtensionCollision(tinyxml2::XMLElement *_elem,
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void InsertSDFExtensionVisual(tinyxml2::XMLElement *_elem,
-                              const std::string &_linkName)
+void URDF2SDFPrivate::InsertSDFExtensionVisual(tinyxml2::XMLElement *_elem,
+                                               const std::string &_linkName)
 {
   // loop through extensions for the whole model
   // and see which ones belong to _linkName
@@ -1894,13 +1996,13 @@ void InsertSDFExtensionVisual(tinyxml2::XMLElement *_elem,
   //   - urdf visual name -> sdf visual name conversion
   //   - fixed joint reduction / lumping
   for (StringSDFExtensionPtrMap::iterator
-      sdfIt = g_extensions.begin();
-      sdfIt != g_extensions.end(); ++sdfIt)
+      sdfIt = this->extensions.begin();
+      sdfIt != this->extensions.end(); ++sdfIt)
   {
     if (sdfIt->first == _linkName)
     {
       // std::cerr << "============================\n";
-      // std::cerr << "working on g_extensions for link ["
+      // std::cerr << "working on extensions for link ["
       //           << sdfIt->first << "]\n";
       // if _elem already has a material element, use it
       tinyxml2::XMLElement *material = _elem->FirstChildElement("material");
@@ -2079,12 +2181,12 @@ void InsertSDFExtensionVisual(tinyxml2::XMLElement *_elem,
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void InsertSDFExtensionLink(tinyxml2::XMLElement *_elem,
-                            const std::string &_linkName)
+void URDF2SDFPrivate::InsertSDFExtensionLink(tinyxml2::XMLElement *_elem,
+                                             const std::string &_linkName)
 {
   for (StringSDFExtensionPtrMap::iterator
-       sdfIt = g_extensions.begin();
-       sdfIt != g_extensions.end(); ++sdfIt)
+       sdfIt = this->extensions.begin();
+       sdfIt != this->extensions.end(); ++sdfIt)
   {
     if (sdfIt->first == _linkName)
     {
@@ -2133,13 +2235,13 @@ void InsertSDFExtensionLink(tinyxml2::XMLElement *_elem,
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void InsertSDFExtensionJoint(tinyxml2::XMLElement *_elem,
-                             const std::string &_jointName)
+void URDF2SDFPrivate::InsertSDFExtensionJoint(tinyxml2::XMLElement *_elem,
+                                              const std::string &_jointName)
 {
   auto* doc = _elem->GetDocument();
   for (StringSDFExtensionPtrMap::iterator
-      sdfIt = g_extensions.begin();
-      sdfIt != g_extensions.end(); ++sdfIt)
+      sdfIt = this->extensions.begin();
+      sdfIt != this->extensions.end(); ++sdfIt)
   {
     if (sdfIt->first == _jointName)
     {
@@ -2280,11 +2382,11 @@ void InsertSDFExtensionJoint(tinyxml2::XMLElement *_elem,
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void InsertSDFExtensionRobot(tinyxml2::XMLElement *_elem)
+void URDF2SDFPrivate::InsertSDFExtensionRobot(tinyxml2::XMLElement *_elem)
 {
   for (StringSDFExtensionPtrMap::iterator
-      sdfIt = g_extensions.begin();
-      sdfIt != g_extensions.end(); ++sdfIt)
+      sdfIt = this->extensions.begin();
+      sdfIt != this->extensions.end(); ++sdfIt)
   {
     if (sdfIt->first.empty())
     {
@@ -2486,7 +2588,7 @@ ignition::math::Pose3d inverseTransformToParentFrame(
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void ReduceSDFExtensionToParent(urdf::LinkSharedPtr _link)
+void URDF2SDFPrivate::ReduceSDFExtensionToParent(urdf::LinkSharedPtr _link)
 {
   /// \todo: move to header
   /// Take the link's existing list of gazebo extensions, transfer them
@@ -2502,8 +2604,8 @@ void ReduceSDFExtensionToParent(urdf::LinkSharedPtr _link)
 
   // update extension map with references to linkName
   // this->ListSDFExtensions();
-  StringSDFExtensionPtrMap::iterator ext = g_extensions.find(linkName);
-  if (ext != g_extensions.end())
+  StringSDFExtensionPtrMap::iterator ext = this->extensions.find(linkName);
+  if (ext != this->extensions.end())
   {
     sdfdbg << "  REDUCE EXTENSION: moving reference from ["
            << linkName << "] to [" << _link->getParent()->name << "]\n";
@@ -2516,21 +2618,22 @@ void ReduceSDFExtensionToParent(urdf::LinkSharedPtr _link)
       (*ge)->reductionTransform = TransformToParentFrame(
           (*ge)->reductionTransform,
           _link->parent_joint->parent_to_joint_origin_transform);
-      // for sensor and projector blocks only
-      ReduceSDFExtensionsTransform((*ge));
+      // the sensor and projector poses are written once the lumping is
+      // done, see ReduceFixedJoints
+      this->reducedExtensions.insert(*ge);
     }
 
     // find pointer to the existing extension with the new _link reference
     std::string parentLinkName = _link->getParent()->name;
     StringSDFExtensionPtrMap::iterator parentExt =
-      g_extensions.find(parentLinkName);
+      this->extensions.find(parentLinkName);
 
     // if none exist, create new extension with parentLinkName
-    if (parentExt == g_extensions.end())
+    if (parentExt == this->extensions.end())
     {
       std::vector<SDFExtensionPtr> ge;
-      g_extensions.insert(std::make_pair(parentLinkName, ge));
-      parentExt = g_extensions.find(parentLinkName);
+      this->extensions.insert(std::make_pair(parentLinkName, ge));
+      parentExt = this->extensions.find(parentLinkName);
     }
 
     // move sdf extensions from _link into the parent _link's extensions
@@ -2542,17 +2645,28 @@ void ReduceSDFExtensionToParent(urdf::LinkSharedPtr _link)
     ext->second.clear();
   }
 
-  // for extensions with empty reference, search and replace
-  // _link name patterns within the plugin with new _link name
-  // and assign the proper reduction transform for the _link name pattern
-  for (StringSDFExtensionPtrMap::iterator sdfIt = g_extensions.begin();
-       sdfIt != g_extensions.end(); ++sdfIt)
+  // search and replace _link name patterns within the blobs that refer to
+  // _link with the new _link name and assign the proper reduction transform
+  // for the _link name pattern. The renamed blobs are indexed again under
+  // the names they now refer to, so they are found when the parent link is
+  // lumped in turn.
+  auto refs = this->linkReferences.find(linkName);
+  if (refs != this->linkReferences.end())
   {
-    // update reduction transform (for contacts, rays, cameras for now).
-    for (std::vector<SDFExtensionPtr>::iterator ge = sdfIt->second.begin();
-         ge != sdfIt->second.end(); ++ge)
+    std::vector<SDFExtensionBlobRef> blobRefs = std::move(refs->second);
+    this->linkReferences.erase(refs);
+
+    std::set<tinyxml2::XMLDocument *> visited;
+    for (const auto &ref : blobRefs)
     {
-      ReduceSDFExtensionFrameReplace(*ge, _link);
+      auto blobIt = ref.first->blobs.begin() + ref.second;
+      if (!visited.insert(blobIt->get()).second)
+        continue;
+
+      // update reduction transform (for contacts, rays, cameras for now).
+      ReduceSDFExtensionFrameReplace(blobIt, ref.first->reductionTransform,
+                                     _link);
+      this->IndexSDFExtensionBlob(ref.first, ref.second);
     }
   }
 
@@ -2560,8 +2674,10 @@ void ReduceSDFExtensionToParent(urdf::LinkSharedPtr _link)
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void ReduceSDFExtensionFrameReplace(SDFExtensionPtr _ge,
-                                    urdf::LinkSharedPtr _link)
+void ReduceSDFExtensionFrameReplace(
+    std::vector<XMLDocumentPtr>::iterator _blobIt,
+    const ignition::math::Pose3d &_reductionTransform,
+    urdf::LinkSharedPtr _link)
 {
   std::string linkName = _link->name;
   std::string parentLinkName = _link->getParent()->name;
@@ -2574,26 +2690,95 @@ void ReduceSDFExtensionFrameReplace(SDFExtensionPtr _ge,
   //         <collision>base_footprint_collision</collision>
   sdfdbg << "  STRING REPLACE: instances of _link name ["
         << linkName << "] with [" << parentLinkName << "]\n";
-  for (auto blobIt = _ge->blobs.begin();
-         blobIt != _ge->blobs.end(); ++blobIt)
+
+  tinyxml2::XMLPrinter debugStreamIn;
+  (*_blobIt)->Print(&debugStreamIn);
+  sdfdbg << "        INITIAL STRING link ["
+         << linkName << "]-->[" << parentLinkName << "]: ["
+         << debugStreamIn.CStr() << "]\n";
+
+  ReduceSDFExtensionContactSensorFrameReplace(_blobIt, _link);
+  ReduceSDFExtensionPluginFrameReplace(_blobIt, _link,
+                                       "plugin", "bodyName",
+                                       _reductionTransform);
+  ReduceSDFExtensionPluginFrameReplace(_blobIt, _link,
+                                       "plugin", "frameName",
+                                       _reductionTransform);
+  ReduceSDFExtensionProjectorFrameReplace(_blobIt, _link);
+  ReduceSDFExtensionGripperFrameReplace(_blobIt, _link);
+  ReduceSDFExtensionJointFrameReplace(_blobIt, _link);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::vector<std::string> SDFExtensionBlobLinkNames(const XMLDocumentPtr &_blob)
+{
+  std::vector<std::string> names;
+  tinyxml2::XMLElement *blobElem = _blob->FirstChildElement();
+  if (!blobElem)
   {
-    tinyxml2::XMLPrinter debugStreamIn;
-    (*blobIt)->Print(&debugStreamIn);
-    sdfdbg << "        INITIAL STRING link ["
-           << linkName << "]-->[" << parentLinkName << "]: ["
-           << debugStreamIn.CStr() << "]\n";
+    return names;
+  }
 
-    ReduceSDFExtensionContactSensorFrameReplace(blobIt, _link);
-    ReduceSDFExtensionPluginFrameReplace(blobIt, _link,
-                                         "plugin", "bodyName",
-                                         _ge->reductionTransform);
-    ReduceSDFExtensionPluginFrameReplace(blobIt, _link,
-                                         "plugin", "frameName",
-                                         _ge->reductionTransform);
-    ReduceSDFExtensionProjectorFrameReplace(blobIt, _link);
-    ReduceSDFExtensionGripperFrameReplace(blobIt, _link);
-    ReduceSDFExtensionJointFrameReplace(blobIt, _link);
+  auto addKeyValue = [&names](tinyxml2::XMLElement *_elem)
+  {
+    if (_elem)
+    {
+      names.push_back(GetKeyValueAsString(_elem));
+    }
+  };
+
+  // contact collision names are the link name plus g_collisionExt
+  // (see ReduceSDFExtensionContactSensorFrameReplace)
+  if (strcmp(blobElem->Name(), "sensor") == 0)
+  {
+    tinyxml2::XMLElement *contact = _blob->FirstChildElement("contact");
+    if (contact && contact->FirstChildElement("collision"))
+    {
+      std::string collision =
+        GetKeyValueAsString(contact->FirstChildElement("collision"));
+      if (collision.size() > g_collisionExt.size() &&
+          collision.compare(collision.size() - g_collisionExt.size(),
+            g_collisionExt.size(), g_collisionExt) == 0)
+      {
+        names.push_back(
+            collision.substr(0, collision.size() - g_collisionExt.size()));
+      }
+    }
+  }
+  else if (strcmp(blobElem->Name(), "plugin") == 0)
+  {
+    addKeyValue(_blob->FirstChildElement("bodyName"));
+    addKeyValue(_blob->FirstChildElement("frameName"));
+  }
+  else if (strcmp(blobElem->Name(), "gripper") == 0)
+  {
+    addKeyValue(_blob->FirstChildElement("gripper_link"));
+    addKeyValue(_blob->FirstChildElement("palm_link"));
+  }
+  else if (strcmp(blobElem->Name(), "joint") == 0)
+  {
+    addKeyValue(_blob->FirstChildElement("parent"));
+    addKeyValue(_blob->FirstChildElement("child"));
+  }
+
+  // projector references are linkName/projectorName
+  tinyxml2::XMLElement *projector = _blob->FirstChildElement("projector");
+  if (projector)
+  {
+    std::string projectorName = GetKeyValueAsString(projector);
+    size_t pos = projectorName.find("/");
+    if (pos == std::string::npos)
+    {
+      sdferr << "no slash in projector reference tag [" << projectorName
+             << "], expecting linkName/projector_name.\n";
+    }
+    else
+    {
+      names.push_back(projectorName.substr(0, pos));
+    }
   }
+
+  return names;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -2614,8 +2799,8 @@ void ReduceSDFExtensionsTransform(SDFExtensionPtr _ge)
 void URDF2SDF::ListSDFExtensions()
 {
   for (StringSDFExtensionPtrMap::iterator
-      sdfIt = g_extensions.begin();
-      sdfIt != g_extensions.end(); ++sdfIt)
+      sdfIt = this->dataPtr->extensions.begin();
+      sdfIt != this->dataPtr->extensions.end(); ++sdfIt)
   {
     int extCount = 0;
     for (std::vector<SDFExtensionPtr>::iterator ge = sdfIt->second.begin();
@@ -2642,8 +2827,8 @@ void URDF2SDF::ListSDFExtensions()
 void URDF2SDF::ListSDFExtensions(const std::string &_reference)
 {
   for (StringSDFExtensionPtrMap::iterator
-      sdfIt = g_extensions.begin();
-      sdfIt != g_extensions.end(); ++sdfIt)
+      sdfIt = this->dataPtr->extensions.begin();
+      sdfIt != this->dataPtr->extensions.end(); ++sdfIt)
   {
     if (sdfIt->first == _reference)
     {
@@ -2665,9 +2850,9 @@ void URDF2SDF::ListSDFExtensions(const std::string &_reference)
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void CreateSDF(tinyxml2::XMLElement *_root,
-               urdf::LinkConstSharedPtr _link,
-               const ignition::math::Pose3d &_transform)
+void URDF2SDFPrivate::CreateSDF(tinyxml2::XMLElement *_root,
+                                urdf::LinkConstSharedPtr _link,
+                                const ignition::math::Pose3d &_transform)
 {
   ignition::math::Pose3d _currentTransform = _transform;
 
@@ -2708,17 +2893,17 @@ void CreateSDF(tinyxml2::XMLElement *_root,
 
   // create <body:...> block for non fixed joint attached bodies
   if ((_link->getParent() && _link->getParent()->name == "world") ||
-      !g_reduceFixedJoints ||
+      !this->reduceFixedJoints ||
       (!_link->parent_joint ||
-       !FixedJointShouldBeReduced(_link->parent_joint)))
+       !this->FixedJointShouldBeReduced(_link->parent_joint)))
   {
-    CreateLink(_root, _link, _currentTransform);
+    this->CreateLink(_root, _link, _currentTransform);
   }
 
   // recurse into children
   for (unsigned int i = 0 ; i < _link->child_links.size() ; ++i)
   {
-    CreateSDF(_root, _link->child_links[i], _currentTransform);
+    this->CreateSDF(_root, _link->child_links[i], _currentTransform);
   }
 }
 
@@ -2751,9 +2936,9 @@ urdf::Pose CopyPose(ignition::math::Pose3d _pose)
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void CreateLink(tinyxml2::XMLElement *_root,
-                urdf::LinkConstSharedPtr _link,
-                ignition::math::Pose3d &_currentTransform)
+void URDF2SDFPrivate::CreateLink(tinyxml2::XMLElement *_root,
+                                 urdf::LinkConstSharedPtr _link,
+                                 ignition::math::Pose3d &_currentTransform)
 {
   // create new body
   tinyxml2::XMLElement *elem = _root->GetDocument()->NewElement("link");
@@ -2786,24 +2971,24 @@ void CreateLink(tinyxml2::XMLElement *_root,
   CreateInertial(elem, _link);
 
   // create new collision block
-  CreateCollisions(elem, _link);
+  this->CreateCollisions(elem, _link);
 
   // create new visual block
-  CreateVisuals(elem, _link);
+  this->CreateVisuals(elem, _link);
 
   // copy sdf extensions data
-  InsertSDFExtensionLink(elem, _link->name);
+  this->InsertSDFExtensionLink(elem, _link->name);
 
   // make a <joint:...> block
-  CreateJoint(_root, _link, _currentTransform);
+  this->CreateJoint(_root, _link, _currentTransform);
 
   // add body to document
   _root->LinkEndChild(elem);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void CreateCollisions(tinyxml2::XMLElement* _elem,
-                      urdf::LinkConstSharedPtr _link)
+void URDF2SDFPrivate::CreateCollisions(tinyxml2::XMLElement* _elem,
+                                       urdf::LinkConstSharedPtr _link)
 {
   // loop through all collisions in
   //   collision_array (urdf 0.3.x)
@@ -2840,15 +3025,15 @@ void CreateCollisions(tinyxml2::XMLElement* _elem,
     }
 
     // make a <collision> block
-    CreateCollision(_elem, _link, *collision, collisionName);
+    this->CreateCollision(_elem, _link, *collision, collisionName);
 
     ++collisionCount;
   }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void CreateVisuals(tinyxml2::XMLElement* _elem,
-                   urdf::LinkConstSharedPtr _link)
+void URDF2SDFPrivate::CreateVisuals(tinyxml2::XMLElement* _elem,
+                                    urdf::LinkConstSharedPtr _link)
 {
   // loop through all visuals in
   //   visual_array (urdf 0.3.x)
@@ -2885,7 +3070,7 @@ void CreateVisuals(tinyxml2::XMLElement* _elem,
     }
 
     // make a <visual> block
-    CreateVisual(_elem, _link, *visual, visualName);
+    this->CreateVisual(_elem, _link, *visual, visualName);
 
     ++visualCount;
   }
@@ -2931,9 +3116,9 @@ void CreateInertial(tinyxml2::XMLElement *_elem,
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void CreateJoint(tinyxml2::XMLElement *_root,
-                 urdf::LinkConstSharedPtr _link,
-                 ignition::math::Pose3d &/*_currentTransform*/)
+void URDF2SDFPrivate::CreateJoint(tinyxml2::XMLElement *_root,
+                                  urdf::LinkConstSharedPtr _link,
+                                  ignition::math::Pose3d &/*_currentTransform*/)
 {
   // compute the joint tag
   std::string jtype;
@@ -2971,16 +3156,17 @@ void CreateJoint(tinyxml2::XMLElement *_root,
   if (jtype == "fixed")
   {
     fixedJointConvertedToRevoluteJoint =
-      (g_fixedJointsTransformedInRevoluteJoints.find(_link->parent_joint->name)
-       != g_fixedJointsTransformedInRevoluteJoints.end());
+      (this->fixedJointsTransformedInRevoluteJoints.find(
+           _link->parent_joint->name) !=
+       this->fixedJointsTransformedInRevoluteJoints.end());
   }
 
   // skip if joint type is fixed and it is lumped
   //   skip/return with the exception of root link being world,
   //   because there's no lumping there
   if (_link->getParent() && _link->getParent()->name != "world"
-      && FixedJointShouldBeReduced(_link->parent_joint)
-      && g_reduceFixedJoints)
+      && this->FixedJointShouldBeReduced(_link->parent_joint)
+      && this->reduceFixedJoints)
   {
     return;
   }
@@ -3038,7 +3224,7 @@ void CreateJoint(tinyxml2::XMLElement *_root,
                     Values2str(1, &_link->parent_joint->dynamics->friction));
       }
 
-      if (g_enforceLimits && _link->parent_joint->limits)
+      if (this->enforceLimits && _link->parent_joint->limits)
       {
         if (jtype == "slider")
         {
@@ -3096,7 +3282,7 @@ void CreateJoint(tinyxml2::XMLElement *_root,
     }
 
     // copy sdf extensions data
-    InsertSDFExtensionJoint(joint, _link->parent_joint->name);
+    this->InsertSDFExtensionJoint(joint, _link->parent_joint->name);
 
     // add joint to document
     _root->LinkEndChild(joint);
@@ -3104,10 +3290,10 @@ void CreateJoint(tinyxml2::XMLElement *_root,
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void CreateCollision(tinyxml2::XMLElement* _elem,
-                     urdf::LinkConstSharedPtr _link,
-                     urdf::CollisionSharedPtr _collision,
-                     const std::string &_oldLinkName)
+void URDF2SDFPrivate::CreateCollision(tinyxml2::XMLElement* _elem,
+                                      urdf::LinkConstSharedPtr _link,
+                                      urdf::CollisionSharedPtr _collision,
+                                      const std::string &_oldLinkName)
 {
   auto* doc = _elem->GetDocument();
   // begin create geometry node, skip if no collision specified
@@ -3152,15 +3338,16 @@ void CreateCollision(tinyxml2::XMLElement* _elem,
   }
 
   // set additional data from extensions
-  InsertSDFExtensionCollision(sdfCollision, _link->name);
+  this->InsertSDFExtensionCollision(sdfCollision, _link->name);
 
   // add geometry to body
   _elem->LinkEndChild(sdfCollision);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void CreateVisual(tinyxml2::XMLElement *_elem, urdf::LinkConstSharedPtr _link,
-    urdf::VisualSharedPtr _visual, const std::string &_oldLinkName)
+void URDF2SDFPrivate::CreateVisual(tinyxml2::XMLElement *_elem,
+    urdf::LinkConstSharedPtr _link, urdf::VisualSharedPtr _visual,
+    const std::string &_oldLinkName)
 {
   auto* doc = _elem->GetDocument();
   // begin create sdf visual node
@@ -3198,7 +3385,7 @@ void CreateVisual(tinyxml2::XMLElement *_elem, urdf::LinkConstSharedPtr _link,
   }
 
   // set additional data from extensions
-  InsertSDFExtensionVisual(sdfVisual, _link->name);
+  this->InsertSDFExtensionVisual(sdfVisual, _link->name);
 
   // end create _visual node
   _elem->LinkEndChild(sdfVisual);
@@ -3209,15 +3396,80 @@ void URDF2SDF::InitModelString(const std::string &_urdfStr,
                                tinyxml2::XMLDocument* _sdfXmlOut,
                                bool _enforceLimits)
 {
-  g_enforceLimits = _enforceLimits;
+  tinyxml2::XMLDocument urdfXml;
+  if (urdfXml.Parse(_urdfStr.c_str()))
+  {
+    sdferr << "Unable to parse URDF string: " << urdfXml.ErrorStr() << "\n";
+    return;
+  }
 
-  // Create a RobotModel from string
-  urdf::ModelInterfaceSharedPtr robotModel = urdf::parseURDF(_urdfStr);
+  // URDF is compatible with version 1.7. The automatic conversion script
+  // will up-convert URDF to SDF.
+  if (!this->InitModel(urdfXml, _urdfStr, _sdfXmlOut, _enforceLimits, "1.7"))
+  {
+    sdferr << "Unable to call parseURDF on robot model\n";
+  }
+}
 
-  if (!robotModel)
+////////////////////////////////////////////////////////////////////////////////
+void URDF2SDF::InitModelDoc(const tinyxml2::XMLDocument *_xmlDoc,
+                            tinyxml2::XMLDocument *_sdfXmlDoc)
+{
+  tinyxml2::XMLDocument urdfXml;
+  _xmlDoc->DeepCopy(&urdfXml);
+  if (!this->InitModel(urdfXml, "", _sdfXmlDoc, true, "1.7"))
   {
     sdferr << "Unable to call parseURDF on robot model\n";
-    return;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void URDF2SDF::InitModelFile(const std::string &_filename,
+                             tinyxml2::XMLDocument *_sdfXmlDoc)
+{
+  tinyxml2::XMLDocument xmlDoc;
+  if (!xmlDoc.LoadFile(_filename.c_str()))
+  {
+    if (!this->InitModel(xmlDoc, "", _sdfXmlDoc, true, "1.7"))
+    {
+      sdferr << "Unable to call parseURDF on robot model\n";
+    }
+  }
+  else
+  {
+    sdferr << "Unable to load file["
+      << _filename << "]:" << xmlDoc.ErrorStr() << "\n";
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool URDF2SDF::ConvertDoc(tinyxml2::XMLDocument &_urdfXml,
+                          std::string_view _urdfStr,
+                          tinyxml2::XMLDocument *_sdfXmlDoc)
+{
+  // The converted model doesn't use anything that changed since version
+  // 1.7, so it's written at the current version to skip the conversion.
+  return this->InitModel(_urdfXml, _urdfStr, _sdfXmlDoc, true, SDF_VERSION);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool URDF2SDF::InitModel(tinyxml2::XMLDocument &_urdfXml,
+                         std::string_view _urdfStr,
+                         tinyxml2::XMLDocument *_sdfXmlOut,
+                         bool _enforceLimits,
+                         const std::string &_version)
+{
+  // Start from a fresh state, so that nothing is left over from a previous
+  // conversion with this object.
+  this->dataPtr = std::make_unique<URDF2SDFPrivate>();
+  this->dataPtr->enforceLimits = _enforceLimits;
+
+  // Create a RobotModel from the document
+  urdf::ModelInterfaceSharedPtr robotModel = parseURDF(_urdfXml, _urdfStr);
+
+  if (!robotModel)
+  {
+    return false;
   }
 
   // create root element and define needed namespaces
@@ -3231,19 +3483,10 @@ void URDF2SDF::InitModelString(const std::string &_urdfStr,
   ignition::math::Pose3d transform;
 
   // parse sdf extension
-  tinyxml2::XMLDocument urdfXml;
-  if (urdfXml.Parse(_urdfStr.c_str()))
-  {
-    sdferr << "Unable to parse URDF string: " << urdfXml.ErrorStr() << "\n";
-    return;
-  }
-  g_extensions.clear();
-  g_fixedJointsTransformedInFixedJoints.clear();
-  g_fixedJointsTransformedInRevoluteJoints.clear();
-  this->ParseSDFExtension(urdfXml);
+  this->ParseSDFExtension(_urdfXml);
 
   // Parse robot pose
-  ParseRobotOrigin(urdfXml);
+  this->dataPtr->ParseRobotOrigin(_urdfXml);
 
   urdf::LinkConstSharedPtr rootLink = robotModel->getRoot();
   tinyxml2::XMLElement *sdf;
@@ -3260,9 +3503,10 @@ void URDF2SDF::InitModelString(const std::string &_urdfStr,
     // parent link recursively
     // using the disabledFixedJointLumping or preserveFixedJoint options
     // is possible to disable fixed joint lumping only for selected joints
-    if (g_reduceFixedJoints)
+    if (this->dataPtr->reduceFixedJoints)
     {
-      ReduceFixedJoints(robot, urdf::const_pointer_cast<urdf::Link>(rootLink));
+      this->dataPtr->ReduceFixedJoints(robot,
+          urdf::const_pointer_cast<urdf::Link>(rootLink));
     }
 
     if (rootLink->name == "world")
@@ -3272,28 +3516,26 @@ void URDF2SDF::InitModelString(const std::string &_urdfStr,
           child = rootLink->child_links.begin();
           child != rootLink->child_links.end(); ++child)
       {
-        CreateSDF(robot, (*child), transform);
+        this->dataPtr->CreateSDF(robot, (*child), transform);
       }
     }
     else
     {
       // convert, starting from root link
-      CreateSDF(robot, rootLink, transform);
+      this->dataPtr->CreateSDF(robot, rootLink, transform);
     }
 
     // insert the extensions without reference into <robot> root level
-    InsertSDFExtensionRobot(robot);
+    this->dataPtr->InsertSDFExtensionRobot(robot);
 
-    InsertRobotOrigin(robot);
+    this->dataPtr->InsertRobotOrigin(robot);
 
     // Create new sdf
     sdf = _sdfXmlOut->NewElement("sdf");
 
     try
     {
-      // URDF is compatible with version 1.7. The automatic conversion script
-      // will up-convert URDF to SDF.
-      sdf->SetAttribute("version", "1.7");
+      sdf->SetAttribute("version", _version.c_str());
       // add robot to sdf
       sdf->LinkEndChild(robot);
     }
@@ -3308,45 +3550,20 @@ void URDF2SDF::InitModelString(const std::string &_urdfStr,
   }
 
   _sdfXmlOut->LinkEndChild(sdf);
+  return true;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-void URDF2SDF::InitModelDoc(const tinyxml2::XMLDocument *_xmlDoc,
-                            tinyxml2::XMLDocument *_sdfXmlDoc)
-{
-  tinyxml2::XMLPrinter printer;
-  _xmlDoc->Print(&printer);
-  std::string urdfStr = printer.CStr();
-  InitModelString(urdfStr, _sdfXmlDoc);
-}
-
-////////////////////////////////////////////////////////////////////////////////
-void URDF2SDF::InitModelFile(const std::string &_filename,
-                             tinyxml2::XMLDocument *_sdfXmlDoc)
-{
-  tinyxml2::XMLDocument xmlDoc;
-  if (!xmlDoc.LoadFile(_filename.c_str()))
-  {
-    this->InitModelDoc(&xmlDoc, _sdfXmlDoc);
-  }
-  else
-  {
-    sdferr << "Unable to load file["
-      << _filename << "]:" << xmlDoc.ErrorStr() << "\n";
-  }
-}
-
-////////////////////////////////////////////////////////////////////////////////
-bool FixedJointShouldBeReduced(urdf::JointSharedPtr _jnt)
+bool URDF2SDFPrivate::FixedJointShouldBeReduced(urdf::JointSharedPtr _jnt)
 {
     // A joint should be lumped only if its type is fixed and
     // the disabledFixedJointLumping or preserveFixedJoint
     // joint options are not set
     return (_jnt->type == urdf::Joint::FIXED &&
-              (g_fixedJointsTransformedInRevoluteJoints.find(_jnt->name) ==
-                 g_fixedJointsTransformedInRevoluteJoints.end()) &&
-              (g_fixedJointsTransformedInFixedJoints.find(_jnt->name) ==
-                 g_fixedJointsTransformedInFixedJoints.end()));
+              (this->fixedJointsTransformedInRevoluteJoints.find(_jnt->name) ==
+                 this->fixedJointsTransformedInRevoluteJoints.end()) &&
+              (this->fixedJointsTransformedInFixedJoints.find(_jnt->name) ==
+                 this->fixedJointsTransformedInFixedJoints.end()));
 }
 
 ////////////////////////////////////////////////////////////////////////////////
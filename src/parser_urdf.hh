@@ -20,7 +20,9 @@
 #include <tinyxml2.h>
 #include <sdf/sdf_config.h>
 
+#include <memory>
 #include <string>
+#include <string_view>
 
 #include "sdf/Console.hh"
 #include "sdf/Types.hh"
@@ -32,6 +34,9 @@ namespace sdf
   inline namespace SDF_VERSION_NAMESPACE {
   //
 
+  // Forward declare private data class.
+  class URDF2SDFPrivate;
+
   /// \brief URDF to SDF converter
   ///
   /// This is now deprecated for external usage and will be removed in the next
@@ -66,6 +71,20 @@ namespace sdf
                                  tinyxml2::XMLDocument *_sdfXmlDoc,
                                  bool _enforceLimits = true);
 
+    /// \brief convert a urdf document that was already parsed to an sdf xml
+    /// document at the current SDFormat version. The urdf isn't parsed
+    /// again when libsdformat uses its internal copy of urdfdom, and the sdf
+    /// doesn't need to be converted to the current version.
+    /// \param[in] _urdfXml the parsed urdf document.
+    /// \param[in] _urdfStr the text of the urdf document, which is parsed
+    /// when libsdformat uses a system installation of urdfdom. It can be
+    /// empty, in which case _urdfXml is printed when the text is needed.
+    /// \param[inout] _sdfXmlDoc document to populate with the sdf model.
+    /// \return False if _urdfXml doesn't hold a valid urdf model.
+    public: bool ConvertDoc(tinyxml2::XMLDocument &_urdfXml,
+                            std::string_view _urdfStr,
+                            tinyxml2::XMLDocument *_sdfXmlDoc);
+
     /// \brief Return true if the filename is a URDF model.
     /// \param[in] _filename File to check.
     /// \return True if _filename is a URDF model.
@@ -80,6 +99,22 @@ namespace sdf
     /// things that do not belong in urdf but should be mapped into sdf
     /// @todo: do this using sdf definitions, not hard coded stuff
     private: void ParseSDFExtension(tinyxml2::XMLDocument &_urdfXml);
+
+    /// \brief convert a parsed urdf document to an sdf xml document.
+    /// \param[in] _urdfXml the parsed urdf document.
+    /// \param[in] _urdfStr the text of the urdf document, or empty.
+    /// \param[inout] _sdfXmlOut document to populate with the sdf model.
+    /// \param[in] _enforceLimits option to enforce joint limits
+    /// \param[in] _version version of the sdf document.
+    /// \return False if _urdfXml doesn't hold a valid urdf model.
+    private: bool InitModel(tinyxml2::XMLDocument &_urdfXml,
+                            std::string_view _urdfStr,
+                            tinyxml2::XMLDocument *_sdfXmlOut,
+                            bool _enforceLimits,
+                            const std::string &_version);
+
+    /// \brief State of the conversion.
+    private: std::unique_ptr<URDF2SDFPrivate> dataPtr;
   };
   }
 }
@@ -18,6 +18,9 @@
 #include <gtest/gtest.h>
 
 #include <list>
+#include <string>
+#include <thread>
+#include <vector>
 
 #include "sdf/sdf.hh"
 #include "parser_urdf.hh"
@@ -852,6 +855,179 @@ TEST(URDFParser, OutputPrecision)
   EXPECT_EQ("0", poseValues[5]);
 }
 
+/////////////////////////////////////////////////
+/// \brief Generate a chain of links connected by fixed joints, with an
+/// option on one of the joints and a robot origin.
+/// \param[in] _links Number of links.
+/// \param[in] _option Name of the option of the middle joint, or empty.
+/// \return URDF string.
+std::string getFixedJointChainUrdf(int _links, const std::string &_option)
+{
+  std::ostringstream stream;
+  stream << "<robot name='chain_" << _links << "_" << _option << "'>"
+         << "  <origin xyz='" << _links << " 0 0' rpy='0 0 0'/>";
+  for (int i = 0; i < _links; ++i)
+  {
+    stream << "  <link name='link" << i << "'>"
+           << "    <inertial>"
+           << "      <mass value='" << i + 1 << "'/>"
+           << "      <inertia ixx='1' ixy='0' ixz='0'"
+           << "               iyy='1' iyz='0' izz='1'/>"
+           << "    </inertial>"
+           << "    <collision>"
+           << "      <geometry><box size='1 1 1'/></geometry>"
+           << "    </collision>"
+           << "  </link>"
+           << "  <gazebo reference='link" << i << "'>"
+           << "    <mu1>" << i << "</mu1>"
+           << "  </gazebo>";
+    if (i > 0)
+    {
+      stream << "  <joint name='joint" << i << "' type='fixed'>"
+             << "    <parent link='link" << i - 1 << "'/>"
+             << "    <child link='link" << i << "'/>"
+             << "    <origin xyz='0 0 " << i << "' rpy='0 0 0'/>"
+             << "  </joint>";
+    }
+  }
+  if (!_option.empty())
+  {
+    stream << "  <gazebo reference='joint" << _links / 2 << "'>"
+           << "    <" << _option << ">true</" << _option << ">"
+           << "  </gazebo>";
+  }
+  stream << "</robot>";
+  return stream.str();
+}
+
+/////////////////////////////////////////////////
+/// Convert different URDFs from several threads at once and check that
+/// every thread produces the same result as a serial conversion.
+TEST(URDFParser, ParallelConversion)
+{
+  std::vector<std::string> urdfs;
+  for (const std::string option :
+      {"", "disableFixedJointLumping", "preserveFixedJoint"})
+  {
+    for (int links : {2, 5, 9})
+      urdfs.push_back(getFixedJointChainUrdf(links, option));
+  }
+
+  std::vector<std::string> expected;
+  for (const auto &urdf : urdfs)
+  {
+    expected.push_back(convertUrdfStrToSdfStr(urdf));
+    EXPECT_NE(std::string::npos, expected.back().find("<model"));
+  }
+
+  // Converting the URDFs in another order with a single object must give
+  // the same results, so nothing is left over from a previous conversion.
+  sdf::URDF2SDF parser;
+  for (std::size_t i = urdfs.size(); i-- > 0;)
+  {
+    tinyxml2::XMLDocument sdfResult;
+    parser.InitModelString(urdfs[i], &sdfResult);
+    tinyxml2::XMLPrinter printer;
+    sdfResult.Accept(&printer);
+    EXPECT_EQ(expected[i], printer.CStr());
+  }
+
+  const std::size_t threadCount = 8;
+  const std::size_t iterations = 4;
+  std::vector<std::vector<std::string>> results(threadCount);
+  std::vector<std::thread> threads;
+  for (std::size_t t = 0; t < threadCount; ++t)
+  {
+    threads.emplace_back([&, t]()
+    {
+      for (std::size_t i = 0; i < iterations * urdfs.size(); ++i)
+      {
+        const std::size_t index = (t + i) % urdfs.size();
+        results[t].push_back(convertUrdfStrToSdfStr(urdfs[index]));
+      }
+    });
+  }
+  for (auto &thread : threads)
+    thread.join();
+
+  for (std::size_t t = 0; t < threadCount; ++t)
+  {
+    ASSERT_EQ(iterations * urdfs.size(), results[t].size());
+    for (std::size_t i = 0; i < results[t].size(); ++i)
+      EXPECT_EQ(expected[(t + i) % urdfs.size()], results[t][i]);
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(URDFParser, ConvertDoc)
+{
+  const std::string urdf = getFixedJointChainUrdf(5, "preserveFixedJoint");
+
+  tinyxml2::XMLDocument urdfXml;
+  ASSERT_EQ(tinyxml2::XML_SUCCESS, urdfXml.Parse(urdf.c_str()));
+
+  // The document is converted at the current version, with or without the
+  // text of the URDF.
+  for (const std::string text : {urdf, std::string()})
+  {
+    sdf::URDF2SDF parser;
+    tinyxml2::XMLDocument sdfResult;
+    EXPECT_TRUE(parser.ConvertDoc(urdfXml, text, &sdfResult));
+    tinyxml2::XMLElement *sdfXml = sdfResult.FirstChildElement("sdf");
+    ASSERT_NE(nullptr, sdfXml);
+    EXPECT_STREQ(SDF_VERSION, sdfXml->Attribute("version"));
+
+    // Except for the version, the result is the same as InitModelString.
+    sdfXml->SetAttribute("version", "1.7");
+    tinyxml2::XMLPrinter printer;
+    sdfResult.Accept(&printer);
+    EXPECT_EQ(convertUrdfStrToSdfStr(urdf), printer.CStr());
+  }
+
+  tinyxml2::XMLDocument sdfXml;
+  ASSERT_EQ(tinyxml2::XML_SUCCESS, sdfXml.Parse(
+      "<sdf version='1.8'><model name='m'/></sdf>"));
+  sdf::URDF2SDF parser;
+  tinyxml2::XMLDocument sdfResult;
+  EXPECT_FALSE(parser.ConvertDoc(sdfXml, "", &sdfResult));
+  EXPECT_EQ(nullptr, sdfResult.FirstChildElement("sdf"));
+}
+
+/////////////////////////////////////////////////
+TEST(URDFParser, LumpFixedJointChain)
+{
+  sdf::SDF sdf;
+  convertUrdfStrToSdf(getFixedJointChainUrdf(4, ""), sdf);
+  sdf::ElementPtr model = sdf.Root()->GetElement("model");
+  ASSERT_NE(nullptr, model);
+
+  // All links are lumped into the first one, which holds the mass of the
+  // whole chain.
+  sdf::ElementPtr link = model->GetElement("link");
+  ASSERT_NE(nullptr, link);
+  EXPECT_EQ("link0", link->Get<std::string>("name"));
+  EXPECT_EQ(nullptr, link->GetNextElement("link"));
+  EXPECT_DOUBLE_EQ(10.0,
+      link->GetElement("inertial")->Get<double>("mass"));
+
+  // The collisions keep the order of the chain and are posed by the
+  // accumulated transform of the fixed joints.
+  const std::vector<std::string> names = {
+    "link0_collision", "link1_collision_1", "link2_collision_2",
+    "link3_collision_3"};
+  const std::vector<double> heights = {0, 1, 3, 6};
+  std::size_t i = 0;
+  for (sdf::ElementPtr collision = link->GetElement("collision"); collision;
+       collision = collision->GetNextElement("collision"), ++i)
+  {
+    ASSERT_LT(i, names.size());
+    EXPECT_EQ(names[i], collision->Get<std::string>("name"));
+    EXPECT_EQ(ignition::math::Pose3d(0, 0, heights[i], 0, 0, 0),
+        collision->Get<ignition::math::Pose3d>("pose"));
+  }
+  EXPECT_EQ(names.size(), i);
+}
+
 /////////////////////////////////////////////////
 /// Main
 int main(int argc, char **argv)
@@ -37,6 +37,10 @@
 #ifndef URDF_INTERFACE_UTILS_H
 #define URDF_INTERFACE_UTILS_H
 
+#include <limits>
+#include <locale>
+#include <sstream>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
@@ -62,6 +66,30 @@ void split_string(std::vector<std::string> &result,
   }
 }
 
+// Replacement for std::stod that always parses with the classic locale,
+// regardless of the global locale. Like std::stod, leading whitespace is
+// skipped, parsing stops at the first character that is not part of the
+// number, std::invalid_argument is thrown if no conversion could be
+// performed and std::out_of_range if the value is out of range.
+inline
+double strToDouble(const std::string &in)
+{
+  std::istringstream stream(in);
+  stream.imbue(std::locale::classic());
+  double out = 0;
+  stream >> out;
+  if (stream.fail())
+  {
+    if (out == std::numeric_limits<double>::max() ||
+        out == -std::numeric_limits<double>::max())
+    {
+      throw std::out_of_range("strToDouble: value out of range [" + in + "]");
+    }
+    throw std::invalid_argument("strToDouble: unable to convert [" + in + "]");
+  }
+  return out;
+}
+
 }
 
 #endif
@@ -39,6 +39,7 @@
 #include <stdexcept>
 #include <string>
 #include <urdf_model/joint.h>
+#include <urdf_model/utils.h>
 // #include <console_bridge/console.h>
 #include <tinyxml2.h>
 #include <urdf_parser/urdf_parser.h>
@@ -60,7 +61,7 @@ bool parseJointDynamics(JointDynamics &jd, tinyxml2::XMLElement* config)
   {
     try
     {
-      jd.damping = std::stod(damping_str);
+      jd.damping = strToDouble(damping_str);
     }
     catch (std::invalid_argument &e)
     {
@@ -81,7 +82,7 @@ bool parseJointDynamics(JointDynamics &jd, tinyxml2::XMLElement* config)
   {
     try
     {
-      jd.friction = std::stod(friction_str);
+      jd.friction = strToDouble(friction_str);
     }
     catch (std::invalid_argument &e)
     {
@@ -115,7 +116,7 @@ bool parseJointLimits(JointLimits &jl, tinyxml2::XMLElement* config)
   {
     try
     {
-      jl.lower = std::stod(lower_str);
+      jl.lower = strToDouble(lower_str);
     }
     catch (std::invalid_argument &e)
     {
@@ -136,7 +137,7 @@ bool parseJointLimits(JointLimits &jl, tinyxml2::XMLElement* config)
   {
     try
     {
-      jl.upper = std::stod(upper_str);
+      jl.upper = strToDouble(upper_str);
     }
     catch (std::invalid_argument &e)
     {
@@ -157,7 +158,7 @@ bool parseJointLimits(JointLimits &jl, tinyxml2::XMLElement* config)
   {
     try
     {
-      jl.effort = std::stod(effort_str);
+      jl.effort = strToDouble(effort_str);
     }
     catch (std::invalid_argument &e)
     {
@@ -178,7 +179,7 @@ bool parseJointLimits(JointLimits &jl, tinyxml2::XMLElement* config)
   {
     try
     {
-      jl.velocity = std::stod(velocity_str);
+      jl.velocity = strToDouble(velocity_str);
     }
     catch (std::invalid_argument &e)
     {
@@ -207,7 +208,7 @@ bool parseJointSafety(JointSafety &js, tinyxml2::XMLElement* config)
   {
     try
     {
-      js.soft_lower_limit = std::stod(soft_lower_limit_str);
+      js.soft_lower_limit = strToDouble(soft_lower_limit_str);
     }
     catch (std::invalid_argument &e)
     {
@@ -229,7 +230,7 @@ bool parseJointSafety(JointSafety &js, tinyxml2::XMLElement* config)
   {
     try
     {
-      js.soft_upper_limit = std::stod(soft_upper_limit_str);
+      js.soft_upper_limit = strToDouble(soft_upper_limit_str);
     }
     catch (std::invalid_argument &e)
     {
@@ -251,7 +252,7 @@ bool parseJointSafety(JointSafety &js, tinyxml2::XMLElement* config)
   {
     try
     {
-      js.k_position = std::stod(k_position_str);
+      js.k_position = strToDouble(k_position_str);
     }
     catch (std::invalid_argument &e)
     {
@@ -272,7 +273,7 @@ bool parseJointSafety(JointSafety &js, tinyxml2::XMLElement* config)
   {
     try
     {
-      js.k_velocity = std::stod(k_velocity_str);
+      js.k_velocity = strToDouble(k_velocity_str);
     }
     catch (std::invalid_argument &e)
     {
@@ -301,7 +302,7 @@ bool parseJointCalibration(JointCalibration &jc, tinyxml2::XMLElement* config)
   {
     try
     {
-      jc.rising.reset(new double(std::stod(rising_position_str)));
+      jc.rising.reset(new double(strToDouble(rising_position_str)));
     }
     catch (std::invalid_argument &e)
     {
@@ -323,7 +324,7 @@ bool parseJointCalibration(JointCalibration &jc, tinyxml2::XMLElement* config)
   {
     try
     {
-      jc.falling.reset(new double(std::stod(falling_position_str)));
+      jc.falling.reset(new double(strToDouble(falling_position_str)));
     }
     catch (std::invalid_argument &e)
     {
@@ -363,7 +364,7 @@ bool parseJointMimic(JointMimic &jm, tinyxml2::XMLElement* config)
   {
     try
     {
-      jm.multiplier = std::stod(multiplier_str);
+      jm.multiplier = strToDouble(multiplier_str);
     }
     catch (std::invalid_argument &e)
     {
@@ -386,7 +387,7 @@ bool parseJointMimic(JointMimic &jm, tinyxml2::XMLElement* config)
   {
     try
     {
-      jm.offset = std::stod(offset_str);
+      jm.offset = strToDouble(offset_str);
     }
     catch (std::invalid_argument &e)
     {
@@ -37,6 +37,7 @@
 
 #include <urdf_parser/urdf_parser.h>
 #include <urdf_model/link.h>
+#include <urdf_model/utils.h>
 #include <fstream>
 #include <sstream>
 #include <stdexcept>
@@ -112,7 +113,7 @@ bool parseSphere(Sphere &s, tinyxml2::XMLElement *c)
 
   try
   {
-    s.radius = std::stod(c->Attribute("radius"));
+    s.radius = strToDouble(c->Attribute("radius"));
   }
   catch (std::invalid_argument &e)
   {
@@ -164,7 +165,7 @@ bool parseCylinder(Cylinder &y, tinyxml2::XMLElement *c)
 
   try
   {
-    y.length = std::stod(c->Attribute("length"));
+    y.length = strToDouble(c->Attribute("length"));
   }
   catch (std::invalid_argument &/*e*/)
   {
@@ -181,7 +182,7 @@ bool parseCylinder(Cylinder &y, tinyxml2::XMLElement *c)
 
   try
   {
-    y.radius = std::stod(c->Attribute("radius"));
+    y.radius = strToDouble(c->Attribute("radius"));
   }
   catch (std::invalid_argument &/*e*/)
   {
@@ -298,7 +299,7 @@ bool parseInertial(Inertial &i, tinyxml2::XMLElement *config)
 
   try
   {
-    i.mass = std::stod(mass_xml->Attribute("value"));
+    i.mass = strToDouble(mass_xml->Attribute("value"));
   }
   catch (std::invalid_argument &/*e*/)
   {
@@ -328,12 +329,12 @@ bool parseInertial(Inertial &i, tinyxml2::XMLElement *config)
   }
   try
   {
-    i.ixx  = std::stod(inertia_xml->Attribute("ixx"));
-    i.ixy  = std::stod(inertia_xml->Attribute("ixy"));
-    i.ixz  = std::stod(inertia_xml->Attribute("ixz"));
-    i.iyy  = std::stod(inertia_xml->Attribute("iyy"));
-    i.iyz  = std::stod(inertia_xml->Attribute("iyz"));
-    i.izz  = std::stod(inertia_xml->Attribute("izz"));
+    i.ixx  = strToDouble(inertia_xml->Attribute("ixx"));
+    i.ixy  = strToDouble(inertia_xml->Attribute("ixy"));
+    i.ixz  = strToDouble(inertia_xml->Attribute("ixz"));
+    i.iyy  = strToDouble(inertia_xml->Attribute("iyy"));
+    i.iyz  = strToDouble(inertia_xml->Attribute("iyz"));
+    i.izz  = strToDouble(inertia_xml->Attribute("izz"));
   }
   catch (std::invalid_argument &/*e*/)
   {
@@ -61,18 +61,22 @@ ModelInterfaceSharedPtr  parseURDFFile(const std::string &path)
 
 ModelInterfaceSharedPtr  parseURDF(const std::string &xml_string)
 {
-  ModelInterfaceSharedPtr model(new ModelInterface);
-  model->clear();
-
   tinyxml2::XMLDocument xml_doc;
   xml_doc.Parse(xml_string.c_str());
   if (xml_doc.Error())
   {
     xml_doc.ClearError();
-    model.reset();
-    return model;
+    return ModelInterfaceSharedPtr();
   }
 
+  return parseURDF(xml_doc);
+}
+
+ModelInterfaceSharedPtr  parseURDF(tinyxml2::XMLDocument &xml_doc)
+{
+  ModelInterfaceSharedPtr model(new ModelInterface);
+  model->clear();
+
   tinyxml2::XMLElement *robot_xml = xml_doc.FirstChildElement("robot");
   if (!robot_xml)
   {
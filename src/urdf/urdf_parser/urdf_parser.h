@@ -59,6 +59,7 @@ URDFDOM_DLLAPI std::string values2str(double d);
 namespace urdf{
 
   URDFDOM_DLLAPI ModelInterfaceSharedPtr parseURDF(const std::string &xml_string);
+  URDFDOM_DLLAPI ModelInterfaceSharedPtr parseURDF(tinyxml2::XMLDocument &xml_doc);
   URDFDOM_DLLAPI ModelInterfaceSharedPtr parseURDFFile(const std::string &path);
   URDFDOM_DLLAPI tinyxml2::XMLDocument*  exportURDF(ModelInterfaceSharedPtr &model);
   URDFDOM_DLLAPI tinyxml2::XMLDocument*  exportURDF(const ModelInterface &model);
@@ -318,3 +318,134 @@ TEST(IncludesTest, Includes_15_convert)
   EXPECT_EQ("1.6", modelElem->OriginalVersion());
   EXPECT_EQ("1.6", linkElem->OriginalVersion());
 }
+
+//////////////////////////////////////////////////
+/// Loading included files on several threads gives the same result as
+/// loading them one at a time.
+TEST(IncludesTest, ParallelIncludes)
+{
+  const auto worldFile =
+    sdf::filesystem::append(g_testPath, "sdf", "includes.sdf");
+
+  sdf::ParserConfig serialConfig;
+  serialConfig.SetFindCallback(findFileCb);
+
+  sdf::ParserConfig parallelConfig(serialConfig);
+  parallelConfig.SetIncludeThreadCount(4);
+  EXPECT_EQ(1u, serialConfig.IncludeThreadCount());
+  EXPECT_EQ(4u, parallelConfig.IncludeThreadCount());
+
+  sdf::Root serialRoot;
+  sdf::Errors errors = serialRoot.Load(worldFile, serialConfig);
+  EXPECT_TRUE(errors.empty());
+
+  sdf::Root parallelRoot;
+  errors = parallelRoot.Load(worldFile, parallelConfig);
+  EXPECT_TRUE(errors.empty());
+
+  ASSERT_NE(nullptr, serialRoot.Element());
+  ASSERT_NE(nullptr, parallelRoot.Element());
+  EXPECT_EQ(serialRoot.Element()->ToString(""),
+            parallelRoot.Element()->ToString(""));
+
+  // The included elements keep their file paths and versions.
+  sdf::ElementPtr serialWorld = serialRoot.Element()->GetElement("world");
+  sdf::ElementPtr parallelWorld = parallelRoot.Element()->GetElement("world");
+  ASSERT_NE(nullptr, serialWorld);
+  ASSERT_NE(nullptr, parallelWorld);
+
+  sdf::ElementPtr serialElem = serialWorld->GetFirstElement();
+  sdf::ElementPtr parallelElem = parallelWorld->GetFirstElement();
+  while (serialElem && parallelElem)
+  {
+    EXPECT_EQ(serialElem->GetName(), parallelElem->GetName());
+    EXPECT_EQ(serialElem->FilePath(), parallelElem->FilePath());
+    EXPECT_EQ(serialElem->OriginalVersion(),
+              parallelElem->OriginalVersion());
+    serialElem = serialElem->GetNextElement();
+    parallelElem = parallelElem->GetNextElement();
+  }
+  EXPECT_EQ(nullptr, serialElem);
+  EXPECT_EQ(nullptr, parallelElem);
+
+  // Errors for includes that cannot be found are reported in document
+  // order.
+  const std::string missingSdf =
+    "<sdf version='1.8'>"
+    "  <world name='default'>"
+    "    <include><uri>model://missing_a</uri></include>"
+    "    <include><uri>test_model</uri></include>"
+    "    <include><uri>model://missing_b</uri></include>"
+    "  </world>"
+    "</sdf>";
+  sdf::Root missingRoot;
+  errors = missingRoot.LoadSdfString(missingSdf, parallelConfig);
+  ASSERT_GE(errors.size(), 2u);
+  EXPECT_EQ(sdf::ErrorCode::DIRECTORY_NONEXISTANT, errors[0].Code());
+  EXPECT_NE(std::string::npos, errors[0].Message().find("missing_a"));
+  EXPECT_EQ(sdf::ErrorCode::DIRECTORY_NONEXISTANT, errors[1].Code());
+  EXPECT_NE(std::string::npos, errors[1].Message().find("missing_b"));
+}
+
+//////////////////////////////////////////////////
+/// Included files are loaded once when the include cache is enabled.
+TEST(IncludesTest, IncludeCache)
+{
+  const auto worldFile =
+    sdf::filesystem::append(g_testPath, "sdf", "includes.sdf");
+
+  sdf::ParserConfig uncachedConfig;
+  uncachedConfig.SetFindCallback(findFileCb);
+  EXPECT_FALSE(uncachedConfig.IncludeCacheEnabled());
+
+  sdf::ParserConfig config(uncachedConfig);
+  config.SetIncludeCacheEnabled(true);
+  EXPECT_TRUE(config.IncludeCacheEnabled());
+  EXPECT_EQ(0u, config.IncludeCacheHits());
+  EXPECT_EQ(0u, config.IncludeCacheMisses());
+
+  sdf::Root uncachedRoot;
+  EXPECT_TRUE(uncachedRoot.Load(worldFile, uncachedConfig).empty());
+  EXPECT_EQ(0u, uncachedConfig.IncludeCacheHits());
+  EXPECT_EQ(0u, uncachedConfig.IncludeCacheMisses());
+
+  // includes.sdf includes each of its files more than once, with different
+  // overrides.
+  sdf::Root root;
+  EXPECT_TRUE(root.Load(worldFile, config).empty());
+  const std::size_t misses = config.IncludeCacheMisses();
+  EXPECT_LT(0u, misses);
+  EXPECT_LT(0u, config.IncludeCacheHits());
+
+  ASSERT_NE(nullptr, uncachedRoot.Element());
+  ASSERT_NE(nullptr, root.Element());
+  EXPECT_EQ(uncachedRoot.Element()->ToString(""),
+            root.Element()->ToString(""));
+
+  // Loading the world again only hits the cache.
+  const std::size_t hits = config.IncludeCacheHits();
+  sdf::Root secondRoot;
+  EXPECT_TRUE(secondRoot.Load(worldFile, config).empty());
+  EXPECT_EQ(misses, config.IncludeCacheMisses());
+  EXPECT_EQ(hits + misses + hits, config.IncludeCacheHits());
+  ASSERT_NE(nullptr, secondRoot.Element());
+  EXPECT_EQ(root.Element()->ToString(""),
+            secondRoot.Element()->ToString(""));
+
+  // The cache also works with concurrent include loading, and each file is
+  // still loaded once when several threads request it at the same time.
+  sdf::ParserConfig parallelConfig(config);
+  EXPECT_EQ(0u, parallelConfig.IncludeCacheHits());
+  parallelConfig.SetIncludeThreadCount(4);
+  sdf::Root parallelRoot;
+  EXPECT_TRUE(parallelRoot.Load(worldFile, parallelConfig).empty());
+  EXPECT_EQ(misses, parallelConfig.IncludeCacheMisses());
+  EXPECT_EQ(hits, parallelConfig.IncludeCacheHits());
+  ASSERT_NE(nullptr, parallelRoot.Element());
+  EXPECT_EQ(root.Element()->ToString(""),
+            parallelRoot.Element()->ToString(""));
+
+  config.ClearIncludeCache();
+  EXPECT_EQ(0u, config.IncludeCacheHits());
+  EXPECT_EQ(0u, config.IncludeCacheMisses());
+}
@@ -19,6 +19,7 @@
 #include <gtest/gtest.h>
 
 #include <ignition/math/Pose3.hh>
+#include "sdf/Collision.hh"
 #include "sdf/Element.hh"
 #include "sdf/Error.hh"
 #include "sdf/Filesystem.hh"
@@ -27,6 +28,7 @@
 #include "sdf/Model.hh"
 #include "sdf/Root.hh"
 #include "sdf/Types.hh"
+#include "sdf/Visual.hh"
 #include "sdf/World.hh"
 #include "test_config.h"
 
@@ -304,6 +306,43 @@ TEST(DOMRoot, MultiNestedModel)
   EXPECT_NE(nullptr, outerModel->FrameByName(innerFrameNestedName));
 }
 
+/////////////////////////////////////////////////
+TEST(DOMRoot, MultiNestedModelCopyLookup)
+{
+  const std::string testFile =
+    sdf::filesystem::append(PROJECT_SOURCE_PATH, "test", "sdf",
+        "model_multi_nested_model.sdf");
+
+  sdf::Root root;
+  auto errors = root.Load(testFile);
+  EXPECT_TRUE(errors.empty());
+
+  const sdf::Model *outerModel = root.ModelByIndex(0);
+  ASSERT_NE(nullptr, outerModel);
+
+  // Lookups by name in a copy return objects owned by the copy.
+  const sdf::Model copy(*outerModel);
+  const sdf::Model *innerModel =
+      copy.ModelByIndex(0)->ModelByIndex(0);
+  ASSERT_NE(nullptr, innerModel);
+  EXPECT_EQ(innerModel, copy.ModelByName("mid_model::inner_model"));
+  EXPECT_NE(outerModel->ModelByName("mid_model::inner_model"),
+            copy.ModelByName("mid_model::inner_model"));
+  EXPECT_EQ(copy.LinkByIndex(0), copy.LinkByName("outer_link"));
+  EXPECT_EQ(innerModel->LinkByIndex(0),
+            copy.LinkByName("mid_model::inner_model::inner_link"));
+  EXPECT_EQ(innerModel->JointByIndex(0),
+            copy.JointByName("mid_model::inner_model::inner_joint"));
+  EXPECT_EQ(innerModel->FrameByIndex(0),
+            copy.FrameByName("mid_model::inner_model::inner_frame"));
+
+  // Partial and unknown nested names are not found.
+  EXPECT_EQ(nullptr, copy.ModelByName("mid_model::"));
+  EXPECT_EQ(nullptr, copy.ModelByName("inner_model"));
+  EXPECT_EQ(nullptr, copy.LinkByName("mid_model::outer_link"));
+  EXPECT_EQ(nullptr, copy.LinkByName("unknown::inner_link"));
+}
+
 /////////////////////////////////////////////////
 TEST(DOMLink, NestedModelPoseRelativeTo)
 {
@@ -577,3 +616,55 @@ TEST(DOMRoot, LoadInvalidNestedModelWithoutLinks)
   // errors[5]
   // errors[6]
 }
+
+/////////////////////////////////////////////////
+TEST(DOMModel, RenamedChildren)
+{
+  const std::string sdf =
+    "<sdf version='1.8'>"
+    "  <model name='model'>"
+    "    <link name='link'>"
+    "      <collision name='collision'>"
+    "        <geometry><sphere><radius>1</radius></sphere></geometry>"
+    "      </collision>"
+    "      <visual name='visual'>"
+    "        <geometry><sphere><radius>1</radius></sphere></geometry>"
+    "      </visual>"
+    "    </link>"
+    "    <frame name='frame'/>"
+    "  </model>"
+    "</sdf>";
+
+  sdf::Root root;
+  sdf::Errors errors = root.LoadSdfString(sdf);
+  EXPECT_TRUE(errors.empty()) << errors;
+  const sdf::Model *model = root.ModelByIndex(0);
+  ASSERT_NE(nullptr, model);
+
+  // Children renamed through their const SetName functions are found by
+  // their new names.
+  const sdf::Link *link = model->LinkByName("link");
+  ASSERT_NE(nullptr, link);
+  link->SetName("renamed_link");
+  EXPECT_EQ(link, model->LinkByName("renamed_link"));
+  EXPECT_EQ(nullptr, model->LinkByName("link"));
+  EXPECT_TRUE(model->LinkNameExists("renamed_link"));
+
+  const sdf::Frame *frame = model->FrameByName("frame");
+  ASSERT_NE(nullptr, frame);
+  frame->SetName("renamed_frame");
+  EXPECT_EQ(frame, model->FrameByName("renamed_frame"));
+  EXPECT_EQ(nullptr, model->FrameByName("frame"));
+
+  const sdf::Collision *collision = link->CollisionByName("collision");
+  ASSERT_NE(nullptr, collision);
+  collision->SetName("renamed_collision");
+  EXPECT_EQ(collision, link->CollisionByName("renamed_collision"));
+  EXPECT_EQ(nullptr, link->CollisionByName("collision"));
+
+  const sdf::Visual *visual = link->VisualByName("visual");
+  ASSERT_NE(nullptr, visual);
+  visual->SetName("renamed_visual");
+  EXPECT_EQ(visual, link->VisualByName("renamed_visual"));
+  EXPECT_EQ(nullptr, link->VisualByName("visual"));
+}
@@ -18,6 +18,8 @@
 #include <sstream>
 #include <fstream>
 #include <string>
+#include <tuple>
+#include <vector>
 
 #include <gtest/gtest.h>
 #include <ignition/math/Pose3.hh>
@@ -1217,6 +1219,169 @@ TEST(NestedReference, PoseRelativeToInWorld)
   }
 }
 
+//////////////////////////////////////////////////
+TEST(NestedReference, ResolvePosesInWorld)
+{
+  const std::string testFile =
+    sdf::filesystem::append(PROJECT_SOURCE_PATH, "test", "sdf",
+        "world_relative_to_nested_reference.sdf");
+
+  sdf::Root root;
+  EXPECT_TRUE(root.Load(testFile).empty());
+  const sdf::World *world = root.WorldByIndex(0);
+  ASSERT_NE(nullptr, world);
+
+  using Pose = ignition::math::Pose3d;
+  using PoseType = sdf::ResolvedPoses::PoseType;
+
+  // All the poses of the world, relative to the world frame.
+  sdf::ResolvedPoses poses;
+  EXPECT_TRUE(world->ResolvePoses(poses).empty());
+  EXPECT_EQ("world", poses.ResolveTo());
+  ASSERT_EQ(17u, poses.Count());
+  ASSERT_EQ(17u, poses.Positions().size());
+  ASSERT_EQ(17u, poses.Orientations().size());
+  EXPECT_EQ("M1", poses.Names()[0]);
+  EXPECT_EQ(PoseType::MODEL, poses.Types()[0]);
+  EXPECT_EQ(Pose(1, 0, 0, 0, IGN_PI_2, 0), poses.PoseByIndex(0));
+
+  std::size_t index = poses.IndexByName("M1::CM1::L");
+  ASSERT_LT(index, poses.Count());
+  EXPECT_EQ(PoseType::LINK, poses.Types()[index]);
+
+  for (const std::string frameName : {"F2", "F3", "F4", "F5", "F6", "F7"})
+  {
+    const sdf::Frame *frame = world->FrameByName(frameName);
+    ASSERT_NE(nullptr, frame);
+    Pose pose;
+    EXPECT_TRUE(frame->SemanticPose().Resolve(pose).empty());
+
+    index = poses.IndexByName(frameName);
+    ASSERT_LT(index, poses.Count());
+    EXPECT_EQ(PoseType::FRAME, poses.Types()[index]);
+    EXPECT_EQ(pose, poses.PoseByIndex(index)) << frameName;
+  }
+
+  // The poses of a model match the poses resolved one by one.
+  const sdf::Model *model = world->ModelByName("M1");
+  ASSERT_NE(nullptr, model);
+
+  // The children of links are resolved relative to the world as well.
+  {
+    const sdf::Link *link = model->LinkByName("L1");
+    ASSERT_NE(nullptr, link);
+    const sdf::Collision *collision = link->CollisionByName("C1");
+    ASSERT_NE(nullptr, collision);
+    Pose pose;
+    EXPECT_TRUE(collision->SemanticPose().Resolve(pose, "__model__").empty());
+
+    index = poses.IndexByName("M1::L1::C1");
+    ASSERT_LT(index, poses.Count());
+    EXPECT_EQ(PoseType::COLLISION, poses.Types()[index]);
+    EXPECT_EQ(poses.PoseByIndex(0) * pose, poses.PoseByIndex(index));
+  }
+  EXPECT_TRUE(model->ResolvePoses(poses).empty());
+  EXPECT_EQ("__model__", poses.ResolveTo());
+  ASSERT_EQ(10u, poses.Count());
+  for (std::size_t i = 0; i < poses.Count(); ++i)
+  {
+    // The semantic poses of the children of links and of objects in nested
+    // models are checked below.
+    const std::string &name = poses.Names()[i];
+    if (name.find("::") != std::string::npos)
+    {
+      continue;
+    }
+
+    sdf::Errors errors;
+    Pose pose;
+    switch (poses.Types()[i])
+    {
+      case PoseType::LINK:
+        ASSERT_NE(nullptr, model->LinkByName(name));
+        errors = model->LinkByName(name)->SemanticPose().Resolve(pose);
+        break;
+      case PoseType::JOINT:
+        ASSERT_NE(nullptr, model->JointByName(name));
+        errors = model->JointByName(name)->SemanticPose().Resolve(
+            pose, "__model__");
+        break;
+      case PoseType::FRAME:
+        ASSERT_NE(nullptr, model->FrameByName(name));
+        errors = model->FrameByName(name)->SemanticPose().Resolve(
+            pose, "__model__");
+        break;
+      case PoseType::MODEL:
+        ASSERT_NE(nullptr, model->ModelByName(name));
+        errors = model->ModelByName(name)->SemanticPose().Resolve(pose);
+        break;
+      default:
+        FAIL() << "Unexpected pose type for " << name;
+    }
+    EXPECT_TRUE(errors.empty()) << name;
+    EXPECT_EQ(pose, poses.PoseByIndex(i)) << name;
+  }
+
+  index = poses.IndexByName("CM1::L");
+  ASSERT_LT(index, poses.Count());
+  EXPECT_EQ(Pose(0, 1, 0, IGN_PI_2, 0, 0) * Pose(1, 0, 0, 0, -IGN_PI_2, 0),
+      poses.PoseByIndex(index));
+
+  // The poses of collisions, visuals and sensors match their semantic poses.
+  // Those in the nested model are resolved in its scope and composed with
+  // the pose of the nested model.
+  const sdf::Link *link1 = model->LinkByName("L1");
+  ASSERT_NE(nullptr, link1);
+  const sdf::Link *link2 = model->LinkByName("L2");
+  ASSERT_NE(nullptr, link2);
+  const sdf::Link *nestedLink = model->LinkByName("CM1::L");
+  ASSERT_NE(nullptr, nestedLink);
+  ASSERT_NE(nullptr, link1->CollisionByName("C1"));
+  ASSERT_NE(nullptr, link1->VisualByName("V1"));
+  ASSERT_NE(nullptr, link2->SensorByName("S1"));
+  ASSERT_NE(nullptr, nestedLink->VisualByName("V"));
+
+  index = poses.IndexByName("CM1");
+  ASSERT_LT(index, poses.Count());
+  const Pose nestedModelPose = poses.PoseByIndex(index);
+
+  const std::vector<std::tuple<std::string, PoseType, sdf::SemanticPose,
+      Pose>> linkChildren = {
+    {"L1::C1", PoseType::COLLISION,
+        link1->CollisionByName("C1")->SemanticPose(), Pose::Zero},
+    {"L1::V1", PoseType::VISUAL,
+        link1->VisualByName("V1")->SemanticPose(), Pose::Zero},
+    {"L2::S1", PoseType::SENSOR,
+        link2->SensorByName("S1")->SemanticPose(), Pose::Zero},
+    {"CM1::L::V", PoseType::VISUAL,
+        nestedLink->VisualByName("V")->SemanticPose(), nestedModelPose}};
+  for (const auto &[name, type, semanticPose, scopePose] : linkChildren)
+  {
+    Pose pose;
+    EXPECT_TRUE(semanticPose.Resolve(pose, "__model__").empty()) << name;
+
+    index = poses.IndexByName(name);
+    ASSERT_LT(index, poses.Count()) << name;
+    EXPECT_EQ(type, poses.Types()[index]) << name;
+    EXPECT_EQ(scopePose * pose, poses.PoseByIndex(index)) << name;
+  }
+
+  // Poses relative to another frame.
+  EXPECT_TRUE(model->ResolvePoses(poses, "L2").empty());
+  index = poses.IndexByName("L2");
+  ASSERT_LT(index, poses.Count());
+  EXPECT_EQ(Pose::Zero, poses.PoseByIndex(index));
+  index = poses.IndexByName("F1");
+  ASSERT_LT(index, poses.Count());
+  EXPECT_EQ(Pose(1, 0, 0, 0, 0, 0), poses.PoseByIndex(index));
+
+  // An unknown frame to resolve to is an error.
+  sdf::Errors errors = model->ResolvePoses(poses, "invalid");
+  ASSERT_EQ(1u, errors.size());
+  EXPECT_EQ(sdf::ErrorCode::POSE_RELATIVE_TO_INVALID, errors[0].Code());
+  EXPECT_EQ(0u, poses.Count());
+}
+
 /////////////////////////////////////////////////
 TEST(NestedReference, PlacementFrameAttribute)
 {
@@ -0,0 +1,203 @@
+/*
+ * Copyright 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <gtest/gtest.h>
+
+#include "sdf/Filesystem.hh"
+#include "sdf/ParserConfig.hh"
+#include "sdf/Root.hh"
+#include "sdf/parser.hh"
+#include "test_config.h"
+
+const auto g_testPath = sdf::filesystem::append(PROJECT_SOURCE_PATH, "test");
+
+/////////////////////////////////////////////////
+/// \brief Read a whole file into a string.
+/// \param[in] _filename File to read.
+/// \return Contents of the file.
+std::string fileContents(const std::string &_filename)
+{
+  std::ifstream stream(_filename);
+  std::stringstream contents;
+  contents << stream.rdbuf();
+  return contents.str();
+}
+
+/////////////////////////////////////////////////
+/// \brief Check that reading a file, which streams files that don't need to
+/// be converted, gives the same result as reading its contents as a string,
+/// which always builds a DOM.
+/// \param[in] _filename File to read.
+/// \param[in] _config Parser configuration.
+/// \param[in] _convert True to convert the file to the latest version.
+void compareWithDom(const std::string &_filename,
+                    const sdf::ParserConfig &_config, bool _convert)
+{
+  SCOPED_TRACE(_filename);
+  const std::string contents = fileContents(_filename);
+
+  sdf::SDFPtr fileSdf(new sdf::SDF());
+  sdf::init(fileSdf);
+  sdf::Errors fileErrors;
+
+  sdf::SDFPtr stringSdf(new sdf::SDF());
+  sdf::init(stringSdf);
+  sdf::Errors stringErrors;
+
+  bool fileResult = false;
+  bool stringResult = false;
+  if (_convert)
+  {
+    fileResult = sdf::readFile(_filename, _config, fileSdf, fileErrors);
+    stringResult = sdf::readString(contents, _config, stringSdf,
+                                   stringErrors);
+  }
+  else
+  {
+    fileResult = sdf::readFileWithoutConversion(_filename, _config, fileSdf,
+                                                fileErrors);
+    stringResult = sdf::readStringWithoutConversion(contents, _config,
+                                                    stringSdf, stringErrors);
+  }
+
+  EXPECT_EQ(stringResult, fileResult);
+  if (!stringResult)
+    return;
+
+  EXPECT_EQ(stringSdf->Root()->ToString(""), fileSdf->Root()->ToString(""));
+  EXPECT_EQ(stringSdf->OriginalVersion(), fileSdf->OriginalVersion());
+  EXPECT_EQ(_filename, fileSdf->FilePath());
+
+  ASSERT_EQ(stringErrors.size(), fileErrors.size());
+  for (std::size_t i = 0; i < stringErrors.size(); ++i)
+  {
+    EXPECT_EQ(stringErrors[i].Code(), fileErrors[i].Code());
+    EXPECT_EQ(stringErrors[i].Message(), fileErrors[i].Message());
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Parser configuration that finds the test models.
+/// \return The configuration.
+sdf::ParserConfig testConfig()
+{
+  sdf::ParserConfig config;
+  config.SetFindCallback([](const std::string &_input)
+      {
+        return sdf::filesystem::append(g_testPath, "integration", "model",
+            _input);
+      });
+  return config;
+}
+
+/////////////////////////////////////////////////
+TEST(ParserStreaming, TestFiles)
+{
+  const sdf::ParserConfig config = testConfig();
+  const std::string sdfDir = sdf::filesystem::append(g_testPath, "sdf");
+
+  sdf::filesystem::DirIter endIter;
+  for (sdf::filesystem::DirIter dirIter(sdfDir); dirIter != endIter; ++dirIter)
+  {
+    const std::string filename = *dirIter;
+    if (filename.size() < 4 ||
+        filename.compare(filename.size() - 4, 4, ".sdf") != 0)
+    {
+      continue;
+    }
+
+    compareWithDom(filename, config, true);
+    compareWithDom(filename, config, false);
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(ParserStreaming, LargeWorld)
+{
+  // A world larger than the batches in which elements are streamed, with
+  // unknown elements and includes in between models.
+  std::ostringstream stream;
+  stream << "<?xml version='1.0'?>\n"
+         << "<!-- generated world -->\n"
+         << "<sdf version='" << SDF_VERSION << "' xmlns:ext='ext'>\n"
+         << "  <ext:root_data value='1'/>\n"
+         << "  <world name='default'>\n"
+         << "    <gravity>0 0 -9.8</gravity>\n";
+  for (int i = 0; i < 5000; ++i)
+  {
+    stream << "    <model name='model_" << i << "'>\n"
+           << "      <pose>" << i << " 0 0 0 0 0</pose>\n"
+           << "      <link name='link'>\n"
+           << "        <collision name='collision'>\n"
+           << "          <geometry><box><size>1 1 1</size></box></geometry>\n"
+           << "        </collision>\n"
+           << "      </link>\n"
+           << "      <plugin name='p' filename='p.so'><a>x</a></plugin>\n"
+           << "    </model>\n";
+    if (i % 1000 == 0)
+    {
+      stream << "    <ext:data index='" << i << "'>text</ext:data>\n"
+             << "    <include>\n"
+             << "      <uri>test_model</uri>\n"
+             << "      <name>included_" << i << "</name>\n"
+             << "    </include>\n";
+    }
+  }
+  stream << "    <light name='sun' type='directional'/>\n"
+         << "  </world>\n"
+         << "</sdf>\n";
+
+  const std::string filename = sdf::filesystem::append(PROJECT_BINARY_DIR,
+      "parser_streaming_large_world.sdf");
+  {
+    std::ofstream file(filename);
+    file << stream.str();
+  }
+
+  compareWithDom(filename, testConfig(), true);
+}
+
+/////////////////////////////////////////////////
+TEST(ParserStreaming, StringView)
+{
+  const std::string filename = sdf::filesystem::append(g_testPath,
+      "integration", "model", "test_model", "model.sdf");
+  const std::string contents = fileContents(filename);
+
+  // Only the viewed characters are parsed, so the view doesn't need to be
+  // null terminated.
+  const std::string padded = contents + "<unterminated";
+  const std::string_view view(padded.data(), contents.size());
+
+  sdf::SDFPtr sdf(new sdf::SDF());
+  sdf::init(sdf);
+  sdf::Errors errors;
+  EXPECT_TRUE(sdf::readString(view, sdf, errors));
+  EXPECT_TRUE(errors.empty());
+  ASSERT_NE(nullptr, sdf->Root()->GetElement("model"));
+  EXPECT_EQ("test_model",
+      sdf->Root()->GetElement("model")->Get<std::string>("name"));
+
+  sdf::Root root;
+  errors = root.LoadSdfString(view);
+  EXPECT_TRUE(errors.empty());
+  EXPECT_EQ(1u, root.ModelCount());
+}
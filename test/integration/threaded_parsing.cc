@@ -0,0 +1,112 @@
+/*
+ * Copyright 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "sdf/Filesystem.hh"
+#include "sdf/ParserConfig.hh"
+#include "sdf/Root.hh"
+#include "sdf/parser.hh"
+#include "test_config.h"
+
+const auto g_testPath = sdf::filesystem::append(PROJECT_SOURCE_PATH, "test");
+
+/////////////////////////////////////////////////
+/// \brief Load a file with the given configuration.
+/// \param[in] _file File to load.
+/// \param[in] _config Parser configuration.
+/// \param[out] _errors Errors encountered while loading.
+/// \return The loaded element tree as a string.
+std::string loadToString(const std::string &_file,
+    const sdf::ParserConfig &_config, sdf::Errors &_errors)
+{
+  sdf::Root root;
+  _errors = root.Load(_file, _config);
+  if (!root.Element())
+    return std::string();
+  return root.Element()->ToString("");
+}
+
+/////////////////////////////////////////////////
+/// Parse the same and different files from several threads at once and
+/// check that every thread produces the same result as a serial parse.
+TEST(ThreadedParsing, IndependentFiles)
+{
+  sdf::ParserConfig config;
+  config.SetFindCallback([](const std::string &_input)
+      {
+        return sdf::filesystem::append(g_testPath, "integration", "model",
+            _input);
+      });
+
+  const std::vector<std::string> files =
+  {
+    sdf::filesystem::append(g_testPath, "sdf", "includes.sdf"),
+    sdf::filesystem::append(g_testPath, "sdf", "double_pendulum.sdf"),
+    sdf::filesystem::append(g_testPath, "integration", "model", "pr2.sdf"),
+    sdf::filesystem::append(g_testPath, "integration",
+        "fixed_joint_reduction.urdf"),
+  };
+
+  // Serial reference results.
+  std::vector<std::string> expected;
+  for (const auto &file : files)
+  {
+    sdf::Errors errors;
+    expected.push_back(loadToString(file, config, errors));
+    EXPECT_TRUE(errors.empty()) << file;
+    EXPECT_FALSE(expected.back().empty()) << file;
+  }
+
+  const unsigned int threadCount = 8;
+  const unsigned int iterations = 4;
+  std::atomic<unsigned int> mismatches{0};
+  std::atomic<unsigned int> failures{0};
+
+  std::vector<std::thread> threads;
+  for (unsigned int t = 0; t < threadCount; ++t)
+  {
+    threads.emplace_back([&, t]()
+    {
+      // Each thread uses its own copy of the configuration.
+      const sdf::ParserConfig threadConfig(config);
+      for (unsigned int i = 0; i < iterations; ++i)
+      {
+        // Half of the threads parse the same file, the others rotate through
+        // the list so that different files are parsed concurrently.
+        const std::size_t index = (t % 2 == 0) ? 0 : (t + i) % files.size();
+        sdf::Errors errors;
+        const std::string result =
+          loadToString(files[index], threadConfig, errors);
+        if (!errors.empty())
+          ++failures;
+        if (result != expected[index])
+          ++mismatches;
+      }
+    });
+  }
+
+  for (auto &thread : threads)
+    thread.join();
+
+  EXPECT_EQ(0u, failures);
+  EXPECT_EQ(0u, mismatches);
+}
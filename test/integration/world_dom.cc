@@ -220,3 +220,242 @@ TEST(DOMWorld, LoadModelFrameSameName)
       SemanticPose().Resolve(pose, "ground").empty());
   EXPECT_EQ(Pose(0, -2, 3, 0, 0, 0), pose);
 }
+
+/////////////////////////////////////////////////
+/// \brief Generate a world with a model named "base" and a model and a
+/// frame relative to it.
+/// \param[in] _baseModel SDFormat string of the "base" model.
+/// \return SDFormat string.
+static std::string updateModelWorld(const std::string &_baseModel)
+{
+  return "<sdf version='1.8'>"
+         "<world name='default'>" + _baseModel +
+         "  <model name='other'>"
+         "    <pose relative_to='base'>0 1 0 0 0 0</pose>"
+         "    <link name='L'/>"
+         "  </model>"
+         "  <frame name='F' attached_to='base'>"
+         "    <pose>0 0 1 0 0 0</pose>"
+         "  </frame>"
+         "</world>"
+         "</sdf>";
+}
+
+/////////////////////////////////////////////////
+TEST(DOMWorld, UpdateModel)
+{
+  using Pose = ignition::math::Pose3d;
+
+  const std::string baseModel =
+    "<model name='base'>"
+    "  <pose>1 0 0 0 0 0</pose>"
+    "  <link name='L'/>"
+    "  <frame name='F1' attached_to='L'>"
+    "    <pose>0 0 2 0 0 0</pose>"
+    "  </frame>"
+    "</model>";
+
+  sdf::Root root;
+  sdf::Errors errors = root.LoadSdfString(updateModelWorld(baseModel));
+  EXPECT_TRUE(errors.empty()) << errors;
+  sdf::World *world = root.WorldByIndex(0);
+  ASSERT_NE(nullptr, world);
+
+  Pose pose;
+  EXPECT_TRUE(world->ModelByName("other")->
+      SemanticPose().Resolve(pose, "world").empty());
+  EXPECT_EQ(Pose(1, 1, 0, 0, 0, 0), pose);
+  EXPECT_TRUE(world->FrameByName("F")->
+      SemanticPose().Resolve(pose, "world").empty());
+  EXPECT_EQ(Pose(1, 0, 1, 0, 0, 0), pose);
+
+  // Move the model and its frame, and add a link and a frame.
+  const std::string movedModel =
+    "<model name='base'>"
+    "  <pose>3 0 0 0 0 0</pose>"
+    "  <link name='L'/>"
+    "  <link name='L2'>"
+    "    <pose>0 0 5 0 0 0</pose>"
+    "  </link>"
+    "  <frame name='F1' attached_to='L2'>"
+    "    <pose>0 0 1 0 0 0</pose>"
+    "  </frame>"
+    "  <frame name='F2' attached_to='F1'/>"
+    "</model>";
+  sdf::Root movedRoot;
+  errors = movedRoot.LoadSdfString(updateModelWorld(movedModel));
+  EXPECT_TRUE(errors.empty()) << errors;
+  const sdf::Model *moved = movedRoot.WorldByIndex(0)->ModelByName("base");
+  ASSERT_NE(nullptr, moved);
+
+  errors = world->UpdateModel(*moved);
+  EXPECT_TRUE(errors.empty()) << errors;
+
+  const sdf::Model *base = world->ModelByName("base");
+  ASSERT_NE(nullptr, base);
+  EXPECT_EQ(2u, base->LinkCount());
+  EXPECT_TRUE(base->SemanticPose().Resolve(pose, "world").empty());
+  EXPECT_EQ(Pose(3, 0, 0, 0, 0, 0), pose);
+  EXPECT_TRUE(base->FrameByName("F2")->
+      SemanticPose().Resolve(pose, "world").empty());
+  EXPECT_EQ(Pose(3, 0, 6, 0, 0, 0), pose);
+  EXPECT_TRUE(world->ModelByName("other")->
+      SemanticPose().Resolve(pose, "world").empty());
+  EXPECT_EQ(Pose(3, 1, 0, 0, 0, 0), pose);
+  EXPECT_TRUE(world->FrameByName("F")->
+      SemanticPose().Resolve(pose, "world").empty());
+  EXPECT_EQ(Pose(3, 0, 1, 0, 0, 0), pose);
+
+  std::string body;
+  EXPECT_TRUE(base->FrameByName("F2")->ResolveAttachedToBody(body).empty());
+  EXPECT_EQ("L2", body);
+  EXPECT_TRUE(world->FrameByName("F")->ResolveAttachedToBody(body).empty());
+  EXPECT_EQ("base::L", body);
+
+  // Removing a frame requires loading the world again.
+  sdf::Root removedRoot;
+  errors = removedRoot.LoadSdfString(updateModelWorld(baseModel));
+  EXPECT_TRUE(errors.empty()) << errors;
+  errors = world->UpdateModel(
+      *removedRoot.WorldByIndex(0)->ModelByName("base"));
+  ASSERT_FALSE(errors.empty());
+  EXPECT_EQ(sdf::ErrorCode::FRAME_ATTACHED_TO_GRAPH_ERROR, errors[0].Code());
+  EXPECT_EQ(2u, world->ModelByName("base")->LinkCount());
+
+  // A model can't be relative to a model that is relative to it.
+  const std::string cycleModel =
+    "<model name='base'>"
+    "  <pose relative_to='other'>3 0 0 0 0 0</pose>"
+    "  <link name='L'/>"
+    "  <link name='L2'/>"
+    "  <frame name='F1' attached_to='L2'/>"
+    "  <frame name='F2' attached_to='F1'/>"
+    "</model>";
+  sdf::Root cycleRoot;
+  cycleRoot.LoadSdfString(updateModelWorld(cycleModel));
+  const sdf::Model *cycle = cycleRoot.WorldByIndex(0)->ModelByName("base");
+  ASSERT_NE(nullptr, cycle);
+  errors = world->UpdateModel(*cycle);
+  ASSERT_FALSE(errors.empty());
+  EXPECT_EQ(sdf::ErrorCode::POSE_RELATIVE_TO_CYCLE, errors[0].Code());
+  EXPECT_TRUE(world->ModelByName("base")->
+      SemanticPose().Resolve(pose, "world").empty());
+  EXPECT_EQ(Pose(3, 0, 0, 0, 0, 0), pose);
+
+  // A world that wasn't loaded has no graphs to update.
+  sdf::World emptyWorld;
+  errors = emptyWorld.UpdateModel(*moved);
+  EXPECT_FALSE(errors.empty());
+}
+
+/////////////////////////////////////////////////
+/// Loading the models of a world on several threads gives the same result as
+/// loading them one at a time.
+TEST(DOMWorld, ParallelModelLoad)
+{
+  using Pose = ignition::math::Pose3d;
+
+  // Each model is placed relative to the previous one. When requested, a
+  // model without links and a duplicate name add errors in the middle of
+  // the world.
+  const int modelCount = 40;
+  auto worldSdf = [&](bool _withErrors)
+  {
+    std::string result =
+      "<sdf version='1.8'>"
+      "  <world name='default'>";
+    for (int i = 0; i < modelCount; ++i)
+    {
+      const std::string name = "model_" + std::to_string(i);
+      std::string pose = "<pose>1 0 0 0 0 0</pose>";
+      if (i > 0)
+      {
+        pose = "<pose relative_to='model_" + std::to_string(i - 1) +
+          "'>1 0 0 0 0 0</pose>";
+      }
+      result += "<model name='" + name + "'>" + pose;
+      if (!_withErrors || i != 10)
+        result += "<link name='link'/><frame name='frame'/>";
+      result += "</model>";
+      if (_withErrors && i == 20)
+        result += "<model name='" + name + "'><link name='link'/></model>";
+    }
+    result +=
+      "  </world>"
+      "</sdf>";
+    return result;
+  };
+
+  sdf::ParserConfig serialConfig;
+  sdf::ParserConfig parallelConfig;
+  parallelConfig.SetModelLoadThreadCount(4);
+  EXPECT_EQ(1u, serialConfig.ModelLoadThreadCount());
+  EXPECT_EQ(4u, parallelConfig.ModelLoadThreadCount());
+
+  sdf::Root serialRoot;
+  sdf::Errors errors = serialRoot.LoadSdfString(worldSdf(false), serialConfig);
+  EXPECT_TRUE(errors.empty());
+
+  sdf::Root parallelRoot;
+  errors = parallelRoot.LoadSdfString(worldSdf(false), parallelConfig);
+  EXPECT_TRUE(errors.empty());
+
+  const sdf::World *serialWorld = serialRoot.WorldByIndex(0);
+  const sdf::World *parallelWorld = parallelRoot.WorldByIndex(0);
+  ASSERT_NE(nullptr, serialWorld);
+  ASSERT_NE(nullptr, parallelWorld);
+  ASSERT_EQ(static_cast<uint64_t>(modelCount), serialWorld->ModelCount());
+  ASSERT_EQ(serialWorld->ModelCount(), parallelWorld->ModelCount());
+  for (uint64_t i = 0; i < parallelWorld->ModelCount(); ++i)
+  {
+    const sdf::Model *serialModel = serialWorld->ModelByIndex(i);
+    const sdf::Model *parallelModel = parallelWorld->ModelByIndex(i);
+    EXPECT_EQ(serialModel->Name(), parallelModel->Name());
+    EXPECT_EQ(serialModel->LinkCount(), parallelModel->LinkCount());
+    EXPECT_EQ(serialModel->FrameCount(), parallelModel->FrameCount());
+  }
+
+  // The world's graphs include every model.
+  Pose pose;
+  const sdf::Model *model = parallelWorld->ModelByName("model_5");
+  ASSERT_NE(nullptr, model);
+  EXPECT_TRUE(model->SemanticPose().Resolve(pose, "world").empty());
+  EXPECT_EQ(Pose(6, 0, 0, 0, 0, 0), pose);
+  EXPECT_TRUE(model->FrameByName("frame")->
+      SemanticPose().Resolve(pose, "world").empty());
+  EXPECT_EQ(Pose(6, 0, 0, 0, 0, 0), pose);
+
+  // Errors are reported in document order.
+  sdf::Root serialErrorRoot;
+  sdf::Errors serialErrors =
+      serialErrorRoot.LoadSdfString(worldSdf(true), serialConfig);
+  ASSERT_FALSE(serialErrors.empty());
+
+  sdf::Root parallelErrorRoot;
+  sdf::Errors parallelErrors =
+      parallelErrorRoot.LoadSdfString(worldSdf(true), parallelConfig);
+  ASSERT_EQ(serialErrors.size(), parallelErrors.size());
+  for (std::size_t i = 0; i < serialErrors.size(); ++i)
+  {
+    EXPECT_EQ(serialErrors[i].Code(), parallelErrors[i].Code());
+    EXPECT_EQ(serialErrors[i].Message(), parallelErrors[i].Message());
+  }
+
+  // A model at the root of the file gets its own graphs.
+  const std::string modelSdf =
+    "<sdf version='1.8'>"
+    "  <model name='root_model'>"
+    "    <link name='link'/>"
+    "    <frame name='frame' attached_to='link'>"
+    "      <pose>0 1 0 0 0 0</pose>"
+    "    </frame>"
+    "  </model>"
+    "</sdf>";
+  sdf::Root modelRoot;
+  EXPECT_TRUE(modelRoot.LoadSdfString(modelSdf, parallelConfig).empty());
+  model = modelRoot.ModelByIndex(0);
+  ASSERT_NE(nullptr, model);
+  EXPECT_TRUE(model->FrameByName("frame")->
+      SemanticPose().Resolve(pose, "__model__").empty());
+  EXPECT_EQ(Pose(0, 1, 0, 0, 0, 0), pose);
+}
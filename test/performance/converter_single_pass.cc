@@ -0,0 +1,107 @@
+/*
+ * Copyright 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <chrono>
+#include <iostream>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "sdf/sdf.hh"
+
+#include "performance/generators.hh"
+
+/////////////////////////////////////////////////
+/// \brief Generate an SDFormat 1.6 world with _count models, each with a
+/// chain of links connected by revolute joints.
+/// \param[in] _count Number of models.
+/// \return SDFormat string.
+std::string world16(int _count)
+{
+  return generators::world("1.6", _count, [](std::ostream &_stream, int _i)
+      {
+        const int links = 5;
+        _stream << "<pose frame='world'>" << _i << " 0 0 0 0 0</pose>";
+        for (int j = 0; j < links; ++j)
+        {
+          _stream << "<link name='link_" << j << "'>"
+                  << "  <pose>0 0 " << j << " 0 0 0</pose>"
+                  << "  <visual name='v'>"
+                  << "    <pose>0 0 0.5 0 0 0</pose>"
+                  << "    <geometry><box><size>1 1 1</size></box></geometry>"
+                  << "  </visual>"
+                  << "  <collision name='c'>"
+                  << "    <pose>0 0 0.5 0 0 0</pose>"
+                  << "    <geometry><box><size>1 1 1</size></box></geometry>"
+                  << "  </collision>"
+                  << "</link>";
+          if (j > 0)
+          {
+            _stream << "<joint name='joint_" << j << "' type='revolute'>"
+                    << "  <parent>link_" << j - 1 << "</parent>"
+                    << "  <child>link_" << j << "</child>"
+                    << "  <axis>"
+                    << "    <xyz>0 0 1</xyz>"
+                    << "    <use_parent_model_frame>true"
+                    << "</use_parent_model_frame>"
+                    << "  </axis>"
+                    << "</joint>";
+          }
+        }
+        _stream << "<plugin name='p' filename='libp.so'>"
+                << "  <pose frame='link_0'>0 0 0 0 0 0</pose>"
+                << "</plugin>";
+      });
+}
+
+/////////////////////////////////////////////////
+/// Convert a large 1.6 world to the current version with the default
+/// conversion and with single pass conversion. Both must give the same
+/// result.
+TEST(ConverterPerformance, SinglePass)
+{
+  for (int count : {250, 500, 1000, 2000})
+  {
+    const std::string sdfString = world16(count);
+
+    std::string results[2];
+    double ms[2];
+    for (bool singlePass : {false, true})
+    {
+      sdf::ParserConfig config;
+      config.SetSinglePassConversionEnabled(singlePass);
+
+      sdf::SDFPtr sdfParsed(new sdf::SDF());
+      sdf::init(sdfParsed);
+      sdf::Errors errors;
+
+      auto start = std::chrono::steady_clock::now();
+      EXPECT_TRUE(sdf::readString(sdfString, config, sdfParsed, errors));
+      auto end = std::chrono::steady_clock::now();
+      EXPECT_TRUE(errors.empty());
+
+      ms[singlePass] =
+        std::chrono::duration<double, std::milli>(end - start).count();
+      results[singlePass] = sdfParsed->Root()->ToString("");
+    }
+
+    EXPECT_EQ(results[0], results[1]);
+    std::cout << "models[" << count << "] "
+              << "default[" << ms[0] << " ms] "
+              << "single pass[" << ms[1] << " ms]" << std::endl;
+  }
+}
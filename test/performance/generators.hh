@@ -0,0 +1,145 @@
+/*
+ * Copyright 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef SDF_TEST_PERFORMANCE_GENERATORS_HH_
+#define SDF_TEST_PERFORMANCE_GENERATORS_HH_
+
+#include <functional>
+#include <ostream>
+#include <sstream>
+#include <string>
+
+/// \brief Generators of SDFormat and URDF documents of any size, shared by
+/// the performance tests.
+namespace generators
+{
+  /////////////////////////////////////////////////
+  /// \brief Generate an SDFormat world named "default".
+  /// \param[in] _version SDFormat version of the document.
+  /// \param[in] _content Elements of the world.
+  /// \return SDFormat string.
+  inline std::string world(const std::string &_version,
+                           const std::string &_content)
+  {
+    return "<sdf version='" + _version + "'>"
+           "<world name='default'>" + _content + "</world>"
+           "</sdf>";
+  }
+
+  /////////////////////////////////////////////////
+  /// \brief Generate an SDFormat world named "default" with _count models
+  /// named model_0, model_1, and so on.
+  /// \param[in] _version SDFormat version of the document.
+  /// \param[in] _count Number of models.
+  /// \param[in] _model Writes the elements of the model with the given
+  /// index.
+  /// \return SDFormat string.
+  inline std::string world(const std::string &_version, int _count,
+      const std::function<void(std::ostream &, int)> &_model)
+  {
+    std::ostringstream stream;
+    for (int i = 0; i < _count; ++i)
+    {
+      stream << "<model name='model_" << i << "'>";
+      _model(stream, i);
+      stream << "</model>";
+    }
+    return world(_version, stream.str());
+  }
+
+  /// \brief Description of a URDF robot whose links form a tree. Each link
+  /// after the first one is the child of a joint with the same index.
+  struct UrdfTree
+  {
+    /// \brief Name of the robot.
+    std::string name = "tree";
+
+    /// \brief Number of links.
+    int links = 1;
+
+    /// \brief Prefix of the link names, which is followed by the index.
+    std::string linkPrefix = "link_";
+
+    /// \brief Prefix of the joint names, which is followed by the index.
+    std::string jointPrefix = "joint_";
+
+    /// \brief Index of the parent link of the link with the given index.
+    /// By default the links form a chain.
+    std::function<int(int)> parent = [](int _i) { return _i - 1; };
+
+    /// \brief Type of the joint with the given index.
+    std::function<std::string(int)> jointType =
+      [](int) { return std::string("fixed"); };
+
+    /// \brief Writes the elements of the link with the given index, if set.
+    std::function<void(std::ostream &, int)> link;
+
+    /// \brief Writes the elements of the joint with the given index besides
+    /// its parent and child, if set.
+    std::function<void(std::ostream &, int)> joint;
+
+    /// \brief Writes the elements that follow the link with the given
+    /// index, such as <gazebo> extensions, if set.
+    std::function<void(std::ostream &, int)> extensions;
+
+    /// \brief Elements written before the first link.
+    std::string header;
+
+    /// \brief Elements written after the last link.
+    std::string footer;
+  };
+
+  /////////////////////////////////////////////////
+  /// \brief Generate a URDF robot whose links form a tree.
+  /// \param[in] _tree Description of the robot.
+  /// \return URDF string.
+  inline std::string urdf(const UrdfTree &_tree)
+  {
+    std::ostringstream stream;
+    stream << "<robot name='" << _tree.name << "'>" << _tree.header;
+    for (int i = 0; i < _tree.links; ++i)
+    {
+      stream << "<link name='" << _tree.linkPrefix << i << "'>";
+      if (_tree.link)
+      {
+        _tree.link(stream, i);
+      }
+      stream << "</link>";
+
+      if (_tree.extensions)
+      {
+        _tree.extensions(stream, i);
+      }
+
+      if (i > 0)
+      {
+        stream << "<joint name='" << _tree.jointPrefix << i << "' type='"
+               << _tree.jointType(i) << "'>"
+               << "  <parent link='" << _tree.linkPrefix << _tree.parent(i)
+               << "'/>"
+               << "  <child link='" << _tree.linkPrefix << i << "'/>";
+        if (_tree.joint)
+        {
+          _tree.joint(stream, i);
+        }
+        stream << "</joint>";
+      }
+    }
+    stream << _tree.footer << "</robot>";
+    return stream.str();
+  }
+}
+#endif
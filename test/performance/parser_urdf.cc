@@ -15,12 +15,16 @@
  *
  */
 
+#include <chrono>
+#include <iostream>
+#include <set>
 #include <string>
 
 #include <gtest/gtest.h>
 
 #include "sdf/sdf.hh"
 
+#include "performance/generators.hh"
 #include "test_config.h"
 
 TEST(URDFParser, AtlasURDF_5runs_performance)
@@ -32,5 +36,107 @@ TEST(URDFParser, AtlasURDF_5runs_performance)
   for (int i = 0; i < 5; i++)
   {
     sdf::SDFPtr root = sdf::readFile(URDF_TEST_FILE);
+    ASSERT_NE(nullptr, root);
+
+    // The URDF is converted straight to the current version.
+    EXPECT_EQ(SDF_VERSION, root->OriginalVersion());
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Generate a URDF binary tree of _count links below a base link.
+/// Every _revoluteEvery-th joint is revolute, all others are fixed and get
+/// lumped. Each link has a visual, a collision and a projector reference,
+/// which is one of the link references that are renamed when the link is
+/// lumped.
+/// \param[in] _count Number of links below the base link.
+/// \param[in] _revoluteEvery Period of the revolute joints.
+/// \return URDF string.
+std::string fixedJointTree(int _count, int _revoluteEvery)
+{
+  generators::UrdfTree tree;
+  tree.links = _count + 1;
+  tree.parent = [](int _i) { return (_i - 1) / 2; };
+  tree.jointType = [_revoluteEvery](int _i)
+  {
+    return std::string(_i % _revoluteEvery == 0 ? "revolute" : "fixed");
+  };
+  tree.link = [](std::ostream &_stream, int)
+  {
+    _stream << "<inertial>"
+            << "  <origin xyz='0 0 0.1' rpy='0 0 0'/>"
+            << "  <mass value='1'/>"
+            << "  <inertia ixx='1' ixy='0' ixz='0' iyy='1' iyz='0' izz='1'/>"
+            << "</inertial>"
+            << "<visual><geometry><box size='1 1 1'/></geometry></visual>"
+            << "<collision><geometry><box size='1 1 1'/></geometry>"
+            << "</collision>";
+  };
+  tree.joint = [_revoluteEvery](std::ostream &_stream, int _i)
+  {
+    _stream << "<origin xyz='0 0.1 1' rpy='0 0 0.1'/>";
+    if (_i % _revoluteEvery == 0)
+    {
+      _stream << "<axis xyz='0 0 1'/>"
+              << "<limit lower='-1' upper='1' effort='1' velocity='1'/>";
+    }
+  };
+  tree.extensions = [](std::ostream &_stream, int _i)
+  {
+    _stream << "<gazebo>"
+            << "  <projector>link_" << _i << "/projector</projector>"
+            << "</gazebo>";
+  };
+  return generators::urdf(tree);
+}
+
+/////////////////////////////////////////////////
+/// Conversion time per link should stay roughly constant as the number of
+/// links lumped by fixed joint reduction grows.
+TEST(URDFParser, FixedJointTree_performance)
+{
+  const int revoluteEvery = 10;
+  for (int count : {250, 500, 1000, 2000})
+  {
+    const std::string urdf = fixedJointTree(count, revoluteEvery);
+
+    sdf::SDFPtr sdfParsed(new sdf::SDF());
+    sdf::init(sdfParsed);
+
+    auto start = std::chrono::steady_clock::now();
+    ASSERT_TRUE(sdf::readString(urdf, sdfParsed));
+    auto end = std::chrono::steady_clock::now();
+
+    sdf::ElementPtr model = sdfParsed->Root()->GetElement("model");
+    ASSERT_NE(nullptr, model);
+
+    // only the base link and the children of revolute joints remain
+    std::set<std::string> links;
+    for (sdf::ElementPtr link = model->GetElement("link"); link;
+         link = link->GetNextElement("link"))
+    {
+      links.insert(link->Get<std::string>("name"));
+    }
+    EXPECT_EQ(1u + count / revoluteEvery, links.size());
+
+    // the projector references are all kept, and refer to the links that
+    // remain
+    const std::string sdfString = sdfParsed->Root()->ToString("");
+    const std::string tag = "<projector>";
+    int projectors = 0;
+    for (std::size_t pos = sdfString.find(tag); pos != std::string::npos;
+         pos = sdfString.find(tag, pos + 1))
+    {
+      ++projectors;
+      const std::size_t begin = pos + tag.size();
+      const std::string linkName =
+        sdfString.substr(begin, sdfString.find('/', begin) - begin);
+      EXPECT_EQ(1u, links.count(linkName)) << linkName;
+    }
+    EXPECT_EQ(count + 1, projectors);
+
+    std::cout << count << " links: "
+              << std::chrono::duration<double, std::milli>(end - start).count()
+              << " ms\n";
   }
 }
@@ -0,0 +1,96 @@
+/*
+ * Copyright 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <chrono>
+#include <iostream>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "sdf/sdf.hh"
+
+#include "performance/generators.hh"
+
+/////////////////////////////////////////////////
+/// \brief Generate a world with _count models, each with a single link.
+/// \param[in] _count Number of models.
+/// \return SDFormat string.
+std::string wideWorld(int _count)
+{
+  return generators::world(SDF_VERSION, _count,
+      [](std::ostream &_stream, int _i)
+      {
+        _stream << "<pose>" << _i << " 0 0 0 0 0</pose>"
+                << "<link name='link'/>";
+      });
+}
+
+/////////////////////////////////////////////////
+/// Parse time per child should stay roughly constant as the number of
+/// children of a single element grows.
+TEST(ParserPerformance, WideWorld)
+{
+  // Time per model of the smallest and the largest world. The largest world
+  // has 16 times more models, so a quadratic parser would take 16 times
+  // longer per model. A bound of 4 leaves room for cache effects and timer
+  // noise.
+  const double maxRatio = 4.0;
+  double firstUsPerModel = 0;
+  double lastUsPerModel = 0;
+
+  for (int count : {500, 1000, 2000, 4000, 8000})
+  {
+    const std::string sdfString = wideWorld(count);
+
+    sdf::SDFPtr sdfParsed(new sdf::SDF());
+    sdf::init(sdfParsed);
+
+    auto start = std::chrono::steady_clock::now();
+    ASSERT_TRUE(sdf::readString(sdfString, sdfParsed));
+    auto parsed = std::chrono::steady_clock::now();
+
+    sdf::ElementPtr world = sdfParsed->Root()->GetElement("world");
+    ASSERT_NE(nullptr, world);
+
+    // Look up every model attribute and the last child repeatedly.
+    int found = 0;
+    for (sdf::ElementPtr model = world->GetElement("model"); model;
+         model = model->GetNextElement("model"))
+    {
+      if (model->GetAttribute("name") && world->HasElement("model"))
+        ++found;
+    }
+    EXPECT_EQ(count, found);
+    auto iterated = std::chrono::steady_clock::now();
+
+    const double parseMs = std::chrono::duration<double, std::milli>(
+        parsed - start).count();
+    const double iterateMs = std::chrono::duration<double, std::milli>(
+        iterated - parsed).count();
+    std::cout << "models[" << count << "] "
+              << "parse[" << parseMs << " ms, "
+              << 1000.0 * parseMs / count << " us/model] "
+              << "iterate[" << iterateMs << " ms]" << std::endl;
+
+    lastUsPerModel = 1000.0 * (parseMs + iterateMs) / count;
+    if (firstUsPerModel <= 0)
+      firstUsPerModel = lastUsPerModel;
+  }
+
+  EXPECT_LT(lastUsPerModel, maxRatio * firstUsPerModel)
+      << "Time per model grows with the number of models";
+}
@@ -0,0 +1,111 @@
+/*
+ * Copyright 2020 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <chrono>
+#include <iostream>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "sdf/sdf.hh"
+
+#include "performance/generators.hh"
+
+/////////////////////////////////////////////////
+/// \brief Generate a world with _count models, each with a link and a
+/// frame. The pose of the first model is _x.
+/// \param[in] _count Number of models.
+/// \param[in] _x X coordinate of the first model.
+/// \return SDFormat string.
+std::string editedWorld(int _count, double _x)
+{
+  return generators::world(SDF_VERSION, _count,
+      [_x](std::ostream &_stream, int _i)
+      {
+        _stream << "<pose>" << (_i == 0 ? _x : _i) << " 0 0 0 0 0</pose>"
+                << "<link name='link'/>"
+                << "<frame name='frame'>"
+                << "  <pose>0 0 1 0 0 0</pose>"
+                << "</frame>";
+      });
+}
+
+/////////////////////////////////////////////////
+/// The time to move a model of a world should stay roughly constant as the
+/// number of models grows, while loading the world again grows with it.
+TEST(WorldPerformance, UpdateModel)
+{
+  // The model is moved back and forth between two poses, so every update
+  // changes the world.
+  sdf::Root movedRoots[2];
+  const sdf::Model *moved[2];
+  for (int i = 0; i < 2; ++i)
+  {
+    ASSERT_TRUE(movedRoots[i].LoadSdfString(editedWorld(1, -1 - i)).empty());
+    moved[i] = movedRoots[i].WorldByIndex(0)->ModelByIndex(0);
+    ASSERT_NE(nullptr, moved[i]);
+  }
+
+  // Time per edit in the smallest and the largest world. The largest world
+  // has 16 times more models, so an update that depends on the size of the
+  // world would take up to 16 times longer. A bound of 4 leaves room for
+  // cache effects and timer noise.
+  const double maxRatio = 4.0;
+  double firstUsPerEdit = 0;
+  double lastUsPerEdit = 0;
+
+  const int kEdits = 100;
+  for (int count : {500, 1000, 2000, 4000, 8000})
+  {
+    const std::string sdfString = editedWorld(count, 0);
+
+    sdf::Root root;
+    auto start = std::chrono::steady_clock::now();
+    ASSERT_TRUE(root.LoadSdfString(sdfString).empty());
+    auto loaded = std::chrono::steady_clock::now();
+
+    sdf::World *world = root.WorldByIndex(0);
+    ASSERT_NE(nullptr, world);
+
+    for (int i = 0; i < kEdits; ++i)
+    {
+      ASSERT_TRUE(world->UpdateModel(*moved[i % 2]).empty());
+
+      ignition::math::Pose3d pose;
+      ASSERT_TRUE(world->ModelByIndex(0)->FrameByIndex(0)->SemanticPose()
+          .Resolve(pose, "world").empty());
+      ASSERT_EQ(ignition::math::Pose3d(-1 - i % 2, 0, 1, 0, 0, 0), pose);
+    }
+    auto updated = std::chrono::steady_clock::now();
+
+    const double loadMs = std::chrono::duration<double, std::milli>(
+        loaded - start).count();
+    const double updateMs = std::chrono::duration<double, std::milli>(
+        updated - loaded).count();
+    std::cout << "models[" << count << "] "
+              << "load[" << loadMs << " ms] "
+              << "update[" << 1000.0 * updateMs / kEdits << " us/edit]"
+              << std::endl;
+
+    lastUsPerEdit = 1000.0 * updateMs / kEdits;
+    if (firstUsPerEdit <= 0)
+      firstUsPerEdit = lastUsPerEdit;
+  }
+
+  EXPECT_LT(lastUsPerEdit, maxRatio * firstUsPerEdit)
+      << "Time per edit grows with the number of models";
+}